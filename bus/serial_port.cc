@@ -70,10 +70,24 @@ SerialPort::operator= (SerialPort&& other) noexcept
 	_max_write_failure_count = other._max_write_failure_count;
 	_input_buffer = std::move (other._input_buffer);
 	_output_buffer = std::move (other._output_buffer);
+	_read_bytes_metric = other._read_bytes_metric;
+	_written_bytes_metric = other._written_bytes_metric;
+	_read_failures_metric = other._read_failures_metric;
+	_write_failures_metric = other._write_failures_metric;
 	return *this;
 }
 
 
+void
+SerialPort::set_metrics (MetricsRegistry& metrics, MetricLabels const& labels)
+{
+	_read_bytes_metric = &metrics.counter ("neutrino_serial_port_read_bytes_total", "Number of bytes read from serial port", labels);
+	_written_bytes_metric = &metrics.counter ("neutrino_serial_port_written_bytes_total", "Number of bytes written to serial port", labels);
+	_read_failures_metric = &metrics.counter ("neutrino_serial_port_read_failures_total", "Number of serial port read failures", labels);
+	_write_failures_metric = &metrics.counter ("neutrino_serial_port_write_failures_total", "Number of serial port write failures", labels);
+}
+
+
 void
 SerialPort::set_max_read_failures (unsigned int number)
 {
@@ -107,6 +121,9 @@ SerialPort::write (Blob const& data)
 			_logger << _log_prefix << "Write failure (could not write " << _output_buffer.size() << " bytes)." << std::endl;
 			_write_failure_count++;
 
+			if (_write_failures_metric)
+				_write_failures_metric->add();
+
 			if (_write_failure_count > _max_write_failure_count)
 				notify_failure ("multiple write failures");
 		}
@@ -117,10 +134,16 @@ SerialPort::write (Blob const& data)
 	{
 		_logger << _log_prefix << "Write buffer overrun." << std::endl;
 
+		if (_written_bytes_metric)
+			_written_bytes_metric->add (to_unsigned (written));
+
 		_output_buffer.erase (_output_buffer.begin(), _output_buffer.begin() + written);
 	}
 	else
 	{
+		if (_written_bytes_metric)
+			_written_bytes_metric->add (to_unsigned (written));
+
 		_output_buffer.clear();
 		_write_failure_count = 0;
 	}
@@ -302,6 +325,10 @@ SerialPort::read()
 				{
 					_logger << _log_prefix << "Read failure (0 bytes read by read())." << std::endl;
 					_read_failure_count++;
+
+					if (_read_failures_metric)
+						_read_failures_metric->add();
+
 					if (_read_failure_count > _max_read_failure_count)
 						notify_failure ("multiple read failures");
 				}
@@ -313,10 +340,18 @@ SerialPort::read()
 	});
 
 	if (exc || err)
+	{
+		if (_read_failures_metric)
+			_read_failures_metric->add();
+
 		notify_failure ("read()");
+	}
 
 	if (!buffer.empty())
 	{
+		if (_read_bytes_metric)
+			_read_bytes_metric->add (buffer.size());
+
 		_input_buffer.append (buffer.begin(), buffer.end());
 		if (_data_ready)
 			_data_ready();
@@ -17,6 +17,7 @@
 // Neutrino:
 #include <neutrino/blob.h>
 #include <neutrino/logger.h>
+#include <neutrino/metrics.h>
 #include <neutrino/noncopyable.h>
 #include <neutrino/numeric.h>
 #include <neutrino/owner_token.h>
@@ -216,6 +217,13 @@ class SerialPort:
 	set_logger (Logger const& logger)
 		{ _logger = logger.with_context (kLoggerScope); }
 
+	/**
+	 * Register and update metrics (bytes read/written, read/write failures) in given registry.
+	 * Use labels to distinguish between multiple serial ports.
+	 */
+	void
+	set_metrics (MetricsRegistry&, MetricLabels const& = {});
+
 	/**
 	 * Set number of read failures at which
 	 * connection will be closed. Default: 0.
@@ -357,6 +365,10 @@ class SerialPort:
 	unsigned int						_max_write_failure_count	{ 0 };
 	Blob								_input_buffer;				// Data from the device.
 	Blob								_output_buffer;				// Data to to sent to the device.
+	Counter*							_read_bytes_metric			{ nullptr };
+	Counter*							_written_bytes_metric		{ nullptr };
+	Counter*							_read_failures_metric		{ nullptr };
+	Counter*							_write_failures_metric		{ nullptr };
 };
 
 
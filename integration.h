@@ -0,0 +1,431 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__INTEGRATION_H__INCLUDED
+#define NEUTRINO__INTEGRATION_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/range.h>
+#include <neutrino/si/utils.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+
+namespace neutrino {
+
+/**
+ * Type of integral of Callable over Argument (eg. si::Length for velocity integrated over time).
+ */
+template<class Argument, class Callable>
+	using IntegralOf = decltype (std::declval<Argument>() * std::declval<std::invoke_result_t<Callable, Argument>>());
+
+
+template<class Integral>
+	struct IntegrationParameters
+	{
+		// Integration stops when estimated error is below max (absolute_tolerance, relative_tolerance × |integral|):
+		Integral	absolute_tolerance	{ };
+		double		relative_tolerance	{ 1e-10 };
+		// Maximum number of subintervals the range can be split into:
+		std::size_t	max_intervals		{ 1000 };
+	};
+
+
+template<class Integral>
+	struct IntegrationResult
+	{
+		Integral	value;
+		// Estimated absolute error:
+		Integral	error;
+		std::size_t	evaluations;
+		// False if max_intervals was reached before the error target:
+		bool		converged;
+	};
+
+
+namespace detail {
+
+/**
+ * Nodes and weights of the 15-point Kronrod rule and the embedded 7-point Gauss rule on [-1, 1], for non-negative
+ * nodes. Values from QUADPACK.
+ */
+constexpr std::array<double, 8> kKronrodNodes {
+	0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+	0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+	0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+	0.207784955007898467600689403773245, 0.0,
+};
+
+constexpr std::array<double, 8> kKronrodWeights {
+	0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+	0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+	0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+	0.204432940075298892414161999234649, 0.209482141084727828012999174891714,
+};
+
+// Gauss weights for Kronrod nodes 1, 3, 5 and 7:
+constexpr std::array<double, 4> kGaussWeights {
+	0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+	0.381830050505118944950369775488975, 0.417959183673469387755102040816327,
+};
+
+
+template<class Argument, class Integral>
+	struct IntegrationInterval
+	{
+		Argument	a;
+		Argument	b;
+		Integral	value;
+		Integral	error;
+
+		[[nodiscard]]
+		friend bool
+		operator< (IntegrationInterval const& lhs, IntegrationInterval const& rhs)
+			{ return lhs.error < rhs.error; }
+	};
+
+
+/**
+ * Integrate function over [a, b] with G7K15 rule. Error estimate is the difference between Kronrod and Gauss results.
+ */
+template<class Argument, class Callable>
+	[[nodiscard]]
+	inline auto
+	gauss_kronrod_15 (Callable& function, Argument const a, Argument const b)
+	{
+		using std::abs;
+		using Integral = IntegralOf<Argument, Callable>;
+
+		auto const center = 0.5 * (a + b);
+		auto const half_length = 0.5 * (b - a);
+		auto const value_at_center = function (center);
+		auto kronrod = value_at_center * kKronrodWeights[7];
+		auto gauss = value_at_center * kGaussWeights[3];
+
+		for (std::size_t i = 0; i < 7; ++i)
+		{
+			auto const offset = half_length * kKronrodNodes[i];
+			auto const sum = function (center - offset) + function (center + offset);
+			kronrod += sum * kKronrodWeights[i];
+
+			if (i % 2 == 1)
+				gauss += sum * kGaussWeights[i / 2];
+		}
+
+		return IntegrationInterval<Argument, Integral> {
+			.a = a,
+			.b = b,
+			.value = kronrod * half_length,
+			.error = abs ((kronrod - gauss) * half_length),
+		};
+	}
+
+
+template<class Integral>
+	[[nodiscard]]
+	inline Integral
+	error_target (IntegrationParameters<Integral> const& parameters, Integral const value)
+	{
+		using std::abs;
+
+		return std::max (parameters.absolute_tolerance, parameters.relative_tolerance * abs (value));
+	}
+
+
+/**
+ * Adaptive Gauss-Kronrod integration (like QUADPACK's QAG): keep bisecting the interval with the largest error
+ * estimate. If work_performer is not nullptr, up to threads_number() worst intervals are bisected at once and
+ * the new halves are evaluated in parallel.
+ */
+template<class Argument, class Callable>
+	[[nodiscard]]
+	inline auto
+	adaptive_gauss_kronrod (Callable& function, Range<Argument> const range, IntegrationParameters<IntegralOf<Argument, Callable>> const& parameters,
+							WorkPerformer* const work_performer)
+	{
+		using Integral = IntegralOf<Argument, Callable>;
+		using Interval = IntegrationInterval<Argument, Integral>;
+
+		constexpr std::size_t kEvaluationsPerInterval = 15;
+
+		auto const batch_size = work_performer ? std::max<std::size_t> (1, work_performer->threads_number()) : 1;
+		auto const max_intervals = std::max<std::size_t> (1, parameters.max_intervals);
+		std::priority_queue<Interval> intervals;
+		Integral value { };
+		Integral error { };
+
+		auto const add = [&] (Interval const& interval) {
+			value += interval.value;
+			error += interval.error;
+			intervals.push (interval);
+		};
+
+		auto const evaluate = [&] (std::vector<std::pair<Argument, Argument>> const& bounds) {
+			if (work_performer && bounds.size() > 1)
+			{
+				std::vector<std::future<Interval>> futures;
+				futures.reserve (bounds.size());
+
+				for (auto const& [a, b]: bounds)
+					futures.push_back (work_performer->submit ([&function, a, b] { return gauss_kronrod_15 (function, a, b); }));
+
+				for (auto& future: futures)
+					add (future.get());
+			}
+			else
+			{
+				for (auto const& [a, b]: bounds)
+					add (gauss_kronrod_15 (function, a, b));
+			}
+		};
+
+		// In parallel mode start with one interval per thread:
+		std::vector<std::pair<Argument, Argument>> bounds;
+		auto const initial_intervals = std::min (batch_size, max_intervals);
+		auto const step = range.extent() / static_cast<double> (initial_intervals);
+
+		for (std::size_t i = 0; i < initial_intervals; ++i)
+			bounds.emplace_back (range.min() + step * static_cast<double> (i), i + 1 == initial_intervals ? range.max() : range.min() + step * static_cast<double> (i + 1));
+
+		evaluate (bounds);
+
+		while (error > error_target (parameters, value) && intervals.size() < max_intervals)
+		{
+			bounds.clear();
+
+			// Each bisection adds one interval:
+			for (std::size_t i = 0; i < batch_size && !intervals.empty() && intervals.size() + bounds.size() < max_intervals; ++i)
+			{
+				auto const worst = intervals.top();
+				intervals.pop();
+				value -= worst.value;
+				error -= worst.error;
+
+				auto const middle = 0.5 * (worst.a + worst.b);
+				bounds.emplace_back (worst.a, middle);
+				bounds.emplace_back (middle, worst.b);
+			}
+
+			evaluate (bounds);
+
+			// Error could drop below zero due to rounding of the running sums; recompute it from scratch then:
+			if (error < Integral())
+			{
+				auto copy = intervals;
+				error = Integral();
+
+				for (; !copy.empty(); copy.pop())
+					error += copy.top().error;
+			}
+		}
+
+		return IntegrationResult<Integral> {
+			.value = value,
+			.error = error,
+			.evaluations = kEvaluationsPerInterval * (2 * intervals.size() - initial_intervals),
+			.converged = error <= error_target (parameters, value),
+		};
+	}
+
+
+/**
+ * Return Simpson's rule integral over [a, b] given function values at a, (a + b) / 2 and b.
+ */
+template<class Argument, class Value>
+	[[nodiscard]]
+	constexpr auto
+	simpson_rule (Argument const a, Argument const b, Value const& f_a, Value const& f_m, Value const& f_b)
+	{
+		return (b - a) / 6.0 * (f_a + 4.0 * f_m + f_b);
+	}
+
+
+/**
+ * Recursive step of adaptive Simpson's method (Lyness' variant with Richardson extrapolation).
+ * Subtracts used intervals from the remaining_intervals budget.
+ */
+template<class Argument, class Callable, class Value, class Integral>
+	inline void
+	adaptive_simpson_step (Callable& function, Argument const a, Argument const b, Value const& f_a, Value const& f_m, Value const& f_b,
+						   Integral const whole, Integral const tolerance, std::size_t& remaining_intervals, IntegrationResult<Integral>& result)
+	{
+		using std::abs;
+
+		auto const m = 0.5 * (a + b);
+		auto const f_lm = function (0.5 * (a + m));
+		auto const f_rm = function (0.5 * (m + b));
+		auto const left = simpson_rule (a, m, f_a, f_lm, f_m);
+		auto const right = simpson_rule (m, b, f_m, f_rm, f_b);
+		auto const difference = left + right - whole;
+		result.evaluations += 2;
+
+		if (abs (difference) <= 15.0 * tolerance || remaining_intervals == 0)
+		{
+			result.value += left + right + difference / 15.0;
+			result.error += abs (difference) / 15.0;
+
+			if (abs (difference) > 15.0 * tolerance)
+				result.converged = false;
+		}
+		else
+		{
+			--remaining_intervals;
+			adaptive_simpson_step (function, a, m, f_a, f_lm, f_m, left, 0.5 * tolerance, remaining_intervals, result);
+			adaptive_simpson_step (function, m, b, f_m, f_rm, f_b, right, 0.5 * tolerance, remaining_intervals, result);
+		}
+	}
+
+
+/**
+ * Adaptive Simpson integration of [a, b] with given absolute tolerance.
+ */
+template<class Argument, class Callable, class Integral>
+	[[nodiscard]]
+	inline IntegrationResult<Integral>
+	adaptive_simpson (Callable& function, Argument const a, Argument const b, Integral const tolerance, std::size_t max_intervals)
+	{
+		auto const f_a = function (a);
+		auto const f_m = function (0.5 * (a + b));
+		auto const f_b = function (b);
+		IntegrationResult<Integral> result { .value = Integral(), .error = Integral(), .evaluations = 3, .converged = true };
+		adaptive_simpson_step (function, a, b, f_a, f_m, f_b, simpson_rule (a, b, f_a, f_m, f_b), tolerance, --max_intervals, result);
+		return result;
+	}
+
+
+template<class Argument, class Callable>
+	[[nodiscard]]
+	inline auto
+	adaptive_simpson (Callable& function, Range<Argument> const range, IntegrationParameters<IntegralOf<Argument, Callable>> const& parameters,
+					  WorkPerformer* const work_performer)
+	{
+		using Integral = IntegralOf<Argument, Callable>;
+
+		auto const max_intervals = std::max<std::size_t> (1, parameters.max_intervals);
+		// Simpson's method needs an absolute tolerance up front, so estimate the integral roughly first:
+		auto const rough = adaptive_simpson (function, range.min(), range.max(), Integral(), 4);
+		auto const tolerance = error_target (parameters, rough.value);
+
+		auto const tasks = work_performer ? std::min (std::max<std::size_t> (1, work_performer->threads_number()), max_intervals) : 1;
+		auto const step = range.extent() / static_cast<double> (tasks);
+		auto const bounds = [&] (std::size_t const i) {
+			return std::pair { range.min() + step * static_cast<double> (i), i + 1 == tasks ? range.max() : range.min() + step * static_cast<double> (i + 1) };
+		};
+
+		// Each part gets its share of tolerance and intervals:
+		auto const part_tolerance = tolerance / static_cast<double> (tasks);
+		auto const part_max_intervals = max_intervals / tasks;
+		IntegrationResult<Integral> result { .value = Integral(), .error = Integral(), .evaluations = rough.evaluations, .converged = true };
+
+		auto const add = [&result] (IntegrationResult<Integral> const& part) {
+			result.value += part.value;
+			result.error += part.error;
+			result.evaluations += part.evaluations;
+			result.converged = result.converged && part.converged;
+		};
+
+		if (tasks > 1)
+		{
+			std::vector<std::future<IntegrationResult<Integral>>> futures;
+			futures.reserve (tasks);
+
+			for (std::size_t i = 0; i < tasks; ++i)
+			{
+				futures.push_back (work_performer->submit ([&function, ab = bounds (i), part_tolerance, part_max_intervals] {
+					return adaptive_simpson (function, ab.first, ab.second, part_tolerance, part_max_intervals);
+				}));
+			}
+
+			for (auto& future: futures)
+				add (future.get());
+		}
+		else
+			add (adaptive_simpson (function, range.min(), range.max(), tolerance, max_intervals));
+
+		return result;
+	}
+
+} // namespace detail
+
+
+/**
+ * Integrate function over range with adaptive Gauss-Kronrod (G7K15) quadrature: the interval with the largest error
+ * estimate is bisected until the total error estimate meets the target given in parameters. Converges very quickly
+ * for smooth functions and concentrates evaluations where the function changes quickly. Like trapezoid_integral()
+ * it works with SI quantities.
+ */
+template<class Argument, class Callable>
+	[[nodiscard]]
+	inline auto
+	gauss_kronrod_integral (Callable function, Range<Argument> const range, IntegrationParameters<IntegralOf<Argument, Callable>> const& parameters = {})
+	{
+		return detail::adaptive_gauss_kronrod (function, range, parameters, nullptr);
+	}
+
+
+/**
+ * Like gauss_kronrod_integral(), but evaluate intervals in parallel on given WorkPerformer. The function
+ * must be safe to call from many threads at once. Worth it only for functions that are expensive to evaluate.
+ * Blocks until the integral is computed.
+ */
+template<class Argument, class Callable>
+	[[nodiscard]]
+	inline auto
+	gauss_kronrod_integral (Callable function, Range<Argument> const range, IntegrationParameters<IntegralOf<Argument, Callable>> const& parameters,
+							WorkPerformer& work_performer)
+	{
+		return detail::adaptive_gauss_kronrod (function, range, parameters, &work_performer);
+	}
+
+
+/**
+ * Integrate function over range with adaptive Simpson's method. Needs more evaluations than gauss_kronrod_integral()
+ * for smooth functions, but copes better with functions that aren't smooth (eg. have kinks or steps).
+ * Works with SI quantities.
+ */
+template<class Argument, class Callable>
+	[[nodiscard]]
+	inline auto
+	simpson_integral (Callable function, Range<Argument> const range, IntegrationParameters<IntegralOf<Argument, Callable>> const& parameters = {})
+	{
+		return detail::adaptive_simpson (function, range, parameters, nullptr);
+	}
+
+
+/**
+ * Like simpson_integral(), but split the range into one part per thread of given WorkPerformer. The function
+ * must be safe to call from many threads at once.
+ * Blocks until the integral is computed.
+ */
+template<class Argument, class Callable>
+	[[nodiscard]]
+	inline auto
+	simpson_integral (Callable function, Range<Argument> const range, IntegrationParameters<IntegralOf<Argument, Callable>> const& parameters,
+					  WorkPerformer& work_performer)
+	{
+		return detail::adaptive_simpson (function, range, parameters, &work_performer);
+	}
+
+} // namespace neutrino
+
+#endif
+
@@ -37,7 +37,26 @@ LoggerOutput::log (LogBlock const& block)
 	if (_add_timestamps)
 		_stream << '[' << LoggerOutput::kTimestampColor << std::format ("{:08.4f} s", block.timestamp().in<si::Second>()) << LoggerOutput::kResetColor << ']';
 
-	_stream << block.string();
+	auto const string = block.string();
+	_stream << string;
+
+	if (_blocks_metric)
+	{
+		_blocks_metric->add();
+		_bytes_metric->add (string.size());
+	}
+}
+
+
+void
+LoggerOutput::set_metrics (MetricsRegistry& metrics, MetricLabels const& labels)
+{
+	auto& blocks_metric = metrics.counter ("neutrino_logger_blocks_total", "Number of log blocks (usually lines) written", labels);
+	auto& bytes_metric = metrics.counter ("neutrino_logger_bytes_total", "Number of bytes of log messages written (without timestamps)", labels);
+
+	std::lock_guard lock (_stream_mutex);
+	_blocks_metric = &blocks_metric;
+	_bytes_metric = &bytes_metric;
 }
 
 
@@ -16,6 +16,7 @@
 
 // Neutrino:
 #include <neutrino/si/si.h>
+#include <neutrino/metrics.h>
 #include <neutrino/owner_token.h>
 #include <neutrino/polymorphic.h>
 #include <neutrino/strong_type.h>
@@ -84,6 +85,12 @@ class LoggerOutput
 	set_timestamps_enabled (bool enabled)
 		{ _add_timestamps = enabled; }
 
+	/**
+	 * Register and update metrics of logged blocks and bytes in given registry.
+	 */
+	void
+	set_metrics (MetricsRegistry&, MetricLabels const& = {});
+
 	/**
 	 * Log given LogBlock.
 	 */
@@ -95,6 +102,8 @@ class LoggerOutput
 	std::mutex		_stream_mutex;
 	std::ostream&	_stream;
 	bool			_add_timestamps		{ true };
+	Counter*		_blocks_metric		{ nullptr };
+	Counter*		_bytes_metric		{ nullptr };
 };
 
 
@@ -0,0 +1,101 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Local:
+#include "mapped_file.h"
+
+// Neutrino:
+#include <neutrino/scope_exit.h>
+#include <neutrino/stdexcept.h>
+
+// System:
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+// Standard:
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <utility>
+
+
+namespace neutrino {
+
+MappedFile::MappedFile (std::filesystem::path const& path)
+{
+	auto const fd = ::open (path.c_str(), O_RDONLY | O_CLOEXEC);
+
+	if (fd < 0)
+		throw IOError (std::format ("could not open file {}: {}", path.string(), strerror (errno)));
+
+	ScopeExit close_fd ([fd] { ::close (fd); });
+	struct stat st;
+
+	if (::fstat (fd, &st) < 0)
+		throw IOError (std::format ("could not stat file {}: {}", path.string(), strerror (errno)));
+
+	_size = static_cast<std::size_t> (st.st_size);
+
+	// mmap() doesn't accept zero length:
+	if (_size > 0)
+	{
+		auto* const data = ::mmap (nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+
+		if (data == MAP_FAILED)
+			throw IOError (std::format ("could not map file {}: {}", path.string(), strerror (errno)));
+
+		_data = static_cast<uint8_t const*> (data);
+	}
+}
+
+
+MappedFile::MappedFile (MappedFile&& other) noexcept:
+	_data (std::exchange (other._data, nullptr)),
+	_size (std::exchange (other._size, 0))
+{ }
+
+
+MappedFile::~MappedFile()
+{
+	unmap();
+}
+
+
+MappedFile&
+MappedFile::operator= (MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		unmap();
+		_data = std::exchange (other._data, nullptr);
+		_size = std::exchange (other._size, 0);
+	}
+
+	return *this;
+}
+
+
+void
+MappedFile::unmap() noexcept
+{
+	if (_data)
+		::munmap (const_cast<uint8_t*> (_data), _size);
+
+	_data = nullptr;
+	_size = 0;
+}
+
+} // namespace neutrino
@@ -0,0 +1,75 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MAPPED_FILE_H__INCLUDED
+#define NEUTRINO__MAPPED_FILE_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/blob.h>
+#include <neutrino/noncopyable.h>
+
+// Standard:
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+
+namespace neutrino {
+
+/**
+ * Read-only memory mapping of a whole file.
+ * Mapped memory is page-aligned.
+ */
+class MappedFile: private Noncopyable
+{
+  public:
+	/**
+	 * Map given file into memory.
+	 * Throws IOError if file can't be opened or mapped.
+	 */
+	explicit
+	MappedFile (std::filesystem::path const&);
+
+	// Move ctor
+	MappedFile (MappedFile&&) noexcept;
+
+	// Dtor
+	~MappedFile();
+
+	// Move operator
+	MappedFile&
+	operator= (MappedFile&&) noexcept;
+
+	/**
+	 * Return contents of the file.
+	 */
+	[[nodiscard]]
+	BlobView
+	data() const noexcept
+		{ return { _data, _size }; }
+
+  private:
+	/**
+	 * Unmap memory, if mapped.
+	 */
+	void
+	unmap() noexcept;
+
+  private:
+	uint8_t const*	_data	{ nullptr };
+	std::size_t		_size	{ 0 };
+};
+
+} // namespace neutrino
+
+#endif
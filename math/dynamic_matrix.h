@@ -0,0 +1,706 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__DYNAMIC_MATRIX_H__INCLUDED
+#define NEUTRINO__MATH__DYNAMIC_MATRIX_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/math/concepts.h>
+#include <neutrino/math/matrix.h>
+#include <neutrino/math/simd_pack.h>
+#include <neutrino/work_performer.h>
+
+// Boost:
+#include <boost/align/aligned_allocator.hpp>
+
+// Standard:
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <future>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+namespace neutrino::math {
+
+/**
+ * Non-owning view of a row-major matrix with sizes known at runtime. Used to pass fixed-size Matrix and
+ * DynamicMatrix to the same algorithms. Scalar may be const-qualified for read-only views.
+ */
+template<class pScalar>
+	class DynamicMatrixView
+	{
+	  public:
+		using Scalar = pScalar;
+
+	  public:
+		// Ctor
+		constexpr
+		DynamicMatrixView (Scalar* data, std::size_t columns, std::size_t rows, std::size_t row_stride) noexcept:
+			_data (data),
+			_columns (columns),
+			_rows (rows),
+			_row_stride (row_stride)
+		{ }
+
+		// Ctor. Converts mutable view to read-only view.
+		template<class OtherScalar>
+			requires (std::is_same_v<Scalar, OtherScalar const>)
+			constexpr
+			DynamicMatrixView (DynamicMatrixView<OtherScalar> const& other) noexcept:
+				DynamicMatrixView (other.data(), other.n_columns(), other.n_rows(), other.row_stride())
+			{ }
+
+		[[nodiscard]]
+		constexpr std::size_t
+		n_columns() const noexcept
+			{ return _columns; }
+
+		[[nodiscard]]
+		constexpr std::size_t
+		n_rows() const noexcept
+			{ return _rows; }
+
+		/**
+		 * Return distance (in elements) between starts of consecutive rows.
+		 */
+		[[nodiscard]]
+		constexpr std::size_t
+		row_stride() const noexcept
+			{ return _row_stride; }
+
+		[[nodiscard]]
+		constexpr Scalar*
+		data() const noexcept
+			{ return _data; }
+
+		/**
+		 * Fast element accessor. Doesn't perform range checks.
+		 */
+		[[nodiscard]]
+		constexpr Scalar&
+		operator[] (std::size_t column, std::size_t row) const noexcept
+			{ return _data[row * _row_stride + column]; }
+
+		/**
+		 * Return given row as a span.
+		 */
+		[[nodiscard]]
+		constexpr std::span<Scalar>
+		row (std::size_t index) const noexcept
+			{ return { _data + index * _row_stride, _columns }; }
+
+	  private:
+		Scalar*		_data;
+		std::size_t	_columns;
+		std::size_t	_rows;
+		std::size_t	_row_stride;
+	};
+
+
+/**
+ * A row-major matrix with sizes known only at runtime, for problems like least-squares fits where the number
+ * of equations depends on data. Storage is aligned to cache line.
+ *
+ * Operations on matrices of incompatible sizes throw std::length_error.
+ */
+template<Scalar pScalar>
+	class DynamicMatrix
+	{
+	  public:
+		static constexpr std::size_t kAlignment = 64;
+
+		using Scalar	= pScalar;
+		using Storage	= std::vector<Scalar, boost::alignment::aligned_allocator<Scalar, kAlignment>>;
+
+	  public:
+		// Ctor. Creates empty 0×0 matrix.
+		DynamicMatrix() = default;
+
+		// Ctor. Initializes to zero.
+		explicit
+		DynamicMatrix (std::size_t columns, std::size_t rows, ZeroInitializer = zero);
+
+		// Ctor. Initializes to identity matrix.
+		explicit
+		DynamicMatrix (std::size_t columns, std::size_t rows, IdentityInitializer);
+
+		/**
+		 * Ctor. Initializes from sequence of scalars: {
+		 *	 R0C0, R0C1, R0C2,
+		 *	 R1C0, R1C1, R1C2,
+		 *	 ...
+		 * }
+		 */
+		explicit
+		DynamicMatrix (std::size_t columns, std::size_t rows, std::initializer_list<Scalar> values);
+
+		// Ctor. Copies fixed-size matrix.
+		template<std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+			explicit
+			DynamicMatrix (Matrix<Scalar, Columns, Rows, TargetSpace, SourceSpace> const&);
+
+		// Ctor. Copies viewed matrix.
+		template<class ViewScalar>
+			requires (std::is_same_v<std::remove_const_t<ViewScalar>, Scalar>)
+			explicit
+			DynamicMatrix (DynamicMatrixView<ViewScalar> const&);
+
+		[[nodiscard]]
+		bool
+		operator== (DynamicMatrix const&) const = default;
+
+		[[nodiscard]]
+		std::size_t
+		n_columns() const noexcept
+			{ return _columns; }
+
+		[[nodiscard]]
+		std::size_t
+		n_rows() const noexcept
+			{ return _rows; }
+
+		/**
+		 * Change size. Contents are lost and matrix is zeroed.
+		 */
+		void
+		resize (std::size_t columns, std::size_t rows);
+
+		/**
+		 * Array of data.
+		 */
+		[[nodiscard]]
+		Storage&
+		components() noexcept
+			{ return _data; }
+
+		/**
+		 * Array of data.
+		 */
+		[[nodiscard]]
+		Storage const&
+		components() const noexcept
+			{ return _data; }
+
+		/**
+		 * Safe element accessor. Throws std::out_of_range when accessing elements outside matrix.
+		 */
+		[[nodiscard]]
+		Scalar&
+		at (std::size_t column, std::size_t row);
+
+		/**
+		 * Safe element accessor. Throws std::out_of_range when accessing elements outside matrix.
+		 */
+		[[nodiscard]]
+		Scalar const&
+		at (std::size_t column, std::size_t row) const
+			{ return const_cast<DynamicMatrix&> (*this).at (column, row); }
+
+		/**
+		 * Fast element accessor. Doesn't perform range checks.
+		 */
+		[[nodiscard]]
+		Scalar&
+		operator[] (std::size_t column, std::size_t row) noexcept
+			{ return _data[row * _columns + column]; }
+
+		/**
+		 * Fast element accessor. Doesn't perform range checks.
+		 */
+		[[nodiscard]]
+		Scalar const&
+		operator[] (std::size_t column, std::size_t row) const noexcept
+			{ return _data[row * _columns + column]; }
+
+		[[nodiscard]]
+		DynamicMatrixView<Scalar>
+		view() noexcept
+			{ return { _data.data(), _columns, _rows, _columns }; }
+
+		[[nodiscard]]
+		DynamicMatrixView<Scalar const>
+		view() const noexcept
+			{ return { _data.data(), _columns, _rows, _columns }; }
+
+		/**
+		 * Copy into fixed-size matrix. Throws std::length_error if sizes differ.
+		 */
+		template<std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace = void, CoordinateSystem SourceSpace = TargetSpace>
+			[[nodiscard]]
+			Matrix<Scalar, Columns, Rows, TargetSpace, SourceSpace>
+			to_matrix() const;
+
+		/**
+		 * Return transposed matrix.
+		 */
+		[[nodiscard]]
+		DynamicMatrix
+		transposed() const;
+
+		DynamicMatrix&
+		operator+= (DynamicMatrix const&);
+
+		DynamicMatrix&
+		operator-= (DynamicMatrix const&);
+
+		DynamicMatrix&
+		operator*= (Scalar const& scalar) noexcept;
+
+	  private:
+		std::size_t	_columns	{ 0 };
+		std::size_t	_rows		{ 0 };
+		Storage		_data;
+	};
+
+
+namespace detail {
+
+// Number of rows of the result computed together by the GEMM micro-kernel:
+constexpr std::size_t kGemmMicroRows	= 4;
+// Number of shared-dimension elements processed per block, so that the used part of B fits in L2 cache:
+constexpr std::size_t kGemmDepthBlock	= 128;
+// Number of result columns processed per block:
+constexpr std::size_t kGemmColumnBlock	= 256;
+
+
+template<class SA, class SB, class SR>
+	constexpr bool kGemmUsesSimd = std::is_same_v<SA, SB> && std::is_same_v<SA, SR> && simd::kNativeLanes<SR> > 1;
+
+
+inline void
+check_sizes (bool const condition, char const* message)
+{
+	if (!condition)
+		throw std::length_error (message);
+}
+
+
+/**
+ * Add A × B to Rows consecutive rows of C, for columns [column_begin, column_end) and given depth.
+ * Pointers point to the first row and first depth element to process.
+ */
+template<std::size_t Rows, class SA, class SB, class SR>
+	inline void
+	gemm_micro_kernel (SA const* a, std::size_t const a_stride,
+					   SB const* b, std::size_t const b_stride,
+					   SR* c, std::size_t const c_stride,
+					   std::size_t const depth, std::size_t const column_begin, std::size_t const column_end) noexcept
+	{
+		constexpr bool kSimd = kGemmUsesSimd<SA, SB, SR>;
+		constexpr std::size_t kLanes = kSimd ? simd::kNativeLanes<SR> : 1;
+
+		using VA = std::conditional_t<kSimd, simd::NativePack<SR>, SA>;
+		using VB = std::conditional_t<kSimd, simd::NativePack<SR>, SB>;
+		using VR = std::conditional_t<kSimd, simd::NativePack<SR>, SR>;
+
+		// Two packs wide, so that there are enough independent accumulators to hide FMA latency:
+		auto const process = [&]<std::size_t Packs> (std::size_t const j) {
+			// Unqualified calls find fused multiply-add of packs by ADL:
+			using simd::multiply_add;
+
+			std::array<std::array<VR, Packs>, Rows> acc;
+
+			for (std::size_t r = 0; r < Rows; ++r)
+				for (std::size_t p = 0; p < Packs; ++p)
+					acc[r][p] = simd::load<VR> (c + r * c_stride + j + p * kLanes);
+
+			for (std::size_t k = 0; k < depth; ++k)
+			{
+				std::array<VB, Packs> b_packs;
+
+				for (std::size_t p = 0; p < Packs; ++p)
+					b_packs[p] = simd::load<VB> (b + k * b_stride + j + p * kLanes);
+
+				for (std::size_t r = 0; r < Rows; ++r)
+				{
+					auto const a_rk = simd::broadcast<VA> (a[r * a_stride + k]);
+
+					for (std::size_t p = 0; p < Packs; ++p)
+						acc[r][p] = multiply_add (a_rk, b_packs[p], acc[r][p]);
+				}
+			}
+
+			for (std::size_t r = 0; r < Rows; ++r)
+				for (std::size_t p = 0; p < Packs; ++p)
+					simd::store (c + r * c_stride + j + p * kLanes, acc[r][p]);
+		};
+
+		std::size_t j = column_begin;
+
+		for (; j + 2 * kLanes <= column_end; j += 2 * kLanes)
+			process.template operator()<2> (j);
+
+		for (; j + kLanes <= column_end; j += kLanes)
+			process.template operator()<1> (j);
+
+		if constexpr (kSimd)
+		{
+			// Remaining columns one by one:
+			for (; j < column_end; ++j)
+			{
+				for (std::size_t r = 0; r < Rows; ++r)
+				{
+					auto sum = c[r * c_stride + j];
+
+					for (std::size_t k = 0; k < depth; ++k)
+						sum += a[r * a_stride + k] * b[k * b_stride + j];
+
+					c[r * c_stride + j] = sum;
+				}
+			}
+		}
+	}
+
+
+/**
+ * Compute rows [row_begin, row_end) of result = A × B.
+ */
+template<class SA, class SB, class SR>
+	inline void
+	gemm_rows (DynamicMatrixView<SA const> const a,
+			   DynamicMatrixView<SB const> const b,
+			   DynamicMatrixView<SR> const result,
+			   std::size_t const row_begin,
+			   std::size_t const row_end)
+	{
+		auto const depth = a.n_columns();
+		auto const columns = b.n_columns();
+
+		for (std::size_t r = row_begin; r < row_end; ++r)
+			std::ranges::fill (result.row (r), SR{});
+
+		for (std::size_t jj = 0; jj < columns; jj += kGemmColumnBlock)
+		{
+			auto const column_end = std::min (jj + kGemmColumnBlock, columns);
+
+			for (std::size_t kk = 0; kk < depth; kk += kGemmDepthBlock)
+			{
+				auto const block_depth = std::min (kGemmDepthBlock, depth - kk);
+				auto const* const b_block = b.data() + kk * b.row_stride();
+				std::size_t r = row_begin;
+
+				for (; r + kGemmMicroRows <= row_end; r += kGemmMicroRows)
+				{
+					gemm_micro_kernel<kGemmMicroRows> (a.data() + r * a.row_stride() + kk, a.row_stride(),
+													   b_block, b.row_stride(),
+													   result.data() + r * result.row_stride(), result.row_stride(),
+													   block_depth, jj, column_end);
+				}
+
+				for (; r < row_end; ++r)
+				{
+					gemm_micro_kernel<1> (a.data() + r * a.row_stride() + kk, a.row_stride(),
+										  b_block, b.row_stride(),
+										  result.data() + r * result.row_stride(), result.row_stride(),
+										  block_depth, jj, column_end);
+				}
+			}
+		}
+	}
+
+
+template<class SA, class SB, class SR>
+	inline void
+	check_gemm_sizes (DynamicMatrixView<SA> const& a, DynamicMatrixView<SB> const& b, DynamicMatrixView<SR> const& result)
+	{
+		check_sizes (a.n_columns() == b.n_rows(), "number of columns of A must be equal to number of rows of B");
+		check_sizes (result.n_rows() == a.n_rows() && result.n_columns() == b.n_columns(), "result matrix has wrong size");
+	}
+
+} // namespace detail
+
+
+template<Scalar S>
+	inline
+	DynamicMatrix<S>::DynamicMatrix (std::size_t const columns, std::size_t const rows, ZeroInitializer):
+		_columns (columns),
+		_rows (rows),
+		_data (columns * rows, Scalar{})
+	{ }
+
+
+template<Scalar S>
+	inline
+	DynamicMatrix<S>::DynamicMatrix (std::size_t const columns, std::size_t const rows, IdentityInitializer):
+		DynamicMatrix (columns, rows)
+	{
+		for (std::size_t d = 0; d < std::min (columns, rows); ++d)
+			(*this)[d, d] = Scalar (1);
+	}
+
+
+template<Scalar S>
+	inline
+	DynamicMatrix<S>::DynamicMatrix (std::size_t const columns, std::size_t const rows, std::initializer_list<Scalar> const values):
+		_columns (columns),
+		_rows (rows),
+		_data (values.begin(), values.end())
+	{
+		detail::check_sizes (values.size() == columns * rows, "number of values doesn't match matrix size");
+	}
+
+
+template<Scalar S>
+	template<std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+		inline
+		DynamicMatrix<S>::DynamicMatrix (Matrix<Scalar, Columns, Rows, TargetSpace, SourceSpace> const& matrix):
+			_columns (Columns),
+			_rows (Rows),
+			_data (matrix.components().begin(), matrix.components().end())
+		{ }
+
+
+template<Scalar S>
+	template<class ViewScalar>
+		requires (std::is_same_v<std::remove_const_t<ViewScalar>, S>)
+		inline
+		DynamicMatrix<S>::DynamicMatrix (DynamicMatrixView<ViewScalar> const& view):
+			_columns (view.n_columns()),
+			_rows (view.n_rows())
+		{
+			_data.reserve (_columns * _rows);
+
+			for (std::size_t r = 0; r < _rows; ++r)
+				_data.insert (_data.end(), view.row (r).begin(), view.row (r).end());
+		}
+
+
+template<Scalar S>
+	inline void
+	DynamicMatrix<S>::resize (std::size_t const columns, std::size_t const rows)
+	{
+		_columns = columns;
+		_rows = rows;
+		_data.assign (columns * rows, Scalar{});
+	}
+
+
+template<Scalar S>
+	inline auto
+	DynamicMatrix<S>::at (std::size_t const column, std::size_t const row) -> Scalar&
+	{
+		if (column >= _columns || row >= _rows)
+			throw std::out_of_range ("element [" + std::to_string (column) + ", " + std::to_string (row) + "] is out of bounds in the DynamicMatrix");
+
+		return (*this)[column, row];
+	}
+
+
+template<Scalar S>
+	template<std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+		inline Matrix<S, Columns, Rows, TargetSpace, SourceSpace>
+		DynamicMatrix<S>::to_matrix() const
+		{
+			detail::check_sizes (_columns == Columns && _rows == Rows, "DynamicMatrix size doesn't match fixed-size Matrix");
+			return Matrix<S, Columns, Rows, TargetSpace, SourceSpace> (_data.begin(), _data.end());
+		}
+
+
+template<Scalar S>
+	inline DynamicMatrix<S>
+	DynamicMatrix<S>::transposed() const
+	{
+		DynamicMatrix result (_rows, _columns);
+
+		for (std::size_t r = 0; r < _rows; ++r)
+			for (std::size_t c = 0; c < _columns; ++c)
+				result[r, c] = (*this)[c, r];
+
+		return result;
+	}
+
+
+template<Scalar S>
+	inline DynamicMatrix<S>&
+	DynamicMatrix<S>::operator+= (DynamicMatrix const& other)
+	{
+		detail::check_sizes (_columns == other._columns && _rows == other._rows, "matrices have different sizes");
+
+		for (std::size_t i = 0; i < _data.size(); ++i)
+			_data[i] += other._data[i];
+
+		return *this;
+	}
+
+
+template<Scalar S>
+	inline DynamicMatrix<S>&
+	DynamicMatrix<S>::operator-= (DynamicMatrix const& other)
+	{
+		detail::check_sizes (_columns == other._columns && _rows == other._rows, "matrices have different sizes");
+
+		for (std::size_t i = 0; i < _data.size(); ++i)
+			_data[i] -= other._data[i];
+
+		return *this;
+	}
+
+
+template<Scalar S>
+	inline DynamicMatrix<S>&
+	DynamicMatrix<S>::operator*= (Scalar const& scalar) noexcept
+	{
+		for (auto& value: _data)
+			value *= scalar;
+
+		return *this;
+	}
+
+
+/*
+ * Global functions
+ */
+
+
+/**
+ * Return mutable view of a fixed-size matrix.
+ */
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	[[nodiscard]]
+	constexpr DynamicMatrixView<S>
+	view (Matrix<S, Columns, Rows, TargetSpace, SourceSpace>& matrix) noexcept
+	{
+		return { matrix.components().data(), Columns, Rows, Columns };
+	}
+
+
+/**
+ * Return read-only view of a fixed-size matrix.
+ */
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	[[nodiscard]]
+	constexpr DynamicMatrixView<S const>
+	view (Matrix<S, Columns, Rows, TargetSpace, SourceSpace> const& matrix) noexcept
+	{
+		return { matrix.components().data(), Columns, Rows, Columns };
+	}
+
+
+/**
+ * Compute result = A × B using cache-blocked, SIMD-vectorized (for float and double) algorithm.
+ * Result must not overlap A or B.
+ */
+template<class SA, class SB, class SR>
+	inline void
+	gemm (DynamicMatrixView<SA> const a, DynamicMatrixView<SB> const b, DynamicMatrixView<SR> const result)
+	{
+		detail::check_gemm_sizes (a, b, result);
+		detail::gemm_rows<std::remove_const_t<SA>, std::remove_const_t<SB>, SR> (a, b, result, 0, result.n_rows());
+	}
+
+
+/**
+ * Like gemm(), but split rows of the result between threads of given WorkPerformer.
+ * Blocks until the whole product is computed.
+ */
+template<class SA, class SB, class SR>
+	inline void
+	gemm (DynamicMatrixView<SA> const a, DynamicMatrixView<SB> const b, DynamicMatrixView<SR> const result, WorkPerformer& work_performer)
+	{
+		detail::check_gemm_sizes (a, b, result);
+
+		auto const rows = result.n_rows();
+		auto const micro_blocks = (rows + detail::kGemmMicroRows - 1) / detail::kGemmMicroRows;
+		auto const tasks = std::max<std::size_t> (1, std::min (micro_blocks, work_performer.threads_number()));
+		auto const rows_per_task = (micro_blocks + tasks - 1) / tasks * detail::kGemmMicroRows;
+		std::vector<std::future<void>> futures;
+		futures.reserve (tasks);
+
+		for (std::size_t row_begin = 0; row_begin < rows; row_begin += rows_per_task)
+		{
+			auto const row_end = std::min (row_begin + rows_per_task, rows);
+			futures.push_back (work_performer.submit ([=] {
+				detail::gemm_rows<std::remove_const_t<SA>, std::remove_const_t<SB>, SR> (a, b, result, row_begin, row_end);
+			}));
+		}
+
+		for (auto& future: futures)
+			future.get();
+	}
+
+
+template<Scalar SA, Scalar SB>
+	[[nodiscard]]
+	inline auto
+	operator* (DynamicMatrix<SA> const& a, DynamicMatrix<SB> const& b)
+	{
+		DynamicMatrix<decltype (SA{} * SB{})> result (b.n_columns(), a.n_rows());
+		gemm (a.view(), b.view(), result.view());
+		return result;
+	}
+
+
+/**
+ * Return A × B computed on threads of given WorkPerformer.
+ */
+template<Scalar SA, Scalar SB>
+	[[nodiscard]]
+	inline auto
+	multiply (DynamicMatrix<SA> const& a, DynamicMatrix<SB> const& b, WorkPerformer& work_performer)
+	{
+		DynamicMatrix<decltype (SA{} * SB{})> result (b.n_columns(), a.n_rows());
+		gemm (a.view(), b.view(), result.view(), work_performer);
+		return result;
+	}
+
+
+template<Scalar S>
+	[[nodiscard]]
+	inline DynamicMatrix<S>
+	operator+ (DynamicMatrix<S> const& a, DynamicMatrix<S> const& b)
+	{
+		auto result = a;
+		result += b;
+		return result;
+	}
+
+
+template<Scalar S>
+	[[nodiscard]]
+	inline DynamicMatrix<S>
+	operator- (DynamicMatrix<S> const& a, DynamicMatrix<S> const& b)
+	{
+		auto result = a;
+		result -= b;
+		return result;
+	}
+
+
+template<Scalar S>
+	[[nodiscard]]
+	inline DynamicMatrix<S>
+	operator* (DynamicMatrix<S> const& matrix, S const& scalar)
+	{
+		auto result = matrix;
+		result *= scalar;
+		return result;
+	}
+
+
+template<Scalar S>
+	[[nodiscard]]
+	inline DynamicMatrix<S>
+	operator* (S const& scalar, DynamicMatrix<S> const& matrix)
+	{
+		return matrix * scalar;
+	}
+
+} // namespace neutrino::math
+
+#endif
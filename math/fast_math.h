@@ -0,0 +1,556 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__FAST_MATH_H__INCLUDED
+#define NEUTRINO__MATH__FAST_MATH_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/math/simd_pack.h>
+#include <neutrino/si/si.h>
+
+// Standard:
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+/**
+ * Approximate elementary functions computed over whole arrays of values.
+ *
+ * Each function takes contiguous input ranges (vectors, arrays, spans) and writes results into an output range
+ * of the same size. Kernels are branch-free, so loops over them get vectorized by the compiler; there's no need
+ * to use SIMD packs explicitly. Accuracy is selected with the Accuracy template parameter; Accuracy::Full just
+ * calls std functions.
+ *
+ * Trigonometric functions also accept si::Angle values and fast_atan2() can write si::Angle results.
+ */
+namespace neutrino::math {
+
+enum class Accuracy
+{
+	// Relative error below about 1e-3 (absolute for fast_sin(), fast_cos() and fast_atan2()):
+	Low,
+	// Relative error below about 1e-6 (absolute for fast_sin(), fast_cos() and fast_atan2()):
+	Medium,
+	// Same results as std functions:
+	Full,
+};
+
+
+namespace detail {
+
+template<class S>
+	struct FastMathTraits;
+
+
+template<>
+	struct FastMathTraits<double>
+	{
+		using Bits = std::int64_t;
+
+		static constexpr int	kMantissaBits	= 52;
+		static constexpr Bits	kExponentBias	= 1023;
+		// Adding and subtracting this constant rounds a value to the nearest integer:
+		static constexpr double	kRoundingMagic	= 0x1.8p52;
+		static constexpr double	kMinExpArgument	= -708.0;
+		static constexpr double	kMaxExpArgument	= +709.0;
+		// π/2 split into a value with trailing zero bits (so that k × kPi2High is exact) and the rest:
+		static constexpr double	kPi2High		= 1.57079632673412561417e+00;
+		static constexpr double	kPi2Low			= 6.07710050650619224932e-11;
+		// ln 2 split the same way:
+		static constexpr double	kLn2High		= 6.93147180369123816490e-01;
+		static constexpr double	kLn2Low			= 1.90821492927058770002e-10;
+	};
+
+
+template<>
+	struct FastMathTraits<float>
+	{
+		using Bits = std::int32_t;
+
+		static constexpr int	kMantissaBits	= 23;
+		static constexpr Bits	kExponentBias	= 127;
+		static constexpr float	kRoundingMagic	= 0x1.8p23f;
+		static constexpr float	kMinExpArgument	= -87.0f;
+		static constexpr float	kMaxExpArgument	= +88.0f;
+		static constexpr float	kPi2High		= 1.5703125f;
+		static constexpr float	kPi2Low			= 4.83826794896619231e-04f;
+		static constexpr float	kLn2High		= 0.693145751953125f;
+		static constexpr float	kLn2Low			= 1.42860682030941723212e-06f;
+	};
+
+
+/**
+ * Evaluate polynomial c₀ + c₁ x + c₂ x² + … with Horner's method.
+ */
+template<class S, class ...Coefficients>
+	[[nodiscard]]
+	constexpr S
+	polynomial (S const x, S const c0, Coefficients const ...cs) noexcept
+	{
+		if constexpr (sizeof... (cs) == 0)
+			return c0;
+		else
+			return c0 + x * polynomial (x, static_cast<S> (cs)...);
+	}
+
+
+/**
+ * Round to nearest integer, return it both as a floating-point and an integer value. |x| must be less than 2²².
+ */
+template<class S>
+	[[nodiscard]]
+	constexpr auto
+	round_with_bits (S const x) noexcept
+	{
+		using Traits = FastMathTraits<S>;
+
+		auto const shifted = x + Traits::kRoundingMagic;
+		auto const integer = std::bit_cast<typename Traits::Bits> (shifted) - std::bit_cast<typename Traits::Bits> (Traits::kRoundingMagic);
+		return std::pair { shifted - Traits::kRoundingMagic, integer };
+	}
+
+
+template<Accuracy kAccuracy, class S>
+	[[nodiscard]]
+	inline S
+	exp_kernel (S const x) noexcept
+	{
+		using Traits = FastMathTraits<S>;
+
+		if constexpr (kAccuracy == Accuracy::Full)
+			return std::exp (x);
+		else
+		{
+			// eˣ = 2ⁿ eʳ, where |r| ≤ ln 2 / 2:
+			auto const clamped = std::clamp (x, static_cast<S> (Traits::kMinExpArgument), static_cast<S> (Traits::kMaxExpArgument));
+			auto const [n, n_bits] = round_with_bits (clamped * std::numbers::log2e_v<S>);
+			auto const r = clamped - n * Traits::kLn2High - n * Traits::kLn2Low;
+			S exp_r;
+
+			// Taylor series; the error of the last omitted term is below 7e-4 and 2e-7 respectively:
+			if constexpr (kAccuracy == Accuracy::Low)
+				exp_r = polynomial<S> (r, 1, 1, 1.0 / 2, 1.0 / 6);
+			else
+				exp_r = polynomial<S> (r, 1, 1, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720);
+
+			auto const two_to_n = std::bit_cast<S> ((n_bits + Traits::kExponentBias) << Traits::kMantissaBits);
+			auto const result = exp_r * two_to_n;
+
+			if (x < Traits::kMinExpArgument)
+				return 0;
+			else if (x > Traits::kMaxExpArgument)
+				return std::numeric_limits<S>::infinity();
+			else
+				return result;
+		}
+	}
+
+
+template<Accuracy kAccuracy, class S>
+	[[nodiscard]]
+	inline S
+	log_kernel (S const x) noexcept
+	{
+		using Traits = FastMathTraits<S>;
+		using Bits = typename Traits::Bits;
+
+		if constexpr (kAccuracy == Accuracy::Full)
+			return std::log (x);
+		else
+		{
+			constexpr Bits kMantissaMask = (Bits (1) << Traits::kMantissaBits) - 1;
+			constexpr Bits kOneBits = Traits::kExponentBias << Traits::kMantissaBits;
+
+			// Scale subnormal arguments up, so that they have implicit leading 1 bit:
+			auto const subnormal = x < std::numeric_limits<S>::min();
+			auto const normal_x = subnormal ? x * static_cast<S> (Bits (1) << Traits::kMantissaBits) : x;
+
+			// x = 2ᵉ m, where m is in [√½, √2):
+			auto const bits = std::bit_cast<Bits> (normal_x);
+			auto e = static_cast<S> ((bits >> Traits::kMantissaBits) - Traits::kExponentBias - (subnormal ? Traits::kMantissaBits : 0));
+			auto m = std::bit_cast<S> ((bits & kMantissaMask) | kOneBits);
+			auto const above = m > std::numbers::sqrt2_v<S>;
+			m = above ? m * S (0.5) : m;
+			e = above ? e + 1 : e;
+
+			// ln m = 2 atanh (s) = 2 (s + s³/3 + s⁵/5 + …), where s = (m - 1) / (m + 1) and |s| < 0.172:
+			auto const s = (m - 1) / (m + 1);
+			auto const s2 = s * s;
+			S series;
+
+			if constexpr (kAccuracy == Accuracy::Low)
+				series = polynomial<S> (s2, 1, 1.0 / 3);
+			else
+				series = polynomial<S> (s2, 1, 1.0 / 3, 1.0 / 5, 1.0 / 7);
+
+			auto const result = e * Traits::kLn2High + (2 * s * series + e * Traits::kLn2Low);
+
+			// Zero, negative and infinite arguments:
+			if (x == 0)
+				return -std::numeric_limits<S>::infinity();
+			else if (!(x >= 0))
+				return std::numeric_limits<S>::quiet_NaN();
+			else if (x == std::numeric_limits<S>::infinity())
+				return x;
+			else
+				return result;
+		}
+	}
+
+
+/**
+ * Compute sine and cosine of x together. Range reduction is accurate for |x| up to about 10⁵ (double) or 10³ (float).
+ */
+template<Accuracy kAccuracy, class S>
+	inline void
+	sin_cos_kernel (S const x, S& sin, S& cos) noexcept
+	{
+		using Traits = FastMathTraits<S>;
+
+		if constexpr (kAccuracy == Accuracy::Full)
+		{
+			sin = std::sin (x);
+			cos = std::cos (x);
+		}
+		else
+		{
+			// x = k π/2 + r, where |r| ≤ π/4:
+			auto const [k, quadrant] = round_with_bits (x * std::numbers::inv_pi_v<S> * 2);
+			auto const r = x - k * Traits::kPi2High - k * Traits::kPi2Low;
+			auto const r2 = r * r;
+			S sin_r;
+			S cos_r;
+
+			// Taylor series; for |r| ≤ π/4 the error of the last omitted term is below 4e-5 and 4e-7 respectively:
+			if constexpr (kAccuracy == Accuracy::Low)
+			{
+				sin_r = r * polynomial<S> (r2, 1, -1.0 / 6, 1.0 / 120);
+				cos_r = polynomial<S> (r2, 1, -1.0 / 2, 1.0 / 24, -1.0 / 720);
+			}
+			else
+			{
+				sin_r = r * polynomial<S> (r2, 1, -1.0 / 6, 1.0 / 120, -1.0 / 5040, 1.0 / 362880);
+				cos_r = polynomial<S> (r2, 1, -1.0 / 2, 1.0 / 24, -1.0 / 720, 1.0 / 40320, -1.0 / 3628800);
+			}
+
+			// Select sin or cos and the sign by the quadrant:
+			auto const swap = (quadrant & 1) != 0;
+			auto const s = swap ? cos_r : sin_r;
+			auto const c = swap ? sin_r : cos_r;
+			sin = (quadrant & 2) != 0 ? -s : s;
+			cos = ((quadrant + 1) & 2) != 0 ? -c : c;
+		}
+	}
+
+
+template<Accuracy kAccuracy, class S>
+	[[nodiscard]]
+	inline S
+	atan2_kernel (S const y, S const x) noexcept
+	{
+		if constexpr (kAccuracy == Accuracy::Full)
+			return std::atan2 (y, x);
+		else
+		{
+			constexpr auto kTanPi8 = static_cast<S> (std::numbers::sqrt2 - 1);
+			constexpr auto kPi = std::numbers::pi_v<S>;
+
+			// Reduce to atan (a) with a in [0, 1]:
+			auto const abs_x = std::abs (x);
+			auto const abs_y = std::abs (y);
+			auto const max = std::max (abs_x, abs_y);
+			auto const min = std::min (abs_x, abs_y);
+			auto const a = max > 0 ? min / max : S (0);
+			// And further to atan (t) with |t| ≤ tan (π/8), using atan (a) = π/4 + atan ((a - 1) / (a + 1)):
+			auto const above = a > kTanPi8;
+			auto const t = above ? (a - 1) / (a + 1) : a;
+			auto const t2 = t * t;
+			S atan_t;
+
+			// Taylor series; for |t| ≤ tan (π/8) the error of the last omitted term is below 3e-4 and 8e-7 respectively:
+			if constexpr (kAccuracy == Accuracy::Low)
+				atan_t = t * polynomial<S> (t2, 1, -1.0 / 3, 1.0 / 5);
+			else
+				atan_t = t * polynomial<S> (t2, 1, -1.0 / 3, 1.0 / 5, -1.0 / 7, 1.0 / 9, -1.0 / 11);
+
+			auto angle = above ? kPi / 4 + atan_t : atan_t;
+			angle = abs_y > abs_x ? kPi / 2 - angle : angle;
+			angle = x < 0 ? kPi - angle : angle;
+			return std::copysign (angle, y);
+		}
+	}
+
+
+template<Accuracy kAccuracy, class S>
+	[[nodiscard]]
+	inline S
+	rsqrt_kernel (S const x) noexcept
+	{
+		using Traits = FastMathTraits<S>;
+		using Bits = typename Traits::Bits;
+
+		if constexpr (kAccuracy == Accuracy::Full)
+			return 1 / std::sqrt (x);
+		else
+		{
+			// Initial approximation from the bit representation, followed by Newton iterations, each of which
+			// roughly squares the relative error (3.4e-2, 1.8e-3, 4.7e-6, 3e-11):
+			constexpr Bits kMagic = std::is_same_v<S, double> ? Bits (0x5fe6eb50c7b537a9) : Bits (0x5f3759df);
+			constexpr int kIterations = kAccuracy == Accuracy::Low ? 2 : 3;
+
+			auto y = std::bit_cast<S> (kMagic - (std::bit_cast<Bits> (x) >> 1));
+
+			for (int i = 0; i < kIterations; ++i)
+				y = y * (S (1.5) - S (0.5) * x * y * y);
+
+			return y;
+		}
+	}
+
+
+/**
+ * Apply function to each element of inputs, writing to outputs. Throws std::length_error if sizes are different.
+ * If the first range contains si::Angles, they're converted to radians in chunks first, so that the loop over
+ * function can still be vectorized.
+ */
+template<class Function>
+	inline void
+	for_each_value (Function&& function, auto const& first, auto&& ...others)
+	{
+		using First = std::ranges::range_value_t<decltype (first)>;
+
+		auto const size = std::ranges::size (first);
+
+		if (((std::ranges::size (others) != size) || ...))
+			throw std::length_error ("input and output ranges must have the same size");
+
+		auto const first_data = std::ranges::data (first);
+
+		// Raw pointers let the compiler vectorize the loops:
+		[&] (auto* const ...others_data) {
+			if constexpr (std::is_same_v<First, si::Angle>)
+			{
+				constexpr std::size_t kChunkSize = 256;
+				std::array<typename First::Value, kChunkSize> radians;
+
+				for (std::size_t begin = 0; begin < size; begin += kChunkSize)
+				{
+					auto const n = std::min (kChunkSize, size - begin);
+
+					for (std::size_t i = 0; i < n; ++i)
+						radians[i] = first_data[begin + i].template in<si::units::Radian>();
+
+					for (std::size_t i = 0; i < n; ++i)
+						function (radians[i], others_data[begin + i]...);
+				}
+			}
+			else
+			{
+				for (std::size_t i = 0; i < size; ++i)
+					function (first_data[i], others_data[i]...);
+			}
+		} (std::ranges::data (others)...);
+	}
+
+} // namespace detail
+
+
+/**
+ * Contiguous range of floating-point values.
+ */
+template<class Range>
+	concept FastMathRange =
+		std::ranges::contiguous_range<Range> &&
+		std::ranges::sized_range<Range> &&
+		std::floating_point<std::ranges::range_value_t<Range>>;
+
+
+/**
+ * Contiguous range of floating-point values or si::Angles.
+ */
+template<class Range>
+	concept FastMathAngleRange =
+		std::ranges::contiguous_range<Range> &&
+		std::ranges::sized_range<Range> &&
+		(std::floating_point<std::ranges::range_value_t<Range>> || std::is_same_v<std::ranges::range_value_t<Range>, si::Angle>);
+
+
+/**
+ * Compute eˣ for each x. Arguments below about -708 (double) or -87 (float) give 0, which is less precise than
+ * std::exp() in the subnormal range.
+ * Throws std::length_error if ranges have different sizes.
+ */
+template<Accuracy kAccuracy = Accuracy::Medium>
+	inline void
+	fast_exp (FastMathRange auto const& xs, FastMathRange auto&& results)
+	{
+		detail::for_each_value ([] (auto const x, auto& result) {
+			result = detail::exp_kernel<kAccuracy> (x);
+		}, xs, results);
+	}
+
+
+/**
+ * Compute natural logarithm of each x.
+ * Throws std::length_error if ranges have different sizes.
+ */
+template<Accuracy kAccuracy = Accuracy::Medium>
+	inline void
+	fast_log (FastMathRange auto const& xs, FastMathRange auto&& results)
+	{
+		detail::for_each_value ([] (auto const x, auto& result) {
+			result = detail::log_kernel<kAccuracy> (x);
+		}, xs, results);
+	}
+
+
+/**
+ * Compute sine of each angle. Range reduction is accurate for angles up to about 10⁵ rad (10³ rad for floats).
+ * Throws std::length_error if ranges have different sizes.
+ */
+template<Accuracy kAccuracy = Accuracy::Medium>
+	inline void
+	fast_sin (FastMathAngleRange auto const& angles, FastMathRange auto&& results)
+	{
+		detail::for_each_value ([] (auto const angle, auto& result) {
+			std::remove_reference_t<decltype (result)> unused;
+			detail::sin_cos_kernel<kAccuracy> (angle, result, unused);
+		}, angles, results);
+	}
+
+
+/**
+ * Compute cosine of each angle. See fast_sin().
+ * Throws std::length_error if ranges have different sizes.
+ */
+template<Accuracy kAccuracy = Accuracy::Medium>
+	inline void
+	fast_cos (FastMathAngleRange auto const& angles, FastMathRange auto&& results)
+	{
+		detail::for_each_value ([] (auto const angle, auto& result) {
+			std::remove_reference_t<decltype (result)> unused;
+			detail::sin_cos_kernel<kAccuracy> (angle, unused, result);
+		}, angles, results);
+	}
+
+
+/**
+ * Compute both sine and cosine of each angle, at about the cost of one of them. See fast_sin().
+ * Throws std::length_error if ranges have different sizes.
+ */
+template<Accuracy kAccuracy = Accuracy::Medium>
+	inline void
+	fast_sin_cos (FastMathAngleRange auto const& angles, FastMathRange auto&& sines, FastMathRange auto&& cosines)
+	{
+		detail::for_each_value ([] (auto const angle, auto& sin, auto& cos) {
+			detail::sin_cos_kernel<kAccuracy> (angle, sin, cos);
+		}, angles, sines, cosines);
+	}
+
+
+/**
+ * Compute atan2 (y, x) for each pair of values. Arguments can be SI quantities of the same type. Results can be
+ * floating-point values (radians) or si::Angles.
+ * Throws std::length_error if ranges have different sizes.
+ */
+template<Accuracy kAccuracy = Accuracy::Medium>
+	inline void
+	fast_atan2 (std::ranges::contiguous_range auto const& ys, std::ranges::contiguous_range auto const& xs, FastMathAngleRange auto&& results)
+	{
+		detail::for_each_value ([] (auto const y, auto const x, auto& result) {
+			static_assert (std::is_same_v<decltype (y), decltype (x)>, "y and x must have the same type");
+
+			using Result = std::remove_reference_t<decltype (result)>;
+
+			auto angle = [&] {
+				if constexpr (std::floating_point<decltype (y)>)
+					return detail::atan2_kernel<kAccuracy> (y, x);
+				else
+					return detail::atan2_kernel<kAccuracy> (y.to_floating_point(), x.to_floating_point());
+			}();
+
+			if constexpr (std::is_same_v<Result, si::Angle>)
+				result = si::Angle (angle);
+			else
+				result = angle;
+		}, ys, xs, results);
+	}
+
+
+/**
+ * Compute square root of each x. It's always exact, since hardware square root is as fast as any approximation.
+ * Also accepts SI quantities (computed without SIMD).
+ * Throws std::length_error if ranges have different sizes.
+ */
+inline void
+fast_sqrt (std::ranges::contiguous_range auto const& xs, std::ranges::contiguous_range auto&& results)
+{
+	using std::sqrt;
+	using S = std::ranges::range_value_t<decltype (xs)>;
+
+	auto const size = std::ranges::size (xs);
+
+	if (std::ranges::size (results) != size)
+		throw std::length_error ("input and output ranges must have the same size");
+
+	auto const input = std::ranges::data (xs);
+	auto const output = std::ranges::data (results);
+
+	if constexpr (std::floating_point<S>)
+	{
+		simd::for_each_pack<S> (size, [&]<class V> (std::size_t const i) {
+			simd::store (output + i, V (sqrt (simd::load<V> (input + i))));
+		});
+	}
+	else
+	{
+		for (std::size_t i = 0; i < size; ++i)
+			output[i] = sqrt (input[i]);
+	}
+}
+
+
+/**
+ * Compute 1 / √x for each x. Also accepts SI quantities: the approximation is computed on values in base units.
+ * Throws std::length_error if ranges have different sizes.
+ */
+template<Accuracy kAccuracy = Accuracy::Medium>
+	inline void
+	fast_rsqrt (std::ranges::contiguous_range auto const& xs, std::ranges::contiguous_range auto&& results)
+	{
+		detail::for_each_value ([] (auto const x, auto& result) {
+			using Result = std::remove_reference_t<decltype (result)>;
+
+			if constexpr (std::floating_point<Result>)
+				result = detail::rsqrt_kernel<kAccuracy> (x);
+			else
+				result = Result (detail::rsqrt_kernel<kAccuracy> (x.to_base_unit_floating_point()));
+		}, xs, results);
+	}
+
+} // namespace neutrino::math
+
+#endif
+
@@ -18,25 +18,323 @@
 #include <neutrino/map.h>
 #include <neutrino/numeric.h>
 #include <neutrino/sequence_utils.h>
+#include <neutrino/si/concepts.h>
 #include <neutrino/synchronized.h>
 #include <neutrino/types.h>
+#include <neutrino/work_performer.h>
 
 // Standard:
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
 #include <cstddef>
+#include <future>
 #include <initializer_list>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <tuple>
 #include <vector>
 #include <type_traits>
+#include <utility>
 
 
 namespace neutrino::math {
 
+/**
+ * Interpolation of Field values along the last argument, see Field::compile().
+ */
+enum class FieldInterpolation
+{
+	Linear,
+	CubicSpline,	// Natural cubic spline, continuous second derivative
+	Akima,			// Akima spline, less overshoot than cubic spline near outliers
+	Pchip,			// Piecewise cubic Hermite interpolating polynomial, preserves monotonicity of data
+};
+
+
+namespace detail {
+
+template<class Tuple>
+	struct FieldKeyArraysH;
+
+
+template<class ...Keys>
+	struct FieldKeyArraysH<std::tuple<Keys...>>
+	{
+		using type = std::tuple<std::vector<std::remove_cvref_t<Keys>>...>;
+	};
+
+
+/**
+ * Keys for which position on a uniform axis can be computed arithmetically.
+ */
+template<class Key>
+	concept FieldUniformAxisKey = requires (Key a) {
+		{ (a - a) * (1.0 / (a - a)) } -> std::convertible_to<double>;
+	};
+
+
+/**
+ * Evenly spaced keys of a submap.
+ */
+template<class Key>
+	struct FieldUniformAxis
+	{ };
+
+
+template<FieldUniformAxisKey Key>
+	struct FieldUniformAxis<Key>
+	{
+		Key									first;
+		decltype (1.0 / (first - first))	inverse_spacing;
+	};
+
+
+template<class Tuple>
+	struct FieldUniformAxesH;
+
+
+template<class ...Keys>
+	struct FieldUniformAxesH<std::tuple<Keys...>>
+	{
+		using type = std::tuple<std::vector<std::optional<FieldUniformAxis<std::remove_cvref_t<Keys>>>>...>;
+	};
+
+
+/**
+ * Return uniform axis description if keys are evenly spaced. Keys may deviate from perfectly uniform positions
+ * by 1% of spacing (eg. due to rounding errors in generated tables); lookups always return exact results anyway.
+ */
+template<class Key>
+	inline std::optional<FieldUniformAxis<Key>>
+	detect_uniform_axis (std::span<Key const> const keys)
+	{
+		constexpr double kTolerance = 0.01;
+
+		if constexpr (FieldUniformAxisKey<Key>)
+		{
+			if (keys.size() >= 3)
+			{
+				auto const inverse_spacing = static_cast<double> (keys.size() - 1) / (keys.back() - keys.front());
+
+				for (std::size_t i = 0; i < keys.size(); ++i)
+				{
+					double const position = (keys[i] - keys.front()) * inverse_spacing;
+
+					if (!(std::abs (position - static_cast<double> (i)) <= kTolerance))
+						return std::nullopt;
+				}
+
+				return FieldUniformAxis<Key> { keys.front(), inverse_spacing };
+			}
+		}
+
+		return std::nullopt;
+	}
+
+
+/**
+ * Compute derivatives at keys of a natural cubic spline going through given points.
+ * Requires at least 3 points.
+ */
+template<class Key, class Slope>
+	inline void
+	compute_natural_spline_slopes (std::span<Key const> const keys, std::span<Slope const> const secants, std::span<Slope> const slopes)
+	{
+		using Curvature = decltype (std::declval<Slope>() / std::declval<Key>());
+
+		auto const n = keys.size();
+		// Solve the tridiagonal system for second derivatives with the Thomas algorithm; second derivatives at both
+		// ends are 0:
+		std::vector<double> upper (n, 0.0);
+		std::vector<Curvature> rhs (n, Curvature (0.0));
+		std::vector<Curvature> second (n, Curvature (0.0));
+
+		for (std::size_t i = 1; i < n - 1; ++i)
+		{
+			auto const h0 = keys[i] - keys[i - 1];
+			auto const h1 = keys[i + 1] - keys[i];
+			auto const diagonal = 2.0 * (h0 + h1) - h0 * upper[i - 1];
+			upper[i] = h1 / diagonal;
+			rhs[i] = (6.0 * (secants[i] - secants[i - 1]) - h0 * rhs[i - 1]) / diagonal;
+		}
+
+		for (std::size_t i = n - 1; i-- > 1; )
+			second[i] = rhs[i] - upper[i] * second[i + 1];
+
+		for (std::size_t i = 0; i < n - 1; ++i)
+			slopes[i] = secants[i] - (keys[i + 1] - keys[i]) * (2.0 * second[i] + second[i + 1]) / 6.0;
+
+		slopes[n - 1] = secants[n - 2] + (keys[n - 1] - keys[n - 2]) * (second[n - 2] + 2.0 * second[n - 1]) / 6.0;
+	}
+
+
+/**
+ * Compute derivatives at keys of an Akima spline. Requires at least 3 points.
+ */
+template<class Slope>
+	inline void
+	compute_akima_slopes (std::span<Slope const> const secants, std::span<Slope> const slopes)
+	{
+		using std::abs;
+
+		auto const m = secants.size();
+		// Secants extended by two on each side by linear extrapolation:
+		auto const secant = [&] (std::ptrdiff_t const i) -> Slope {
+			auto const last = static_cast<std::ptrdiff_t> (m) - 1;
+
+			if (i < 0)
+				return secants[0] + static_cast<double> (-i) * (secants[0] - secants[1]);
+			else if (i > last)
+				return secants[m - 1] + static_cast<double> (i - last) * (secants[m - 1] - secants[m - 2]);
+			else
+				return secants[static_cast<std::size_t> (i)];
+		};
+
+		for (std::size_t k = 0; k < slopes.size(); ++k)
+		{
+			auto const i = static_cast<std::ptrdiff_t> (k);
+			auto const w1 = abs (secant (i + 1) - secant (i));
+			auto const w2 = abs (secant (i - 1) - secant (i - 2));
+
+			if (w1 + w2 == Slope (0.0))
+				slopes[k] = 0.5 * (secant (i - 1) + secant (i));
+			else
+			{
+				auto const r = w1 / (w1 + w2);
+				slopes[k] = r * secant (i - 1) + (1.0 - r) * secant (i);
+			}
+		}
+	}
+
+
+/**
+ * Compute derivatives at keys of a PCHIP interpolant (Fritsch-Carlson method with three-point end
+ * conditions, same as in SciPy). Requires at least 3 points.
+ */
+template<class Key, class Slope>
+	inline void
+	compute_pchip_slopes (std::span<Key const> const keys, std::span<Slope const> const secants, std::span<Slope> const slopes)
+	{
+		using std::abs;
+
+		auto const n = keys.size();
+
+		for (std::size_t i = 1; i < n - 1; ++i)
+		{
+			if (sgn (secants[i - 1]) * sgn (secants[i]) <= 0)
+				slopes[i] = Slope (0.0);
+			else
+			{
+				auto const h0 = keys[i] - keys[i - 1];
+				auto const h1 = keys[i + 1] - keys[i];
+				auto const w1 = 2.0 * h1 + h0;
+				auto const w2 = h1 + 2.0 * h0;
+				slopes[i] = (w1 + w2) / (w1 / secants[i - 1] + w2 / secants[i]);
+			}
+		}
+
+		auto const end_slope = [] (Key const h0, Key const h1, Slope const s0, Slope const s1) {
+			auto const slope = ((2.0 * h0 + h1) * s0 - h0 * s1) / (h0 + h1);
+
+			if (sgn (slope) != sgn (s0))
+				return Slope (0.0);
+			else if (sgn (s0) != sgn (s1) && abs (slope) > 3.0 * abs (s0))
+				return 3.0 * s0;
+			else
+				return slope;
+		};
+
+		slopes[0] = end_slope (keys[1] - keys[0], keys[2] - keys[1], secants[0], secants[1]);
+		slopes[n - 1] = end_slope (keys[n - 1] - keys[n - 2], keys[n - 2] - keys[n - 3], secants[n - 2], secants[n - 3]);
+	}
+
+
+/**
+ * Compute coefficients of cubic polynomials interpolating between each pair of neighbouring keys. Polynomials
+ * are functions of position t ∈ [0, 1] within the cell: y (t) = c[0] + c[1] t + c[2] t² + c[3] t³.
+ * Coefficients for the last key describe a constant polynomial.
+ */
+template<class Key, class Value>
+	inline void
+	compute_cubic_coefficients (std::span<Key const> const keys, std::span<Value const> const values, FieldInterpolation const interpolation,
+								std::span<std::array<Value, 4>> const coefficients)
+	{
+		using Slope = decltype (std::declval<Value>() / std::declval<Key>());
+
+		auto const n = keys.size();
+		std::vector<Slope> secants (n - 1);
+		std::vector<Slope> slopes (n);
+
+		for (std::size_t i = 0; i + 1 < n; ++i)
+			secants[i] = (values[i + 1] - values[i]) / (keys[i + 1] - keys[i]);
+
+		if (n == 2)
+			slopes = { secants[0], secants[0] };
+		else if (n > 2)
+		{
+			switch (interpolation)
+			{
+				case FieldInterpolation::Linear:
+					// Slopes are not used.
+					break;
+
+				case FieldInterpolation::CubicSpline:
+					compute_natural_spline_slopes<Key, Slope> (keys, secants, slopes);
+					break;
+
+				case FieldInterpolation::Akima:
+					compute_akima_slopes<Slope> (secants, slopes);
+					break;
+
+				case FieldInterpolation::Pchip:
+					compute_pchip_slopes<Key, Slope> (keys, secants, slopes);
+					break;
+			}
+		}
+
+		// Cubic Hermite polynomials with given slopes at both ends of each cell:
+		for (std::size_t i = 0; i + 1 < n; ++i)
+		{
+			auto const h = keys[i + 1] - keys[i];
+			auto const d0 = h * slopes[i];
+			auto const d1 = h * slopes[i + 1];
+			auto const dy = values[i + 1] - values[i];
+
+			if (interpolation == FieldInterpolation::Linear)
+				coefficients[i] = { values[i], dy, Value (0.0), Value (0.0) };
+			else
+				coefficients[i] = { values[i], d0, 3.0 * dy - 2.0 * d0 - d1, d0 + d1 - 2.0 * dy };
+		}
+
+		coefficients[n - 1] = { values[n - 1], Value (0.0), Value (0.0), Value (0.0) };
+	}
+
+} // namespace detail
+
+
 /**
  * N-dimensional lookup table with interpolation/extrapolation support.
  *
  * Template parameters are argument types followed by the result value type.
  * Example: Field<X, Y, Z, V> describes a 3-dimensional field mapping
  * (X, Y, Z) -> V.
+ *
+ * Besides the map of points, Field keeps a flat copy of it for fast lookups in value() and extrapolated_value():
+ * for each dimension one contiguous sorted array of keys of all submaps on that level, offsets of child keys
+ * of each key on the next level, and an array of values for the last level. Bracketing points are found with
+ * binary search within each submap. Submaps with evenly spaced keys (at least 3) are detected during construction
+ * and for them the bracketing points are computed arithmetically in O(1).
+ *
+ * By default values are interpolated linearly. Field can be compiled into cubic polynomials for each cell along
+ * the last argument with compile(), so that much sparser tables give the same accuracy.
+ *
+ * Points of minimum and maximum values of the whole field and of the subspaces below each key are computed together
+ * with flat tables, so min_value(), max_value(), codomain() and min/max_argument() don't need to walk the whole map.
  */
 template<class Argument0, class ...RemainingArgumentsAndValue>
 	class Field
@@ -52,6 +350,15 @@ template<class Argument0, class ...RemainingArgumentsAndValue>
 		using Arguments				= TupleSlice<0, std::tuple_size_v<ArgumentsAndValue> - 1, ArgumentsAndValue>;
 		using Value					= std::remove_cvref_t<std::tuple_element_t<kNumArguments, ArgumentsAndValue>>;
 		using DataMap				= MultiDimensionalMap<Arguments, Value>;
+		using KeyArrays				= typename detail::FieldKeyArraysH<Arguments>::type;
+		using UniformAxes			= typename detail::FieldUniformAxesH<Arguments>::type;
+		using LastArgument			= std::remove_cvref_t<std::tuple_element_t<kNumArguments - 1, Arguments>>;
+
+		// Whether compile() can be used:
+		static constexpr bool kCubicInterpolationSupported = si::FloatingPointOrQuantity<Value> && si::FloatingPointOrQuantity<LastArgument>;
+
+		// Whether values can be compared, so that min_value(), max_value(), etc. can be used:
+		static constexpr bool kOrderedValues = requires (Value const& a, Value const& b) { { a < b } -> std::convertible_to<bool>; };
 
 		/**
 		 * A point in the field subspace. Arguments and value.
@@ -126,6 +433,8 @@ template<class Argument0, class ...RemainingArgumentsAndValue>
 			{ }
 		};
 
+		class Cursor;
+
 	  public:
 		/**
 		 * Create a data-table from argument-value points given in the map.
@@ -194,6 +503,67 @@ template<class Argument0, class ...RemainingArgumentsAndValue>
 			Value
 			operator() (Args&&...) const;
 
+		/**
+		 * Compute value() for many points at once: results[i] is set to value() for points[i].
+		 *
+		 * Points are processed in small blocks. First bracketing keys and interpolation weights are found for each
+		 * point of the block; points falling into the same or neighbouring cells as the previous point don't need
+		 * searches (see Cursor), so points sorted or clustered by arguments are evaluated fastest. Then interpolation is computed for the whole block
+		 * in loops that the compiler can vectorize. Results are the same as from value().
+		 *
+		 * Throws std::length_error if spans have different sizes.
+		 */
+		void
+		evaluate (std::span<Arguments const> points, std::span<std::optional<Value>> results) const;
+
+		/**
+		 * Like evaluate(), but split points between threads of given WorkPerformer.
+		 * Blocks until all results are computed.
+		 */
+		void
+		evaluate (std::span<Arguments const> points, std::span<std::optional<Value>> results, WorkPerformer&) const;
+
+		/**
+		 * Compute extrapolated_value() for many points at once. Same notes as for evaluate() apply.
+		 */
+		void
+		evaluate_extrapolated (std::span<Arguments const> points, std::span<Value> results) const;
+
+		/**
+		 * Like evaluate_extrapolated(), but split points between threads of given WorkPerformer.
+		 * Blocks until all results are computed.
+		 */
+		void
+		evaluate_extrapolated (std::span<Arguments const> points, std::span<Value> results, WorkPerformer&) const;
+
+		/**
+		 * Compute coefficients of cubic polynomials for each cell along the last argument, so that values are
+		 * interpolated with given method instead of linearly. Other arguments are still interpolated linearly.
+		 * Evaluation is a Horner scheme on a flat array of coefficients. Compiling with FieldInterpolation::Linear
+		 * restores linear interpolation.
+		 *
+		 * Note that cubic splines and Akima splines may overshoot data points, so min_value(), max_value() and
+		 * codomain() (which only consider data points) may not contain all interpolated values.
+		 */
+		void
+		compile (FieldInterpolation)
+			requires (kCubicInterpolationSupported);
+
+		/**
+		 * Return interpolation method along the last argument.
+		 */
+		[[nodiscard]]
+		FieldInterpolation
+		interpolation() const noexcept
+			{ return _interpolation; }
+
+		/**
+		 * Return a Cursor for fast lookups at points that change smoothly between calls.
+		 */
+		[[nodiscard]]
+		Cursor
+		cursor() const;
+
 		/**
 		 * Return the point of minimum known argument.
 		 */
@@ -271,6 +641,61 @@ template<class Argument0, class ...RemainingArgumentsAndValue>
 		DataMap const&
 		data_map() const;
 
+	  private:
+		// Number of values needed to interpolate at a point:
+		static constexpr std::size_t kCorners				= std::size_t (1) << kNumArguments;
+		// Number of points evaluated together by evaluate():
+		static constexpr std::size_t kEvaluationBlockSize	= 64;
+		// Minimum number of points per task in parallel evaluate():
+		static constexpr std::size_t kMinPointsPerTask		= 4096;
+
+		/**
+		 * Bracket found for the previous point by evaluate() or Cursor. Position of the bracket is relative to the
+		 * beginning of the submap, so that it's also a good guess when the submap changes (neighbouring submaps
+		 * usually have similar keys).
+		 */
+		struct CachedBracket
+		{
+			std::size_t	position	{ std::numeric_limits<std::size_t>::max() };
+		};
+
+		// One cached bracket for each node of the interpolation tree (at most kCorners / 2 nodes on the last level):
+		using BracketCache = std::array<std::array<CachedBracket, kCorners / 2>, kNumArguments>;
+
+		/**
+		 * Interpolation data for a block of points in evaluate(). Interpolation of a point is a binary tree: node k
+		 * on level L interpolates between nodes 2k and 2k + 1 on level L + 1 with weight weights[2^L - 1 + k];
+		 * nodes below the last level are values of the field with indices given in corners.
+		 */
+		struct EvaluationBlock
+		{
+			std::array<std::array<std::size_t, kEvaluationBlockSize>, kCorners>	corners;
+			std::array<std::array<double, kEvaluationBlockSize>, kCorners - 1>		weights;
+			std::array<std::array<Value, kEvaluationBlockSize>, kCorners>			values;
+			std::array<bool, kEvaluationBlockSize>									defined;
+		};
+
+		// Point in the subspace of keys on given Level; its arguments are for Level and further levels:
+		template<std::size_t Level>
+			using LevelPoint = SubspacePoint<TupleSlice<Level, kNumArguments, Arguments>>;
+
+		/**
+		 * Points of minimum and maximum values in subspaces below each key on given Level (other than the last one).
+		 * Points for key i are min[i] and max[i]; their arguments are for levels Level + 1 and further.
+		 */
+		template<std::size_t Level>
+			struct LevelExtremes
+			{
+				std::vector<LevelPoint<Level + 1>>	min;
+				std::vector<LevelPoint<Level + 1>>	max;
+			};
+
+		template<std::size_t ...Level>
+			static std::tuple<LevelExtremes<Level>...>
+			level_extremes_tuple (std::index_sequence<Level...>);
+
+		using ValueExtremes = decltype (level_extremes_tuple (std::make_index_sequence<kNumArguments - 1>()));
+
 	  private:
 		/**
 		 * Search all submaps and throw EmptyDomainException if any of the maps
@@ -281,45 +706,147 @@ template<class Argument0, class ...RemainingArgumentsAndValue>
 			validate (Map const&);
 
 		/**
-		 * Helper for min_argument() and max_argument().
+		 * Return true if value a is better than b, that is less for minimum searches or greater for maximum ones.
+		 */
+		template<bool Maximum>
+			[[nodiscard]]
+			static bool
+			is_better (Value const& a, Value const& b)
+			{
+				if constexpr (Maximum)
+					return a > b;
+				else
+					return a < b;
+			}
+
+		/**
+		 * Compute points of minimum and maximum values below each key and in the whole field.
+		 */
+		void
+		compute_value_extremes();
+
+		/**
+		 * Return the point of minimum value (or maximum if Maximum is true) in the subspace of the key with given index
+		 * on given Level. Arguments of the point start with the key itself.
 		 */
-		template<class Map, class GetIter>
+		template<bool Maximum, std::size_t Level>
 			[[nodiscard]]
-			typename Map::key_type
-			compute_minmax_argument (Map const&, GetIter&&) const;
+			LevelPoint<Level>
+			extreme_point (std::size_t index) const;
 
 		/**
-		 * Helper for min_argument() and max_argument().
+		 * Return the best of extreme_point() for keys [begin, end) on given Level. If there are many, the first one
+		 * is returned.
 		 */
-		template<class Map, class GetIter, class X, class ...Xs>
+		template<bool Maximum, std::size_t Level>
 			[[nodiscard]]
-			std::optional<NthArgument<sizeof...(Xs) + 1u>>
-			compute_minmax_argument (Map const&, GetIter&&, X&&, Xs&&...) const;
+			LevelPoint<Level>
+			best_point (std::size_t begin, std::size_t end) const;
 
 		/**
 		 * Helper for min_argument() and max_argument().
 		 */
-		template<class Map, class IsBetter>
+		template<bool Maximum, std::size_t Level, class X, class ...Xs>
 			[[nodiscard]]
-			MinMaxSubspacePoint<Map>
-			compute_minmax_value (Map const&, IsBetter&&) const;
+			std::optional<NthArgument<Level + sizeof...(Xs) + 1>>
+			compute_minmax_argument (std::size_t submap, X&&, Xs&&...) const;
 
 		/**
-		 * Helper for min_argument() and max_argument().
+		 * Helper for min_value_point() and max_value_point().
 		 */
-		template<class Map, class IsBetter, class X, class ...Xs>
+		template<bool Maximum, std::size_t Level, class X, class ...Xs>
 			[[nodiscard]]
-			MinMaxSubspacePoint<Map, X, Xs...>
-			compute_minmax_value (Map const&, IsBetter&&, X&&, Xs&&...) const;
+			std::optional<LevelPoint<Level>>
+			compute_minmax_value (std::size_t submap, X&&, Xs&&...) const;
+
+		/**
+		 * Build flat lookup tables from the map.
+		 */
+		void
+		build_flat_tables();
 
 		/**
-		 * Return interpolated value for given map.
-		 * Argument must be within data domain for that map.
+		 * Helper for build_flat_tables(). Append keys and values of the map to tables of given Level.
 		 */
-		template<class Map, class X, class ...Xs>
+		template<std::size_t Level, class Map>
+			void
+			flatten (Map const&);
+
+		/**
+		 * Return range of indices of keys of given submap in std::get<Level> (_keys).
+		 */
+		template<std::size_t Level>
+			[[nodiscard]]
+			std::pair<std::size_t, std::size_t>
+			submap_range (std::size_t submap) const;
+
+		/**
+		 * Find keys bracketing x in given submap on given Level; semantics are the same as of
+		 * adjacent_find_for_extrapolation().
+		 */
+		template<std::size_t Level, class X>
+			[[nodiscard]]
+			std::tuple<bool, NthArgument<Level> const*, NthArgument<Level> const*>
+			find_bracket (std::size_t submap, X const& x) const;
+
+		/**
+		 * Like find_bracket(), but first check the cached bracket and its neighbouring cells and search only if x
+		 * doesn't fall into any of them. Return indices of bracketing keys in std::get<Level> (_keys).
+		 * If cached is nullptr, just search.
+		 */
+		template<std::size_t Level, class X>
+			[[nodiscard]]
+			std::tuple<bool, std::size_t, std::size_t>
+			find_cached_bracket (std::size_t submap, X const& x, CachedBracket* cached) const;
+
+		/**
+		 * Return position of x within the cell [x0, x1], from 0 to 1.
+		 */
+		template<class X, class Key>
+			[[nodiscard]]
+			static double
+			cell_position (X const& x, Key const& x0, Key const& x1);
+
+		/**
+		 * Evaluate cubic polynomial of given cell of the last level at given position within the cell.
+		 */
+		[[nodiscard]]
+		Value
+		cubic_value (std::size_t cell, double position) const;
+
+		/**
+		 * Return interpolated value for given submap on given Level of the flat tables.
+		 * Submap index is the index of its parent key on the previous level.
+		 * If cache is not nullptr, brackets are cached in it; node is the index of the node of interpolation tree
+		 * on the Level, see EvaluationBlock.
+		 */
+		template<std::size_t Level, class X, class ...Xs>
 			[[nodiscard]]
 			std::optional<Value>
-			compute_value (Map&&, bool extrapolate, X&&, Xs&&...) const;
+			compute_value (std::size_t submap, bool extrapolate, BracketCache* cache, std::size_t node, X&&, Xs&&...) const;
+
+		/**
+		 * Fill in corners and weights of given node of the interpolation tree of point q of the block.
+		 * Return false if value is undefined at the point.
+		 */
+		template<std::size_t Level>
+			[[nodiscard]]
+			bool
+			compute_stencil (std::size_t submap, std::size_t node, Arguments const& point, bool extrapolate, BracketCache&, EvaluationBlock&, std::size_t q) const;
+
+		/**
+		 * Implementation of evaluate() and evaluate_extrapolated().
+		 */
+		template<class Result>
+			void
+			evaluate_points (std::span<Arguments const> points, std::span<Result> results, bool extrapolate) const;
+
+		/**
+		 * Implementation of parallel evaluate() and evaluate_extrapolated().
+		 */
+		template<class Result>
+			void
+			evaluate_points (std::span<Arguments const> points, std::span<Result> results, bool extrapolate, WorkPerformer&) const;
 
 		/**
 		 * Renormalization helper for all values of a tuple.
@@ -348,9 +875,115 @@ template<class Argument0, class ...RemainingArgumentsAndValue>
 				return result;
 			}
 
-	  private:
-		DataMap _data_map;
-	};
+	  private:
+		DataMap				_data_map;
+		// Flat copy of _data_map used for lookups.
+		// Child keys of key i on level L are std::get<L + 1> (_keys)[_offsets[L][i] … _offsets[L][i + 1]).
+		KeyArrays			_keys;
+		std::array<std::vector<std::size_t>, kNumArguments - 1>
+							_offsets;
+		std::vector<Value>	_values;
+		// Uniform axis for each submap on each level, or std::nullopt if submap keys are not evenly spaced:
+		UniformAxes			_uniform_axes;
+		FieldInterpolation	_interpolation { FieldInterpolation::Linear };
+		// Coefficients of cubic polynomials for each cell on the last level, empty for linear interpolation.
+		// Cell i is between keys i and i + 1 on the last level:
+		std::vector<std::array<Value, 4>>
+							_coefficients;
+		// Summaries for min_value_point() and max_value_point(), computed together with flat tables:
+		ValueExtremes		_value_extremes;
+		std::optional<Point>
+							_min_value_point;
+		std::optional<Point>
+							_max_value_point;
+	};
+
+
+/**
+ * Lookups into a Field for arguments that change smoothly between calls (eg. tables sampled every few milliseconds).
+ * Cursor remembers keys bracketing the previous arguments on each axis and checks that cell and its neighbours
+ * first, so in the common case a lookup takes a couple of comparisons per axis. Keys are searched for only when
+ * arguments jump further. Results are the same as from Field::value() and Field::extrapolated_value().
+ *
+ * Cursor refers to the Field, which must outlive it. A single Cursor must not be used by many threads at once.
+ */
+template<class A, class ...R>
+	class Field<A, R...>::Cursor
+	{
+	  public:
+		// Ctor
+		explicit
+		Cursor (Field const&);
+
+		/**
+		 * Same as Field::value().
+		 */
+		template<class ...Args>
+			[[nodiscard]]
+			std::optional<Value>
+			value (Args&&...);
+
+		/**
+		 * Same as Field::extrapolated_value().
+		 */
+		template<class ...Args>
+			[[nodiscard]]
+			Value
+			extrapolated_value (Args&&...);
+
+		/**
+		 * Alias for extrapolated_value().
+		 */
+		template<class ...Args>
+			[[nodiscard]]
+			Value
+			operator() (Args&&...);
+
+	  private:
+		Field const*	_field;
+		BracketCache	_cache;
+	};
+
+
+template<class A, class ...R>
+	inline
+	Field<A, R...>::Cursor::Cursor (Field const& field):
+		_field (&field)
+	{ }
+
+
+template<class A, class ...R>
+	template<class ...Args>
+		inline auto
+		Field<A, R...>::Cursor::value (Args&& ...args)
+			-> std::optional<Value>
+		{
+			static_assert (sizeof...(args) == kNumArguments, "not enough arguments");
+
+			return _field->template compute_value<0> (0, false, &_cache, 0, std::forward<Args> (args)...);
+		}
+
+
+template<class A, class ...R>
+	template<class ...Args>
+		inline auto
+		Field<A, R...>::Cursor::extrapolated_value (Args&& ...args)
+			-> Value
+		{
+			static_assert (sizeof...(args) == kNumArguments, "not enough arguments");
+
+			return *_field->template compute_value<0> (0, true, &_cache, 0, std::forward<Args> (args)...);
+		}
+
+
+template<class A, class ...R>
+	template<class ...Args>
+		inline auto
+		Field<A, R...>::Cursor::operator() (Args&& ...args)
+			-> Value
+		{
+			return extrapolated_value (std::forward<Args> (args)...);
+		}
 
 
 template<class A, class ...R>
@@ -359,6 +992,7 @@ template<class A, class ...R>
 		_data_map (map)
 	{
 		validate (_data_map);
+		build_flat_tables();
 	}
 
 
@@ -368,6 +1002,7 @@ template<class A, class ...R>
 		_data_map (std::move (map))
 	{
 		validate (_data_map);
+		build_flat_tables();
 	}
 
 
@@ -377,13 +1012,23 @@ template<class A, class ...R>
 		_data_map (std::move (pairs))
 	{
 		validate (_data_map);
+		build_flat_tables();
 	}
 
 
 template<class A, class ...R>
 	inline
 	Field<A, R...>::Field (Field&& other) noexcept:
-		_data_map (std::move (other._data_map))
+		_data_map (std::move (other._data_map)),
+		_keys (std::move (other._keys)),
+		_offsets (std::move (other._offsets)),
+		_values (std::move (other._values)),
+		_uniform_axes (std::move (other._uniform_axes)),
+		_interpolation (other._interpolation),
+		_coefficients (std::move (other._coefficients)),
+		_value_extremes (std::move (other._value_extremes)),
+		_min_value_point (std::move (other._min_value_point)),
+		_max_value_point (std::move (other._max_value_point))
 	{ }
 
 
@@ -392,6 +1037,15 @@ template<class A, class ...R>
 	Field<A, R...>::operator= (Field&& other) noexcept
 	{
 		_data_map = std::move (other._data_map);
+		_keys = std::move (other._keys);
+		_offsets = std::move (other._offsets);
+		_values = std::move (other._values);
+		_uniform_axes = std::move (other._uniform_axes);
+		_interpolation = other._interpolation;
+		_coefficients = std::move (other._coefficients);
+		_value_extremes = std::move (other._value_extremes);
+		_min_value_point = std::move (other._min_value_point);
+		_max_value_point = std::move (other._max_value_point);
 		return *this;
 	}
 
@@ -412,7 +1066,7 @@ template<class A, class ...R>
 		{
 			static_assert (sizeof...(args) == kNumArguments, "not enough arguments");
 
-			return compute_value (_data_map, false, std::forward<Args> (args)...);
+			return compute_value<0> (0, false, nullptr, 0, std::forward<Args> (args)...);
 		}
 
 
@@ -424,7 +1078,7 @@ template<class A, class ...R>
 		{
 			static_assert (sizeof...(args) == kNumArguments, "not enough arguments");
 
-			return *compute_value (_data_map, true, std::forward<Args> (args)...);
+			return *compute_value<0> (0, true, nullptr, 0, std::forward<Args> (args)...);
 		}
 
 
@@ -438,6 +1092,75 @@ template<class A, class ...R>
 		}
 
 
+template<class A, class ...R>
+	inline void
+	Field<A, R...>::compile (FieldInterpolation const interpolation)
+		requires (kCubicInterpolationSupported)
+	{
+		constexpr auto kLastLevel = kNumArguments - 1;
+
+		_interpolation = interpolation;
+		_coefficients.clear();
+
+		if (interpolation != FieldInterpolation::Linear)
+		{
+			auto const& keys = std::get<kLastLevel> (_keys);
+			auto const submaps = std::get<kLastLevel> (_uniform_axes).size();
+			_coefficients.resize (keys.size());
+
+			for (std::size_t submap = 0; submap < submaps; ++submap)
+			{
+				auto const [begin, end] = submap_range<kLastLevel> (submap);
+				auto const n = end - begin;
+
+				detail::compute_cubic_coefficients<LastArgument, Value> (std::span (keys).subspan (begin, n), std::span (_values).subspan (begin, n),
+																		 interpolation, std::span (_coefficients).subspan (begin, n));
+			}
+		}
+	}
+
+
+template<class A, class ...R>
+	inline auto
+	Field<A, R...>::cursor() const
+		-> Cursor
+	{
+		return Cursor (*this);
+	}
+
+
+template<class A, class ...R>
+	inline void
+	Field<A, R...>::evaluate (std::span<Arguments const> const points, std::span<std::optional<Value>> const results) const
+	{
+		evaluate_points (points, results, false);
+	}
+
+
+template<class A, class ...R>
+	inline void
+	Field<A, R...>::evaluate (std::span<Arguments const> const points, std::span<std::optional<Value>> const results, WorkPerformer& work_performer) const
+	{
+		evaluate_points (points, results, false, work_performer);
+	}
+
+
+template<class A, class ...R>
+	inline void
+	Field<A, R...>::evaluate_extrapolated (std::span<Arguments const> const points, std::span<Value> const results) const
+	{
+		evaluate_points (points, results, true);
+	}
+
+
+template<class A, class ...R>
+	inline void
+	Field<A, R...>::evaluate_extrapolated (std::span<Arguments const> const points, std::span<Value> const results, WorkPerformer& work_performer) const
+	{
+		evaluate_points (points, results, true, work_performer);
+	}
+
+
 template<class A, class ...R>
 	template<class ...Args>
 		inline auto
@@ -446,12 +1169,10 @@ template<class A, class ...R>
 		{
 			static_assert (sizeof...(Args) <= kNumArguments - 1, "number of arguments must be between 0 and dimensions()-1");
 
-			auto const get_iter = [](auto&& map) { return map.begin(); };
-
 			if constexpr (sizeof...(Args) == 0)
-				return compute_minmax_argument (_data_map, get_iter);
+				return std::get<0> (_keys).front();
 			else
-				return compute_minmax_argument (_data_map, get_iter, std::forward<Args> (xs)...);
+				return compute_minmax_argument<false, 0> (0, std::forward<Args> (xs)...);
 		}
 
 
@@ -463,12 +1184,10 @@ template<class A, class ...R>
 		{
 			static_assert (sizeof...(Args) <= kNumArguments - 1, "number of arguments must be between 0 and dimensions()-1");
 
-			auto const get_iter = [](auto&& map) { return map.rbegin(); };
-
 			if constexpr (sizeof...(Args) == 0)
-				return compute_minmax_argument (_data_map, get_iter);
+				return std::get<0> (_keys).back();
 			else
-				return compute_minmax_argument (_data_map, get_iter, std::forward<Args> (xs)...);
+				return compute_minmax_argument<true, 0> (0, std::forward<Args> (xs)...);
 		}
 
 
@@ -480,9 +1199,10 @@ template<class A, class ...R>
 		{
 			static_assert (sizeof...(Args) <= kNumArguments - 1, "number of arguments must be between 0 and dimensions()-1");
 
-			auto const is_better = [](auto&& a, auto&& b) { return a < b; };
-
-			return compute_minmax_value (_data_map, is_better, std::forward<Args> (xs)...);
+			if constexpr (sizeof...(Args) == 0)
+				return *_min_value_point;
+			else
+				return compute_minmax_value<false, 0> (0, std::forward<Args> (xs)...);
 		}
 
 
@@ -494,9 +1214,10 @@ template<class A, class ...R>
 		{
 			static_assert (sizeof...(Args) <= kNumArguments - 1, "number of arguments must be between 0 and dimensions()-1");
 
-			auto const is_better = [](auto&& a, auto&& b) { return a > b; };
-
-			return compute_minmax_value (_data_map, is_better, std::forward<Args> (xs)...);
+			if constexpr (sizeof...(Args) == 0)
+				return *_max_value_point;
+			else
+				return compute_minmax_value<true, 0> (0, std::forward<Args> (xs)...);
 		}
 
 
@@ -550,17 +1271,17 @@ template<class A, class ...R>
 				return { min_argument(), max_argument() };
 			else
 			{
-				auto min = min_argument();
+				auto min = min_argument (xs...);
 
 				if (!min)
 					return std::nullopt;
 
-				auto max = max_argument();
+				auto max = max_argument (xs...);
 
 				if (!max)
 					return std::nullopt;
 
-				return { *min, *max };
+				return Range { *min, *max };
 			}
 		}
 
@@ -576,17 +1297,17 @@ template<class A, class ...R>
 				return { min_value(), max_value() };
 			else
 			{
-				auto min_y = min_value_point (std::forward<Args> (args)...);
+				auto min_y = min_value (args...);
 
 				if (!min_y)
 					return std::nullopt;
 
-				auto max_y = max_value_point (std::forward<Args> (args)...);
+				auto max_y = max_value (args...);
 
 				if (!max_y)
 					return std::nullopt;
 
-				return { *min_y, *max_y };
+				return Range { *min_y, *max_y };
 			}
 		}
 
@@ -617,47 +1338,115 @@ template<class A, class ...R>
 
 
 template<class A, class ...R>
-	template<class Map, class GetIter>
+	inline void
+	Field<A, R...>::compute_value_extremes()
+	{
+		if constexpr (kOrderedValues)
+		{
+			// From the last level to the first one, so that extremes below keys of the next level are already known:
+			[&]<std::size_t ...I> (std::index_sequence<I...>) {
+				([&] {
+					constexpr std::size_t kLevel = kNumArguments - 2 - I;
+
+					auto& extremes = std::get<kLevel> (_value_extremes);
+					auto const& offsets = _offsets[kLevel];
+					auto const size = std::get<kLevel> (_keys).size();
+					extremes.min.reserve (size);
+					extremes.max.reserve (size);
+
+					for (std::size_t i = 0; i < size; ++i)
+					{
+						extremes.min.push_back (best_point<false, kLevel + 1> (offsets[i], offsets[i + 1]));
+						extremes.max.push_back (best_point<true, kLevel + 1> (offsets[i], offsets[i + 1]));
+					}
+				}(), ...);
+			} (std::make_index_sequence<kNumArguments - 1>());
+
+			_min_value_point = best_point<false, 0> (0, std::get<0> (_keys).size());
+			_max_value_point = best_point<true, 0> (0, std::get<0> (_keys).size());
+		}
+	}
+
+
+template<class A, class ...R>
+	template<bool Maximum, std::size_t Level>
+		inline auto
+		Field<A, R...>::extreme_point (std::size_t const index) const
+			-> LevelPoint<Level>
+		{
+			auto const& key = std::get<Level> (_keys)[index];
+
+			if constexpr (Level == kNumArguments - 1)
+				return LevelPoint<Level> (std::make_tuple (key), _values[index]);
+			else
+			{
+				auto const& extremes = std::get<Level> (_value_extremes);
+				auto const& below = Maximum ? extremes.max[index] : extremes.min[index];
+				return LevelPoint<Level> (std::tuple_cat (std::make_tuple (key), below.arguments), below.value);
+			}
+		}
+
+
+template<class A, class ...R>
+	template<bool Maximum, std::size_t Level>
 		inline auto
-		Field<A, R...>::compute_minmax_argument (Map const& map, GetIter&& get_iter) const
-			-> typename Map::key_type
+		Field<A, R...>::best_point (std::size_t const begin, std::size_t const end) const
+			-> LevelPoint<Level>
 		{
-			return get_iter (map)->first;
+			auto best = extreme_point<Maximum, Level> (begin);
+
+			for (std::size_t i = begin + 1; i < end; ++i)
+			{
+				auto const candidate = extreme_point<Maximum, Level> (i);
+
+				if (is_better<Maximum> (candidate.value, best.value))
+					best = candidate;
+			}
+
+			return best;
 		}
 
 
 template<class A, class ...R>
-	template<class Map, class GetIter, class X, class ...Xs>
+	template<bool Maximum, std::size_t Level, class X, class ...Xs>
 		inline auto
-		Field<A, R...>::compute_minmax_argument (Map const& map, GetIter&& get_iter, X&& x_unconverted, Xs&& ...xs) const
-			-> std::optional<NthArgument<sizeof...(Xs) + 1u>>
+		Field<A, R...>::compute_minmax_argument (std::size_t const submap, X&& x_unconverted, Xs&& ...xs) const
+			-> std::optional<NthArgument<Level + sizeof...(Xs) + 1>>
 		{
-			using MapKey = typename Map::key_type;
+			using Key = NthArgument<Level>;
 
-			// "x" is a key in the "map" argument.
+			// "x" is a key on the Level.
 
-			auto const x = static_cast<MapKey> (x_unconverted);
-			auto const get_first = [](auto pair) { return pair.first; };
-			auto const [ia, ib] = adjacent_find (map.begin(), map.end(), x, get_first);
+			auto const x = static_cast<Key> (x_unconverted);
+			auto const& keys = std::get<Level> (_keys);
+			auto const [begin, end] = submap_range<Level> (submap);
+			auto const [inside_domain, ia, ib] = sorted_adjacent_find_for_extrapolation (keys.data() + begin, keys.data() + end, x, [](Key const& key) { return key; });
 
-			if (ia == ib)
+			if (!inside_domain || ia == ib)
 				return std::nullopt;
 
-			Range const xrange { ia->first, ib->first };
+			auto const a = static_cast<std::size_t> (ia - keys.data());
+			auto const b = static_cast<std::size_t> (ib - keys.data());
+			Range const xrange { *ia, *ib };
 
 			if constexpr (sizeof...(Xs) == 0)
 			{
-				Range const yrange { compute_minmax_argument (ia->second, get_iter), compute_minmax_argument (ib->second, get_iter) };
+				auto const child_argument = [&] (std::size_t const index) {
+					auto const [child_begin, child_end] = submap_range<Level + 1> (index);
+					return std::get<Level + 1> (_keys)[Maximum ? child_end - 1 : child_begin];
+				};
+
+				Range const yrange { child_argument (a), child_argument (b) };
 				return renormalize (x, xrange, yrange);
 			}
 			else
 			{
-				auto min_y = compute_minmax_argument (ia->second, get_iter);
+				auto min_y = compute_minmax_argument<Maximum, Level + 1> (a, std::forward<Xs> (xs)...);
 
 				if (!min_y)
 					return std::nullopt;
 
-				auto max_y = compute_minmax_argument (ib->second, get_iter);
+				auto max_y = compute_minmax_argument<Maximum, Level + 1> (b, std::forward<Xs> (xs)...);
 
 				if (!max_y)
 					return std::nullopt;
@@ -669,77 +1458,36 @@ template<class A, class ...R>
 
 
 template<class A, class ...R>
-	template<class Map, class IsBetter>
-		inline auto
-		Field<A, R...>::compute_minmax_value (Map const& map, IsBetter&& is_better) const
-			-> MinMaxSubspacePoint<Map>
-		{
-			// If map values are also maps, recurse:
-			if constexpr (is_specialization_v<typename Map::mapped_type, std::map>)
-			{
-				auto best = compute_minmax_value (map.begin()->second, is_better);
-				auto best_argument = map.begin()->first;
-
-				for (auto it = std::next (map.begin()); it != map.end(); ++it)
-				{
-					auto const better = compute_minmax_value (it->second, is_better);
-
-					if (is_better (better.value, best.value))
-					{
-						best = better;
-						best_argument = it->first;
-					}
-				}
-
-				return SubspacePoint (std::tuple_cat (std::make_tuple (best_argument), best.arguments), best.value);
-			}
-			// If map values are scalars:
-			else
-			{
-				auto best = SubspacePoint (std::make_tuple (map.begin()->first), map.begin()->second);
-
-				for (auto const& i: map)
-					if (is_better (i.second, best.value))
-						best = SubspacePoint (std::make_tuple (i.first), i.second);
-
-				return best;
-			}
-		}
-
-
-template<class A, class ...R>
-	template<class Map, class IsBetter, class X, class ...Xs>
+	template<bool Maximum, std::size_t Level, class X, class ...Xs>
 		inline auto
-		Field<A, R...>::compute_minmax_value (Map const& map, IsBetter&& is_better, X&& x_unconverted, Xs&& ...xs) const
-			-> MinMaxSubspacePoint<Map, X, Xs...>
+		Field<A, R...>::compute_minmax_value (std::size_t const submap, X&& x_unconverted, Xs&& ...xs) const
+			-> std::optional<LevelPoint<Level>>
 		{
-			using MapKey = typename Map::key_type;
-			using MapValue = typename Map::mapped_type;
+			using Key = NthArgument<Level>;
+			using Subkey = NthArgument<Level + 1>;
 
-			auto const x = static_cast<MapKey> (x_unconverted);
+			// "x" is a key on the Level.
 
-			// "x" is a key in the "map" argument.
-
-			auto const get_first = [](auto pair) { return pair.first; };
-			auto const [inside_domain, ia, ib] = adjacent_find_for_extrapolation (map.begin(), map.end(), x, get_first);
-			MapKey const& key_a = ia->first;
-			MapKey const& key_b = ib->first;
-			MapValue const& value_a = ia->second;
-			MapValue const& value_b = ib->second;
+			auto const x = static_cast<Key> (x_unconverted);
+			auto const& keys = std::get<Level> (_keys);
+			auto const [begin, end] = submap_range<Level> (submap);
+			auto const [inside_domain, ia, ib] = sorted_adjacent_find_for_extrapolation (keys.data() + begin, keys.data() + end, x, [](Key const& key) { return key; });
 
 			if (!inside_domain)
 				return std::nullopt;
 
-			Range const xrange { key_a, key_b };
+			auto const a = static_cast<std::size_t> (ia - keys.data());
+			auto const b = static_cast<std::size_t> (ib - keys.data());
+			Range const xrange { *ia, *ib };
 
 			if constexpr (sizeof...(xs) > 0)
 			{
-				auto p_min = compute_minmax_value (ia->second, is_better, std::forward<Xs> (xs)...);
+				auto p_min = compute_minmax_value<Maximum, Level + 1> (a, std::forward<Xs> (xs)...);
 
 				if (!p_min)
 					return std::nullopt;
 
-				auto p_max = compute_minmax_value (ib->second, is_better, std::forward<Xs> (xs)...);
+				auto p_max = compute_minmax_value<Maximum, Level + 1> (b, std::forward<Xs> (xs)...);
 
 				if (!p_max)
 					return std::nullopt;
@@ -747,103 +1495,172 @@ template<class A, class ...R>
 				auto const yrange = Range { p_min->value, p_max->value };
 				auto const interpolated_value = renormalize (x, xrange, yrange);
 				auto const interpolated_arguments = renormalize_tuple (x, xrange, p_min->arguments, p_max->arguments);
-				return SubspacePoint (std::tuple_cat (std::make_tuple (x), interpolated_arguments), interpolated_value);
+				return LevelPoint<Level> (std::tuple_cat (std::make_tuple (x), interpolated_arguments), interpolated_value);
 			}
 			else
 			{
-				if constexpr (is_specialization_v<typename Map::mapped_type, std::map>)
-				{
-					// value_a, value_b are of type std::map.
+				// For each key present in both bracketing submaps interpolate between extremes of subspaces below that
+				// key (known from _value_extremes) and pick the best one:
 
-					using Submap = typename Map::mapped_type;
-					using SubmapKey = typename Submap::key_type;
-					using SubmapValue = typename Submap::mapped_type;
-					using BestValue = MinMaxSubspacePoint<Submap>;
+				auto const& subkeys = std::get<Level + 1> (_keys);
+				auto const [a_begin, a_end] = submap_range<Level + 1> (a);
+				auto const [b_begin, b_end] = submap_range<Level + 1> (b);
+				std::optional<LevelPoint<Level + 1>> best;
 
-					std::optional<BestValue> best;
+				auto const find = [&] (std::size_t const begin, std::size_t const end, Subkey const& subkey) -> std::optional<std::size_t> {
+					auto const* const found = std::lower_bound (subkeys.data() + begin, subkeys.data() + end, subkey);
 
-					auto const best_value = [&] (Submap const& map, SubmapKey const& key) -> std::optional<BestValue> {
-						if (auto found = map.find (key); found != map.end())
-						{
-							SubmapValue const& value = found->second;
-
-							if constexpr (is_specialization_v<std::remove_cvref_t<decltype (value)>, std::map>)
-							{
-								auto const p = compute_minmax_value (value, is_better);
-								return SubspacePoint { std::tuple_cat (std::make_tuple (key), p.arguments), p.value };
-							}
-							else
-								return SubspacePoint { std::make_tuple (key), value };
-						}
-						else
-							return std::nullopt;
-					};
+					if (found != subkeys.data() + end && !(subkey < *found))
+						return static_cast<std::size_t> (found - subkeys.data());
+					else
+						return std::nullopt;
+				};
 
-					auto const find_best_for_key = [&] (typename Submap::key_type const& subkey) -> void {
-						auto const ia2 = best_value (value_a, subkey);
+				auto const find_best_for_keys = [&] (std::size_t const index_a, std::size_t const index_b) -> void {
+					auto const point_a = extreme_point<Maximum, Level + 1> (index_a);
+					auto const point_b = extreme_point<Maximum, Level + 1> (index_b);
+					auto const yrange2 = Range { point_a.value, point_b.value };
+					auto const better_value = renormalize (x, xrange, yrange2);
 
-						if (!ia2)
-							return;
+					if (!best || is_better<Maximum> (better_value, best->value))
+						best = LevelPoint<Level + 1> (renormalize_tuple (x, xrange, point_a.arguments, point_b.arguments), better_value);
+				};
 
-						auto const ib2 = best_value (value_b, subkey);
+				for (std::size_t i = a_begin; i < a_end; ++i)
+					if (auto const j = find (b_begin, b_end, subkeys[i]))
+						find_best_for_keys (i, *j);
 
-						if (!ib2)
-							return;
+				for (std::size_t j = b_begin; j < b_end; ++j)
+					if (auto const i = find (a_begin, a_end, subkeys[j]))
+						find_best_for_keys (*i, j);
 
-						auto const yrange2 = Range { ia2->value, ib2->value };
-						auto const better_value = renormalize (x, xrange, yrange2);
-						auto const better_arguments = renormalize_tuple (x, xrange, ia2->arguments, ib2->arguments);
+				if (best)
+					return LevelPoint<Level> (std::tuple_cat (std::make_tuple (x), best->arguments), best->value);
+				else
+					return std::nullopt;
+			}
+		}
 
-						if (!best || is_better (better_value, best->value))
-							best = SubspacePoint { better_arguments, better_value };
-					};
 
-					for (auto const& pair: value_a)
-						find_best_for_key (pair.first);
+template<class A, class ...R>
+	inline void
+	Field<A, R...>::build_flat_tables()
+	{
+		flatten<0> (_data_map);
 
-					for (auto const& pair: value_b)
-						find_best_for_key (pair.first);
+		// Close the last range of child keys for each level:
+		[&]<std::size_t ...Level> (std::index_sequence<Level...>) {
+			(_offsets[Level].push_back (std::get<Level + 1> (_keys).size()), ...);
+		} (std::make_index_sequence<kNumArguments - 1>());
 
-					if (best)
-						return SubspacePoint { std::tuple_cat (std::make_tuple (x), best->arguments), best->value };
-					else
-						return std::nullopt;
+		compute_value_extremes();
+	}
+
+
+template<class A, class ...R>
+	template<std::size_t Level, class Map>
+		inline void
+		Field<A, R...>::flatten (Map const& map)
+		{
+			auto& keys = std::get<Level> (_keys);
+			auto const begin = keys.size();
+			keys.reserve (keys.size() + map.size());
+
+			for (auto const& [key, mapped]: map)
+			{
+				keys.push_back (key);
+
+				if constexpr (Level < kNumArguments - 1)
+				{
+					// Children of this key are appended contiguously to the next level by the recursive call:
+					_offsets[Level].push_back (std::get<Level + 1> (_keys).size());
+					flatten<Level + 1> (mapped);
 				}
 				else
-					return renormalize (x, xrange, Range { value_a, value_b });
+					_values.push_back (mapped);
+			}
+
+			std::get<Level> (_uniform_axes).push_back (detail::detect_uniform_axis (std::span<NthArgument<Level> const> (keys).subspan (begin)));
+		}
+
+
+template<class A, class ...R>
+	template<std::size_t Level>
+		inline auto
+		Field<A, R...>::submap_range (std::size_t const submap) const
+			-> std::pair<std::size_t, std::size_t>
+		{
+			if constexpr (Level == 0)
+				return { 0, std::get<0> (_keys).size() };
+			else
+				return { _offsets[Level - 1][submap], _offsets[Level - 1][submap + 1] };
+		}
+
+
+template<class A, class ...R>
+	template<std::size_t Level, class X>
+		inline auto
+		Field<A, R...>::find_bracket (std::size_t const submap, X const& x) const
+			-> std::tuple<bool, NthArgument<Level> const*, NthArgument<Level> const*>
+		{
+			using Key = NthArgument<Level>;
+
+			auto const [begin, end] = submap_range<Level> (submap);
+			auto const* keys = std::get<Level> (_keys).data() + begin;
+			auto const size = end - begin;
+
+			if constexpr (detail::FieldUniformAxisKey<Key>)
+			{
+				if (auto const& axis = std::get<Level> (_uniform_axes)[submap])
+				{
+					if (keys[0] <= x && x <= keys[size - 1])
+					{
+						auto const last_cell = static_cast<double> (size - 2);
+						auto const position = std::clamp<double> ((static_cast<Key> (x) - axis->first) * axis->inverse_spacing, 0.0, last_cell);
+						auto i = static_cast<std::size_t> (position);
+
+						// Correct rounding errors so that the result is exactly the same as from binary search, that is
+						// keys[i] < x <= keys[i + 1] or i == 0:
+						while (i > 0 && !(keys[i] < x))
+							--i;
+
+						while (keys[i + 1] < x)
+							++i;
+
+						return { true, keys + i, keys + i + 1 };
+					}
+				}
 			}
+
+			return sorted_adjacent_find_for_extrapolation (keys, keys + size, x, [](Key const& key) { return key; });
 		}
 
 
 template<class A, class ...R>
-	template<class Map, class X, class ...Xs>
+	template<std::size_t Level, class X, class ...Xs>
 		inline auto
-		Field<A, R...>::compute_value (Map&& map, bool extrapolate, X&& x, Xs&& ...xs) const
+		Field<A, R...>::compute_value (std::size_t const submap, bool extrapolate, BracketCache* cache, std::size_t const node, X&& x, Xs&& ...xs) const
 			-> std::optional<Value>
 		{
-			// "x" is a key in the "map" argument.
+			// "x" is a key on the Level.
 
-			auto const get_first = [](auto pair) { return pair.first; };
-			auto const [inside_domain, ia, ib] = adjacent_find_for_extrapolation (map.begin(), map.end(), x, get_first);
-			auto const& key_a = ia->first;
-			auto const& key_b = ib->first;
-			auto const& submap_a = ia->second;
-			auto const& submap_b = ib->second;
-			Range const xrange { key_a, key_b };
+			auto const& keys = std::get<Level> (_keys);
+			auto const [inside_domain, a, b] = find_cached_bracket<Level> (submap, x, cache ? &(*cache)[Level][node] : nullptr);
+			Range const xrange { keys[a], keys[b] };
 
 			if constexpr (sizeof...(xs) > 0)
 			{
-				// Get value recursively from the inner map:
-				auto const min_y = compute_value (ia->second, extrapolate, std::forward<Xs> (xs)...);
+				// Get value recursively from the next level:
+				auto const min_y = compute_value<Level + 1> (a, extrapolate, cache, 2 * node, std::forward<Xs> (xs)...);
 
-				if (ia == ib)
+				if (a == b)
 					return min_y;
 				else
 				{
 					if (!min_y)
 						return std::nullopt;
 
-					auto const max_y = compute_value (ib->second, extrapolate, std::forward<Xs> (xs)...);
+					auto const max_y = compute_value<Level + 1> (b, extrapolate, cache, 2 * node + 1, std::forward<Xs> (xs)...);
 
 					if (!max_y)
 						return std::nullopt;
@@ -858,13 +1675,17 @@ template<class A, class ...R>
 			}
 			else
 			{
-				if (ia == ib)
+				if (a == b)
 				{
-					return ia->second;
+					return _values[a];
 				}
 				else if (inside_domain || extrapolate)
 				{
-					Range const yrange { submap_a, submap_b };
+					if constexpr (kCubicInterpolationSupported)
+						if (!_coefficients.empty())
+							return cubic_value (a, cell_position (x, keys[a], keys[b]));
+
+					Range const yrange { _values[a], _values[b] };
 
 					if constexpr (kLinearExtrapolate)
 						return renormalize (x, xrange, yrange);
@@ -876,6 +1697,222 @@ template<class A, class ...R>
 			}
 		}
 
+
+template<class A, class ...R>
+	template<class X, class Key>
+		inline double
+		Field<A, R...>::cell_position (X const& x, Key const& x0, Key const& x1)
+		{
+			// Same as in renormalize() used by linear interpolation:
+			auto const position = static_cast<double> ((x - x0) / (x1 - x0));
+
+			if constexpr (kLinearExtrapolate)
+				return position;
+			else
+				return std::clamp (position, 0.0, 1.0);
+		}
+
+
+template<class A, class ...R>
+	inline auto
+	Field<A, R...>::cubic_value (std::size_t const cell, double const position) const
+		-> Value
+	{
+		auto const& c = _coefficients[cell];
+		return ((c[3] * position + c[2]) * position + c[1]) * position + c[0];
+	}
+
+
+template<class A, class ...R>
+	template<std::size_t Level, class X>
+		inline auto
+		Field<A, R...>::find_cached_bracket (std::size_t const submap, X const& x, CachedBracket* const cached) const
+			-> std::tuple<bool, std::size_t, std::size_t>
+		{
+			auto const& keys = std::get<Level> (_keys);
+
+			auto const [begin, end] = submap_range<Level> (submap);
+
+			// Searches return (true, a, a + 1) for keys[a] < x <= keys[a + 1], so the cached cell or its neighbour
+			// can be used instead if x falls into it:
+			if (cached && cached->position < end - begin - 1)
+			{
+				auto const a = begin + cached->position;
+
+				if (keys[a] < x)
+				{
+					if (x <= keys[a + 1])
+						return { true, a, a + 1 };
+					else if (a + 2 < end && x <= keys[a + 2])
+					{
+						++cached->position;
+						return { true, a + 1, a + 2 };
+					}
+				}
+				else if (a > begin && keys[a - 1] < x)
+				{
+					--cached->position;
+					return { true, a - 1, a };
+				}
+			}
+
+			auto const [inside_domain, ia, ib] = find_bracket<Level> (submap, x);
+			auto const a = static_cast<std::size_t> (ia - keys.data());
+			auto const b = static_cast<std::size_t> (ib - keys.data());
+
+			if (cached)
+				cached->position = a == b ? std::numeric_limits<std::size_t>::max() : a - begin;
+
+			return { inside_domain, a, b };
+		}
+
+
+template<class A, class ...R>
+	template<std::size_t Level>
+		inline bool
+		Field<A, R...>::compute_stencil (std::size_t const submap, std::size_t const node, Arguments const& point, bool const extrapolate,
+										 BracketCache& cache, EvaluationBlock& block, std::size_t const q) const
+		{
+			auto const& keys = std::get<Level> (_keys);
+			auto const& x = std::get<Level> (point);
+			auto const [inside_domain, a, b] = find_cached_bracket<Level> (submap, x, &cache[Level][node]);
+			auto& weight = block.weights[(std::size_t (1) << Level) - 1 + node][q];
+
+			// Same as in compute_value(), but computes interpolation weight instead of the value:
+			if (a == b)
+				weight = 0.0;
+			else
+			{
+				if constexpr (Level == kNumArguments - 1)
+					if (!inside_domain && !extrapolate)
+						return false;
+
+				weight = cell_position (x, keys[a], keys[b]);
+			}
+
+			if constexpr (Level == kNumArguments - 1)
+			{
+				block.corners[2 * node][q] = a;
+				block.corners[2 * node + 1][q] = b;
+				return true;
+			}
+			else
+			{
+				return compute_stencil<Level + 1> (a, 2 * node, point, extrapolate, cache, block, q)
+					&& compute_stencil<Level + 1> (b, 2 * node + 1, point, extrapolate, cache, block, q);
+			}
+		}
+
+
+template<class A, class ...R>
+	template<class Result>
+		inline void
+		Field<A, R...>::evaluate_points (std::span<Arguments const> const points, std::span<Result> const results, bool const extrapolate) const
+		{
+			if (points.size() != results.size())
+				throw std::length_error ("Field::evaluate(): points and results have different sizes");
+
+			BracketCache cache;
+			// Can be large for fields with many dimensions, so keep it off the stack:
+			auto const block = std::make_unique<EvaluationBlock>();
+
+			for (std::size_t begin = 0; begin < points.size(); begin += kEvaluationBlockSize)
+			{
+				auto const n = std::min (kEvaluationBlockSize, points.size() - begin);
+
+				for (std::size_t q = 0; q < n; ++q)
+					block->defined[q] = compute_stencil<0> (0, 0, points[begin + q], extrapolate, cache, *block, q);
+
+				auto levels = kNumArguments;
+
+				if constexpr (kCubicInterpolationSupported)
+				{
+					if (!_coefficients.empty())
+					{
+						// Nodes of the last level are evaluated directly from polynomials of their left corners:
+						--levels;
+
+						for (std::size_t node = 0; node < kCorners / 2; ++node)
+						{
+							auto const& weights = block->weights[kCorners / 2 - 1 + node];
+							auto const& corners = block->corners[2 * node];
+							auto& result = block->values[node];
+
+							for (std::size_t q = 0; q < n; ++q)
+								result[q] = block->defined[q] ? cubic_value (corners[q], weights[q]) : Value();
+						}
+					}
+				}
+
+				if (levels == kNumArguments)
+				{
+					for (std::size_t c = 0; c < kCorners; ++c)
+						for (std::size_t q = 0; q < n; ++q)
+							block->values[c][q] = block->defined[q] ? _values[block->corners[c][q]] : Value();
+				}
+
+				// Reduce the interpolation trees level by level. Same formula as in renormalize(), so that the results
+				// are the same as from value():
+				for (std::size_t level = levels; level-- > 0; )
+				{
+					for (std::size_t node = 0; node < (std::size_t (1) << level); ++node)
+					{
+						auto const& weights = block->weights[(std::size_t (1) << level) - 1 + node];
+						auto& result = block->values[node];
+						auto const& y0 = block->values[2 * node];
+						auto const& y1 = block->values[2 * node + 1];
+
+						for (std::size_t q = 0; q < n; ++q)
+							result[q] = weights[q] * (y1[q] - y0[q]) + y0[q];
+					}
+				}
+
+				for (std::size_t q = 0; q < n; ++q)
+				{
+					if constexpr (std::is_same_v<Result, std::optional<Value>>)
+					{
+						if (block->defined[q])
+							results[begin + q] = block->values[0][q];
+						else
+							results[begin + q] = std::nullopt;
+					}
+					else
+						results[begin + q] = block->values[0][q];
+				}
+			}
+		}
+
+
+template<class A, class ...R>
+	template<class Result>
+		inline void
+		Field<A, R...>::evaluate_points (std::span<Arguments const> const points, std::span<Result> const results, bool const extrapolate,
+										 WorkPerformer& work_performer) const
+		{
+			if (points.size() != results.size())
+				throw std::length_error ("Field::evaluate(): points and results have different sizes");
+
+			auto const tasks = std::max<std::size_t> (1, std::min (points.size() / kMinPointsPerTask, work_performer.threads_number()));
+
+			if (tasks == 1)
+				return evaluate_points (points, results, extrapolate);
+
+			auto const points_per_task = (points.size() + tasks - 1) / tasks;
+			std::vector<std::future<void>> futures;
+			futures.reserve (tasks);
+
+			for (std::size_t begin = 0; begin < points.size(); begin += points_per_task)
+			{
+				auto const n = std::min (points_per_task, points.size() - begin);
+				futures.push_back (work_performer.submit ([=, this] {
+					evaluate_points (points.subspan (begin, n), results.subspan (begin, n), extrapolate);
+				}));
+			}
+
+			for (auto& future: futures)
+				future.get();
+		}
+
 } // namespace neutrino::math
 
 #endif
@@ -0,0 +1,657 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__FIELD_FILE_H__INCLUDED
+#define NEUTRINO__MATH__FIELD_FILE_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/blob.h>
+#include <neutrino/math/field.h>
+#include <neutrino/numeric.h>
+#include <neutrino/range.h>
+#include <neutrino/sequence_utils.h>
+#include <neutrino/si/concepts.h>
+#include <neutrino/stdexcept.h>
+
+// Boost:
+#include <boost/endian/conversion.hpp>
+
+// Standard:
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/*
+ * Binary file format for Field tables. Files can be memory-mapped (see MappedFile) and used for lookups in place
+ * with FieldView, without building any maps.
+ *
+ * All numbers are little-endian. File begins with a header:
+ *
+ *   offset	size	contents
+ *   0		8		magic "NEUFIELD"
+ *   8		4		format version (uint32), currently kFieldFileVersion
+ *   12		4		number of arguments N (uint32)
+ *   16		8		total file size (uint64)
+ *   24		72 × (N + 1)
+ *					type descriptors of arguments and the value, each:
+ *					  uint32 size of floating-point number (4 or 8), uint32 1 if type is an SI quantity, 0 otherwise,
+ *					  8 × int32 exponents of the SI unit, 4 × int64 scale numerator and denominator, offset numerator
+ *					  and denominator of the unit
+ *   …		16 × 2N	array descriptors (uint64 byte offset from the beginning of file, uint64 number of elements)
+ *					for: keys on each level (N arrays), offsets on each level except the last (N - 1 arrays), values
+ *
+ * Arrays follow, each aligned to kFieldFileAlignment bytes. Their contents are the same as flat tables of Field:
+ * keys of all submaps on each level, sorted within each submap; children of key i on level L are keys
+ * [offsets[L][i], offsets[L][i + 1]) on level L + 1 (offsets are uint64, each array has one more element than keys
+ * on its level); values correspond to keys on the last level. Keys and values are stored as numbers of units given
+ * in the type descriptors.
+ */
+
+
+namespace neutrino::math {
+
+constexpr uint32_t kFieldFileVersion	= 1;
+constexpr std::size_t kFieldFileAlignment	= 64;
+
+
+/**
+ * Types that can be stored in field files: single or double precision floating-point numbers and SI quantities
+ * based on them.
+ */
+template<class T>
+	concept FieldFileScalar =
+		(std::floating_point<T> && (sizeof (T) == 4 || sizeof (T) == 8)) ||
+		(si::QuantityConcept<T> && std::floating_point<typename T::Value> && sizeof (T) == sizeof (typename T::Value) &&
+		 (sizeof (T) == 4 || sizeof (T) == 8) && std::is_trivially_copyable_v<T>);
+
+
+namespace detail {
+
+constexpr std::array<uint8_t, 8>	kFieldFileMagic				{ 'N', 'E', 'U', 'F', 'I', 'E', 'L', 'D' };
+constexpr std::size_t				kFieldFileTypeSize			= 72;
+constexpr std::size_t				kFieldFileArraySize			= 16;
+constexpr std::size_t				kFieldFileTypesOffset		= 24;
+
+
+/**
+ * Type descriptor stored in field files.
+ */
+struct FieldFileType
+{
+	uint32_t				scalar_size			{ 0 };
+	uint32_t				is_quantity			{ 0 };
+	std::array<int32_t, 8>	exponents			{ };
+	int64_t					scale_numerator		{ 1 };
+	int64_t					scale_denominator	{ 1 };
+	int64_t					offset_numerator	{ 0 };
+	int64_t					offset_denominator	{ 1 };
+
+	[[nodiscard]]
+	bool
+	operator== (FieldFileType const&) const = default;
+};
+
+
+/**
+ * Position of an array in field file.
+ */
+struct FieldFileArray
+{
+	uint64_t	offset	{ 0 };
+	uint64_t	size	{ 0 };
+};
+
+
+template<FieldFileScalar T>
+	inline FieldFileType
+	field_file_type()
+	{
+		FieldFileType type;
+
+		if constexpr (si::QuantityConcept<T>)
+		{
+			auto const unit = T::Unit::dynamic_unit();
+			type.scalar_size = sizeof (typename T::Value);
+			type.is_quantity = 1;
+
+			for (std::size_t i = 0; i < type.exponents.size(); ++i)
+				type.exponents[i] = unit.exponents()[i];
+
+			type.scale_numerator = unit.scale().numerator();
+			type.scale_denominator = unit.scale().denominator();
+			type.offset_numerator = unit.offset().numerator();
+			type.offset_denominator = unit.offset().denominator();
+		}
+		else
+			type.scalar_size = sizeof (T);
+
+		return type;
+	}
+
+
+/**
+ * Return floating-point representation of given number or quantity, as stored in the field file.
+ */
+template<FieldFileScalar T>
+	inline auto
+	field_file_scalar (T const value)
+	{
+		if constexpr (si::QuantityConcept<T>)
+			return value.to_floating_point();
+		else
+			return value;
+	}
+
+
+/**
+ * Append an integer or floating-point number to the blob as little-endian.
+ */
+template<class T>
+	inline void
+	append_little_endian (Blob& blob, T const value)
+	{
+		if constexpr (std::floating_point<T>)
+		{
+			using Integer = std::conditional_t<sizeof (T) == 4, uint32_t, uint64_t>;
+			append_little_endian (blob, std::bit_cast<Integer> (value));
+		}
+		else
+		{
+			auto const little = boost::endian::native_to_little (value);
+			auto const bytes = std::bit_cast<std::array<uint8_t, sizeof (T)>> (little);
+			blob.append (bytes.data(), bytes.size());
+		}
+	}
+
+
+/**
+ * Read little-endian integer from given position of the blob.
+ */
+template<std::integral T>
+	inline T
+	read_little_endian (BlobView const blob, std::size_t const position)
+	{
+		std::array<uint8_t, sizeof (T)> bytes;
+		std::memcpy (bytes.data(), blob.data() + position, bytes.size());
+		return boost::endian::little_to_native (std::bit_cast<T> (bytes));
+	}
+
+
+inline void
+append_padding (Blob& blob)
+{
+	blob.resize ((blob.size() + kFieldFileAlignment - 1) / kFieldFileAlignment * kFieldFileAlignment, 0);
+}
+
+
+template<class Tuple>
+	struct FieldFileKeyArraysH;
+
+
+template<class ...Keys>
+	struct FieldFileKeyArraysH<std::tuple<Keys...>>
+	{
+		using type = std::tuple<std::vector<std::remove_cvref_t<Keys>>...>;
+	};
+
+
+template<class Tuple>
+	struct FieldFileKeySpansH;
+
+
+template<class ...Keys>
+	struct FieldFileKeySpansH<std::tuple<Keys...>>
+	{
+		using type = std::tuple<std::span<std::remove_cvref_t<Keys> const>...>;
+	};
+
+} // namespace detail
+
+
+/**
+ * Read-only view of a field file, usable for lookups in place (eg. in memory-mapped file). Lookups give the same
+ * results as Field::value() and Field::extrapolated_value() of the field from which the file was created.
+ * Field files are created with to_field_file().
+ *
+ * Arguments and value types must be the same as ones stored in the file, including SI units.
+ * FieldView doesn't own the data, so the data must outlive the view.
+ */
+template<FieldFileScalar Argument0, FieldFileScalar ...RemainingArgumentsAndValue>
+	class FieldView
+	{
+	  public:
+		using FieldType			= Field<Argument0, RemainingArgumentsAndValue...>;
+		using Arguments			= typename FieldType::Arguments;
+		using Value				= typename FieldType::Value;
+		using DataMap			= typename FieldType::DataMap;
+		using KeySpans			= typename detail::FieldFileKeySpansH<Arguments>::type;
+
+		static constexpr std::size_t kNumArguments = FieldType::kNumArguments;
+
+		template<std::size_t N>
+			using NthArgument = typename FieldType::template NthArgument<N>;
+
+	  public:
+		/**
+		 * Create view of field file contents.
+		 * Throws InvalidFormat if the data is not a valid field file with matching types.
+		 * Data must be aligned at least to alignof (double).
+		 */
+		explicit
+		FieldView (BlobView);
+
+		/**
+		 * Return number of dimensions of the field.
+		 */
+		[[nodiscard]]
+		static constexpr std::size_t
+		dimensions() noexcept
+			{ return kNumArguments; }
+
+		/**
+		 * Same as Field::value().
+		 */
+		template<class ...Args>
+			[[nodiscard]]
+			std::optional<Value>
+			value (Args&&...) const;
+
+		/**
+		 * Same as Field::extrapolated_value().
+		 */
+		template<class ...Args>
+			[[nodiscard]]
+			Value
+			extrapolated_value (Args&&...) const;
+
+		/**
+		 * Alias for extrapolated_value().
+		 */
+		template<class ...Args>
+			[[nodiscard]]
+			Value
+			operator() (Args&&... args) const
+				{ return extrapolated_value (std::forward<Args> (args)...); }
+
+		/**
+		 * Convert back to the DataMap representation, eg. to create a Field.
+		 */
+		[[nodiscard]]
+		DataMap
+		to_data_map() const;
+
+	  private:
+		/**
+		 * Return span of array described at given position of the header.
+		 * Verify that it fits in the data and is properly aligned.
+		 */
+		template<class T>
+			[[nodiscard]]
+			std::span<T const>
+			array_at (std::size_t header_position) const;
+
+		/**
+		 * Verify that offsets on given level are non-decreasing, describe non-empty submaps and cover all keys
+		 * of the next level, so that lookups don't go out of bounds.
+		 */
+		template<std::size_t Level>
+			void
+			validate_offsets() const;
+
+		/**
+		 * Return interpolated value for keys [begin, end) on given Level.
+		 */
+		template<std::size_t Level, class X, class ...Xs>
+			[[nodiscard]]
+			std::optional<Value>
+			compute_value (std::size_t begin, std::size_t end, bool extrapolate, X&&, Xs&&...) const;
+
+		/**
+		 * Helper for to_data_map().
+		 */
+		template<std::size_t Level, class Map>
+			void
+			fill_map (Map&, std::size_t begin, std::size_t end) const;
+
+	  private:
+		BlobView		_data;
+		KeySpans		_keys;
+		std::array<std::span<uint64_t const>, kNumArguments - 1>
+						_offsets;
+		std::span<Value const>
+						_values;
+	};
+
+
+namespace detail {
+
+/**
+ * Helper for to_field_file(). Append keys and values of the map to flat arrays of given Level.
+ */
+template<std::size_t Level, class Map, class KeyArrays, class Value>
+	inline void
+	flatten_for_field_file (Map const& map, KeyArrays& keys, std::vector<std::vector<uint64_t>>& offsets, std::vector<Value>& values)
+	{
+		constexpr bool kLastLevel = Level + 1 == std::tuple_size_v<KeyArrays>;
+
+		for (auto const& [key, mapped]: map)
+		{
+			std::get<Level> (keys).push_back (key);
+
+			if constexpr (kLastLevel)
+				values.push_back (mapped);
+			else
+			{
+				offsets[Level].push_back (std::get<Level + 1> (keys).size());
+				flatten_for_field_file<Level + 1> (mapped, keys, offsets, values);
+			}
+		}
+	}
+
+} // namespace detail
+
+
+/**
+ * Serialize the field into the field file format.
+ */
+template<FieldFileScalar Argument0, FieldFileScalar ...RemainingArgumentsAndValue>
+	inline Blob
+	to_field_file (Field<Argument0, RemainingArgumentsAndValue...> const& field)
+	{
+		using FieldType = Field<Argument0, RemainingArgumentsAndValue...>;
+		using Value = typename FieldType::Value;
+
+		constexpr auto kNumArguments = FieldType::kNumArguments;
+
+		typename detail::FieldFileKeyArraysH<typename FieldType::Arguments>::type keys;
+		std::vector<std::vector<uint64_t>> offsets (kNumArguments - 1);
+		std::vector<Value> values;
+		detail::flatten_for_field_file<0> (field.data_map(), keys, offsets, values);
+
+		[&]<std::size_t ...L> (std::index_sequence<L...>) {
+			// Closing offsets:
+			((offsets[L].push_back (std::get<L + 1> (keys).size())), ...);
+		} (std::make_index_sequence<kNumArguments - 1>());
+
+		Blob blob;
+		blob.append (detail::kFieldFileMagic.data(), detail::kFieldFileMagic.size());
+		detail::append_little_endian (blob, kFieldFileVersion);
+		detail::append_little_endian (blob, static_cast<uint32_t> (kNumArguments));
+		// File size, filled in at the end:
+		detail::append_little_endian (blob, uint64_t (0));
+
+		for (auto const& type: { detail::field_file_type<Argument0>(), detail::field_file_type<RemainingArgumentsAndValue>()... })
+		{
+			detail::append_little_endian (blob, type.scalar_size);
+			detail::append_little_endian (blob, type.is_quantity);
+
+			for (auto const exponent: type.exponents)
+				detail::append_little_endian (blob, exponent);
+
+			detail::append_little_endian (blob, type.scale_numerator);
+			detail::append_little_endian (blob, type.scale_denominator);
+			detail::append_little_endian (blob, type.offset_numerator);
+			detail::append_little_endian (blob, type.offset_denominator);
+		}
+
+		// Array descriptors, filled in when arrays are appended:
+		auto const arrays_position = blob.size();
+		blob.resize (blob.size() + detail::kFieldFileArraySize * 2 * kNumArguments, 0);
+		std::size_t array_index = 0;
+
+		auto const append_array = [&] (auto const& array) {
+			detail::append_padding (blob);
+			Blob descriptor;
+			detail::append_little_endian (descriptor, static_cast<uint64_t> (blob.size()));
+			detail::append_little_endian (descriptor, static_cast<uint64_t> (array.size()));
+			blob.replace (arrays_position + detail::kFieldFileArraySize * array_index++, descriptor.size(), descriptor);
+
+			for (auto const& element: array)
+			{
+				if constexpr (std::integral<std::remove_cvref_t<decltype (element)>>)
+					detail::append_little_endian (blob, element);
+				else
+					detail::append_little_endian (blob, detail::field_file_scalar (element));
+			}
+		};
+
+		std::apply ([&] (auto const& ...key_arrays) { (append_array (key_arrays), ...); }, keys);
+
+		for (auto const& level_offsets: offsets)
+			append_array (level_offsets);
+
+		append_array (values);
+
+		Blob file_size;
+		detail::append_little_endian (file_size, static_cast<uint64_t> (blob.size()));
+		blob.replace (16, file_size.size(), file_size);
+		return blob;
+	}
+
+
+template<FieldFileScalar A, FieldFileScalar ...R>
+	inline
+	FieldView<A, R...>::FieldView (BlobView const data):
+		_data (data)
+	{
+		if constexpr (std::endian::native != std::endian::little)
+			throw InvalidFormat ("field files can be used in place only on little-endian hosts");
+
+		auto const header_size = detail::kFieldFileTypesOffset + detail::kFieldFileTypeSize * (kNumArguments + 1)
+							   + detail::kFieldFileArraySize * 2 * kNumArguments;
+
+		if (data.size() < header_size || !std::equal (detail::kFieldFileMagic.begin(), detail::kFieldFileMagic.end(), data.begin()))
+			throw InvalidFormat ("not a field file");
+
+		if (auto const version = detail::read_little_endian<uint32_t> (data, 8); version != kFieldFileVersion)
+			throw InvalidFormat (std::format ("unsupported field file version {}", version));
+
+		if (detail::read_little_endian<uint32_t> (data, 12) != kNumArguments)
+			throw InvalidFormat ("field file has different number of arguments");
+
+		if (detail::read_little_endian<uint64_t> (data, 16) != data.size())
+			throw InvalidFormat ("field file size is invalid");
+
+		if (reinterpret_cast<std::uintptr_t> (data.data()) % alignof (double) != 0)
+			throw InvalidFormat ("field file data is not aligned");
+
+		std::size_t position = detail::kFieldFileTypesOffset;
+
+		for (auto const& expected: { detail::field_file_type<A>(), detail::field_file_type<R>()... })
+		{
+			detail::FieldFileType type;
+			type.scalar_size = detail::read_little_endian<uint32_t> (data, position);
+			type.is_quantity = detail::read_little_endian<uint32_t> (data, position + 4);
+
+			for (std::size_t i = 0; i < type.exponents.size(); ++i)
+				type.exponents[i] = detail::read_little_endian<int32_t> (data, position + 8 + 4 * i);
+
+			type.scale_numerator = detail::read_little_endian<int64_t> (data, position + 40);
+			type.scale_denominator = detail::read_little_endian<int64_t> (data, position + 48);
+			type.offset_numerator = detail::read_little_endian<int64_t> (data, position + 56);
+			type.offset_denominator = detail::read_little_endian<int64_t> (data, position + 64);
+
+			if (type != expected)
+				throw InvalidFormat ("field file types or units are different from expected");
+
+			position += detail::kFieldFileTypeSize;
+		}
+
+		[&]<std::size_t ...L> (std::index_sequence<L...>) {
+			((std::get<L> (_keys) = array_at<NthArgument<L>> (position + detail::kFieldFileArraySize * L)), ...);
+		} (std::make_index_sequence<kNumArguments>());
+
+		for (std::size_t level = 0; level < kNumArguments - 1; ++level)
+			_offsets[level] = array_at<uint64_t> (position + detail::kFieldFileArraySize * (kNumArguments + level));
+
+		_values = array_at<Value> (position + detail::kFieldFileArraySize * (2 * kNumArguments - 1));
+
+		if (std::get<0> (_keys).empty())
+			throw InvalidFormat ("field file domain is empty");
+
+		if (_values.size() != std::get<kNumArguments - 1> (_keys).size())
+			throw InvalidFormat ("field file has different number of values and keys");
+
+		[&]<std::size_t ...L> (std::index_sequence<L...>) {
+			(validate_offsets<L>(), ...);
+		} (std::make_index_sequence<kNumArguments - 1>());
+	}
+
+
+template<FieldFileScalar A, FieldFileScalar ...R>
+	template<class ...Args>
+		inline auto
+		FieldView<A, R...>::value (Args&& ...args) const
+			-> std::optional<Value>
+		{
+			static_assert (sizeof...(args) == kNumArguments, "not enough arguments");
+
+			return compute_value<0> (0, std::get<0> (_keys).size(), false, std::forward<Args> (args)...);
+		}
+
+
+template<FieldFileScalar A, FieldFileScalar ...R>
+	template<class ...Args>
+		inline auto
+		FieldView<A, R...>::extrapolated_value (Args&& ...args) const
+			-> Value
+		{
+			static_assert (sizeof...(args) == kNumArguments, "not enough arguments");
+
+			return *compute_value<0> (0, std::get<0> (_keys).size(), true, std::forward<Args> (args)...);
+		}
+
+
+template<FieldFileScalar A, FieldFileScalar ...R>
+	inline auto
+	FieldView<A, R...>::to_data_map() const
+		-> DataMap
+	{
+		DataMap map;
+		fill_map<0> (map, 0, std::get<0> (_keys).size());
+		return map;
+	}
+
+
+template<FieldFileScalar A, FieldFileScalar ...R>
+	template<class T>
+		inline auto
+		FieldView<A, R...>::array_at (std::size_t const header_position) const
+			-> std::span<T const>
+		{
+			auto const offset = detail::read_little_endian<uint64_t> (_data, header_position);
+			auto const size = detail::read_little_endian<uint64_t> (_data, header_position + 8);
+
+			if (offset % kFieldFileAlignment != 0 || offset > _data.size() || size > (_data.size() - offset) / sizeof (T))
+				throw InvalidFormat ("field file array is out of bounds or misaligned");
+
+			// Arrays contain little-endian numbers of the same layout as T:
+			return { reinterpret_cast<T const*> (_data.data() + offset), static_cast<std::size_t> (size) };
+		}
+
+
+template<FieldFileScalar A, FieldFileScalar ...R>
+	template<std::size_t Level>
+		inline void
+		FieldView<A, R...>::validate_offsets() const
+		{
+			auto const& offsets = _offsets[Level];
+
+			if (offsets.size() != std::get<Level> (_keys).size() + 1 || offsets.front() != 0 || offsets.back() != std::get<Level + 1> (_keys).size())
+				throw InvalidFormat ("field file offsets don't match keys");
+
+			for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+				if (offsets[i] >= offsets[i + 1])
+					throw InvalidFormat ("field file offsets are invalid or describe empty submaps");
+		}
+
+
+template<FieldFileScalar A, FieldFileScalar ...R>
+	template<std::size_t Level, class X, class ...Xs>
+		inline auto
+		FieldView<A, R...>::compute_value (std::size_t const begin, std::size_t const end, bool extrapolate, X&& x, Xs&& ...xs) const
+			-> std::optional<Value>
+		{
+			// Same algorithm as Field::compute_value() with linear interpolation:
+
+			using Key = NthArgument<Level>;
+
+			auto const& keys = std::get<Level> (_keys);
+			auto const [inside_domain, ia, ib] = sorted_adjacent_find_for_extrapolation (keys.data() + begin, keys.data() + end, x, [](Key const& key) { return key; });
+			auto const a = static_cast<std::size_t> (ia - keys.data());
+			auto const b = static_cast<std::size_t> (ib - keys.data());
+			Range const xrange { *ia, *ib };
+
+			if constexpr (sizeof...(xs) > 0)
+			{
+				auto const& offsets = _offsets[Level];
+				auto const min_y = compute_value<Level + 1> (offsets[a], offsets[a + 1], extrapolate, std::forward<Xs> (xs)...);
+
+				if (a == b)
+					return min_y;
+				else
+				{
+					if (!min_y)
+						return std::nullopt;
+
+					auto const max_y = compute_value<Level + 1> (offsets[b], offsets[b + 1], extrapolate, std::forward<Xs> (xs)...);
+
+					if (!max_y)
+						return std::nullopt;
+
+					return renormalize (clamp (x, Range<std::remove_cvref_t<X>> (xrange)), xrange, Range { *min_y, *max_y });
+				}
+			}
+			else
+			{
+				if (a == b)
+					return _values[a];
+				else if (inside_domain || extrapolate)
+					return renormalize (clamp (x, Range<std::remove_cvref_t<X>> (xrange)), xrange, Range { _values[a], _values[b] });
+				else
+					return std::nullopt;
+			}
+		}
+
+
+template<FieldFileScalar A, FieldFileScalar ...R>
+	template<std::size_t Level, class Map>
+		inline void
+		FieldView<A, R...>::fill_map (Map& map, std::size_t const begin, std::size_t const end) const
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				auto const& key = std::get<Level> (_keys)[i];
+
+				if constexpr (Level + 1 == kNumArguments)
+					map[key] = _values[i];
+				else
+					fill_map<Level + 1> (map[key], _offsets[Level][i], _offsets[Level][i + 1]);
+			}
+		}
+
+} // namespace neutrino::math
+
+#endif
+
@@ -0,0 +1,440 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__HDR_HISTOGRAM_H__INCLUDED
+#define NEUTRINO__MATH__HDR_HISTOGRAM_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/stdexcept.h>
+
+// Standard:
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+
+namespace neutrino::math {
+
+/**
+ * High dynamic range histogram with log-linear buckets (HDR histogram), eg. for latencies spanning
+ * nanoseconds to seconds.
+ *
+ * Values are recorded as integer multiples of the resolution. Each power-of-two range of such integers is split
+ * into linear sub-buckets, so that values are distinguished with given number of significant decimal digits
+ * over the whole range: value returned for a recorded value differs from it by at most 10^-significant_digits
+ * relatively (or by the resolution, whichever is larger).
+ *
+ * Recording is O(1) and lock-free (two relaxed atomic additions), so a single histogram can be shared by many
+ * threads. Percentile queries skip whole power-of-two ranges using their total counts. Histograms with the same
+ * parameters can be merged without loss of precision.
+ *
+ * Value can be a floating-point number or an SI quantity, eg. si::Time.
+ */
+template<class Value>
+	class HdrHistogram
+	{
+	  public:
+		struct Parameters
+		{
+			// The smallest distinguishable value; values are recorded as integer multiples of it:
+			Value		resolution;
+			// The highest value that can be recorded; higher values are recorded as this value:
+			Value		max_value;
+			// Number of significant decimal digits (1…5):
+			unsigned	significant_digits	{ 3 };
+		};
+
+	  public:
+		/**
+		 * Create an empty histogram.
+		 * Throws InvalidArgument if parameters are invalid.
+		 */
+		explicit
+		HdrHistogram (Parameters const&);
+
+		/**
+		 * Return parameters of the histogram.
+		 */
+		[[nodiscard]]
+		Parameters const&
+		parameters() const noexcept
+			{ return _parameters; }
+
+		/**
+		 * Record a value given number of times. Negative values are recorded as 0, values above max_value as
+		 * max_value.
+		 */
+		void
+		record (Value, std::uint64_t count = 1) noexcept;
+
+		/**
+		 * Return number of recorded values.
+		 */
+		[[nodiscard]]
+		std::uint64_t
+		count() const noexcept;
+
+		/**
+		 * Return the smallest recorded value (lowest value equivalent to it), or 0 if histogram is empty.
+		 */
+		[[nodiscard]]
+		Value
+		min() const noexcept;
+
+		/**
+		 * Return the highest recorded value (highest value equivalent to it), or 0 if histogram is empty.
+		 */
+		[[nodiscard]]
+		Value
+		max() const noexcept;
+
+		/**
+		 * Return mean of recorded values (each counted as the middle of its sub-bucket), or 0 if histogram is empty.
+		 */
+		[[nodiscard]]
+		Value
+		mean() const noexcept;
+
+		/**
+		 * Return value below or equal to which given fraction of recorded values are.
+		 * Percentile is normalized (0…1). Returns the highest value equivalent to the found one, or 0 if histogram
+		 * is empty.
+		 */
+		[[nodiscard]]
+		Value
+		value_at_percentile (double percentile) const;
+
+		/**
+		 * Same as value_at_percentile() for many percentiles at once, but scans the histogram only once.
+		 * Throws std::length_error if spans have different sizes.
+		 */
+		void
+		values_at_percentiles (std::span<double const> percentiles, std::span<Value> results) const;
+
+		/**
+		 * Add all values recorded in the other histogram.
+		 * Throws InvalidArgument if histograms have different parameters.
+		 */
+		void
+		merge (HdrHistogram const&);
+
+		/**
+		 * Remove all recorded values.
+		 */
+		void
+		reset() noexcept;
+
+	  private:
+		/**
+		 * Return index in _counts for value given as number of resolution units.
+		 */
+		[[nodiscard]]
+		std::size_t
+		counts_index (std::uint64_t units) const noexcept;
+
+		/**
+		 * Return the lowest value (in resolution units) recorded in counts at given index.
+		 */
+		[[nodiscard]]
+		std::uint64_t
+		lowest_units (std::size_t index) const noexcept;
+
+		/**
+		 * Return the highest value (in resolution units) recorded in counts at given index.
+		 */
+		[[nodiscard]]
+		std::uint64_t
+		highest_units (std::size_t index) const noexcept;
+
+		[[nodiscard]]
+		Value
+		to_value (double units) const noexcept
+			{ return _parameters.resolution * units; }
+
+	  private:
+		Parameters		_parameters;
+		std::uint64_t	_max_units;
+		// Each power-of-two range of units above the first one is split into _half_count sub-buckets:
+		std::size_t		_half_count_magnitude;
+		std::size_t		_half_count;
+		std::size_t		_counts_size;
+		std::size_t		_groups_size;
+		std::unique_ptr<std::atomic<std::uint64_t>[]>
+						_counts;
+		// Sums of counts of each _half_count consecutive counts, used to skip them quickly in percentile queries:
+		std::unique_ptr<std::atomic<std::uint64_t>[]>
+						_group_counts;
+	};
+
+
+template<class Value>
+	inline
+	HdrHistogram<Value>::HdrHistogram (Parameters const& parameters):
+		_parameters (parameters)
+	{
+		if (!(_parameters.resolution > Value{}))
+			throw InvalidArgument ("HDR histogram resolution must be positive");
+
+		if (!(_parameters.max_value >= _parameters.resolution))
+			throw InvalidArgument ("HDR histogram max_value must not be less than resolution");
+
+		if (_parameters.significant_digits < 1 || _parameters.significant_digits > 5)
+			throw InvalidArgument ("HDR histogram significant_digits must be in range 1…5");
+
+		auto const max_units = _parameters.max_value / _parameters.resolution;
+
+		if (max_units >= 0x1p63)
+			throw InvalidArgument ("HDR histogram max_value is too big compared to resolution");
+
+		_max_units = static_cast<std::uint64_t> (max_units);
+
+		// Values up to this one need single-unit resolution to have requested precision:
+		std::uint64_t largest_single_unit_value = 2;
+
+		for (unsigned i = 0; i < _parameters.significant_digits; ++i)
+			largest_single_unit_value *= 10;
+
+		auto const count_magnitude = static_cast<std::size_t> (std::bit_width (largest_single_unit_value - 1));
+		_half_count_magnitude = count_magnitude - 1;
+		_half_count = std::size_t (1) << _half_count_magnitude;
+
+		// Number of power-of-two ranges needed to cover _max_units (the first one has 2 × _half_count sub-buckets):
+		std::size_t buckets = 1;
+
+		for (std::uint64_t smallest_untrackable = std::uint64_t (1) << count_magnitude; smallest_untrackable <= _max_units; smallest_untrackable <<= 1)
+			++buckets;
+
+		_groups_size = buckets + 1;
+		_counts_size = _groups_size * _half_count;
+		_counts = std::make_unique<std::atomic<std::uint64_t>[]> (_counts_size);
+		_group_counts = std::make_unique<std::atomic<std::uint64_t>[]> (_groups_size);
+	}
+
+
+template<class Value>
+	inline void
+	HdrHistogram<Value>::record (Value const value, std::uint64_t const count) noexcept
+	{
+		std::uint64_t units = 0;
+
+		if (value > Value{})
+		{
+			auto const ratio = value / _parameters.resolution;
+			units = ratio < static_cast<double> (_max_units) ? static_cast<std::uint64_t> (ratio) : _max_units;
+		}
+
+		auto const index = counts_index (units);
+		_counts[index].fetch_add (count, std::memory_order_relaxed);
+		_group_counts[index >> _half_count_magnitude].fetch_add (count, std::memory_order_relaxed);
+	}
+
+
+template<class Value>
+	inline std::uint64_t
+	HdrHistogram<Value>::count() const noexcept
+	{
+		std::uint64_t sum = 0;
+
+		for (std::size_t g = 0; g < _groups_size; ++g)
+			sum += _group_counts[g].load (std::memory_order_relaxed);
+
+		return sum;
+	}
+
+
+template<class Value>
+	inline Value
+	HdrHistogram<Value>::min() const noexcept
+	{
+		for (std::size_t i = 0; i < _counts_size; ++i)
+			if (_counts[i].load (std::memory_order_relaxed) > 0)
+				return to_value (static_cast<double> (lowest_units (i)));
+
+		return Value{};
+	}
+
+
+template<class Value>
+	inline Value
+	HdrHistogram<Value>::max() const noexcept
+	{
+		for (std::size_t i = _counts_size; i > 0; --i)
+			if (_counts[i - 1].load (std::memory_order_relaxed) > 0)
+				return to_value (static_cast<double> (highest_units (i - 1)));
+
+		return Value{};
+	}
+
+
+template<class Value>
+	inline Value
+	HdrHistogram<Value>::mean() const noexcept
+	{
+		double sum = 0.0;
+		std::uint64_t total = 0;
+
+		for (std::size_t i = 0; i < _counts_size; ++i)
+		{
+			if (auto const n = _counts[i].load (std::memory_order_relaxed); n > 0)
+			{
+				auto const middle = 0.5 * (static_cast<double> (lowest_units (i)) + static_cast<double> (highest_units (i)));
+				sum += middle * static_cast<double> (n);
+				total += n;
+			}
+		}
+
+		return total > 0 ? to_value (sum / static_cast<double> (total)) : Value{};
+	}
+
+
+template<class Value>
+	inline Value
+	HdrHistogram<Value>::value_at_percentile (double const percentile) const
+	{
+		Value result{};
+		values_at_percentiles ({ &percentile, 1 }, { &result, 1 });
+		return result;
+	}
+
+
+template<class Value>
+	inline void
+	HdrHistogram<Value>::values_at_percentiles (std::span<double const> const percentiles, std::span<Value> const results) const
+	{
+		if (percentiles.size() != results.size())
+			throw std::length_error ("percentiles and results must have the same size");
+
+		std::ranges::fill (results, Value{});
+		auto const total = count();
+
+		if (total == 0)
+			return;
+
+		// Process percentiles in ascending order in a single scan:
+		std::vector<std::size_t> order (percentiles.size());
+		std::iota (order.begin(), order.end(), 0u);
+		std::ranges::sort (order, [&] (std::size_t a, std::size_t b) { return percentiles[a] < percentiles[b]; });
+
+		auto const target_for = [&] (std::size_t const p) {
+			auto const target = std::ceil (std::clamp (percentiles[p], 0.0, 1.0) * static_cast<double> (total));
+			return std::clamp<std::uint64_t> (static_cast<std::uint64_t> (target), 1, total);
+		};
+
+		auto next = order.begin();
+		std::uint64_t cumulative = 0;
+
+		for (std::size_t g = 0; g < _groups_size && next != order.end(); ++g)
+		{
+			auto const group_count = _group_counts[g].load (std::memory_order_relaxed);
+
+			if (cumulative + group_count < target_for (*next))
+			{
+				cumulative += group_count;
+				continue;
+			}
+
+			for (std::size_t i = g * _half_count; i < (g + 1) * _half_count && next != order.end(); ++i)
+			{
+				cumulative += _counts[i].load (std::memory_order_relaxed);
+
+				for (; next != order.end() && cumulative >= target_for (*next); ++next)
+					results[*next] = to_value (static_cast<double> (highest_units (i)));
+			}
+		}
+
+		// Counts may have been recorded during the scan, so that sums of groups didn't match counts:
+		if (next != order.end())
+		{
+			auto const highest = max();
+
+			for (; next != order.end(); ++next)
+				results[*next] = highest;
+		}
+	}
+
+
+template<class Value>
+	inline void
+	HdrHistogram<Value>::merge (HdrHistogram const& other)
+	{
+		if (other._counts_size != _counts_size || other._half_count != _half_count || other._parameters.resolution != _parameters.resolution)
+			throw InvalidArgument ("can't merge HDR histograms with different parameters");
+
+		for (std::size_t i = 0; i < _counts_size; ++i)
+			if (auto const n = other._counts[i].load (std::memory_order_relaxed); n > 0)
+				_counts[i].fetch_add (n, std::memory_order_relaxed);
+
+		for (std::size_t g = 0; g < _groups_size; ++g)
+			_group_counts[g].fetch_add (other._group_counts[g].load (std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+
+template<class Value>
+	inline void
+	HdrHistogram<Value>::reset() noexcept
+	{
+		for (std::size_t i = 0; i < _counts_size; ++i)
+			_counts[i].store (0, std::memory_order_relaxed);
+
+		for (std::size_t g = 0; g < _groups_size; ++g)
+			_group_counts[g].store (0, std::memory_order_relaxed);
+	}
+
+
+template<class Value>
+	inline std::size_t
+	HdrHistogram<Value>::counts_index (std::uint64_t const units) const noexcept
+	{
+		auto const sub_bucket_mask = (std::uint64_t (2) << _half_count_magnitude) - 1;
+		// Index of the power-of-two range; values below 2 × _half_count are in range 0:
+		auto const bucket = static_cast<std::size_t> (std::bit_width (units | sub_bucket_mask)) - _half_count_magnitude - 1;
+		auto const sub_bucket = static_cast<std::size_t> (units >> bucket);
+		return ((bucket + 1) << _half_count_magnitude) + sub_bucket - _half_count;
+	}
+
+
+template<class Value>
+	inline std::uint64_t
+	HdrHistogram<Value>::lowest_units (std::size_t const index) const noexcept
+	{
+		auto const group = index >> _half_count_magnitude;
+		auto const sub_bucket = index & (_half_count - 1);
+
+		if (group == 0)
+			return sub_bucket;
+		else
+			return std::uint64_t (sub_bucket + _half_count) << (group - 1);
+	}
+
+
+template<class Value>
+	inline std::uint64_t
+	HdrHistogram<Value>::highest_units (std::size_t const index) const noexcept
+	{
+		auto const group = index >> _half_count_magnitude;
+		auto const width = group == 0 ? std::uint64_t (1) : std::uint64_t (1) << (group - 1);
+		return lowest_units (index) + width - 1;
+	}
+
+} // namespace neutrino::math
+
+#endif
+
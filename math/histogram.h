@@ -17,20 +17,41 @@
 // Neutrino:
 #include <neutrino/numeric.h>
 #include <neutrino/si/utils.h>
+#include <neutrino/stdexcept.h>
 
 // Standard:
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 
 namespace neutrino::math {
 
+/**
+ * Histogram with fixed-width bins. Also computes basic statistics of the samples.
+ *
+ * Samples can be added incrementally with add(). Mean and standard deviation are updated in a single pass
+ * (Welford's algorithm) and median is approximated from the bins, so samples are never stored or copied.
+ * Histograms with the same bins can be combined with merge(), eg. when filled by many threads.
+ *
+ * Samples below min_x() or above the last bin are counted in statistics, but not put in bins. A sample equal to
+ * max_x() is put in the last bin, so that with the default range all samples are binned.
+ *
+ * Percentile queries use cumulative sums of bins, which are rebuilt on the first query after samples were added.
+ * Because of that, concurrent queries on the same histogram need to be synchronized even though they're const.
+ */
 template<class Value>
 	class Histogram
 	{
 	  public:
-		using Bins = std::vector<std::size_t>;
+		using Bins		= std::vector<std::size_t>;
+		using Square	= decltype (std::declval<Value>() * std::declval<Value>());
 
 		struct Parameters
 		{
@@ -40,11 +61,43 @@ template<class Value>
 		};
 
 	  public:
-		// Ctor
+		/**
+		 * Create an empty histogram to be filled with add().
+		 * Throws InvalidArgument if parameters don't have both min_x and max_x set.
+		 */
+		explicit
+		Histogram (Parameters const&);
+
+		/**
+		 * Create histogram of given samples.
+		 * If min_x or max_x are not set in parameters, they're set to the minimum/maximum of samples; in such case
+		 * the sequence is traversed twice.
+		 * Throws std::length_error if the sequence is empty.
+		 */
 		template<class Iterator>
 			explicit
 			Histogram (Iterator begin, Iterator end, Parameters const&);
 
+		/**
+		 * Add a sample.
+		 */
+		void
+		add (Value const&);
+
+		/**
+		 * Add samples from given sequence.
+		 */
+		template<class Iterator>
+			void
+			add (Iterator begin, Iterator end);
+
+		/**
+		 * Add samples and statistics of other histogram to this one.
+		 * Throws InvalidArgument if histograms have different bins.
+		 */
+		void
+		merge (Histogram const&);
+
 		/**
 		 * Return minimum value of the histogram (X-axis value).
 		 * For minimum recorded value use min().
@@ -85,12 +138,14 @@ template<class Value>
 
 		/**
 		 * Minimum recorded value.
+		 * Undefined if there are no samples.
 		 */
 		Value
 		min() const noexcept;
 
 		/**
 		 * Maximum recorded value.
+		 * Undefined if there are no samples.
 		 */
 		Value
 		max() const noexcept;
@@ -102,13 +157,14 @@ template<class Value>
 		mean() const noexcept;
 
 		/**
-		 * Median.
+		 * Median approximated from bins: the position of the middle sample interpolated linearly within its bin.
+		 * Precision depends on bin width. If the middle sample is outside of the bins, returns min_x() or max_x().
 		 */
 		Value
 		median() const noexcept;
 
 		/**
-		 * Standard deviation.
+		 * Sample standard deviation.
 		 */
 		Value
 		stddev() const noexcept;
@@ -118,25 +174,80 @@ template<class Value>
 		 * That is what fraction of all samples constitute values above given [equal_or_above] value.
 		 *
 		 * It counts data already put in bins, so it's not exact. Its precision depends on bin width.
+		 * Takes constant time.
 		 */
 		float
 		normalized_percentile_for (Value equal_or_above) const;
 
+		/**
+		 * Same as normalized_percentile_for() for many values at once.
+		 * Throws std::length_error if spans have different sizes.
+		 */
+		void
+		normalized_percentiles_for (std::span<Value const> equal_or_above, std::span<float> results) const;
+
+		/**
+		 * Return value below which given fraction (0..1) of samples lie, interpolated linearly within its bin like
+		 * median(). If it's outside of the bins, returns min_x() or max_x(). Takes logarithmic time (binary search
+		 * over cumulative bins).
+		 */
+		Value
+		value_at_percentile (double normalized_percentile) const;
+
+		/**
+		 * Same as value_at_percentile() for many percentiles at once.
+		 * Throws std::length_error if spans have different sizes.
+		 */
+		void
+		values_at_percentiles (std::span<double const> normalized_percentiles, std::span<Value> results) const;
+
+	  private:
+		/**
+		 * Return cumulative sums of bins, rebuilding them if needed.
+		 */
+		std::vector<std::size_t> const&
+		cumulative_bins() const;
+
+		/**
+		 * Set min_x and max_x and allocate bins.
+		 */
+		void
+		initialize_bins (Value min_x, Value max_x);
+
 	  private:
 		Value const	_bin_width;
-		Value		_min_x;
-		Value		_max_x;
-		std::size_t	_max_y		{ 0 };
-		std::size_t	_n_samples	{ 0 };
+		Value		_min_x			{ };
+		Value		_max_x			{ };
+		std::size_t	_max_y			{ 0 };
+		std::size_t	_n_samples		{ 0 };
+		// Number of samples below min_x:
+		std::size_t	_n_underflows	{ 0 };
 		Bins		_bins;
-		Value		_min;
-		Value		_max;
-		Value		_mean;
-		Value		_median;
-		Value		_stddev;
+		Value		_min			{ };
+		Value		_max			{ };
+		// Running mean and sum of squared differences from the mean:
+		Value		_mean			{ };
+		Square		_m2				{ };
+		// Number of samples in bins before each bin (one element more than bins), rebuilt lazily by queries:
+		mutable std::vector<std::size_t>
+					_cumulative_bins;
+		mutable bool
+					_cumulative_bins_valid	{ false };
 	};
 
 
+template<class Value>
+	inline
+	Histogram<Value>::Histogram (Parameters const& parameters):
+		_bin_width (parameters.bin_width > Value() ? parameters.bin_width : Value (1))
+	{
+		if (!parameters.min_x || !parameters.max_x)
+			throw InvalidArgument ("histogram needs min_x and max_x to be filled incrementally");
+
+		initialize_bins (*parameters.min_x, *parameters.max_x);
+	}
+
+
 template<class Value>
 	template<class Iterator>
 		inline
@@ -146,39 +257,111 @@ template<class Value>
 			if (begin == end)
 				throw std::length_error ("can't compute histogram for zero-length sequence");
 
-			auto [min_it, max_it] = std::minmax_element (begin, end);
-			_min = *min_it;
-			_max = *max_it;
+			if (parameters.min_x && parameters.max_x)
+				initialize_bins (*parameters.min_x, *parameters.max_x);
+			else
+			{
+				auto [min_it, max_it] = std::minmax_element (begin, end);
+				initialize_bins (parameters.min_x.value_or (*min_it), parameters.max_x.value_or (*max_it));
+			}
+
+			add (begin, end);
+		}
+
+
+template<class Value>
+	inline void
+	Histogram<Value>::add (Value const& value)
+	{
+		if (_n_samples == 0)
+			_min = _max = value;
+		else
+		{
+			_min = std::min (_min, value);
+			_max = std::max (_max, value);
+		}
 
-			_min_x = parameters.min_x.value_or (_min);
-			_max_x = parameters.max_x.value_or (_max);
+		++_n_samples;
 
-			if (_max_x <= _min_x)
-				_max_x = _min_x + _bin_width;
+		// Welford's algorithm:
+		auto const delta = value - _mean;
+		_mean += delta / static_cast<double> (_n_samples);
+		_m2 += delta * (value - _mean);
 
-			_bins.resize (static_cast<std::size_t> (std::ceil ((_max_x - _min_x) / _bin_width)), 0u);
-			auto const bins = _bins.size();
+		if (value < _min_x)
+			++_n_underflows;
+		else
+		{
+			auto nth_bin = bin_index (value);
 
-			for (Iterator v = begin; v != end; ++v)
-			{
-				std::size_t nth_bin = bin_index (*v);
-				++_n_samples;
+			// Max_x is inclusive; it falls one past the last bin when the range is a multiple of bin width:
+			if (nth_bin >= _bins.size() && value <= _max_x)
+				nth_bin = _bins.size() - 1;
 
-				if (nth_bin < bins)
-				{
-					auto& count = _bins[nth_bin];
-					count++;
+			if (nth_bin < _bins.size())
+			{
+				auto& count = _bins[nth_bin];
+				count++;
+				_cumulative_bins_valid = false;
 
-					if (count > _max_y)
-						_max_y = count;
-				}
+				if (count > _max_y)
+					_max_y = count;
 			}
+		}
+	}
+
+
+template<class Value>
+	template<class Iterator>
+		inline void
+		Histogram<Value>::add (Iterator begin, Iterator end)
+		{
+			for (Iterator v = begin; v != end; ++v)
+				add (*v);
+		}
+
+
+template<class Value>
+	inline void
+	Histogram<Value>::merge (Histogram const& other)
+	{
+		if (other._min_x != _min_x || other._bin_width != _bin_width || other._bins.size() != _bins.size())
+			throw InvalidArgument ("can't merge histograms with different bins");
+
+		if (other._n_samples == 0)
+			return;
+
+		if (_n_samples == 0)
+		{
+			_min = other._min;
+			_max = other._max;
+		}
+		else
+		{
+			_min = std::min (_min, other._min);
+			_max = std::max (_max, other._max);
+		}
+
+		// Combine means and sums of squared differences (Chan et al.):
+		auto const n_a = static_cast<double> (_n_samples);
+		auto const n_b = static_cast<double> (other._n_samples);
+		auto const n = n_a + n_b;
+		auto const delta = other._mean - _mean;
+		_mean += delta * (n_b / n);
+		_m2 += other._m2 + delta * delta * (n_a * n_b / n);
 
-			_mean = neutrino::mean (begin, end);
-			_median = neutrino::median (begin, end);
-			_stddev = neutrino::stddev (begin, end);
+		_n_samples += other._n_samples;
+		_n_underflows += other._n_underflows;
+
+		for (std::size_t b = 0; b < _bins.size(); ++b)
+		{
+			_bins[b] += other._bins[b];
+			_max_y = std::max (_max_y, _bins[b]);
 		}
 
+		_cumulative_bins_valid = false;
+	}
+
 
 template<class Value>
 	inline Value
@@ -256,7 +439,23 @@ template<class Value>
 	inline Value
 	Histogram<Value>::median() const noexcept
 	{
-		return _median;
+		auto const middle = 0.5 * static_cast<double> (_n_samples);
+		auto below = static_cast<double> (_n_underflows);
+
+		if (middle <= below)
+			return _min_x;
+
+		for (std::size_t b = 0; b < _bins.size(); ++b)
+		{
+			auto const count = static_cast<double> (_bins[b]);
+
+			if (middle <= below + count)
+				return _min_x + _bin_width * (static_cast<double> (b) + (middle - below) / count);
+
+			below += count;
+		}
+
+		return _max_x;
 	}
 
 
@@ -264,7 +463,9 @@ template<class Value>
 	inline Value
 	Histogram<Value>::stddev() const noexcept
 	{
-		return _stddev;
+		using std::sqrt;
+
+		return sqrt (_m2 / static_cast<double> (_n_samples - 1));
 	}
 
 
@@ -272,14 +473,93 @@ template<class Value>
 	inline float
 	Histogram<Value>::normalized_percentile_for (Value equal_or_above) const
 	{
-		std::size_t count = 0;
-
-		for (std::size_t b = bin_index (equal_or_above); b < _bins.size(); ++b)
-			count += _bins[b];
+		auto const& cumulative = cumulative_bins();
+		auto const first_bin = equal_or_above < _min_x ? 0 : std::min (bin_index (equal_or_above), _bins.size());
+		auto const count = cumulative.back() - cumulative[first_bin];
 
 		return 1.0f * count / n_samples();
 	}
 
+
+template<class Value>
+	inline void
+	Histogram<Value>::normalized_percentiles_for (std::span<Value const> const equal_or_above, std::span<float> const results) const
+	{
+		if (equal_or_above.size() != results.size())
+			throw std::length_error ("values and results must have the same size");
+
+		for (std::size_t i = 0; i < results.size(); ++i)
+			results[i] = normalized_percentile_for (equal_or_above[i]);
+	}
+
+
+template<class Value>
+	inline Value
+	Histogram<Value>::value_at_percentile (double const normalized_percentile) const
+	{
+		auto const& cumulative = cumulative_bins();
+		// Number of samples in bins below the searched value:
+		auto const target = std::clamp (normalized_percentile, 0.0, 1.0) * static_cast<double> (_n_samples) - static_cast<double> (_n_underflows);
+
+		if (target <= 0.0)
+			return _min_x;
+
+		// Find the first bin that ends at or above target:
+		auto const end = std::lower_bound (cumulative.begin() + 1, cumulative.end(), target, [](std::size_t const count, double const wanted) {
+			return static_cast<double> (count) < wanted;
+		});
+
+		if (end == cumulative.end())
+			return _max_x;
+
+		auto const b = static_cast<std::size_t> (end - cumulative.begin() - 1);
+		auto const below = static_cast<double> (cumulative[b]);
+
+		return _min_x + _bin_width * (static_cast<double> (b) + (target - below) / static_cast<double> (_bins[b]));
+	}
+
+
+template<class Value>
+	inline void
+	Histogram<Value>::values_at_percentiles (std::span<double const> const normalized_percentiles, std::span<Value> const results) const
+	{
+		if (normalized_percentiles.size() != results.size())
+			throw std::length_error ("percentiles and results must have the same size");
+
+		for (std::size_t i = 0; i < results.size(); ++i)
+			results[i] = value_at_percentile (normalized_percentiles[i]);
+	}
+
+
+template<class Value>
+	inline std::vector<std::size_t> const&
+	Histogram<Value>::cumulative_bins() const
+	{
+		if (!_cumulative_bins_valid)
+		{
+			_cumulative_bins.resize (_bins.size() + 1);
+			_cumulative_bins[0] = 0;
+			std::partial_sum (_bins.begin(), _bins.end(), _cumulative_bins.begin() + 1);
+			_cumulative_bins_valid = true;
+		}
+
+		return _cumulative_bins;
+	}
+
+
+template<class Value>
+	inline void
+	Histogram<Value>::initialize_bins (Value const min_x, Value const max_x)
+	{
+		_min_x = min_x;
+		_max_x = max_x;
+
+		if (_max_x <= _min_x)
+			_max_x = _min_x + _bin_width;
+
+		_bins.resize (static_cast<std::size_t> (std::ceil ((_max_x - _min_x) / _bin_width)), 0u);
+	}
+
 } // namespace neutrino::math
 
 #endif
@@ -0,0 +1,191 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__KALMAN_FILTER_H__INCLUDED
+#define NEUTRINO__MATH__KALMAN_FILTER_H__INCLUDED
+
+// Local:
+#include "matrix.h"
+#include "matrix_decomposition.h"
+
+// Standard:
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+namespace neutrino::math {
+
+/**
+ * Linear or extended Kalman filter with state and measurement sizes fixed at compile time.
+ * All matrices are fixed-size, so no memory is allocated at any step.
+ *
+ * Covariance is updated with the Joseph form P = (I - K H) P (I - K H)ᵀ + K R Kᵀ, which keeps it symmetric and
+ * positive-definite in presence of rounding errors. Kalman gain is computed with a Cholesky solve of the
+ * innovation covariance instead of inverting it.
+ *
+ * \param	pStateScalar
+ *			Scalar type of state vector components. May be a si::Quantity.
+ * \param	pMeasurementScalar
+ *			Scalar type of measurement vector components. May be a si::Quantity.
+ */
+template<
+	Scalar pStateScalar,
+	std::size_t pStateSize,
+	std::size_t pMeasurementSize,
+	Scalar pMeasurementScalar = pStateScalar,
+	CoordinateSystem pStateSpace = void,
+	CoordinateSystem pMeasurementSpace = void>
+	class KalmanFilter
+	{
+	  public:
+		static constexpr std::size_t kStateSize			= pStateSize;
+		static constexpr std::size_t kMeasurementSize	= pMeasurementSize;
+
+		using StateScalar			= pStateScalar;
+		using MeasurementScalar		= pMeasurementScalar;
+		using StateSpace			= pStateSpace;
+		using MeasurementSpace		= pMeasurementSpace;
+
+		using State					= Vector<StateScalar, kStateSize, StateSpace, void>;
+		using Covariance			= SquareMatrix<decltype (std::declval<StateScalar>() * std::declval<StateScalar>()), kStateSize, StateSpace>;
+		using Transition			= SquareMatrix<decltype (std::declval<StateScalar>() / std::declval<StateScalar>()), kStateSize, StateSpace>;
+		using Measurement			= Vector<MeasurementScalar, kMeasurementSize, MeasurementSpace, void>;
+		using MeasurementCovariance	= SquareMatrix<decltype (std::declval<MeasurementScalar>() * std::declval<MeasurementScalar>()), kMeasurementSize, MeasurementSpace>;
+		using Observation			= Matrix<decltype (std::declval<MeasurementScalar>() / std::declval<StateScalar>()), kStateSize, kMeasurementSize, MeasurementSpace, StateSpace>;
+		using Gain					= Matrix<decltype (std::declval<StateScalar>() / std::declval<MeasurementScalar>()), kMeasurementSize, kStateSize, StateSpace, MeasurementSpace>;
+
+	  public:
+		// Ctor
+		constexpr
+		KalmanFilter (State const& initial_state, Covariance const& initial_covariance) noexcept:
+			_state (initial_state),
+			_covariance (initial_covariance)
+		{ }
+
+		/**
+		 * Current state estimate.
+		 */
+		[[nodiscard]]
+		constexpr State const&
+		state() const noexcept
+			{ return _state; }
+
+		/**
+		 * Set state estimate.
+		 */
+		constexpr void
+		set_state (State const& state) noexcept
+			{ _state = state; }
+
+		/**
+		 * Current state covariance.
+		 */
+		[[nodiscard]]
+		constexpr Covariance const&
+		covariance() const noexcept
+			{ return _covariance; }
+
+		/**
+		 * Set state covariance.
+		 */
+		constexpr void
+		set_covariance (Covariance const& covariance) noexcept
+			{ _covariance = covariance; }
+
+		/**
+		 * Linear prediction step: x = F x, P = F P Fᵀ + Q.
+		 */
+		constexpr void
+		predict (Transition const& transition, Covariance const& process_noise) noexcept
+			{ predict (transition * _state, transition, process_noise); }
+
+		/**
+		 * Extended prediction step: x = f (x) is computed by the caller and F is the Jacobian of f.
+		 */
+		constexpr void
+		predict (State const& predicted_state, Transition const& transition_jacobian, Covariance const& process_noise) noexcept;
+
+		/**
+		 * Linear update step with measurement z = H x + noise.
+		 * Return false and leave the filter unchanged if innovation covariance isn't positive-definite.
+		 */
+		constexpr bool
+		update (Measurement const& measurement, Observation const& observation, MeasurementCovariance const& measurement_noise) noexcept
+			{ return update_with_innovation (measurement - observation * _state, observation, measurement_noise); }
+
+		/**
+		 * Extended update step: innovation y = z - h (x) is computed by the caller and H is the Jacobian of h.
+		 * Return false and leave the filter unchanged if innovation covariance isn't positive-definite.
+		 */
+		constexpr bool
+		update_with_innovation (Measurement const& innovation, Observation const& observation_jacobian, MeasurementCovariance const& measurement_noise) noexcept;
+
+	  private:
+		State		_state;
+		Covariance	_covariance;
+	};
+
+
+template<Scalar SS, std::size_t N, std::size_t M, Scalar MS, CoordinateSystem SSpace, CoordinateSystem MSpace>
+	constexpr void
+	KalmanFilter<SS, N, M, MS, SSpace, MSpace>::predict (State const& predicted_state,
+														 Transition const& transition_jacobian,
+														 Covariance const& process_noise) noexcept
+	{
+		_state = predicted_state;
+		_covariance = transition_jacobian * _covariance * transition_jacobian.transposed() + process_noise;
+	}
+
+
+template<Scalar SS, std::size_t N, std::size_t M, Scalar MS, CoordinateSystem SSpace, CoordinateSystem MSpace>
+	constexpr bool
+	KalmanFilter<SS, N, M, MS, SSpace, MSpace>::update_with_innovation (Measurement const& innovation,
+																		Observation const& observation_jacobian,
+																		MeasurementCovariance const& measurement_noise) noexcept
+	{
+		auto const& h = observation_jacobian;
+		// H P is used both in innovation covariance and in the gain:
+		auto const hp = h * _covariance;
+		MeasurementCovariance const innovation_covariance = hp * h.transposed() + measurement_noise;
+		auto const cholesky = innovation_covariance.cholesky();
+
+		if (!cholesky.positive_definite())
+			return false;
+
+		// K = P Hᵀ S⁻¹ and both P and S are symmetric, so Kᵀ = S⁻¹ H P:
+		Gain const gain = cholesky.solve (hp).transposed();
+		Transition const i_kh = Transition (math::identity) - gain * h;
+
+		// Joseph form; each term is positive semi-definite on its own, so the sum stays so despite rounding errors:
+		auto const updated_covariance = i_kh * _covariance * i_kh.transposed() + gain * measurement_noise * gain.transposed();
+
+		_state += gain * innovation;
+
+		// Store result removing asymmetry caused by rounding errors:
+		for (std::size_t r = 0; r < kStateSize; ++r)
+		{
+			for (std::size_t c = r; c < kStateSize; ++c)
+			{
+				auto const value = 0.5 * (updated_covariance[c, r] + updated_covariance[r, c]);
+				_covariance[c, r] = value;
+				_covariance[r, c] = value;
+			}
+		}
+
+		return true;
+	}
+
+} // namespace neutrino::math
+
+#endif
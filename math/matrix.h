@@ -16,6 +16,7 @@
 
 // Neutrino:
 #include <neutrino/math/concepts.h>
+#include <neutrino/math/matrix_simd.h>
 #include <neutrino/math/utility.h>
 
 // Standard:
@@ -29,8 +30,18 @@
 
 namespace neutrino::math {
 
+/**
+ * Order of elements in Matrix::components().
+ */
+enum class StorageOrder
+{
+	RowMajor,
+	ColumnMajor,
+};
+
+
 // Forward
-template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSystem pTargetSpace, CoordinateSystem pSourceSpace>
+template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSystem pTargetSpace, CoordinateSystem pSourceSpace, StorageOrder pStorageOrder>
 	class Matrix;
 
 
@@ -38,10 +49,10 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
  * Return a new Matrix with each component converted using static_cast<NewScalar>().
  * Matrix shape and coordinate-system tags are preserved.
  */
-template<class NewScalar, Scalar OldScalar, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<class NewScalar, Scalar OldScalar, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
-	constexpr Matrix<NewScalar, Columns, Rows, TargetSpace, SourceSpace>
-	static_components_cast (Matrix<OldScalar, Columns, Rows, TargetSpace, SourceSpace> const& matrix)
+	constexpr Matrix<NewScalar, Columns, Rows, TargetSpace, SourceSpace, Order>
+	static_components_cast (Matrix<OldScalar, Columns, Rows, TargetSpace, SourceSpace, Order> const& matrix)
 		requires (Scalar<NewScalar> && requires (OldScalar const& value) { static_cast<NewScalar> (value); });
 
 
@@ -53,6 +64,14 @@ template<
 	class Quaternion;
 
 
+template<Scalar pScalar, std::size_t pSize, CoordinateSystem pTargetSpace, CoordinateSystem pSourceSpace>
+	class LUDecomposition;
+
+
+template<Scalar pScalar, std::size_t pSize, CoordinateSystem pTargetSpace, CoordinateSystem pSourceSpace>
+	class CholeskyDecomposition;
+
+
 class BasicMatrix
 {
   protected:
@@ -77,28 +96,35 @@ class BasicMatrix
  *			  M<..., TargetSpace, SourceSpace> x = M<..., TargetSpace, IntermediateSpace>{} * M<..., IntermediateSpace, SourceSpace>{};
  * \param	pSourceSpace
  *			Source CoordinateSystem types.
+ * \param	pStorageOrder
+ *			Order of elements in memory. Operations are the same for both orders, only components() and
+ *			construction from raw arrays depend on it. Use ColumnMajor to interface with column-major external data
+ *			without transposing it. Vectors have the same layout in both orders.
  */
-template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSystem pTargetSpace = void, CoordinateSystem pSourceSpace = pTargetSpace>
+template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSystem pTargetSpace = void, CoordinateSystem pSourceSpace = pTargetSpace, StorageOrder pStorageOrder = StorageOrder::RowMajor>
 	class Matrix: public BasicMatrix
 	{
 	  public:
-		static constexpr std::size_t kColumns	= pColumns;
-		static constexpr std::size_t kRows		= pRows;
+		static constexpr std::size_t kColumns			= pColumns;
+		static constexpr std::size_t kRows				= pRows;
+		static constexpr StorageOrder kStorageOrder	= pStorageOrder;
+		static constexpr StorageOrder kOtherStorageOrder = pStorageOrder == StorageOrder::RowMajor ? StorageOrder::ColumnMajor : StorageOrder::RowMajor;
 
 		using Scalar			= pScalar;
 		using SquaredScalar	= std::remove_cvref_t<decltype (std::declval<Scalar>() * std::declval<Scalar>())>;
 		using InverseScalar		= decltype (1.0 / std::declval<pScalar>());
 		using ColumnVector		= Matrix<Scalar, 1, pRows, pTargetSpace, void>;
-		using InverseMatrix		= Matrix<InverseScalar, pColumns, pRows, pSourceSpace, pTargetSpace>;
-		using TransposedMatrix	= Matrix<Scalar, pRows, pColumns, pSourceSpace, pTargetSpace>;
+		using InverseMatrix		= Matrix<InverseScalar, pColumns, pRows, pSourceSpace, pTargetSpace, pStorageOrder>;
+		using TransposedMatrix	= Matrix<Scalar, pRows, pColumns, pSourceSpace, pTargetSpace, pStorageOrder>;
+		using TransposedView	= Matrix<Scalar, pRows, pColumns, pSourceSpace, pTargetSpace, kOtherStorageOrder>;
 		using TargetSpace		= pTargetSpace;
 		using SourceSpace		= pSourceSpace;
 
 		template<std::size_t NewColumns, std::size_t NewRows>
-			using Resized		= Matrix<Scalar, NewColumns, NewRows, pTargetSpace, pSourceSpace>;
+			using Resized		= Matrix<Scalar, NewColumns, NewRows, pTargetSpace, pSourceSpace, pStorageOrder>;
 
 		template<class NewScalar>
-			using Retyped		= Matrix<NewScalar, pColumns, pRows, pTargetSpace, pSourceSpace>;
+			using Retyped		= Matrix<NewScalar, pColumns, pRows, pTargetSpace, pSourceSpace, pStorageOrder>;
 
 	  public:
 		[[nodiscard]]
@@ -128,6 +154,19 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 			is_column_vector_pack()
 				{ return (sizeof...(Ts) == kColumns) && (std::is_same_v<std::remove_cvref_t<Ts>, ColumnVector> && ...); }
 
+		/**
+		 * Return position of given element in components().
+		 */
+		[[nodiscard]]
+		static constexpr std::size_t
+		component_index (std::size_t column, std::size_t row) noexcept
+		{
+			if constexpr (kStorageOrder == StorageOrder::RowMajor)
+				return row * kColumns + column;
+			else
+				return column * kRows + row;
+		}
+
 	  public:
 		// Ctor. Same as using ZeroInitializer
 		constexpr
@@ -162,11 +201,12 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 			{ }
 
 		/**
-		 * Ctor. Initializes from sequence of scalars: {
+		 * Ctor. Initializes components() from sequence of scalars in storage order. For row-major matrices: {
 		 *	 R0C0, R0C1, R0C2,
 		 *	 R1C0, R1C1, R1C2,
 		 *	 ...
 		 * }
+		 * For column-major matrices: { R0C0, R1C0, …, R0C1, R1C1, … }.
 		 */
 		template<class Iterator>
 			requires (std::is_convertible_v<decltype (*std::declval<Iterator>()), Scalar>)
@@ -174,7 +214,7 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 			Matrix (Iterator begin, Iterator end)
 				{ std::copy (begin, end, _data.begin()); }
 
-		// Ctor. Initializes from std::array of scalars.
+		// Ctor. Initializes components() from std::array of scalars in storage order.
 		explicit constexpr
 		Matrix (std::array<Scalar, kColumns * kRows> const& values) noexcept;
 
@@ -186,7 +226,7 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 			explicit constexpr
 			Matrix (Quaternion<Scalar, TargetSpace, SourceSpace, IsRotationQuaternion> const&) noexcept;
 
-		// Ctor. Initializes from scalars list.
+		// Ctor. Initializes from scalars list, row by row regardless of storage order.
 		template<class ...Ts>
 			requires (is_scalar_pack<Ts...>() || is_column_vector_pack<Ts...>())
 			constexpr
@@ -242,7 +282,7 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 		{ return _data != other._data; }
 
 		/**
-		 * Array of data.
+		 * Array of data in storage order.
 		 */
 		[[nodiscard]]
 		constexpr std::array<Scalar, kColumns * kRows>&
@@ -250,7 +290,7 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 			{ return _data; }
 
 		/**
-		 * Array of data.
+		 * Array of data in storage order.
 		 */
 		[[nodiscard]]
 		constexpr std::array<Scalar, kColumns * kRows> const&
@@ -296,7 +336,7 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 		[[nodiscard]]
 		constexpr Scalar&
 		operator[] (std::size_t column, std::size_t row) noexcept
-			{ return _data[row * kColumns + column]; }
+			{ return _data[component_index (column, row)]; }
 
 		/**
 		 * Fast element accessor. Doesn't perform range checks.
@@ -304,7 +344,7 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 		[[nodiscard]]
 		constexpr Scalar const&
 		operator[] (std::size_t column, std::size_t row) const noexcept
-			{ return _data[row * kColumns + column]; }
+			{ return _data[component_index (column, row)]; }
 
 		/**
 		 * Vector access operator.
@@ -475,6 +515,33 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 		constexpr InverseMatrix
 		inverted() const;
 
+		/**
+		 * Return LU decomposition with partial pivoting. Use it to solve many systems with the same matrix.
+		 * Defined in matrix_decomposition.h.
+		 */
+		[[nodiscard]]
+		constexpr auto
+		lu() const noexcept -> LUDecomposition<Scalar, kColumns, TargetSpace, SourceSpace>
+			requires (is_square());
+
+		/**
+		 * Return Cholesky decomposition. Matrix must be symmetric and positive-definite.
+		 * Defined in matrix_decomposition.h.
+		 */
+		[[nodiscard]]
+		constexpr auto
+		cholesky() const noexcept -> CholeskyDecomposition<Scalar, kColumns, TargetSpace, SourceSpace>
+			requires (is_square());
+
+		/**
+		 * Return determinant of the matrix.
+		 * Defined in matrix_decomposition.h.
+		 */
+		[[nodiscard]]
+		constexpr auto
+		determinant() const noexcept
+			requires (is_square());
+
 		/**
 		 * Return transposed matrix.
 		 */
@@ -482,6 +549,27 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 		constexpr TransposedMatrix
 		transposed() const noexcept;
 
+		/**
+		 * Return transposed matrix without copying. Transposed matrix has the same array of components as this one,
+		 * but interpreted in the other storage order, so the view is a reference to this matrix.
+		 */
+		[[nodiscard]]
+		TransposedView&
+		transposed_view() & noexcept
+			{ return reinterpret_cast<TransposedView&> (*this); }
+
+		/**
+		 * Return transposed matrix without copying.
+		 */
+		[[nodiscard]]
+		TransposedView const&
+		transposed_view() const& noexcept
+			{ return reinterpret_cast<TransposedView const&> (*this); }
+
+		// Forbid views of temporaries:
+		void
+		transposed_view() const&& = delete;
+
 		/**
 		 * Alias for transposed().
 		 */
@@ -595,7 +683,7 @@ template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSyst
 			constexpr void
 			recursive_initialize_from_scalars (std::size_t position, Scalar const& scalar, Ts&& ...rest) noexcept
 			{
-				_data[position] = scalar;
+				_data[component_index (position % kColumns, position / kColumns)] = scalar;
 
 				if constexpr (sizeof...(rest) > 0)
 					recursive_initialize_from_scalars (position + 1, std::forward<Ts> (rest)...);
@@ -621,6 +709,10 @@ template<Scalar S, std::size_t N, CoordinateSystem TS = void, CoordinateSystem S
 	using Vector = Matrix<S, 1, N, TS, SS>;
 
 
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS = void, CoordinateSystem SS = TS>
+	using ColumnMajorMatrix = Matrix<S, C, R, TS, SS, StorageOrder::ColumnMajor>;
+
+
 template<Scalar S, std::size_t N, CoordinateSystem TS = void, CoordinateSystem SS = TS>
 	using SquareMatrix = Matrix<S, N, N, TS, SS>;
 
@@ -630,31 +722,31 @@ template<Scalar S, std::size_t N, CoordinateSystem TS = void, CoordinateSystem S
  */
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix() noexcept:
+	Matrix<S, C, R, TS, SS, O>::Matrix() noexcept:
 		Matrix (zero)
 	{ }
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix (Matrix const& other) noexcept:
+	Matrix<S, C, R, TS, SS, O>::Matrix (Matrix const& other) noexcept:
 		_data (other._data)
 	{ }
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix (ZeroInitializer) noexcept
+	Matrix<S, C, R, TS, SS, O>::Matrix (ZeroInitializer) noexcept
 	{
 		_data.fill (Scalar { 0 });
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix (UnitInitializer) noexcept:
+	Matrix<S, C, R, TS, SS, O>::Matrix (UnitInitializer) noexcept:
 		Matrix (zero)
 	{
 		static_assert (is_square(), "Matrix has to be square");
@@ -664,29 +756,29 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix (IdentityInitializer) noexcept:
+	Matrix<S, C, R, TS, SS, O>::Matrix (IdentityInitializer) noexcept:
 		Matrix (unit)
 	{ }
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix (UninitializedInitializer) noexcept
+	Matrix<S, C, R, TS, SS, O>::Matrix (UninitializedInitializer) noexcept
 	{ }
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix (std::array<Scalar, kColumns * kRows> const& initial_values) noexcept:
+	Matrix<S, C, R, TS, SS, O>::Matrix (std::array<Scalar, kColumns * kRows> const& initial_values) noexcept:
 		_data (initial_values)
 	{ }
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix (std::array<ColumnVector, kColumns> const& initial_vectors) noexcept
+	Matrix<S, C, R, TS, SS, O>::Matrix (std::array<ColumnVector, kColumns> const& initial_vectors) noexcept
 	{
 		for (std::size_t r = 0; r < kRows; ++r)
 			for (std::size_t c = 0; c < kColumns; ++c)
@@ -694,9 +786,9 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
-	constexpr Matrix<S, C, R, TS, SS>
-	Matrix<S, C, R, TS, SS>::equal_diagonal (S const diagonal_value)
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
+	constexpr Matrix<S, C, R, TS, SS, O>
+	Matrix<S, C, R, TS, SS, O>::equal_diagonal (S const diagonal_value)
 		requires (is_square())
 	{
 		Matrix m (zero);
@@ -708,10 +800,10 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	template<bool IsRotationQuaternion>
 	constexpr
-	Matrix<S, C, R, TS, SS>::Matrix (Quaternion<Scalar, TargetSpace, SourceSpace, IsRotationQuaternion> const& quaternion) noexcept
+	Matrix<S, C, R, TS, SS, O>::Matrix (Quaternion<Scalar, TargetSpace, SourceSpace, IsRotationQuaternion> const& quaternion) noexcept
 	{
 		static_assert (kColumns == 3 && kRows == 3, "Only square 3x3 matrix can be created froma Quaternion");
 
@@ -734,7 +826,7 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 
 		auto const zz = z * z;
 
-		_data = {
+		*this = Matrix {
 			2.0 * (ww + xx) - 1.0,	2.0 * (xy - wz),		2.0 * (xz + wy),
 			2.0 * (xy + wz),		2.0 * (ww + yy) - 1.0,	2.0 * (yz - wx),
 			2.0 * (xz - wy),		2.0 * (yz + wx),		2.0 * (ww + zz) - 1.0,
@@ -742,20 +834,20 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr auto
-	Matrix<S, C, R, TS, SS>::at (std::size_t column, std::size_t row) -> Scalar&
+	Matrix<S, C, R, TS, SS, O>::at (std::size_t column, std::size_t row) -> Scalar&
 	{
 		if (column >= kColumns || row >= kRows)
 			throw make_out_of_range_exception (column, row);
 
-		return _data[row * kColumns + column];
+		return _data[component_index (column, row)];
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr auto
-	Matrix<S, C, R, TS, SS>::column (std::size_t index) const noexcept -> ColumnVector
+	Matrix<S, C, R, TS, SS, O>::column (std::size_t index) const noexcept -> ColumnVector
 	{
 		ColumnVector result;
 
@@ -766,9 +858,9 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr auto
-	Matrix<S, C, R, TS, SS>::inverted() const -> InverseMatrix
+	Matrix<S, C, R, TS, SS, O>::inverted() const -> InverseMatrix
 	{
 		static_assert (is_square(), "Matrix needs to be square");
 
@@ -820,7 +912,7 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 			// Gauss-Jordan inversion.
 
 			auto m = *this / Scalar (1.0);
-			auto E = Matrix<double, kColumns, kRows, SourceSpace, TargetSpace> (math::identity);
+			auto E = Matrix<double, kColumns, kRows, SourceSpace, TargetSpace, kStorageOrder> (math::identity);
 
 			auto const divide_row = [](auto& matrix, std::size_t row, auto value) {
 				auto const inv_value = 1.0 / value;
@@ -858,9 +950,9 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
 	constexpr auto
-	Matrix<S, C, R, TS, SS>::transposed() const noexcept -> TransposedMatrix
+	Matrix<S, C, R, TS, SS, O>::transposed() const noexcept -> TransposedMatrix
 	{
 		if constexpr (kRows == 1 || kColumns == 1)
 		{
@@ -870,7 +962,7 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 		}
 		else
 		{
-			Matrix<Scalar, kRows, kColumns, SS, TS> result;
+			TransposedMatrix result;
 
 			for (std::size_t r = 0; r < kRows; ++r)
 				for (std::size_t c = 0; c < kColumns; ++c)
@@ -881,9 +973,9 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
-	constexpr Matrix<S, C, R, TS, SS>&
-	Matrix<S, C, R, TS, SS>::operator= (Matrix const& other)
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
+	constexpr Matrix<S, C, R, TS, SS, O>&
+	Matrix<S, C, R, TS, SS, O>::operator= (Matrix const& other)
 		noexcept (std::is_copy_assignable_v<Scalar>)
 	{
 		std::copy (other._data.begin(), other._data.end(), _data.begin());
@@ -891,21 +983,39 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
-	constexpr Matrix<S, C, R, TS, SS>&
-	Matrix<S, C, R, TS, SS>::operator+= (Matrix const& other)
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
+	constexpr Matrix<S, C, R, TS, SS, O>&
+	Matrix<S, C, R, TS, SS, O>::operator+= (Matrix const& other)
 		noexcept (noexcept (Scalar{} + Scalar{}))
 	{
+		if constexpr (simd::kHasElementwiseKernel<Scalar, kColumns * kRows>)
+		{
+			if !consteval
+			{
+				simd::add<Scalar, kColumns * kRows> (_data.data(), other._data.data(), _data.data());
+				return *this;
+			}
+		}
+
 		std::transform (_data.begin(), _data.end(), other._data.begin(), _data.begin(), std::plus<Scalar>());
 		return *this;
 	}
 
 
-template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS>
-	constexpr Matrix<S, C, R, TS, SS>&
-	Matrix<S, C, R, TS, SS>::operator-= (Matrix const& other)
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
+	constexpr Matrix<S, C, R, TS, SS, O>&
+	Matrix<S, C, R, TS, SS, O>::operator-= (Matrix const& other)
 		noexcept (noexcept (Scalar{} - Scalar{}))
 	{
+		if constexpr (simd::kHasElementwiseKernel<Scalar, kColumns * kRows>)
+		{
+			if !consteval
+			{
+				simd::subtract<Scalar, kColumns * kRows> (_data.data(), other._data.data(), _data.data());
+				return *this;
+			}
+		}
+
 		std::transform (_data.begin(), _data.end(), other._data.begin(), _data.begin(), std::minus<Scalar>());
 		return *this;
 	}
@@ -916,33 +1026,33 @@ template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, Coordinate
  */
 
 
-template<CoordinateSystem NewTargetSpace, CoordinateSystem NewSourceSpace, CoordinateSystem OldTargetSpace, CoordinateSystem OldSourceSpace, Scalar S, std::size_t Columns, std::size_t Rows>
+template<CoordinateSystem NewTargetSpace, CoordinateSystem NewSourceSpace, CoordinateSystem OldTargetSpace, CoordinateSystem OldSourceSpace, Scalar S, std::size_t Columns, std::size_t Rows, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto&
-	coordinate_system_cast (Matrix<S, Columns, Rows, OldTargetSpace, OldSourceSpace>& matrix)
+	coordinate_system_cast (Matrix<S, Columns, Rows, OldTargetSpace, OldSourceSpace, Order>& matrix)
 	{
 		using Scalar = typename std::remove_cvref_t<decltype (matrix)>::Scalar;
-		return reinterpret_cast<Matrix<Scalar, Columns, Rows, NewTargetSpace, NewSourceSpace>&> (matrix);
+		return reinterpret_cast<Matrix<Scalar, Columns, Rows, NewTargetSpace, NewSourceSpace, Order>&> (matrix);
 	}
 
 
-template<CoordinateSystem NewTargetSpace, CoordinateSystem NewSourceSpace, CoordinateSystem OldTargetSpace, CoordinateSystem OldSourceSpace, Scalar S, std::size_t Columns, std::size_t Rows>
+template<CoordinateSystem NewTargetSpace, CoordinateSystem NewSourceSpace, CoordinateSystem OldTargetSpace, CoordinateSystem OldSourceSpace, Scalar S, std::size_t Columns, std::size_t Rows, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto const&
-	coordinate_system_cast (Matrix<S, Columns, Rows, OldTargetSpace, OldSourceSpace> const& matrix)
+	coordinate_system_cast (Matrix<S, Columns, Rows, OldTargetSpace, OldSourceSpace, Order> const& matrix)
 	{
 		using Scalar = typename std::remove_cvref_t<decltype (matrix)>::Scalar;
-		return reinterpret_cast<Matrix<Scalar, Columns, Rows, NewTargetSpace, NewSourceSpace> const&> (matrix);
+		return reinterpret_cast<Matrix<Scalar, Columns, Rows, NewTargetSpace, NewSourceSpace, Order> const&> (matrix);
 	}
 
 
-template<class NewScalar, Scalar OldScalar, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<class NewScalar, Scalar OldScalar, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
-	constexpr Matrix<NewScalar, Columns, Rows, TargetSpace, SourceSpace>
-	static_components_cast (Matrix<OldScalar, Columns, Rows, TargetSpace, SourceSpace> const& matrix)
+	constexpr Matrix<NewScalar, Columns, Rows, TargetSpace, SourceSpace, Order>
+	static_components_cast (Matrix<OldScalar, Columns, Rows, TargetSpace, SourceSpace, Order> const& matrix)
 		requires (Scalar<NewScalar> && requires (OldScalar const& value) { static_cast<NewScalar> (value); })
 	{
-		auto result = Matrix<NewScalar, Columns, Rows, TargetSpace, SourceSpace> (uninitialized);
+		auto result = Matrix<NewScalar, Columns, Rows, TargetSpace, SourceSpace, Order> (uninitialized);
 		auto const& src_data = matrix.components();
 		auto& dst_data = result.components();
 
@@ -952,10 +1062,34 @@ template<class NewScalar, Scalar OldScalar, std::size_t Columns, std::size_t Row
 		return result;
 	}
 
+
+/**
+ * Return a copy of the matrix with components rearranged for given storage order.
+ */
+template<StorageOrder NewOrder, Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder OldOrder>
+	[[nodiscard]]
+	constexpr Matrix<S, Columns, Rows, TargetSpace, SourceSpace, NewOrder>
+	storage_order_cast (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, OldOrder> const& matrix)
+	{
+		if constexpr (NewOrder == OldOrder || Columns == 1 || Rows == 1)
+			return Matrix<S, Columns, Rows, TargetSpace, SourceSpace, NewOrder> (matrix.components());
+		else
+		{
+			auto result = Matrix<S, Columns, Rows, TargetSpace, SourceSpace, NewOrder> (uninitialized);
+
+			for (std::size_t r = 0; r < Rows; ++r)
+				for (std::size_t c = 0; c < Columns; ++c)
+					result[c, r] = matrix[c, r];
+
+			return result;
+		}
+	}
+
 } // namespace neutrino::math
 
 
 // Local:
+#include "matrix_decomposition.h"
 #include "matrix_operations.h"
 
 #endif
@@ -0,0 +1,476 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__MATRIX_DECOMPOSITION_H__INCLUDED
+#define NEUTRINO__MATH__MATRIX_DECOMPOSITION_H__INCLUDED
+
+// Local:
+#include "matrix.h"
+
+// Standard:
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+namespace neutrino::math {
+namespace detail {
+
+/**
+ * Return Scalar (1) raised to given power. Used to restore units of quantity-typed results.
+ */
+template<std::size_t Power, class S>
+	constexpr auto
+	unit_power()
+	{
+		if constexpr (Power == 1)
+			return S (1);
+		else
+			return S (1) * unit_power<Power - 1, S>();
+	}
+
+} // namespace detail
+
+
+/**
+ * LU decomposition with partial pivoting: P × A = L × U, where L is lower-triangular with unit diagonal and U is
+ * upper-triangular. The factorization is computed once and can be used to solve many systems A × x = b.
+ * If all right-hand sides are known up front, pass them as columns of one matrix to solve(), which is much faster
+ * than solving them one by one.
+ * Computations are done on dimensionless values, so quantity-typed matrices are supported.
+ */
+template<Scalar pScalar, std::size_t pSize, CoordinateSystem pTargetSpace, CoordinateSystem pSourceSpace>
+	class LUDecomposition
+	{
+	  public:
+		static constexpr std::size_t kSize = pSize;
+
+		using Scalar		= pScalar;
+		using Value			= std::remove_cvref_t<decltype (std::declval<Scalar>() / std::declval<Scalar>())>;
+		using TargetSpace	= pTargetSpace;
+		using SourceSpace	= pSourceSpace;
+		using SourceMatrix	= Matrix<Scalar, kSize, kSize, TargetSpace, SourceSpace>;
+		using InverseMatrix	= typename SourceMatrix::InverseMatrix;
+
+		template<class RhsScalar>
+			using SolutionScalar = std::remove_cvref_t<decltype (std::declval<RhsScalar>() / std::declval<Scalar>())>;
+
+	  public:
+		// Ctor
+		explicit constexpr
+		LUDecomposition (SourceMatrix const&) noexcept;
+
+		/**
+		 * Return true if a zero pivot was encountered. Solutions of a singular system will contain infinities or NaNs.
+		 */
+		[[nodiscard]]
+		constexpr bool
+		singular() const noexcept
+			{ return _singular; }
+
+		/**
+		 * Return row permutation: row i of P × A is row permutation()[i] of A.
+		 */
+		[[nodiscard]]
+		constexpr std::array<std::size_t, kSize> const&
+		permutation() const noexcept
+			{ return _permutation; }
+
+		/**
+		 * Return determinant of the decomposed matrix.
+		 */
+		[[nodiscard]]
+		constexpr auto
+		determinant() const noexcept;
+
+		/**
+		 * Solve A × X = B for each column of B.
+		 */
+		template<math::Scalar RhsScalar, std::size_t RhsColumns, CoordinateSystem RhsSourceSpace>
+			[[nodiscard]]
+			constexpr Matrix<SolutionScalar<RhsScalar>, RhsColumns, kSize, SourceSpace, RhsSourceSpace>
+			solve (Matrix<RhsScalar, RhsColumns, kSize, TargetSpace, RhsSourceSpace> const& rhs) const noexcept;
+
+		/**
+		 * Return inverse of the decomposed matrix.
+		 */
+		[[nodiscard]]
+		constexpr InverseMatrix
+		inverted() const noexcept
+			{ return solve (Matrix<double, kSize, kSize, TargetSpace, TargetSpace> (math::identity)); }
+
+	  private:
+		// Row-major L and U stored together (unit diagonal of L is implicit):
+		Matrix<Value, kSize, kSize>				_lu					{ math::uninitialized };
+		std::array<Value, kSize>				_inverse_pivots;
+		std::array<std::size_t, kSize>			_permutation;
+		bool									_odd_permutation	{ false };
+		bool									_singular			{ false };
+	};
+
+
+/**
+ * Cholesky decomposition A = L × Lᵀ of a symmetric positive-definite matrix. Only the lower triangle of A is used.
+ * About twice as fast as LUDecomposition and numerically stable without pivoting.
+ */
+template<Scalar pScalar, std::size_t pSize, CoordinateSystem pTargetSpace, CoordinateSystem pSourceSpace>
+	class CholeskyDecomposition
+	{
+	  public:
+		static constexpr std::size_t kSize = pSize;
+
+		using Scalar		= pScalar;
+		using Value			= std::remove_cvref_t<decltype (std::declval<Scalar>() / std::declval<Scalar>())>;
+		using TargetSpace	= pTargetSpace;
+		using SourceSpace	= pSourceSpace;
+		using SourceMatrix	= Matrix<Scalar, kSize, kSize, TargetSpace, SourceSpace>;
+		using InverseMatrix	= typename SourceMatrix::InverseMatrix;
+
+		template<class RhsScalar>
+			using SolutionScalar = std::remove_cvref_t<decltype (std::declval<RhsScalar>() / std::declval<Scalar>())>;
+
+	  public:
+		// Ctor
+		explicit constexpr
+		CholeskyDecomposition (SourceMatrix const&) noexcept;
+
+		/**
+		 * Return false if the matrix turned out not to be positive-definite. Solutions will contain NaNs in such case.
+		 */
+		[[nodiscard]]
+		constexpr bool
+		positive_definite() const noexcept
+			{ return _positive_definite; }
+
+		/**
+		 * Return determinant of the decomposed matrix.
+		 */
+		[[nodiscard]]
+		constexpr auto
+		determinant() const noexcept;
+
+		/**
+		 * Solve A × X = B for each column of B.
+		 */
+		template<math::Scalar RhsScalar, std::size_t RhsColumns, CoordinateSystem RhsSourceSpace>
+			[[nodiscard]]
+			constexpr Matrix<SolutionScalar<RhsScalar>, RhsColumns, kSize, SourceSpace, RhsSourceSpace>
+			solve (Matrix<RhsScalar, RhsColumns, kSize, TargetSpace, RhsSourceSpace> const& rhs) const noexcept;
+
+		/**
+		 * Return inverse of the decomposed matrix.
+		 */
+		[[nodiscard]]
+		constexpr InverseMatrix
+		inverted() const noexcept
+			{ return solve (Matrix<double, kSize, kSize, TargetSpace, TargetSpace> (math::identity)); }
+
+	  private:
+		// Row-major lower-triangular L; upper triangle is unused:
+		Matrix<Value, kSize, kSize>				_lower				{ math::uninitialized };
+		std::array<Value, kSize>				_inverse_diagonal;
+		bool									_positive_definite	{ true };
+	};
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	constexpr
+	LUDecomposition<S, N, TS, SS>::LUDecomposition (SourceMatrix const& matrix) noexcept
+	{
+		using std::abs;
+
+		for (std::size_t r = 0; r < kSize; ++r)
+		{
+			_permutation[r] = r;
+
+			for (std::size_t c = 0; c < kSize; ++c)
+				_lu[c, r] = matrix[c, r] / Scalar (1);
+		}
+
+		for (std::size_t k = 0; k < kSize; ++k)
+		{
+			// Find pivot:
+			std::size_t pivot_row = k;
+			auto pivot_magnitude = abs (_lu[k, k]);
+
+			for (std::size_t r = k + 1; r < kSize; ++r)
+			{
+				if (auto const magnitude = abs (_lu[k, r]); magnitude > pivot_magnitude)
+				{
+					pivot_row = r;
+					pivot_magnitude = magnitude;
+				}
+			}
+
+			if (pivot_magnitude == Value (0))
+			{
+				_singular = true;
+				_inverse_pivots[k] = Value (1) / _lu[k, k];
+				continue;
+			}
+
+			if (pivot_row != k)
+			{
+				for (std::size_t c = 0; c < kSize; ++c)
+					std::swap (_lu[c, k], _lu[c, pivot_row]);
+
+				std::swap (_permutation[k], _permutation[pivot_row]);
+				_odd_permutation = !_odd_permutation;
+			}
+
+			auto const inv_pivot = Value (1) / _lu[k, k];
+			_inverse_pivots[k] = inv_pivot;
+
+			for (std::size_t r = k + 1; r < kSize; ++r)
+			{
+				auto const factor = _lu[k, r] * inv_pivot;
+				_lu[k, r] = factor;
+
+				for (std::size_t c = k + 1; c < kSize; ++c)
+					_lu[c, r] -= factor * _lu[c, k];
+			}
+		}
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	constexpr auto
+	LUDecomposition<S, N, TS, SS>::determinant() const noexcept
+	{
+		Value result = _odd_permutation ? Value (-1) : Value (1);
+
+		for (std::size_t d = 0; d < kSize; ++d)
+			result *= _lu[d, d];
+
+		return result * detail::unit_power<kSize, Scalar>();
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	template<Scalar RhsScalar, std::size_t RhsColumns, CoordinateSystem RhsSourceSpace>
+	constexpr auto
+	LUDecomposition<S, N, TS, SS>::solve (Matrix<RhsScalar, RhsColumns, kSize, TargetSpace, RhsSourceSpace> const& rhs) const noexcept
+		-> Matrix<SolutionScalar<RhsScalar>, RhsColumns, kSize, SourceSpace, RhsSourceSpace>
+	{
+		auto x = Matrix<Value, RhsColumns, kSize> (math::uninitialized);
+
+		// Forward substitution L × y = P × b. Whole rows of X are processed at once:
+		for (std::size_t r = 0; r < kSize; ++r)
+		{
+			for (std::size_t c = 0; c < RhsColumns; ++c)
+				x[c, r] = static_cast<Value> (rhs[c, _permutation[r]] / RhsScalar (1));
+
+			for (std::size_t k = 0; k < r; ++k)
+			{
+				auto const factor = _lu[k, r];
+
+				for (std::size_t c = 0; c < RhsColumns; ++c)
+					x[c, r] -= factor * x[c, k];
+			}
+		}
+
+		// Backward substitution U × x = y:
+		for (std::size_t r = kSize; r-- > 0; )
+		{
+			for (std::size_t k = r + 1; k < kSize; ++k)
+			{
+				auto const factor = _lu[k, r];
+
+				for (std::size_t c = 0; c < RhsColumns; ++c)
+					x[c, r] -= factor * x[c, k];
+			}
+
+			for (std::size_t c = 0; c < RhsColumns; ++c)
+				x[c, r] *= _inverse_pivots[r];
+		}
+
+		auto result = Matrix<SolutionScalar<RhsScalar>, RhsColumns, kSize, SourceSpace, RhsSourceSpace> (math::uninitialized);
+		auto const unit = RhsScalar (1) / Scalar (1);
+
+		for (std::size_t i = 0; i < x.components().size(); ++i)
+			result.components()[i] = x.components()[i] * unit;
+
+		return result;
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	constexpr
+	CholeskyDecomposition<S, N, TS, SS>::CholeskyDecomposition (SourceMatrix const& matrix) noexcept
+	{
+		using std::sqrt;
+
+		for (std::size_t j = 0; j < kSize; ++j)
+		{
+			auto diagonal = matrix[j, j] / Scalar (1);
+
+			for (std::size_t k = 0; k < j; ++k)
+				diagonal -= _lower[k, j] * _lower[k, j];
+
+			if (!(diagonal > Value (0)))
+				_positive_definite = false;
+
+			auto const l = sqrt (diagonal);
+			auto const inv_l = Value (1) / l;
+			_lower[j, j] = l;
+			_inverse_diagonal[j] = inv_l;
+
+			for (std::size_t r = j + 1; r < kSize; ++r)
+			{
+				auto sum = matrix[j, r] / Scalar (1);
+
+				for (std::size_t k = 0; k < j; ++k)
+					sum -= _lower[k, r] * _lower[k, j];
+
+				_lower[j, r] = sum * inv_l;
+			}
+		}
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	constexpr auto
+	CholeskyDecomposition<S, N, TS, SS>::determinant() const noexcept
+	{
+		Value result (1);
+
+		for (std::size_t d = 0; d < kSize; ++d)
+			result *= _lower[d, d] * _lower[d, d];
+
+		return result * detail::unit_power<kSize, Scalar>();
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	template<Scalar RhsScalar, std::size_t RhsColumns, CoordinateSystem RhsSourceSpace>
+	constexpr auto
+	CholeskyDecomposition<S, N, TS, SS>::solve (Matrix<RhsScalar, RhsColumns, kSize, TargetSpace, RhsSourceSpace> const& rhs) const noexcept
+		-> Matrix<SolutionScalar<RhsScalar>, RhsColumns, kSize, SourceSpace, RhsSourceSpace>
+	{
+		auto x = Matrix<Value, RhsColumns, kSize> (math::uninitialized);
+
+		// Forward substitution L × y = b:
+		for (std::size_t r = 0; r < kSize; ++r)
+		{
+			for (std::size_t c = 0; c < RhsColumns; ++c)
+				x[c, r] = static_cast<Value> (rhs[c, r] / RhsScalar (1));
+
+			for (std::size_t k = 0; k < r; ++k)
+			{
+				auto const factor = _lower[k, r];
+
+				for (std::size_t c = 0; c < RhsColumns; ++c)
+					x[c, r] -= factor * x[c, k];
+			}
+
+			for (std::size_t c = 0; c < RhsColumns; ++c)
+				x[c, r] *= _inverse_diagonal[r];
+		}
+
+		// Backward substitution Lᵀ × x = y:
+		for (std::size_t r = kSize; r-- > 0; )
+		{
+			for (std::size_t k = r + 1; k < kSize; ++k)
+			{
+				auto const factor = _lower[r, k];
+
+				for (std::size_t c = 0; c < RhsColumns; ++c)
+					x[c, r] -= factor * x[c, k];
+			}
+
+			for (std::size_t c = 0; c < RhsColumns; ++c)
+				x[c, r] *= _inverse_diagonal[r];
+		}
+
+		auto result = Matrix<SolutionScalar<RhsScalar>, RhsColumns, kSize, SourceSpace, RhsSourceSpace> (math::uninitialized);
+		auto const unit = RhsScalar (1) / Scalar (1);
+
+		for (std::size_t i = 0; i < x.components().size(); ++i)
+			result.components()[i] = x.components()[i] * unit;
+
+		return result;
+	}
+
+
+/*
+ * Matrix methods
+ */
+
+
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
+	constexpr auto
+	Matrix<S, C, R, TS, SS, O>::lu() const noexcept -> LUDecomposition<Scalar, kColumns, TargetSpace, SourceSpace>
+		requires (is_square())
+	{
+		if constexpr (kStorageOrder == StorageOrder::RowMajor)
+			return LUDecomposition<Scalar, kColumns, TargetSpace, SourceSpace> (*this);
+		else
+			return LUDecomposition<Scalar, kColumns, TargetSpace, SourceSpace> (storage_order_cast<StorageOrder::RowMajor> (*this));
+	}
+
+
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
+	constexpr auto
+	Matrix<S, C, R, TS, SS, O>::cholesky() const noexcept -> CholeskyDecomposition<Scalar, kColumns, TargetSpace, SourceSpace>
+		requires (is_square())
+	{
+		if constexpr (kStorageOrder == StorageOrder::RowMajor)
+			return CholeskyDecomposition<Scalar, kColumns, TargetSpace, SourceSpace> (*this);
+		else
+			return CholeskyDecomposition<Scalar, kColumns, TargetSpace, SourceSpace> (storage_order_cast<StorageOrder::RowMajor> (*this));
+	}
+
+
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, StorageOrder O>
+	constexpr auto
+	Matrix<S, C, R, TS, SS, O>::determinant() const noexcept
+		requires (is_square())
+	{
+		auto const& self = *this;
+
+		if constexpr (is_scalar())
+			return self[0, 0];
+		else if constexpr (kColumns == 2)
+			return self[0, 0] * self[1, 1] - self[1, 0] * self[0, 1];
+		else if constexpr (kColumns == 3)
+		{
+			return self[0, 0] * (self[1, 1] * self[2, 2] - self[2, 1] * self[1, 2])
+				 - self[1, 0] * (self[0, 1] * self[2, 2] - self[2, 1] * self[0, 2])
+				 + self[2, 0] * (self[0, 1] * self[1, 2] - self[1, 1] * self[0, 2]);
+		}
+		else
+			return lu().determinant();
+	}
+
+
+/*
+ * Global functions
+ */
+
+
+/**
+ * Return determinant of a square matrix.
+ */
+template<Scalar S, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	[[nodiscard]]
+	constexpr auto
+	det (SquareMatrix<S, Size, TargetSpace, SourceSpace> const& matrix)
+	{
+		return matrix.determinant();
+	}
+
+} // namespace neutrino::math
+
+#endif
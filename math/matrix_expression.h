@@ -0,0 +1,465 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__MATRIX_EXPRESSION_H__INCLUDED
+#define NEUTRINO__MATH__MATRIX_EXPRESSION_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/math/concepts.h>
+#include <neutrino/math/matrix.h>
+#include <neutrino/math/matrix_operations.h>
+
+// Standard:
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+/**
+ * Lazily evaluated matrix expressions (expression templates).
+ *
+ * Regular Matrix operators evaluate eagerly and create a full temporary matrix for each operator. Wrapping any operand
+ * with lazy() makes operators build an expression object instead, which is evaluated row by row in a single pass when
+ * converted to a Matrix (or when evaluate() is called), without intermediate matrices:
+ *
+ *   Matrix<double, 4, 4> m = lazy (a) * b + lazy (c) * d - e;
+ *
+ * Coordinate-system tags are checked the same way as with regular operators. If an operand of a matrix product is
+ * itself a compound expression, it's evaluated into a Matrix first, so that it's not recomputed for each row
+ * of the product.
+ *
+ * Fusing pays off most for element-wise chains and for products of larger matrices. For 3- and 4-sized float/double
+ * products the eager operator* has dedicated SIMD kernels and is usually a bit faster than the lazy product.
+ *
+ * Operands may have any storage order (eg. transposed views); expressions always evaluate into row-major matrices.
+ *
+ * Expressions hold references to lvalue Matrix operands (rvalue operands are copied), so they're meant to be evaluated
+ * within the same full-expression. Don't store them in variables that outlive the operands.
+ */
+namespace neutrino::math {
+
+/**
+ * Node of an expression is a callable object with signature void (std::size_t row, Scalar* output) that computes
+ * given row of the expression and writes it to output.
+ */
+template<Scalar pScalar, std::size_t pColumns, std::size_t pRows, CoordinateSystem pTargetSpace, CoordinateSystem pSourceSpace, class pNode>
+	class MatrixExpression
+	{
+	  public:
+		static constexpr std::size_t kColumns	= pColumns;
+		static constexpr std::size_t kRows		= pRows;
+
+		using Scalar		= pScalar;
+		using TargetSpace	= pTargetSpace;
+		using SourceSpace	= pSourceSpace;
+		using Node			= pNode;
+		using Matrix		= math::Matrix<Scalar, kColumns, kRows, TargetSpace, SourceSpace>;
+		using Row			= std::array<Scalar, kColumns>;
+
+	  public:
+		// Ctor
+		explicit constexpr
+		MatrixExpression (Node node):
+			_node (std::move (node))
+		{ }
+
+		/**
+		 * Compute a single row of the expression and write it to output.
+		 */
+		constexpr void
+		write_row (std::size_t const index, Scalar* const output) const
+			{ _node (index, output); }
+
+		/**
+		 * Compute a single row of the expression.
+		 */
+		[[nodiscard]]
+		constexpr Row
+		row (std::size_t const index) const;
+
+		/**
+		 * Compute single element of the expression. Computes the whole row, so use it sparingly.
+		 */
+		[[nodiscard]]
+		constexpr Scalar
+		operator[] (std::size_t const column, std::size_t const row) const
+			{ return this->row (row)[column]; }
+
+		/**
+		 * Evaluate the expression into a new Matrix.
+		 */
+		[[nodiscard]]
+		constexpr Matrix
+		evaluate() const;
+
+		/**
+		 * Implicit conversion to Matrix, evaluates the expression.
+		 */
+		constexpr
+		operator Matrix() const
+			{ return evaluate(); }
+
+		[[nodiscard]]
+		constexpr Node const&
+		node() const noexcept
+			{ return _node; }
+
+	  private:
+		Node _node;
+	};
+
+
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, class N>
+	constexpr auto
+	MatrixExpression<S, C, R, TS, SS, N>::row (std::size_t const index) const -> Row
+	{
+		Row result;
+		_node (index, result.data());
+		return result;
+	}
+
+
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, class N>
+	constexpr auto
+	MatrixExpression<S, C, R, TS, SS, N>::evaluate() const -> Matrix
+	{
+		auto result = Matrix (uninitialized);
+
+		for (std::size_t r = 0; r < kRows; ++r)
+		{
+			Row row;
+			_node (r, row.data());
+
+			for (std::size_t c = 0; c < kColumns; ++c)
+				result[c, r] = row[c];
+		}
+
+		return result;
+	}
+
+
+namespace detail {
+
+/**
+ * Expression node that refers to an existing matrix.
+ */
+template<class pMatrix>
+	struct MatrixReferenceNode
+	{
+		pMatrix const* matrix;
+
+		constexpr void
+		operator() (std::size_t const row, typename pMatrix::Scalar* const output) const
+		{
+			for (std::size_t c = 0; c < pMatrix::kColumns; ++c)
+				output[c] = (*matrix)[c, row];
+		}
+	};
+
+
+/**
+ * Expression node that holds a copy of a matrix.
+ */
+template<class pMatrix>
+	struct MatrixValueNode
+	{
+		pMatrix matrix;
+
+		constexpr void
+		operator() (std::size_t const row, typename pMatrix::Scalar* const output) const
+		{
+			for (std::size_t c = 0; c < pMatrix::kColumns; ++c)
+				output[c] = matrix[c, row];
+		}
+	};
+
+
+template<class T>
+	constexpr bool kIsMatrixExpression = false;
+
+template<Scalar S, std::size_t C, std::size_t R, CoordinateSystem TS, CoordinateSystem SS, class N>
+	constexpr bool kIsMatrixExpression<MatrixExpression<S, C, R, TS, SS, N>> = true;
+
+
+template<class T>
+	constexpr bool kIsReferenceNode = false;
+
+template<class M>
+	constexpr bool kIsReferenceNode<MatrixReferenceNode<M>> = true;
+
+
+template<class T>
+	constexpr bool kIsValueNode = false;
+
+template<class M>
+	constexpr bool kIsValueNode<MatrixValueNode<M>> = true;
+
+
+template<class T>
+	concept MatrixOrExpression = is_matrix<std::remove_cvref_t<T>, Matrix>::value || kIsMatrixExpression<std::remove_cvref_t<T>>;
+
+
+/**
+ * True if a and b can be used in a lazy binary operation: both are matrices or expressions and at least one
+ * of them is an expression (so that regular eager Matrix operators are not affected).
+ */
+template<class A, class B>
+	concept LazyOperands =
+		MatrixOrExpression<A> && MatrixOrExpression<B> &&
+		(kIsMatrixExpression<std::remove_cvref_t<A>> || kIsMatrixExpression<std::remove_cvref_t<B>>);
+
+
+/**
+ * True if a and b have the same scalar type, dimensions and coordinate systems, as required for element-wise
+ * addition and subtraction.
+ */
+template<class A, class B>
+	concept ElementwiseCompatible =
+		std::is_same_v<typename A::Scalar, typename B::Scalar> &&
+		A::kColumns == B::kColumns && A::kRows == B::kRows &&
+		std::is_same_v<typename A::TargetSpace, typename B::TargetSpace> &&
+		std::is_same_v<typename A::SourceSpace, typename B::SourceSpace>;
+
+
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, class Node>
+	constexpr auto
+	make_expression (Node node)
+	{
+		return MatrixExpression<S, Columns, Rows, TargetSpace, SourceSpace, Node> (std::move (node));
+	}
+
+
+/**
+ * Return operand as a MatrixExpression. Lvalue matrices are referenced, rvalue matrices are copied.
+ */
+template<class Operand>
+	constexpr auto
+	to_expression (Operand&& operand)
+	{
+		using Plain = std::remove_cvref_t<Operand>;
+
+		if constexpr (kIsMatrixExpression<Plain>)
+			return Plain (std::forward<Operand> (operand));
+		else if constexpr (std::is_lvalue_reference_v<Operand>)
+			return make_expression<typename Plain::Scalar, Plain::kColumns, Plain::kRows, typename Plain::TargetSpace, typename Plain::SourceSpace> (MatrixReferenceNode<Plain> { &operand });
+		else
+			return make_expression<typename Plain::Scalar, Plain::kColumns, Plain::kRows, typename Plain::TargetSpace, typename Plain::SourceSpace> (MatrixValueNode<Plain> { std::move (operand) });
+	}
+
+
+/**
+ * Like to_expression(), but compound expressions are evaluated into a matrix, so that they're not recomputed
+ * for each row of a product.
+ */
+template<class Operand>
+	constexpr auto
+	to_product_operand (Operand&& operand)
+	{
+		auto expression = to_expression (std::forward<Operand> (operand));
+		using Node = typename decltype (expression)::Node;
+
+		if constexpr (kIsReferenceNode<Node> || kIsValueNode<Node>)
+			return expression;
+		else
+			return to_expression (expression.evaluate());
+	}
+
+
+/**
+ * Return Matrix referenced or held by a leaf expression.
+ */
+template<class Expression>
+	constexpr auto const&
+	leaf_matrix (Expression const& expression) noexcept
+	{
+		if constexpr (kIsReferenceNode<typename Expression::Node>)
+			return *expression.node().matrix;
+		else
+			return expression.node().matrix;
+	}
+
+} // namespace detail
+
+
+/**
+ * Start a lazy expression with given matrix. The matrix is referenced, not copied.
+ */
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
+	[[nodiscard]]
+	constexpr auto
+	lazy (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> const& matrix) noexcept
+	{
+		return detail::to_expression (matrix);
+	}
+
+
+/**
+ * Start a lazy expression with given temporary matrix. The matrix is moved into the expression.
+ */
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
+	[[nodiscard]]
+	constexpr auto
+	lazy (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order>&& matrix) noexcept
+	{
+		return detail::to_expression (std::move (matrix));
+	}
+
+
+/**
+ * Evaluate an expression into a Matrix. Useful when the result type is not spelled out, like with auto.
+ */
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, class Node>
+	[[nodiscard]]
+	constexpr auto
+	evaluate (MatrixExpression<S, Columns, Rows, TargetSpace, SourceSpace, Node> const& expression)
+	{
+		return expression.evaluate();
+	}
+
+
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, class Node>
+	[[nodiscard]]
+	constexpr auto
+	operator- (MatrixExpression<S, Columns, Rows, TargetSpace, SourceSpace, Node> const& a)
+	{
+		return detail::make_expression<S, Columns, Rows, TargetSpace, SourceSpace> ([a] (std::size_t const r, S* const output) {
+			a.write_row (r, output);
+
+			for (std::size_t c = 0; c < Columns; ++c)
+				output[c] = -output[c];
+		});
+	}
+
+
+template<class A, class B>
+	requires (detail::LazyOperands<A, B> && detail::ElementwiseCompatible<std::remove_cvref_t<A>, std::remove_cvref_t<B>>)
+	[[nodiscard]]
+	constexpr auto
+	operator+ (A&& a, B&& b)
+	{
+		using Operand = std::remove_cvref_t<A>;
+
+		return detail::make_expression<typename Operand::Scalar, Operand::kColumns, Operand::kRows, typename Operand::TargetSpace, typename Operand::SourceSpace> (
+			[ea = detail::to_expression (std::forward<A> (a)), eb = detail::to_expression (std::forward<B> (b))] (std::size_t const r, typename Operand::Scalar* const output) {
+				auto const other = eb.row (r);
+				ea.write_row (r, output);
+
+				for (std::size_t c = 0; c < Operand::kColumns; ++c)
+					output[c] = output[c] + other[c];
+			}
+		);
+	}
+
+
+template<class A, class B>
+	requires (detail::LazyOperands<A, B> && detail::ElementwiseCompatible<std::remove_cvref_t<A>, std::remove_cvref_t<B>>)
+	[[nodiscard]]
+	constexpr auto
+	operator- (A&& a, B&& b)
+	{
+		using Operand = std::remove_cvref_t<A>;
+
+		return detail::make_expression<typename Operand::Scalar, Operand::kColumns, Operand::kRows, typename Operand::TargetSpace, typename Operand::SourceSpace> (
+			[ea = detail::to_expression (std::forward<A> (a)), eb = detail::to_expression (std::forward<B> (b))] (std::size_t const r, typename Operand::Scalar* const output) {
+				auto const other = eb.row (r);
+				ea.write_row (r, output);
+
+				for (std::size_t c = 0; c < Operand::kColumns; ++c)
+					output[c] = output[c] - other[c];
+			}
+		);
+	}
+
+
+/**
+ * Matrix product within a lazy expression. Requires the same IntermediateSpace as the regular operator*.
+ * Each result row is computed as a linear combination of rows of b, which vectorizes well.
+ */
+template<class A, class B>
+	requires (detail::LazyOperands<A, B> &&
+			  std::remove_cvref_t<A>::kColumns == std::remove_cvref_t<B>::kRows &&
+			  std::is_same_v<typename std::remove_cvref_t<A>::SourceSpace, typename std::remove_cvref_t<B>::TargetSpace>)
+	[[nodiscard]]
+	constexpr auto
+	operator* (A&& a, B&& b)
+	{
+		using OperandA = std::remove_cvref_t<A>;
+		using OperandB = std::remove_cvref_t<B>;
+		using ResultScalar = decltype (std::declval<typename OperandA::Scalar>() * std::declval<typename OperandB::Scalar>());
+
+		return detail::make_expression<ResultScalar, OperandB::kColumns, OperandA::kRows, typename OperandA::TargetSpace, typename OperandB::SourceSpace> (
+			[ea = detail::to_product_operand (std::forward<A> (a)), eb = detail::to_product_operand (std::forward<B> (b))] (std::size_t const r, ResultScalar* const output) {
+				auto const& ma = detail::leaf_matrix (ea);
+				auto const& mb = detail::leaf_matrix (eb);
+
+				// Accumulate in a local array, output might alias the operands as far as the compiler knows:
+				std::array<ResultScalar, OperandB::kColumns> row;
+
+				for (std::size_t c = 0; c < OperandB::kColumns; ++c)
+					row[c] = ma[0, r] * mb[c, 0];
+
+				for (std::size_t i = 1; i < OperandA::kColumns; ++i)
+					for (std::size_t c = 0; c < OperandB::kColumns; ++c)
+						row[c] += ma[i, r] * mb[c, i];
+
+				for (std::size_t c = 0; c < OperandB::kColumns; ++c)
+					output[c] = row[c];
+			}
+		);
+	}
+
+
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, class Node, Scalar ScalarB>
+	[[nodiscard]]
+	constexpr auto
+	operator* (MatrixExpression<S, Columns, Rows, TargetSpace, SourceSpace, Node> const& a, ScalarB const& scalar)
+	{
+		using ResultScalar = decltype (std::declval<S>() * std::declval<ScalarB>());
+
+		return detail::make_expression<ResultScalar, Columns, Rows, TargetSpace, SourceSpace> ([a, scalar] (std::size_t const r, ResultScalar* const output) {
+			auto const row = a.row (r);
+
+			for (std::size_t c = 0; c < Columns; ++c)
+				output[c] = row[c] * scalar;
+		});
+	}
+
+
+template<Scalar ScalarA, Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, class Node>
+	[[nodiscard]]
+	constexpr auto
+	operator* (ScalarA const& scalar, MatrixExpression<S, Columns, Rows, TargetSpace, SourceSpace, Node> const& a)
+	{
+		return a * scalar;
+	}
+
+
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, class Node, Scalar ScalarB>
+	[[nodiscard]]
+	constexpr auto
+	operator/ (MatrixExpression<S, Columns, Rows, TargetSpace, SourceSpace, Node> const& a, ScalarB const& scalar)
+	{
+		using ResultScalar = decltype (std::declval<S>() / std::declval<ScalarB>());
+
+		return detail::make_expression<ResultScalar, Columns, Rows, TargetSpace, SourceSpace> ([a, scalar] (std::size_t const r, ResultScalar* const output) {
+			auto const row = a.row (r);
+
+			for (std::size_t c = 0; c < Columns; ++c)
+				output[c] = row[c] / scalar;
+		});
+	}
+
+} // namespace neutrino::math
+
+#endif
@@ -15,6 +15,7 @@
 #define NEUTRINO__MATH__MATRIX_OPERATIONS_H__INCLUDED
 
 // Local:
+#include "matrix_simd.h"
 #include "traits.h"
 
 // Neutrino:
@@ -30,18 +31,19 @@
 namespace neutrino::math {
 
 template<class Test,
-		 template<class, std::size_t, std::size_t, class, class> class Ref>
+		 template<class, std::size_t, std::size_t, class, class, StorageOrder> class Ref>
 	struct is_matrix: public std::false_type
 	{ };
 
 
-template<template<class, std::size_t, std::size_t, class, class> class Ref,
+template<template<class, std::size_t, std::size_t, class, class, StorageOrder> class Ref,
 		 Scalar S,
 		 std::size_t Columns,
 		 std::size_t Rows,
 		 CoordinateSystem TargetSpace,
-		 CoordinateSystem SourceSpace>
-	struct is_matrix<Ref<S, Columns, Rows, TargetSpace, SourceSpace>, Ref>: public std::true_type
+		 CoordinateSystem SourceSpace,
+		 StorageOrder Order>
+	struct is_matrix<Ref<S, Columns, Rows, TargetSpace, SourceSpace, Order>, Ref>: public std::true_type
 	{ };
 
 
@@ -64,6 +66,15 @@ template<
 
 		auto result = Matrix<ResultScalar, BColumns, ARows, TargetSpace, SourceSpace> (uninitialized);
 
+		if constexpr (simd::kHasProductKernel<ScalarA, ScalarB, ARows, Common, BColumns>)
+		{
+			if !consteval
+			{
+				simd::product<ResultScalar, ARows, Common, BColumns> (a.components().data(), b.components().data(), result.components().data());
+				return result;
+			}
+		}
+
 		for (std::size_t r = 0; r < ARows; ++r)
 		{
 			for (std::size_t c = 0; c < BColumns; ++c)
@@ -81,13 +92,91 @@ template<
 	}
 
 
-template<Scalar ScalarA, Scalar ScalarB, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+/**
+ * Product of matrices where at least one of them is stored column-major. The result uses storage order of the first
+ * matrix (vectors are always row-major, their layout is the same anyway). Inner loops walk contiguous memory.
+ */
+template<
+	Scalar ScalarA,
+	Scalar ScalarB,
+	std::size_t ARows,
+	std::size_t Common,
+	std::size_t BColumns,
+	CoordinateSystem TargetSpace,
+	CoordinateSystem IntermediateSpace,
+	CoordinateSystem SourceSpace,
+	StorageOrder OrderA,
+	StorageOrder OrderB
+>
+	requires (OrderA == StorageOrder::ColumnMajor || OrderB == StorageOrder::ColumnMajor)
 	[[nodiscard]]
 	constexpr auto
-	operator* (Matrix<ScalarA, Columns, Rows, TargetSpace, SourceSpace> matrix,
+	operator* (Matrix<ScalarA, Common, ARows, TargetSpace, IntermediateSpace, OrderA> const& a,
+			   Matrix<ScalarB, BColumns, Common, IntermediateSpace, SourceSpace, OrderB> const& b)
+	{
+		if constexpr (OrderA == StorageOrder::RowMajor)
+		{
+			// Rows of A and columns of B are both contiguous here, but dot products are serial chains of additions
+			// that don't vectorize. Rearranging B for the row-major kernel is cheaper:
+			return a * storage_order_cast<StorageOrder::RowMajor> (b);
+		}
+		else
+		{
+			using ResultScalar = decltype (ScalarA{} * ScalarB{});
+
+			constexpr auto kResultOrder = (ARows == 1 || BColumns == 1) ? StorageOrder::RowMajor : OrderA;
+			auto result = Matrix<ResultScalar, BColumns, ARows, TargetSpace, SourceSpace, kResultOrder> (uninitialized);
+
+			// Column-major components of a matrix are row-major components of its transposition
+			// and (A × B)ᵀ = Bᵀ × Aᵀ, so use the row-major SIMD kernel with swapped operands:
+			if constexpr (OrderB == StorageOrder::ColumnMajor && kResultOrder == StorageOrder::ColumnMajor &&
+						  simd::kHasProductKernel<ScalarB, ScalarA, BColumns, Common, ARows>)
+			{
+				if !consteval
+				{
+					simd::product<ResultScalar, BColumns, Common, ARows> (b.components().data(), a.components().data(), result.components().data());
+					return result;
+				}
+			}
+
+			// Each column of the result is a linear combination of contiguous columns of A:
+			for (std::size_t c = 0; c < BColumns; ++c)
+			{
+				for (std::size_t r = 0; r < ARows; ++r)
+					result[c, r] = ResultScalar{};
+
+				for (std::size_t i = 0; i < Common; ++i)
+				{
+					auto const factor = b[c, i];
+
+					for (std::size_t r = 0; r < ARows; ++r)
+						result[c, r] += a[i, r] * factor;
+				}
+			}
+
+			return result;
+		}
+	}
+
+
+template<Scalar ScalarA, Scalar ScalarB, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
+	[[nodiscard]]
+	constexpr auto
+	operator* (Matrix<ScalarA, Columns, Rows, TargetSpace, SourceSpace, Order> const& matrix,
 			   ScalarB const& scalar)
 	{
-		auto result = Matrix<decltype (ScalarA{} * ScalarB{}), Columns, Rows, TargetSpace, SourceSpace> (uninitialized);
+		using ResultScalar = decltype (ScalarA{} * ScalarB{});
+
+		auto result = Matrix<ResultScalar, Columns, Rows, TargetSpace, SourceSpace, Order> (uninitialized);
+
+		if constexpr (std::is_same_v<ResultScalar, ScalarA> && std::is_arithmetic_v<ScalarB> && simd::kHasElementwiseKernel<ScalarA, Columns * Rows>)
+		{
+			if !consteval
+			{
+				simd::scale<ScalarA, Columns * Rows> (matrix.components().data(), static_cast<ScalarA> (scalar), result.components().data());
+				return result;
+			}
+		}
 
 		for (std::size_t i = 0; i < Columns * Rows; ++i)
 			result.components()[i] = matrix.components()[i] * scalar;
@@ -96,23 +185,23 @@ template<Scalar ScalarA, Scalar ScalarB, std::size_t Columns, std::size_t Rows,
 	}
 
 
-template<Scalar ScalarA, Scalar ScalarB, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar ScalarA, Scalar ScalarB, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto
 	operator* (ScalarA const& scalar,
-			   Matrix<ScalarB, Columns, Rows, TargetSpace, SourceSpace> const& matrix)
+			   Matrix<ScalarB, Columns, Rows, TargetSpace, SourceSpace, Order> const& matrix)
 	{
 		return matrix * scalar;
 	}
 
 
-template<Scalar ScalarA, Scalar ScalarB, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar ScalarA, Scalar ScalarB, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto
-	operator/ (Matrix<ScalarA, Columns, Rows, TargetSpace, SourceSpace> matrix,
+	operator/ (Matrix<ScalarA, Columns, Rows, TargetSpace, SourceSpace, Order> matrix,
 			   ScalarB const& scalar)
 	{
-		auto result = Matrix<decltype (ScalarA{} / ScalarB{}), Columns, Rows, TargetSpace, SourceSpace> (uninitialized);
+		auto result = Matrix<decltype (ScalarA{} / ScalarB{}), Columns, Rows, TargetSpace, SourceSpace, Order> (uninitialized);
 		auto const& src_data = matrix.components();
 		auto& dst_data = result.components();
 
@@ -123,30 +212,43 @@ template<Scalar ScalarA, Scalar ScalarB, std::size_t Columns, std::size_t Rows,
 	}
 
 
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
-	constexpr Matrix<S, Columns, Rows, TargetSpace, SourceSpace>
-	operator+ (Matrix<S, Columns, Rows, TargetSpace, SourceSpace> m) noexcept
+	constexpr Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order>
+	operator+ (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> m) noexcept
 	{
 		return m;
 	}
 
 
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto
-	operator+ (Matrix<S, Columns, Rows, TargetSpace, SourceSpace> a,
-			   Matrix<S, Columns, Rows, TargetSpace, SourceSpace> const& b)
-		noexcept (noexcept (a += b))
+	operator+ (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> const& a,
+			   Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> const& b)
+		noexcept (noexcept (S{} + S{}))
 	{
-		return a += b;
+		auto result = Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> (uninitialized);
+
+		if constexpr (simd::kHasElementwiseKernel<S, Columns * Rows>)
+		{
+			if !consteval
+			{
+				simd::add<S, Columns * Rows> (a.components().data(), b.components().data(), result.components().data());
+				return result;
+			}
+		}
+
+		result = a;
+		result += b;
+		return result;
 	}
 
 
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto
-	operator- (Matrix<S, Columns, Rows, TargetSpace, SourceSpace> m)
+	operator- (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> m)
 		noexcept (noexcept (m[0, 0] = -m[0, 0]))
 	{
 		for (std::size_t r = 0; r < Rows; ++r)
@@ -157,14 +259,27 @@ template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem Targe
 	}
 
 
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto
-	operator- (Matrix<S, Columns, Rows, TargetSpace, SourceSpace> a,
-			   Matrix<S, Columns, Rows, TargetSpace, SourceSpace> const& b)
-		noexcept (noexcept (a -= b))
+	operator- (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> const& a,
+			   Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> const& b)
+		noexcept (noexcept (S{} - S{}))
 	{
-		return a -= b;
+		auto result = Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> (uninitialized);
+
+		if constexpr (simd::kHasElementwiseKernel<S, Columns * Rows>)
+		{
+			if !consteval
+			{
+				simd::subtract<S, Columns * Rows> (a.components().data(), b.components().data(), result.components().data());
+				return result;
+			}
+		}
+
+		result = a;
+		result -= b;
+		return result;
 	}
 
 
@@ -199,14 +314,14 @@ template<class ScalarA, class ScalarB, std::size_t Size, CoordinateSystem Target
 /**
  * Return Hadamard product of two vectors.
  */
-template<class ScalarA, class ScalarB, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<class ScalarA, class ScalarB, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto
-	hadamard_product (Matrix<ScalarA, Columns, Rows, TargetSpace, SourceSpace> const& a,
-					  Matrix<ScalarB, Columns, Rows, TargetSpace, SourceSpace> const& b)
+	hadamard_product (Matrix<ScalarA, Columns, Rows, TargetSpace, SourceSpace, Order> const& a,
+					  Matrix<ScalarB, Columns, Rows, TargetSpace, SourceSpace, Order> const& b)
 		noexcept (noexcept (ScalarA{} * ScalarB{}))
 	{
-		Matrix<decltype (ScalarA{} * ScalarB{}), Columns, Rows, TargetSpace, SourceSpace> result;
+		Matrix<decltype (ScalarA{} * ScalarB{}), Columns, Rows, TargetSpace, SourceSpace, Order> result;
 
 		for (std::size_t r = 0; r < Rows; ++r)
 			for (std::size_t c = 0; c < Columns; ++c)
@@ -249,10 +364,10 @@ template<Scalar S, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSys
 /**
  * Return Euclidean norm for a matrix.
  */
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr S
-	euclidean_norm (Matrix<S, Columns, Rows, TargetSpace, SourceSpace> const& m)
+	euclidean_norm (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> const& m)
 	{
 		using SquareScalar = decltype (S{} * S{});
 		SquareScalar norm (0);
@@ -270,10 +385,10 @@ template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem Targe
 /**
  * Return inverted matrix.
  */
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto
-	inv (Matrix<S, Columns, Rows, TargetSpace, SourceSpace> const& matrix)
+	inv (Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> const& matrix)
 	{
 		return matrix.inverted();
 	}
@@ -299,10 +414,10 @@ template<Scalar S, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSys
 /**
  * Traits for Matrix<>
  */
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
-	struct Traits<Matrix<S, Columns, Rows, TargetSpace, SourceSpace>>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
+	struct Traits<Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order>>
 	{
-		typedef Matrix<S, Columns, Rows, TargetSpace, SourceSpace> Value;
+		typedef Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order> Value;
 
 		static consteval Value
 		zero();
@@ -315,30 +430,30 @@ template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem Targe
 	};
 
 
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	consteval auto
-	Traits<Matrix<S, Columns, Rows, TargetSpace, SourceSpace>>::zero()
+	Traits<Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order>>::zero()
 		-> Value
 	{
 		return math::zero;
 	}
 
 
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	consteval auto
-	Traits<Matrix<S, Columns, Rows, TargetSpace, SourceSpace>>::unit()
+	Traits<Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order>>::unit()
 		-> Value
 	{
 		return math::unit;
 	}
 
 
-template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, StorageOrder Order>
 	[[nodiscard]]
 	constexpr auto
-	Traits<Matrix<S, Columns, Rows, TargetSpace, SourceSpace>>::inverted (Value const& v)
+	Traits<Matrix<S, Columns, Rows, TargetSpace, SourceSpace, Order>>::inverted (Value const& v)
 		-> Value
 	{
 		return v.inverted();
@@ -353,27 +468,27 @@ template<Scalar S, std::size_t Columns, std::size_t Rows, CoordinateSystem Targe
 
 
 // Column-vectors:
-template<neutrino::math::Scalar S, std::size_t N, neutrino::math::CoordinateSystem TS, neutrino::math::CoordinateSystem SS>
-	struct std::tuple_size<neutrino::math::Matrix<S, 1, N, TS, SS>>: std::integral_constant<std::size_t, N>
+template<neutrino::math::Scalar S, std::size_t N, neutrino::math::CoordinateSystem TS, neutrino::math::CoordinateSystem SS, neutrino::math::StorageOrder O>
+	struct std::tuple_size<neutrino::math::Matrix<S, 1, N, TS, SS, O>>: std::integral_constant<std::size_t, N>
 	{ };
 
 
 // Row-vectors:
-template<neutrino::math::Scalar S, std::size_t N, neutrino::math::CoordinateSystem TS, neutrino::math::CoordinateSystem SS>
-	struct std::tuple_size<neutrino::math::Matrix<S, N, 1, TS, SS>>: std::integral_constant<std::size_t, N>
+template<neutrino::math::Scalar S, std::size_t N, neutrino::math::CoordinateSystem TS, neutrino::math::CoordinateSystem SS, neutrino::math::StorageOrder O>
+	struct std::tuple_size<neutrino::math::Matrix<S, N, 1, TS, SS, O>>: std::integral_constant<std::size_t, N>
 	{ };
 
 
 // Column-vectors:
-template<neutrino::math::Scalar S, std::size_t N, neutrino::math::CoordinateSystem TS, neutrino::math::CoordinateSystem SS, std::size_t I>
-	struct std::tuple_element<I, neutrino::math::Matrix<S, 1, N, TS, SS>>
+template<neutrino::math::Scalar S, std::size_t N, neutrino::math::CoordinateSystem TS, neutrino::math::CoordinateSystem SS, neutrino::math::StorageOrder O, std::size_t I>
+	struct std::tuple_element<I, neutrino::math::Matrix<S, 1, N, TS, SS, O>>
 	{
 		using type = S;
 	};
 
 // Row-vectors:
-template<neutrino::math::Scalar S, std::size_t N, neutrino::math::CoordinateSystem TS, neutrino::math::CoordinateSystem SS, std::size_t I>
-	struct std::tuple_element<I, neutrino::math::Matrix<S, N, 1, TS, SS>>
+template<neutrino::math::Scalar S, std::size_t N, neutrino::math::CoordinateSystem TS, neutrino::math::CoordinateSystem SS, neutrino::math::StorageOrder O, std::size_t I>
+	struct std::tuple_element<I, neutrino::math::Matrix<S, N, 1, TS, SS, O>>
 	{
 		using type = S;
 	};
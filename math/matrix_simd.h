@@ -0,0 +1,403 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__MATRIX_SIMD_H__INCLUDED
+#define NEUTRINO__MATH__MATRIX_SIMD_H__INCLUDED
+
+// Standard:
+#include <cstddef>
+#include <type_traits>
+
+// System:
+#if defined (__SSE2__) || defined (__AVX__)
+#include <immintrin.h>
+#endif
+
+
+/**
+ * SIMD kernels for fixed-size matrices of float/double stored row-major as contiguous arrays.
+ *
+ * Kernels are selected at compile time from the Scalar type, dimensions and instruction sets enabled for
+ * the compiler (__SSE2__, __SSE3__, __AVX__). When no kernel is available, the kHas…Kernel constants are false and
+ * callers use their generic code path. Matrix-matrix products accumulate terms in the same order as the generic
+ * code; matrix-vector products sum them pairwise, so results may differ from the generic path in the last bits.
+ */
+namespace neutrino::math::simd {
+
+template<class S>
+	constexpr bool kIsSimdScalar = std::is_same_v<S, float> || std::is_same_v<S, double>;
+
+
+/**
+ * True if there's a SIMD kernel for product of matrix [Common columns × ARows rows] and matrix
+ * [BColumns columns × Common rows]. Kernels exist for all 3×3, 3×4, 4×3 and 4×4 matrices multiplied by such matrices
+ * or by column vectors.
+ */
+template<class ScalarA, class ScalarB, std::size_t ARows, std::size_t Common, std::size_t BColumns>
+	constexpr bool kHasProductKernel =
+		std::is_same_v<ScalarA, ScalarB> &&
+		kIsSimdScalar<ScalarA> &&
+		(ARows == 3 || ARows == 4) &&
+		(Common == 3 || Common == 4) &&
+		(BColumns == 3 || BColumns == 4 || BColumns == 1) &&
+#if defined (__AVX__)
+		true;
+#elif defined (__SSE3__)
+		// Without AVX only float kernels that don't load or store 3-sized rows are available (no masked loads):
+		std::is_same_v<ScalarA, float> && (BColumns == 4 || (BColumns == 1 && Common == 4 && ARows == 4));
+#else
+		false;
+#endif
+
+
+/**
+ * True if there're SIMD kernels for element-wise operations (add(), subtract(), scale()) on arrays of
+ * given size.
+ */
+template<class S, std::size_t Size>
+	constexpr bool kHasElementwiseKernel =
+#if defined (__SSE2__) || defined (__AVX__)
+		kIsSimdScalar<S> && Size >= 2;
+#else
+		false;
+#endif
+
+
+/**
+ * Generic matrix product, used by kernels as a fallback and as a reference in benchmarks.
+ * All matrices are row-major; a is [Common × ARows], b is [BColumns × Common], result is [BColumns × ARows].
+ */
+template<class S, std::size_t ARows, std::size_t Common, std::size_t BColumns>
+	inline void
+	product_generic (S const* a, S const* b, S* result) noexcept
+	{
+		for (std::size_t r = 0; r < ARows; ++r)
+		{
+			for (std::size_t c = 0; c < BColumns; ++c)
+			{
+				S scalar {};
+
+				for (std::size_t i = 0; i < Common; ++i)
+					scalar += a[r * Common + i] * b[i * BColumns + c];
+
+				result[r * BColumns + c] = scalar;
+			}
+		}
+	}
+
+
+namespace detail {
+
+#if defined (__AVX__)
+
+inline __m256i
+avx_mask_3_doubles() noexcept
+{
+	return _mm256_set_epi64x (0, -1, -1, -1);
+}
+
+
+inline __m128i
+sse_mask_3_floats() noexcept
+{
+	return _mm_set_epi32 (0, -1, -1, -1);
+}
+
+
+/**
+ * Load a row of 3 or 4 doubles. Missing 4th element is zero.
+ */
+template<std::size_t Size>
+	inline __m256d
+	load_doubles (double const* data) noexcept
+	{
+		if constexpr (Size == 4)
+			return _mm256_loadu_pd (data);
+		else
+			return _mm256_maskload_pd (data, avx_mask_3_doubles());
+	}
+
+
+/**
+ * Store a row of 3 or 4 doubles.
+ */
+template<std::size_t Size>
+	inline void
+	store_doubles (double* data, __m256d const value) noexcept
+	{
+		if constexpr (Size == 4)
+			_mm256_storeu_pd (data, value);
+		else
+			_mm256_maskstore_pd (data, avx_mask_3_doubles(), value);
+	}
+
+
+/**
+ * Return horizontal sums of 4 vectors of doubles as a single vector.
+ */
+inline __m256d
+horizontal_sums (__m256d const p0, __m256d const p1, __m256d const p2, __m256d const p3) noexcept
+{
+	auto const t0 = _mm256_hadd_pd (p0, p1);
+	auto const t1 = _mm256_hadd_pd (p2, p3);
+	auto const swapped = _mm256_permute2f128_pd (t0, t1, 0x21);
+	auto const blended = _mm256_blend_pd (t0, t1, 0b1100);
+	return _mm256_add_pd (swapped, blended);
+}
+
+#endif
+
+
+#if defined (__SSE3__)
+
+/**
+ * Return horizontal sums of 4 vectors of floats as a single vector.
+ */
+inline __m128
+horizontal_sums (__m128 const p0, __m128 const p1, __m128 const p2, __m128 const p3) noexcept
+{
+	return _mm_hadd_ps (_mm_hadd_ps (p0, p1), _mm_hadd_ps (p2, p3));
+}
+
+
+/**
+ * Load a row of 3 or 4 floats. Missing 4th element is zero. 3-sized rows need AVX.
+ */
+template<std::size_t Size>
+	inline __m128
+	load_floats (float const* data) noexcept
+	{
+#if defined (__AVX__)
+		if constexpr (Size == 3)
+			return _mm_maskload_ps (data, sse_mask_3_floats());
+		else
+#endif
+			return _mm_loadu_ps (data);
+	}
+
+
+/**
+ * Store a row of 3 or 4 floats. 3-sized rows need AVX.
+ */
+template<std::size_t Size>
+	inline void
+	store_floats (float* data, __m128 const value) noexcept
+	{
+#if defined (__AVX__)
+		if constexpr (Size == 3)
+			_mm_maskstore_ps (data, sse_mask_3_floats(), value);
+		else
+#endif
+			_mm_storeu_ps (data, value);
+	}
+
+#endif
+
+} // namespace detail
+
+
+/**
+ * Compute matrix product with a SIMD kernel. See kHasProductKernel.
+ */
+template<class S, std::size_t ARows, std::size_t Common, std::size_t BColumns>
+	inline void
+	product (S const* a, S const* b, S* result) noexcept
+	{
+		static_assert (kHasProductKernel<S, S, ARows, Common, BColumns>, "no SIMD kernel for this product");
+
+		if constexpr (BColumns != 1)
+		{
+			// Each result row is a linear combination of rows of b:
+			if constexpr (std::is_same_v<S, double>)
+			{
+#if defined (__AVX__)
+				__m256d b_rows[Common];
+
+				for (std::size_t i = 0; i < Common; ++i)
+					b_rows[i] = detail::load_doubles<BColumns> (b + BColumns * i);
+
+				for (std::size_t r = 0; r < ARows; ++r)
+				{
+					auto const* row = a + Common * r;
+					auto sum = _mm256_mul_pd (_mm256_broadcast_sd (row + 0), b_rows[0]);
+
+					for (std::size_t i = 1; i < Common; ++i)
+						sum = _mm256_add_pd (sum, _mm256_mul_pd (_mm256_broadcast_sd (row + i), b_rows[i]));
+
+					detail::store_doubles<BColumns> (result + BColumns * r, sum);
+				}
+#endif
+			}
+			else
+			{
+#if defined (__SSE3__)
+				__m128 b_rows[Common];
+
+				for (std::size_t i = 0; i < Common; ++i)
+					b_rows[i] = detail::load_floats<BColumns> (b + BColumns * i);
+
+				for (std::size_t r = 0; r < ARows; ++r)
+				{
+					auto const* row = a + Common * r;
+					auto sum = _mm_mul_ps (_mm_set1_ps (row[0]), b_rows[0]);
+
+					for (std::size_t i = 1; i < Common; ++i)
+						sum = _mm_add_ps (sum, _mm_mul_ps (_mm_set1_ps (row[i]), b_rows[i]));
+
+					detail::store_floats<BColumns> (result + BColumns * r, sum);
+				}
+#endif
+			}
+		}
+		else
+		{
+			// Dot products of rows of a with the vector, summed pairwise; rows missing in 3-row matrices are zero:
+			if constexpr (std::is_same_v<S, double>)
+			{
+#if defined (__AVX__)
+				auto const v = detail::load_doubles<Common> (b);
+				__m256d products[4] { _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd() };
+
+				for (std::size_t r = 0; r < ARows; ++r)
+					products[r] = _mm256_mul_pd (detail::load_doubles<Common> (a + Common * r), v);
+
+				detail::store_doubles<ARows> (result, detail::horizontal_sums (products[0], products[1], products[2], products[3]));
+#endif
+			}
+			else
+			{
+#if defined (__SSE3__)
+				auto const v = detail::load_floats<Common> (b);
+				__m128 products[4] { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+
+				for (std::size_t r = 0; r < ARows; ++r)
+					products[r] = _mm_mul_ps (detail::load_floats<Common> (a + Common * r), v);
+
+				detail::store_floats<ARows> (result, detail::horizontal_sums (products[0], products[1], products[2], products[3]));
+#endif
+			}
+		}
+	}
+
+
+/**
+ * Compute result[i] = a[i] + b[i] for i in [0, Size).
+ */
+template<class S, std::size_t Size>
+	inline void
+	add (S const* a, S const* b, S* result) noexcept
+	{
+		std::size_t i = 0;
+
+#if defined (__AVX__)
+		if constexpr (std::is_same_v<S, double>)
+			for (; i + 4 <= Size; i += 4)
+				_mm256_storeu_pd (result + i, _mm256_add_pd (_mm256_loadu_pd (a + i), _mm256_loadu_pd (b + i)));
+		else
+			for (; i + 8 <= Size; i += 8)
+				_mm256_storeu_ps (result + i, _mm256_add_ps (_mm256_loadu_ps (a + i), _mm256_loadu_ps (b + i)));
+#endif
+#if defined (__SSE2__)
+		if constexpr (std::is_same_v<S, double>)
+			for (; i + 2 <= Size; i += 2)
+				_mm_storeu_pd (result + i, _mm_add_pd (_mm_loadu_pd (a + i), _mm_loadu_pd (b + i)));
+		else
+			for (; i + 4 <= Size; i += 4)
+				_mm_storeu_ps (result + i, _mm_add_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+#endif
+
+		for (; i < Size; ++i)
+			result[i] = a[i] + b[i];
+	}
+
+
+/**
+ * Compute result[i] = a[i] - b[i] for i in [0, Size).
+ */
+template<class S, std::size_t Size>
+	inline void
+	subtract (S const* a, S const* b, S* result) noexcept
+	{
+		std::size_t i = 0;
+
+#if defined (__AVX__)
+		if constexpr (std::is_same_v<S, double>)
+			for (; i + 4 <= Size; i += 4)
+				_mm256_storeu_pd (result + i, _mm256_sub_pd (_mm256_loadu_pd (a + i), _mm256_loadu_pd (b + i)));
+		else
+			for (; i + 8 <= Size; i += 8)
+				_mm256_storeu_ps (result + i, _mm256_sub_ps (_mm256_loadu_ps (a + i), _mm256_loadu_ps (b + i)));
+#endif
+#if defined (__SSE2__)
+		if constexpr (std::is_same_v<S, double>)
+			for (; i + 2 <= Size; i += 2)
+				_mm_storeu_pd (result + i, _mm_sub_pd (_mm_loadu_pd (a + i), _mm_loadu_pd (b + i)));
+		else
+			for (; i + 4 <= Size; i += 4)
+				_mm_storeu_ps (result + i, _mm_sub_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+#endif
+
+		for (; i < Size; ++i)
+			result[i] = a[i] - b[i];
+	}
+
+
+/**
+ * Compute result[i] = a[i] * scalar for i in [0, Size).
+ */
+template<class S, std::size_t Size>
+	inline void
+	scale (S const* a, S const scalar, S* result) noexcept
+	{
+		std::size_t i = 0;
+
+#if defined (__AVX__)
+		if constexpr (std::is_same_v<S, double>)
+		{
+			auto const s = _mm256_set1_pd (scalar);
+
+			for (; i + 4 <= Size; i += 4)
+				_mm256_storeu_pd (result + i, _mm256_mul_pd (_mm256_loadu_pd (a + i), s));
+		}
+		else
+		{
+			auto const s = _mm256_set1_ps (scalar);
+
+			for (; i + 8 <= Size; i += 8)
+				_mm256_storeu_ps (result + i, _mm256_mul_ps (_mm256_loadu_ps (a + i), s));
+		}
+#endif
+#if defined (__SSE2__)
+		if constexpr (std::is_same_v<S, double>)
+		{
+			auto const s = _mm_set1_pd (scalar);
+
+			for (; i + 2 <= Size; i += 2)
+				_mm_storeu_pd (result + i, _mm_mul_pd (_mm_loadu_pd (a + i), s));
+		}
+		else
+		{
+			auto const s = _mm_set1_ps (scalar);
+
+			for (; i + 4 <= Size; i += 4)
+				_mm_storeu_ps (result + i, _mm_mul_ps (_mm_loadu_ps (a + i), s));
+		}
+#endif
+
+		for (; i < Size; ++i)
+			result[i] = a[i] * scalar;
+	}
+
+} // namespace neutrino::math::simd
+
+#endif
@@ -0,0 +1,704 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__QUATERNION_BATCH_H__INCLUDED
+#define NEUTRINO__MATH__QUATERNION_BATCH_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/math/concepts.h>
+#include <neutrino/math/quaternion.h>
+#include <neutrino/math/simd_pack.h>
+#include <neutrino/math/vector_batch.h>
+
+// Boost:
+#include <boost/align/aligned_allocator.hpp>
+
+// Standard:
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace neutrino::math {
+
+/**
+ * Batch of quaternions stored as structure-of-arrays: components w, x, y and z of all quaternions are kept in their
+ * own contiguous, cache-line aligned arrays. Use it with multiply(), conjugate(), rotate(),
+ * integrate_angular_velocity(), nlerp(), slerp(), normalize() and fast_renormalize() to process large numbers
+ * of quaternions with SIMD instructions.
+ *
+ * Template parameters have the same meaning as in Quaternion<>.
+ */
+template<std::floating_point pScalar, CoordinateSystem pTargetSpace = void, CoordinateSystem pSourceSpace = pTargetSpace, bool pIsRotationQuaternion = false>
+	class QuaternionBatch
+	{
+	  public:
+		static constexpr std::size_t kAlignment			= 64;
+		static constexpr bool kIsRotationQuaternion	= pIsRotationQuaternion;
+
+		using Scalar			= pScalar;
+		using TargetSpace		= pTargetSpace;
+		using SourceSpace		= pSourceSpace;
+		using Quaternion		= math::Quaternion<Scalar, TargetSpace, SourceSpace, kIsRotationQuaternion>;
+		using ComponentArray	= std::vector<Scalar, boost::alignment::aligned_allocator<Scalar, kAlignment>>;
+
+	  public:
+		// Ctor. Creates empty batch.
+		QuaternionBatch() = default;
+
+		// Ctor. Creates batch of given number of identity quaternions.
+		explicit
+		QuaternionBatch (std::size_t size);
+
+		// Ctor. Copies quaternions into the batch.
+		explicit
+		QuaternionBatch (std::span<Quaternion const> quaternions);
+
+		/**
+		 * Return number of quaternions in the batch.
+		 */
+		[[nodiscard]]
+		std::size_t
+		size() const noexcept
+			{ return _components[0].size(); }
+
+		[[nodiscard]]
+		bool
+		empty() const noexcept
+			{ return _components[0].empty(); }
+
+		void
+		reserve (std::size_t capacity);
+
+		/**
+		 * Resize the batch; new quaternions are identity quaternions.
+		 */
+		void
+		resize (std::size_t size);
+
+		void
+		clear() noexcept;
+
+		void
+		push_back (Quaternion const&);
+
+		/**
+		 * Return copy of the quaternion at given index.
+		 */
+		[[nodiscard]]
+		Quaternion
+		operator[] (std::size_t index) const noexcept;
+
+		/**
+		 * Replace quaternion at given index.
+		 */
+		void
+		set (std::size_t index, Quaternion const&) noexcept;
+
+		/**
+		 * Return array of given component of all quaternions: 0 is w, 1 is x, 2 is y, 3 is z.
+		 */
+		[[nodiscard]]
+		std::span<Scalar>
+		component (std::size_t index) noexcept
+			{ return _components[index]; }
+
+		/**
+		 * Return array of given component of all quaternions: 0 is w, 1 is x, 2 is y, 3 is z.
+		 */
+		[[nodiscard]]
+		std::span<Scalar const>
+		component (std::size_t index) const noexcept
+			{ return _components[index]; }
+
+		/**
+		 * Return quaternions as an array of Quaternion objects.
+		 */
+		[[nodiscard]]
+		std::vector<Quaternion>
+		to_quaternions() const;
+
+	  private:
+		std::array<ComponentArray, 4> _components;
+	};
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline
+	QuaternionBatch<S, TS, SS, R>::QuaternionBatch (std::size_t const size)
+	{
+		resize (size);
+	}
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline
+	QuaternionBatch<S, TS, SS, R>::QuaternionBatch (std::span<Quaternion const> const quaternions)
+	{
+		for (std::size_t c = 0; c < 4; ++c)
+		{
+			auto& component = _components[c];
+			component.resize (quaternions.size());
+
+			for (std::size_t i = 0; i < quaternions.size(); ++i)
+				component[i] = quaternions[i].components()[c];
+		}
+	}
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline void
+	QuaternionBatch<S, TS, SS, R>::reserve (std::size_t const capacity)
+	{
+		for (auto& component: _components)
+			component.reserve (capacity);
+	}
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline void
+	QuaternionBatch<S, TS, SS, R>::resize (std::size_t const size)
+	{
+		_components[0].resize (size, Scalar (1));
+
+		for (std::size_t c = 1; c < 4; ++c)
+			_components[c].resize (size, Scalar (0));
+	}
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline void
+	QuaternionBatch<S, TS, SS, R>::clear() noexcept
+	{
+		for (auto& component: _components)
+			component.clear();
+	}
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline void
+	QuaternionBatch<S, TS, SS, R>::push_back (Quaternion const& quaternion)
+	{
+		for (std::size_t c = 0; c < 4; ++c)
+			_components[c].push_back (quaternion.components()[c]);
+	}
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline auto
+	QuaternionBatch<S, TS, SS, R>::operator[] (std::size_t const index) const noexcept -> Quaternion
+	{
+		return Quaternion (_components[0][index], _components[1][index], _components[2][index], _components[3][index]);
+	}
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline void
+	QuaternionBatch<S, TS, SS, R>::set (std::size_t const index, Quaternion const& quaternion) noexcept
+	{
+		for (std::size_t c = 0; c < 4; ++c)
+			_components[c][index] = quaternion.components()[c];
+	}
+
+
+template<std::floating_point S, CoordinateSystem TS, CoordinateSystem SS, bool R>
+	inline auto
+	QuaternionBatch<S, TS, SS, R>::to_quaternions() const -> std::vector<Quaternion>
+	{
+		std::vector<Quaternion> result;
+		result.reserve (size());
+
+		for (std::size_t i = 0; i < size(); ++i)
+			result.push_back ((*this)[i]);
+
+		return result;
+	}
+
+
+namespace detail {
+
+inline void
+check_quaternion_batch_sizes (std::size_t const a, std::size_t const b)
+{
+	if (a != b)
+		throw std::length_error ("quaternion batches have different sizes");
+}
+
+
+template<class V, class Batch>
+	inline std::array<V, 4>
+	load_quaternions (Batch const& batch, std::size_t const i) noexcept
+	{
+		return {
+			simd::load<V> (batch.component (0).data() + i),
+			simd::load<V> (batch.component (1).data() + i),
+			simd::load<V> (batch.component (2).data() + i),
+			simd::load<V> (batch.component (3).data() + i),
+		};
+	}
+
+
+template<class V, class Batch>
+	inline void
+	store_quaternions (Batch& batch, std::size_t const i, std::array<V, 4> const& q) noexcept
+	{
+		for (std::size_t c = 0; c < 4; ++c)
+			simd::store (batch.component (c).data() + i, q[c]);
+	}
+
+
+/**
+ * Return Hamilton product a × b.
+ */
+template<class V>
+	inline std::array<V, 4>
+	hamilton_product (std::array<V, 4> const& a, std::array<V, 4> const& b) noexcept
+	{
+		auto const [w1, x1, y1, z1] = a;
+		auto const [w2, x2, y2, z2] = b;
+
+		return {
+			V (w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2),
+			V (w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2),
+			V (w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2),
+			V (w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2),
+		};
+	}
+
+
+} // namespace detail
+
+
+/**
+ * Compute result[i] = a[i] × b[i]. The result batch is resized as needed. It may be the same object as one of the inputs.
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem IntermediateSpace, CoordinateSystem SourceSpace, bool RA, bool RB>
+	inline void
+	multiply (QuaternionBatch<S, TargetSpace, IntermediateSpace, RA> const& a,
+			  QuaternionBatch<S, IntermediateSpace, SourceSpace, RB> const& b,
+			  QuaternionBatch<S, TargetSpace, SourceSpace, RA && RB>& result)
+	{
+		detail::check_quaternion_batch_sizes (a.size(), b.size());
+		result.resize (a.size());
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			// Load all inputs before storing anything, so that in-place operation works:
+			detail::store_quaternions (result, i, detail::hamilton_product (detail::load_quaternions<V> (a, i), detail::load_quaternions<V> (b, i)));
+		};
+
+		simd::for_each_pack<S> (a.size(), kernel);
+	}
+
+
+/**
+ * Compute result[i] = a × b[i], for example to change frame of reference of all quaternions in a batch.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem IntermediateSpace, CoordinateSystem SourceSpace, bool RA, bool RB>
+	inline void
+	multiply (Quaternion<S, TargetSpace, IntermediateSpace, RA> const& a,
+			  QuaternionBatch<S, IntermediateSpace, SourceSpace, RB> const& b,
+			  QuaternionBatch<S, TargetSpace, SourceSpace, RA && RB>& result)
+	{
+		result.resize (b.size());
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			auto const qa = std::array<V, 4> {
+				simd::broadcast<V> (a.w()),
+				simd::broadcast<V> (a.x()),
+				simd::broadcast<V> (a.y()),
+				simd::broadcast<V> (a.z()),
+			};
+
+			detail::store_quaternions (result, i, detail::hamilton_product (qa, detail::load_quaternions<V> (b, i)));
+		};
+
+		simd::for_each_pack<S> (b.size(), kernel);
+	}
+
+
+/**
+ * Return batch of a[i] × b[i].
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem IntermediateSpace, CoordinateSystem SourceSpace, bool RA, bool RB>
+	[[nodiscard]]
+	inline QuaternionBatch<S, TargetSpace, SourceSpace, RA && RB>
+	multiply (QuaternionBatch<S, TargetSpace, IntermediateSpace, RA> const& a,
+			  QuaternionBatch<S, IntermediateSpace, SourceSpace, RB> const& b)
+	{
+		QuaternionBatch<S, TargetSpace, SourceSpace, RA && RB> result;
+		multiply (a, b, result);
+		return result;
+	}
+
+
+/**
+ * Return batch of a × b[i].
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem IntermediateSpace, CoordinateSystem SourceSpace, bool RA, bool RB>
+	[[nodiscard]]
+	inline QuaternionBatch<S, TargetSpace, SourceSpace, RA && RB>
+	multiply (Quaternion<S, TargetSpace, IntermediateSpace, RA> const& a,
+			  QuaternionBatch<S, IntermediateSpace, SourceSpace, RB> const& b)
+	{
+		QuaternionBatch<S, TargetSpace, SourceSpace, RA && RB> result;
+		multiply (a, b, result);
+		return result;
+	}
+
+
+/**
+ * Conjugate all quaternions in the batch in place. Like Quaternion::conjugate(), requires TargetSpace and
+ * SourceSpace to be the same; use conjugated() otherwise.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	inline void
+	conjugate (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion>& batch)
+	{
+		static_assert (std::is_same_v<TargetSpace, SourceSpace>, "in-place conjugation requires same TargetSpace and SourceSpace");
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			for (std::size_t c = 1; c < 4; ++c)
+				simd::store (batch.component (c).data() + i, V (-simd::load<V> (batch.component (c).data() + i)));
+		};
+
+		simd::for_each_pack<S> (batch.size(), kernel);
+	}
+
+
+/**
+ * Return batch of conjugated quaternions.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	[[nodiscard]]
+	inline QuaternionBatch<S, SourceSpace, TargetSpace, IsRotationQuaternion>
+	conjugated (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& batch)
+	{
+		QuaternionBatch<S, SourceSpace, TargetSpace, IsRotationQuaternion> result (batch.size());
+		std::ranges::copy (batch.component (0), result.component (0).begin());
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			for (std::size_t c = 1; c < 4; ++c)
+				simd::store (result.component (c).data() + i, V (-simd::load<V> (batch.component (c).data() + i)));
+		};
+
+		simd::for_each_pack<S> (batch.size(), kernel);
+		return result;
+	}
+
+
+/**
+ * Compute result[i] = rotations[i] * vectors[i], that is rotate each vector by its own quaternion.
+ * Quaternions must be normalized. The result batch may be the same object as the input vector batch.
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point SQ, Scalar SV, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	inline void
+	rotate (QuaternionBatch<SQ, TargetSpace, SourceSpace, IsRotationQuaternion> const& rotations,
+			VectorBatch<SV, 3, SourceSpace, void> const& vectors,
+			VectorBatch<SV, 3, TargetSpace, void>& result)
+	{
+		detail::check_quaternion_batch_sizes (rotations.size(), vectors.size());
+		result.resize (vectors.size());
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			using VQ = std::conditional_t<std::is_same_v<V, SV>, SQ, V>;
+
+			auto const [w, qx, qy, qz] = detail::load_quaternions<VQ> (rotations, i);
+			auto const vx = simd::load<V> (vectors.component (0).data() + i);
+			auto const vy = simd::load<V> (vectors.component (1).data() + i);
+			auto const vz = simd::load<V> (vectors.component (2).data() + i);
+
+			// v' = v + w t + u × t, where u is the vector part of the quaternion and t = 2 u × v:
+			auto const two = simd::broadcast<VQ> (SQ (2));
+			auto const tx = two * (qy * vz - qz * vy);
+			auto const ty = two * (qz * vx - qx * vz);
+			auto const tz = two * (qx * vy - qy * vx);
+
+			simd::store (result.component (0).data() + i, V (vx + w * tx + (qy * tz - qz * ty)));
+			simd::store (result.component (1).data() + i, V (vy + w * ty + (qz * tx - qx * tz)));
+			simd::store (result.component (2).data() + i, V (vz + w * tz + (qx * ty - qy * tx)));
+		};
+
+		detail::for_each_batch_element<std::is_same_v<SQ, SV>, SV> (vectors.size(), kernel);
+	}
+
+
+/**
+ * Return batch of rotations[i] * vectors[i].
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point SQ, Scalar SV, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	[[nodiscard]]
+	inline VectorBatch<SV, 3, TargetSpace, void>
+	rotate (QuaternionBatch<SQ, TargetSpace, SourceSpace, IsRotationQuaternion> const& rotations,
+			VectorBatch<SV, 3, SourceSpace, void> const& vectors)
+	{
+		VectorBatch<SV, 3, TargetSpace, void> result;
+		rotate (rotations, vectors, result);
+		return result;
+	}
+
+
+/**
+ * Advance orientations by angular velocities over time dt: q[i] = q[i] × exp (½ ω[i] dt). Angular velocities are
+ * expressed in the body frame (SourceSpace), in radians per unit of dt, and are assumed constant during the step.
+ *
+ * The rotation quaternion exp (½ ω dt) is evaluated with Taylor series of cos and sin(x)/x, which needs neither
+ * trigonometric functions nor square roots; the error is below 1e-9 for rotations up to 1 radian per step.
+ * The rotation itself preserves norms, but rounding errors accumulate over many steps, so call fast_renormalize()
+ * every step or every few steps.
+ *
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	inline void
+	integrate_angular_velocity (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion>& orientations,
+								VectorBatch<S, 3, SourceSpace, void> const& angular_velocities,
+								S const dt)
+	{
+		detail::check_quaternion_batch_sizes (orientations.size(), angular_velocities.size());
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			auto const broadcast = [](S const value) { return simd::broadcast<V> (value); };
+			auto const half_dt = broadcast (dt / 2);
+			auto const hx = V (simd::load<V> (angular_velocities.component (0).data() + i) * half_dt);
+			auto const hy = V (simd::load<V> (angular_velocities.component (1).data() + i) * half_dt);
+			auto const hz = V (simd::load<V> (angular_velocities.component (2).data() + i) * half_dt);
+			// Squared half-angle of rotation:
+			auto const a2 = V (hx * hx + hy * hy + hz * hz);
+			// cos a = 1 - a²/2! + a⁴/4! - a⁶/6! + a⁸/8!:
+			auto const cos_a = V (broadcast (1) + a2 * (broadcast (-1.0 / 2) + a2 * (broadcast (1.0 / 24) + a2 * (broadcast (-1.0 / 720) + a2 * broadcast (1.0 / 40320)))));
+			// sin (a) / a = 1 - a²/3! + a⁴/5! - a⁶/7! + a⁸/9!:
+			auto const sinc_a = V (broadcast (1) + a2 * (broadcast (-1.0 / 6) + a2 * (broadcast (1.0 / 120) + a2 * (broadcast (-1.0 / 5040) + a2 * broadcast (1.0 / 362880)))));
+			auto const delta = std::array<V, 4> { cos_a, V (sinc_a * hx), V (sinc_a * hy), V (sinc_a * hz) };
+
+			detail::store_quaternions (orientations, i, detail::hamilton_product<V> (detail::load_quaternions<V> (orientations, i), delta));
+		};
+
+		simd::for_each_pack<S> (orientations.size(), kernel);
+	}
+
+
+/**
+ * Compute normalized linear interpolation between a[i] and b[i] along the shorter arc, for given t in [0, 1].
+ * Cheaper than slerp(), but angular velocity along the path is not constant.
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	inline void
+	nlerp (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& a,
+		   QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& b,
+		   S const t,
+		   QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion>& result)
+	{
+		detail::check_quaternion_batch_sizes (a.size(), b.size());
+		result.resize (a.size());
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			using std::copysign;
+			using std::sqrt;
+
+			auto const qa = detail::load_quaternions<V> (a, i);
+			auto const qb = detail::load_quaternions<V> (b, i);
+			auto const dot = V (qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3]);
+			auto const weight_a = simd::broadcast<V> (1 - t);
+			// Negate b if needed to interpolate along the shorter arc:
+			auto const weight_b = V (copysign (simd::broadcast<V> (t), dot));
+			std::array<V, 4> q;
+
+			for (std::size_t c = 0; c < 4; ++c)
+				q[c] = weight_a * qa[c] + weight_b * qb[c];
+
+			auto const factor = V (simd::broadcast<V> (S (1)) / sqrt (V (q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3])));
+
+			for (std::size_t c = 0; c < 4; ++c)
+				q[c] = q[c] * factor;
+
+			detail::store_quaternions (result, i, q);
+		};
+
+		simd::for_each_pack<S> (a.size(), kernel);
+	}
+
+
+/**
+ * Return batch of nlerp (a[i], b[i], t).
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	[[nodiscard]]
+	inline QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion>
+	nlerp (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& a,
+		   QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& b,
+		   S const t)
+	{
+		QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> result;
+		nlerp (a, b, t, result);
+		return result;
+	}
+
+
+/**
+ * Compute spherical linear interpolation between normalized quaternions a[i] and b[i] along the shorter arc, for
+ * given t in [0, 1].
+ *
+ * Uses polynomial approximation from David Eberly, "A Fast and Accurate Algorithm for Computing SLERP", which
+ * needs only multiplications and additions, so it vectorizes well. The series is evaluated up to 16 terms; measured
+ * maximum error is about 4.5e-8 per component for double, which is good for animation and interpolation between
+ * simulation steps, but not for accumulating rotations.
+ *
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	inline void
+	slerp (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& a,
+		   QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& b,
+		   S const t,
+		   QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion>& result)
+	{
+		detail::check_quaternion_batch_sizes (a.size(), b.size());
+		result.resize (a.size());
+
+		constexpr std::size_t kTerms = 16;
+		// Correction factor for the last coefficients, fitted to minimize maximum error of the truncated series:
+		constexpr double kOnePlusMu = 1.91668;
+
+		// Coefficients uᵢ = 1 / (i (2i + 1)) and vᵢ = i / (2i + 1) of the series sin (tθ) / sin (θ) = Σ cᵢ (cos θ - 1)ⁱ,
+		// where cᵢ = (uᵢ t² - vᵢ) cᵢ₋₁:
+		constexpr auto kU = [] {
+			std::array<double, kTerms> u;
+
+			for (std::size_t i = 1; i <= kTerms; ++i)
+				u[i - 1] = 1.0 / (i * (2.0 * i + 1.0));
+
+			u[kTerms - 1] *= kOnePlusMu;
+			return u;
+		}();
+
+		constexpr auto kV = [] {
+			std::array<double, kTerms> v;
+
+			for (std::size_t i = 1; i <= kTerms; ++i)
+				v[i - 1] = i / (2.0 * i + 1.0);
+
+			v[kTerms - 1] *= kOnePlusMu;
+			return v;
+		}();
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			using std::abs;
+			using std::copysign;
+
+			auto const qa = detail::load_quaternions<V> (a, i);
+			auto const qb = detail::load_quaternions<V> (b, i);
+			auto const dot = V (qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3]);
+			auto const x_minus_1 = V (abs (dot) - simd::broadcast<V> (S (1)));
+			auto const one = simd::broadcast<V> (S (1));
+			auto const d = S (1) - t;
+			auto weight_a = one;
+			auto weight_b = one;
+
+			for (std::size_t k = kTerms; k-- > 0; )
+			{
+				weight_a = one + V (simd::broadcast<V> (static_cast<S> (kU[k] * d * d - kV[k])) * x_minus_1) * weight_a;
+				weight_b = one + V (simd::broadcast<V> (static_cast<S> (kU[k] * t * t - kV[k])) * x_minus_1) * weight_b;
+			}
+
+			weight_a = weight_a * simd::broadcast<V> (d);
+			// Negate b if needed to interpolate along the shorter arc:
+			weight_b = copysign (V (weight_b * simd::broadcast<V> (t)), dot);
+			std::array<V, 4> q;
+
+			for (std::size_t c = 0; c < 4; ++c)
+				q[c] = weight_a * qa[c] + weight_b * qb[c];
+
+			detail::store_quaternions (result, i, q);
+		};
+
+		simd::for_each_pack<S> (a.size(), kernel);
+	}
+
+
+/**
+ * Return batch of slerp (a[i], b[i], t).
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	[[nodiscard]]
+	inline QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion>
+	slerp (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& a,
+		   QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> const& b,
+		   S const t)
+	{
+		QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion> result;
+		slerp (a, b, t, result);
+		return result;
+	}
+
+
+/**
+ * Normalize all quaternions in the batch in place. Like Quaternion::normalize(), zero quaternions become NaNs.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	inline void
+	normalize (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion>& batch)
+	{
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			using std::sqrt;
+
+			auto q = detail::load_quaternions<V> (batch, i);
+			auto const factor = V (simd::broadcast<V> (S (1)) / sqrt (V (q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3])));
+
+			for (auto& component: q)
+				component = component * factor;
+
+			detail::store_quaternions (batch, i, q);
+		};
+
+		simd::for_each_pack<S> (batch.size(), kernel);
+	}
+
+
+/**
+ * Approximately normalize quaternions that are already close to unit length, for example after a single integration
+ * step. Uses one Newton step for 1/sqrt(n) starting from 1, which is q *= (3 - n) / 2 where n is the squared norm.
+ * It needs no square roots nor divisions. If the norm differs from 1 by ε, it will differ by about 1.5 ε² afterwards.
+ */
+template<std::floating_point S, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	inline void
+	fast_renormalize (QuaternionBatch<S, TargetSpace, SourceSpace, IsRotationQuaternion>& batch)
+	{
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			auto q = detail::load_quaternions<V> (batch, i);
+			auto const squared_norm = V (q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+			auto const factor = V ((simd::broadcast<V> (S (3)) - squared_norm) * simd::broadcast<V> (S (0.5)));
+
+			for (auto& component: q)
+				component = component * factor;
+
+			detail::store_quaternions (batch, i, q);
+		};
+
+		simd::for_each_pack<S> (batch.size(), kernel);
+	}
+
+} // namespace neutrino::math
+
+#endif
@@ -0,0 +1,309 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__SIMD_PACK_H__INCLUDED
+#define NEUTRINO__MATH__SIMD_PACK_H__INCLUDED
+
+// Standard:
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// System:
+#if defined (__SSE2__) || defined (__AVX__)
+#include <immintrin.h>
+#endif
+
+
+/**
+ * Thin wrappers over native SIMD registers used by batch (structure-of-arrays) kernels.
+ *
+ * Kernels are written once as generic lambdas taking the "value type" V as a template parameter. They're called
+ * with V = NativePack<S> for full packs of elements and with V = S for the remaining tail elements, so the same
+ * code handles both. Functions load(), store(), broadcast(), sqrt(), abs(), min(), max() and copysign() are defined
+ * for both packs and plain scalars (including SI quantities, for which there's no SIMD path at all).
+ */
+namespace neutrino::math::simd {
+
+template<class S, std::size_t Lanes>
+	struct Pack;
+
+
+#if defined (__AVX__)
+
+template<>
+	struct Pack<double, 4>
+	{
+		static constexpr std::size_t kLanes = 4;
+
+		__m256d value;
+
+		static Pack
+		load (double const* data) noexcept
+			{ return { _mm256_loadu_pd (data) }; }
+
+		static Pack
+		broadcast (double scalar) noexcept
+			{ return { _mm256_set1_pd (scalar) }; }
+
+		void
+		store (double* data) const noexcept
+			{ _mm256_storeu_pd (data, value); }
+
+		friend Pack operator+ (Pack a, Pack b) noexcept { return { _mm256_add_pd (a.value, b.value) }; }
+		friend Pack operator- (Pack a, Pack b) noexcept { return { _mm256_sub_pd (a.value, b.value) }; }
+		friend Pack operator* (Pack a, Pack b) noexcept { return { _mm256_mul_pd (a.value, b.value) }; }
+		friend Pack operator/ (Pack a, Pack b) noexcept { return { _mm256_div_pd (a.value, b.value) }; }
+		friend Pack operator- (Pack a) noexcept { return { _mm256_xor_pd (a.value, _mm256_set1_pd (-0.0)) }; }
+		friend Pack sqrt (Pack a) noexcept { return { _mm256_sqrt_pd (a.value) }; }
+		friend Pack abs (Pack a) noexcept { return { _mm256_andnot_pd (_mm256_set1_pd (-0.0), a.value) }; }
+		friend Pack min (Pack a, Pack b) noexcept { return { _mm256_min_pd (a.value, b.value) }; }
+		friend Pack max (Pack a, Pack b) noexcept { return { _mm256_max_pd (a.value, b.value) }; }
+		friend Pack copysign (Pack a, Pack b) noexcept { return { _mm256_or_pd (_mm256_andnot_pd (_mm256_set1_pd (-0.0), a.value), _mm256_and_pd (_mm256_set1_pd (-0.0), b.value)) }; }
+		friend Pack multiply_add (Pack a, Pack b, Pack c) noexcept
+#if defined (__FMA__)
+			{ return { _mm256_fmadd_pd (a.value, b.value, c.value) }; }
+#else
+			{ return a * b + c; }
+#endif
+	};
+
+
+template<>
+	struct Pack<float, 8>
+	{
+		static constexpr std::size_t kLanes = 8;
+
+		__m256 value;
+
+		static Pack
+		load (float const* data) noexcept
+			{ return { _mm256_loadu_ps (data) }; }
+
+		static Pack
+		broadcast (float scalar) noexcept
+			{ return { _mm256_set1_ps (scalar) }; }
+
+		void
+		store (float* data) const noexcept
+			{ _mm256_storeu_ps (data, value); }
+
+		friend Pack operator+ (Pack a, Pack b) noexcept { return { _mm256_add_ps (a.value, b.value) }; }
+		friend Pack operator- (Pack a, Pack b) noexcept { return { _mm256_sub_ps (a.value, b.value) }; }
+		friend Pack operator* (Pack a, Pack b) noexcept { return { _mm256_mul_ps (a.value, b.value) }; }
+		friend Pack operator/ (Pack a, Pack b) noexcept { return { _mm256_div_ps (a.value, b.value) }; }
+		friend Pack operator- (Pack a) noexcept { return { _mm256_xor_ps (a.value, _mm256_set1_ps (-0.0f)) }; }
+		friend Pack sqrt (Pack a) noexcept { return { _mm256_sqrt_ps (a.value) }; }
+		friend Pack abs (Pack a) noexcept { return { _mm256_andnot_ps (_mm256_set1_ps (-0.0f), a.value) }; }
+		friend Pack min (Pack a, Pack b) noexcept { return { _mm256_min_ps (a.value, b.value) }; }
+		friend Pack max (Pack a, Pack b) noexcept { return { _mm256_max_ps (a.value, b.value) }; }
+		friend Pack copysign (Pack a, Pack b) noexcept { return { _mm256_or_ps (_mm256_andnot_ps (_mm256_set1_ps (-0.0f), a.value), _mm256_and_ps (_mm256_set1_ps (-0.0f), b.value)) }; }
+		friend Pack multiply_add (Pack a, Pack b, Pack c) noexcept
+#if defined (__FMA__)
+			{ return { _mm256_fmadd_ps (a.value, b.value, c.value) }; }
+#else
+			{ return a * b + c; }
+#endif
+	};
+
+template<class S>
+	constexpr std::size_t kNativeLanes = std::is_same_v<S, double> ? 4 : std::is_same_v<S, float> ? 8 : 1;
+
+#elif defined (__SSE2__)
+
+template<>
+	struct Pack<double, 2>
+	{
+		static constexpr std::size_t kLanes = 2;
+
+		__m128d value;
+
+		static Pack
+		load (double const* data) noexcept
+			{ return { _mm_loadu_pd (data) }; }
+
+		static Pack
+		broadcast (double scalar) noexcept
+			{ return { _mm_set1_pd (scalar) }; }
+
+		void
+		store (double* data) const noexcept
+			{ _mm_storeu_pd (data, value); }
+
+		friend Pack operator+ (Pack a, Pack b) noexcept { return { _mm_add_pd (a.value, b.value) }; }
+		friend Pack operator- (Pack a, Pack b) noexcept { return { _mm_sub_pd (a.value, b.value) }; }
+		friend Pack operator* (Pack a, Pack b) noexcept { return { _mm_mul_pd (a.value, b.value) }; }
+		friend Pack operator/ (Pack a, Pack b) noexcept { return { _mm_div_pd (a.value, b.value) }; }
+		friend Pack operator- (Pack a) noexcept { return { _mm_xor_pd (a.value, _mm_set1_pd (-0.0)) }; }
+		friend Pack sqrt (Pack a) noexcept { return { _mm_sqrt_pd (a.value) }; }
+		friend Pack abs (Pack a) noexcept { return { _mm_andnot_pd (_mm_set1_pd (-0.0), a.value) }; }
+		friend Pack min (Pack a, Pack b) noexcept { return { _mm_min_pd (a.value, b.value) }; }
+		friend Pack max (Pack a, Pack b) noexcept { return { _mm_max_pd (a.value, b.value) }; }
+		friend Pack copysign (Pack a, Pack b) noexcept { return { _mm_or_pd (_mm_andnot_pd (_mm_set1_pd (-0.0), a.value), _mm_and_pd (_mm_set1_pd (-0.0), b.value)) }; }
+		friend Pack multiply_add (Pack a, Pack b, Pack c) noexcept
+#if defined (__FMA__)
+			{ return { _mm_fmadd_pd (a.value, b.value, c.value) }; }
+#else
+			{ return a * b + c; }
+#endif
+	};
+
+
+template<>
+	struct Pack<float, 4>
+	{
+		static constexpr std::size_t kLanes = 4;
+
+		__m128 value;
+
+		static Pack
+		load (float const* data) noexcept
+			{ return { _mm_loadu_ps (data) }; }
+
+		static Pack
+		broadcast (float scalar) noexcept
+			{ return { _mm_set1_ps (scalar) }; }
+
+		void
+		store (float* data) const noexcept
+			{ _mm_storeu_ps (data, value); }
+
+		friend Pack operator+ (Pack a, Pack b) noexcept { return { _mm_add_ps (a.value, b.value) }; }
+		friend Pack operator- (Pack a, Pack b) noexcept { return { _mm_sub_ps (a.value, b.value) }; }
+		friend Pack operator* (Pack a, Pack b) noexcept { return { _mm_mul_ps (a.value, b.value) }; }
+		friend Pack operator/ (Pack a, Pack b) noexcept { return { _mm_div_ps (a.value, b.value) }; }
+		friend Pack operator- (Pack a) noexcept { return { _mm_xor_ps (a.value, _mm_set1_ps (-0.0f)) }; }
+		friend Pack sqrt (Pack a) noexcept { return { _mm_sqrt_ps (a.value) }; }
+		friend Pack abs (Pack a) noexcept { return { _mm_andnot_ps (_mm_set1_ps (-0.0f), a.value) }; }
+		friend Pack min (Pack a, Pack b) noexcept { return { _mm_min_ps (a.value, b.value) }; }
+		friend Pack max (Pack a, Pack b) noexcept { return { _mm_max_ps (a.value, b.value) }; }
+		friend Pack copysign (Pack a, Pack b) noexcept { return { _mm_or_ps (_mm_andnot_ps (_mm_set1_ps (-0.0f), a.value), _mm_and_ps (_mm_set1_ps (-0.0f), b.value)) }; }
+		friend Pack multiply_add (Pack a, Pack b, Pack c) noexcept
+#if defined (__FMA__)
+			{ return { _mm_fmadd_ps (a.value, b.value, c.value) }; }
+#else
+			{ return a * b + c; }
+#endif
+	};
+
+template<class S>
+	constexpr std::size_t kNativeLanes = std::is_same_v<S, double> ? 2 : std::is_same_v<S, float> ? 4 : 1;
+
+#else
+
+template<class S>
+	constexpr std::size_t kNativeLanes = 1;
+
+#endif
+
+
+template<class T>
+	constexpr bool kIsPack = false;
+
+template<class S, std::size_t Lanes>
+	constexpr bool kIsPack<Pack<S, Lanes>> = true;
+
+
+/**
+ * Widest pack type available for S, or S itself if there's none.
+ */
+template<class S>
+	using NativePack = std::conditional_t<(kNativeLanes<S> > 1), Pack<S, kNativeLanes<S>>, S>;
+
+
+/**
+ * Load V (a pack or a single scalar) from given address.
+ */
+template<class V, class S>
+	[[nodiscard]]
+	inline V
+	load (S const* data) noexcept
+	{
+		if constexpr (kIsPack<V>)
+			return V::load (data);
+		else
+			return *data;
+	}
+
+
+/**
+ * Store pack at given address.
+ */
+template<class S, std::size_t Lanes>
+	inline void
+	store (S* data, Pack<S, Lanes> const value) noexcept
+	{
+		value.store (data);
+	}
+
+
+/**
+ * Store scalar at given address.
+ */
+template<class S>
+	inline void
+	store (S* data, S const& value) noexcept
+	{
+		*data = value;
+	}
+
+
+/**
+ * If V is a pack, return pack with all lanes set to scalar, otherwise return scalar unchanged.
+ */
+template<class V, class S>
+	[[nodiscard]]
+	inline auto
+	broadcast (S const& scalar) noexcept
+	{
+		if constexpr (kIsPack<V>)
+			return V::broadcast (scalar);
+		else
+			return scalar;
+	}
+
+
+/**
+ * Return a × b + c. Packs use fused multiply-add instruction if available, but their overloads are hidden friends,
+ * so call it unqualified after `using simd::multiply_add`.
+ */
+template<class A, class B, class C>
+	[[nodiscard]]
+	constexpr auto
+	multiply_add (A const& a, B const& b, C const& c) noexcept
+	{
+		return a * b + c;
+	}
+
+
+/**
+ * Call kernel.template operator()<V> (index) for each pack of kNativeLanes<S> elements in range [0, size) and then
+ * with V = S for each remaining element.
+ */
+template<class S, class Kernel>
+	inline void
+	for_each_pack (std::size_t const size, Kernel&& kernel)
+	{
+		std::size_t i = 0;
+
+		if constexpr (kNativeLanes<S> > 1)
+			for (; i + kNativeLanes<S> <= size; i += kNativeLanes<S>)
+				kernel.template operator()<NativePack<S>> (i);
+
+		for (; i < size; ++i)
+			kernel.template operator()<S> (i);
+	}
+
+} // namespace neutrino::math::simd
+
+#endif
@@ -0,0 +1,727 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__SPARSE_MATRIX_H__INCLUDED
+#define NEUTRINO__MATH__SPARSE_MATRIX_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/math/concepts.h>
+#include <neutrino/math/dynamic_matrix.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace neutrino::math {
+
+enum class SparseFormat
+{
+	CompressedRows,		// CSR
+	CompressedColumns,	// CSC
+};
+
+
+/**
+ * Single non-zero element used to build sparse matrices.
+ */
+template<class pScalar>
+	struct SparseElement
+	{
+		std::size_t	column;
+		std::size_t	row;
+		pScalar		value;
+	};
+
+
+/**
+ * Sparse matrix in compressed-rows (CSR) or compressed-columns (CSC) format. Memory use is proportional to the number
+ * of non-zero elements. CSR is the better choice for matrix × vector products and for iterative solvers, since
+ * each output element is computed independently and rows can be processed in parallel.
+ *
+ * For CSR, offsets()[r]…offsets()[r + 1] is the range in indices() and values() holding elements of row r and
+ * indices() are column numbers. For CSC it's the other way around.
+ *
+ * Operations on matrices and vectors of incompatible sizes throw std::length_error.
+ */
+template<Scalar pScalar, SparseFormat pFormat>
+	class SparseMatrix
+	{
+	  public:
+		static constexpr SparseFormat kFormat = pFormat;
+
+		using Scalar	= pScalar;
+		using Element	= SparseElement<Scalar>;
+
+	  public:
+		// Ctor. Creates empty 0×0 matrix.
+		SparseMatrix() = default;
+
+		/**
+		 * Ctor. Builds matrix from a list of non-zero elements in any order.
+		 * Values of duplicated elements are summed. Throws std::out_of_range if an element is outside the matrix.
+		 */
+		explicit
+		SparseMatrix (std::size_t columns, std::size_t rows, std::span<Element const> elements);
+
+		// Ctor. Copies non-zero elements of a dense matrix.
+		explicit
+		SparseMatrix (DynamicMatrix<Scalar> const&);
+
+		// Ctor. Converts between CSR and CSC.
+		template<SparseFormat OtherFormat>
+			requires (OtherFormat != pFormat)
+			explicit
+			SparseMatrix (SparseMatrix<Scalar, OtherFormat> const&);
+
+		[[nodiscard]]
+		std::size_t
+		n_columns() const noexcept
+			{ return _columns; }
+
+		[[nodiscard]]
+		std::size_t
+		n_rows() const noexcept
+			{ return _rows; }
+
+		/**
+		 * Return number of stored elements.
+		 */
+		[[nodiscard]]
+		std::size_t
+		non_zeros() const noexcept
+			{ return _values.size(); }
+
+		[[nodiscard]]
+		std::span<std::size_t const>
+		offsets() const noexcept
+			{ return _offsets; }
+
+		[[nodiscard]]
+		std::span<std::size_t const>
+		indices() const noexcept
+			{ return _indices; }
+
+		[[nodiscard]]
+		std::span<Scalar const>
+		values() const noexcept
+			{ return _values; }
+
+		/**
+		 * Return element value or zero if it's not stored. Throws std::out_of_range when accessing elements
+		 * outside matrix.
+		 */
+		[[nodiscard]]
+		Scalar
+		at (std::size_t column, std::size_t row) const;
+
+		/**
+		 * Return diagonal elements.
+		 */
+		[[nodiscard]]
+		std::vector<Scalar>
+		diagonal() const;
+
+		/**
+		 * Convert to dense matrix.
+		 */
+		[[nodiscard]]
+		DynamicMatrix<Scalar>
+		to_dense() const;
+
+	  private:
+		/**
+		 * Return number of compressed lines (rows for CSR, columns for CSC).
+		 */
+		[[nodiscard]]
+		std::size_t
+		n_lines() const noexcept
+			{ return kFormat == SparseFormat::CompressedRows ? _rows : _columns; }
+
+		/**
+		 * Build from elements given as (line, index, value) where line is the compressed dimension.
+		 */
+		template<class LineOf, class IndexOf>
+			void
+			build (std::span<Element const>, LineOf, IndexOf);
+
+	  private:
+		std::size_t					_columns	{ 0 };
+		std::size_t					_rows		{ 0 };
+		std::vector<std::size_t>	_offsets	{ 0 };
+		std::vector<std::size_t>	_indices;
+		std::vector<Scalar>			_values;
+	};
+
+
+template<Scalar S>
+	using CsrMatrix = SparseMatrix<S, SparseFormat::CompressedRows>;
+
+template<Scalar S>
+	using CscMatrix = SparseMatrix<S, SparseFormat::CompressedColumns>;
+
+
+/**
+ * Parameters for iterative solvers.
+ */
+struct IterativeSolverParameters
+{
+	// Stop when |b - A × x| ≤ tolerance × |b|:
+	double			tolerance				{ 1e-10 };
+	std::size_t		max_iterations			{ 1000 };
+	// Scale residuals by inverse of the diagonal of A:
+	bool			jacobi_preconditioner	{ true };
+	// If set, matrix × vector products of CSR matrices are split between threads:
+	WorkPerformer*	work_performer			{ nullptr };
+};
+
+
+struct IterativeSolverResult
+{
+	bool		converged			{ false };
+	std::size_t	iterations			{ 0 };
+	double		relative_residual	{ 0.0 };
+};
+
+
+namespace detail {
+
+/**
+ * Compute rows [row_begin, row_end) of y = A × x for CSR matrix.
+ */
+template<class S, class X, class Y>
+	inline void
+	csr_multiply_rows (CsrMatrix<S> const& a, std::span<X const> const x, std::span<Y> const y, std::size_t const row_begin, std::size_t const row_end)
+	{
+		auto const offsets = a.offsets();
+		auto const indices = a.indices();
+		auto const values = a.values();
+
+		for (std::size_t r = row_begin; r < row_end; ++r)
+		{
+			Y sum {};
+
+			for (std::size_t i = offsets[r]; i < offsets[r + 1]; ++i)
+				sum += values[i] * x[indices[i]];
+
+			y[r] = sum;
+		}
+	}
+
+
+template<std::floating_point S>
+	inline S
+	vector_dot (std::vector<S> const& a, std::vector<S> const& b) noexcept
+	{
+		S sum = 0;
+
+		for (std::size_t i = 0; i < a.size(); ++i)
+			sum += a[i] * b[i];
+
+		return sum;
+	}
+
+
+template<std::floating_point S>
+	inline S
+	vector_norm (std::vector<S> const& a) noexcept
+	{
+		return std::sqrt (vector_dot (a, a));
+	}
+
+
+/**
+ * Return inverse of the diagonal for Jacobi preconditioner, or ones if preconditioner is disabled.
+ * Throws std::domain_error if diagonal contains zeros.
+ */
+template<std::floating_point S, SparseFormat F>
+	inline std::vector<S>
+	inverse_diagonal (SparseMatrix<S, F> const& a, bool const jacobi_preconditioner)
+	{
+		if (!jacobi_preconditioner)
+			return std::vector<S> (a.n_rows(), S (1));
+
+		auto result = a.diagonal();
+
+		for (auto& value: result)
+		{
+			if (value == S (0))
+				throw std::domain_error ("Jacobi preconditioner requires non-zero diagonal");
+
+			value = S (1) / value;
+		}
+
+		return result;
+	}
+
+
+template<std::floating_point S>
+	inline void
+	precondition (std::vector<S> const& inverse_diagonal, std::vector<S> const& input, std::vector<S>& output) noexcept
+	{
+		for (std::size_t i = 0; i < input.size(); ++i)
+			output[i] = inverse_diagonal[i] * input[i];
+	}
+
+
+template<std::floating_point S, SparseFormat F>
+	inline void
+	check_solver_sizes (SparseMatrix<S, F> const& a, std::span<S const> const b, std::span<S> const x)
+	{
+		check_sizes (a.n_columns() == a.n_rows(), "matrix must be square");
+		check_sizes (b.size() == a.n_rows() && x.size() == a.n_columns(), "vector sizes don't match matrix size");
+	}
+
+} // namespace detail
+
+
+template<Scalar S, SparseFormat F>
+	inline
+	SparseMatrix<S, F>::SparseMatrix (std::size_t const columns, std::size_t const rows, std::span<Element const> const elements):
+		_columns (columns),
+		_rows (rows)
+	{
+		for (auto const& element: elements)
+			if (element.column >= columns || element.row >= rows)
+				throw std::out_of_range ("element [" + std::to_string (element.column) + ", " + std::to_string (element.row) + "] is out of bounds in the SparseMatrix");
+
+		if constexpr (kFormat == SparseFormat::CompressedRows)
+			build (elements, [](Element const& e) { return e.row; }, [](Element const& e) { return e.column; });
+		else
+			build (elements, [](Element const& e) { return e.column; }, [](Element const& e) { return e.row; });
+	}
+
+
+template<Scalar S, SparseFormat F>
+	inline
+	SparseMatrix<S, F>::SparseMatrix (DynamicMatrix<Scalar> const& dense)
+	{
+		std::vector<Element> elements;
+
+		for (std::size_t r = 0; r < dense.n_rows(); ++r)
+			for (std::size_t c = 0; c < dense.n_columns(); ++c)
+				if (dense[c, r] != Scalar{})
+					elements.push_back ({ c, r, dense[c, r] });
+
+		*this = SparseMatrix (dense.n_columns(), dense.n_rows(), elements);
+	}
+
+
+template<Scalar S, SparseFormat F>
+	template<SparseFormat OtherFormat>
+		requires (OtherFormat != F)
+		inline
+		SparseMatrix<S, F>::SparseMatrix (SparseMatrix<Scalar, OtherFormat> const& other):
+			_columns (other.n_columns()),
+			_rows (other.n_rows())
+		{
+			// Indices of the other matrix become lines of this one. Count elements per line and then scatter:
+			auto const other_offsets = other.offsets();
+			auto const other_indices = other.indices();
+			auto const other_values = other.values();
+
+			_offsets.assign (n_lines() + 1, 0);
+
+			for (auto const index: other_indices)
+				++_offsets[index + 1];
+
+			for (std::size_t line = 0; line < n_lines(); ++line)
+				_offsets[line + 1] += _offsets[line];
+
+			_indices.resize (other.non_zeros());
+			_values.resize (other.non_zeros());
+			auto next = _offsets;
+
+			// Iterating other lines in order keeps indices within each line sorted:
+			for (std::size_t other_line = 0; other_line + 1 < other_offsets.size(); ++other_line)
+			{
+				for (std::size_t i = other_offsets[other_line]; i < other_offsets[other_line + 1]; ++i)
+				{
+					auto const position = next[other_indices[i]]++;
+					_indices[position] = other_line;
+					_values[position] = other_values[i];
+				}
+			}
+		}
+
+
+template<Scalar S, SparseFormat F>
+	template<class LineOf, class IndexOf>
+		inline void
+		SparseMatrix<S, F>::build (std::span<Element const> const elements, LineOf const line_of, IndexOf const index_of)
+		{
+			std::vector<Element> sorted (elements.begin(), elements.end());
+			std::ranges::sort (sorted, [&] (Element const& a, Element const& b) {
+				return std::pair (line_of (a), index_of (a)) < std::pair (line_of (b), index_of (b));
+			});
+
+			_offsets.assign (n_lines() + 1, 0);
+			_indices.clear();
+			_values.clear();
+			_indices.reserve (sorted.size());
+			_values.reserve (sorted.size());
+
+			for (std::size_t i = 0; i < sorted.size(); ++i)
+			{
+				auto const line = line_of (sorted[i]);
+				auto const index = index_of (sorted[i]);
+
+				if (i > 0 && line == line_of (sorted[i - 1]) && index == index_of (sorted[i - 1]))
+					_values.back() += sorted[i].value;
+				else
+				{
+					_indices.push_back (index);
+					_values.push_back (sorted[i].value);
+					++_offsets[line + 1];
+				}
+			}
+
+			for (std::size_t line = 0; line < n_lines(); ++line)
+				_offsets[line + 1] += _offsets[line];
+		}
+
+
+template<Scalar S, SparseFormat F>
+	inline S
+	SparseMatrix<S, F>::at (std::size_t const column, std::size_t const row) const
+	{
+		if (column >= _columns || row >= _rows)
+			throw std::out_of_range ("element [" + std::to_string (column) + ", " + std::to_string (row) + "] is out of bounds in the SparseMatrix");
+
+		auto const line = kFormat == SparseFormat::CompressedRows ? row : column;
+		auto const index = kFormat == SparseFormat::CompressedRows ? column : row;
+		auto const begin = _indices.begin() + static_cast<std::ptrdiff_t> (_offsets[line]);
+		auto const end = _indices.begin() + static_cast<std::ptrdiff_t> (_offsets[line + 1]);
+		auto const found = std::lower_bound (begin, end, index);
+
+		if (found != end && *found == index)
+			return _values[static_cast<std::size_t> (found - _indices.begin())];
+		else
+			return Scalar{};
+	}
+
+
+template<Scalar S, SparseFormat F>
+	inline std::vector<S>
+	SparseMatrix<S, F>::diagonal() const
+	{
+		std::vector<Scalar> result (std::min (_columns, _rows), Scalar{});
+
+		for (std::size_t line = 0; line < std::min (n_lines(), result.size()); ++line)
+			for (std::size_t i = _offsets[line]; i < _offsets[line + 1]; ++i)
+				if (_indices[i] == line)
+					result[line] = _values[i];
+
+		return result;
+	}
+
+
+template<Scalar S, SparseFormat F>
+	inline DynamicMatrix<S>
+	SparseMatrix<S, F>::to_dense() const
+	{
+		DynamicMatrix<Scalar> result (_columns, _rows);
+
+		for (std::size_t line = 0; line < n_lines(); ++line)
+		{
+			for (std::size_t i = _offsets[line]; i < _offsets[line + 1]; ++i)
+			{
+				if constexpr (kFormat == SparseFormat::CompressedRows)
+					result[_indices[i], line] = _values[i];
+				else
+					result[line, _indices[i]] = _values[i];
+			}
+		}
+
+		return result;
+	}
+
+
+/*
+ * Global functions
+ */
+
+
+/**
+ * Compute y = A × x.
+ */
+template<Scalar S, SparseFormat F, class X, class Y>
+	inline void
+	multiply (SparseMatrix<S, F> const& a, std::span<X const> const x, std::span<Y> const y)
+	{
+		detail::check_sizes (x.size() == a.n_columns() && y.size() == a.n_rows(), "vector sizes don't match matrix size");
+
+		if constexpr (F == SparseFormat::CompressedRows)
+			detail::csr_multiply_rows (a, x, y, 0, a.n_rows());
+		else
+		{
+			auto const offsets = a.offsets();
+			auto const indices = a.indices();
+			auto const values = a.values();
+
+			std::ranges::fill (y, Y{});
+
+			for (std::size_t c = 0; c < a.n_columns(); ++c)
+				for (std::size_t i = offsets[c]; i < offsets[c + 1]; ++i)
+					y[indices[i]] += values[i] * x[c];
+		}
+	}
+
+
+/**
+ * Compute y = A × x splitting rows between threads of given WorkPerformer. Rows are split so that each task
+ * gets about the same number of non-zero elements. Blocks until the whole product is computed.
+ */
+template<Scalar S, class X, class Y>
+	inline void
+	multiply (CsrMatrix<S> const& a, std::span<X const> const x, std::span<Y> const y, WorkPerformer& work_performer)
+	{
+		detail::check_sizes (x.size() == a.n_columns() && y.size() == a.n_rows(), "vector sizes don't match matrix size");
+
+		auto const offsets = a.offsets();
+		auto const tasks = std::max<std::size_t> (1, work_performer.threads_number());
+		std::vector<std::future<void>> futures;
+		futures.reserve (tasks);
+		std::size_t row_begin = 0;
+
+		for (std::size_t t = 1; t <= tasks && row_begin < a.n_rows(); ++t)
+		{
+			auto const target_non_zeros = a.non_zeros() * t / tasks;
+			auto row_end = static_cast<std::size_t> (std::upper_bound (offsets.begin() + 1, offsets.end(), target_non_zeros) - offsets.begin() - 1);
+			row_end = t == tasks ? a.n_rows() : std::clamp (row_end, row_begin + 1, a.n_rows());
+
+			futures.push_back (work_performer.submit ([&a, x, y, row_begin, row_end] {
+				detail::csr_multiply_rows (a, x, y, row_begin, row_end);
+			}));
+
+			row_begin = row_end;
+		}
+
+		for (auto& future: futures)
+			future.get();
+	}
+
+
+/**
+ * Return y = A × x.
+ */
+template<Scalar S, SparseFormat F>
+	[[nodiscard]]
+	inline std::vector<S>
+	operator* (SparseMatrix<S, F> const& a, std::vector<S> const& x)
+	{
+		std::vector<S> y (a.n_rows());
+		multiply (a, std::span<S const> (x), std::span<S> (y));
+		return y;
+	}
+
+
+/**
+ * Return sparse × dense matrix product.
+ */
+template<Scalar S, SparseFormat F>
+	[[nodiscard]]
+	inline DynamicMatrix<S>
+	operator* (SparseMatrix<S, F> const& a, DynamicMatrix<S> const& b)
+	{
+		detail::check_sizes (a.n_columns() == b.n_rows(), "number of columns of A must be equal to number of rows of B");
+
+		DynamicMatrix<S> result (b.n_columns(), a.n_rows());
+		auto const offsets = a.offsets();
+		auto const indices = a.indices();
+		auto const values = a.values();
+
+		// Each non-zero element adds scaled row of B to a row of the result:
+		auto const add_scaled_row = [&] (std::size_t const result_row, S const& value, std::size_t const b_row) {
+			for (std::size_t c = 0; c < b.n_columns(); ++c)
+				result[c, result_row] += value * b[c, b_row];
+		};
+
+		for (std::size_t line = 0; line + 1 < offsets.size(); ++line)
+		{
+			for (std::size_t i = offsets[line]; i < offsets[line + 1]; ++i)
+			{
+				if constexpr (F == SparseFormat::CompressedRows)
+					add_scaled_row (line, values[i], indices[i]);
+				else
+					add_scaled_row (indices[i], values[i], line);
+			}
+		}
+
+		return result;
+	}
+
+
+/**
+ * Solve A × x = b with preconditioned conjugate-gradient method. A must be symmetric and positive-definite.
+ * On input x is the initial guess.
+ */
+template<std::floating_point S, SparseFormat F>
+	inline IterativeSolverResult
+	conjugate_gradient (SparseMatrix<S, F> const& a, std::span<S const> const b, std::span<S> const x, IterativeSolverParameters const& parameters = {})
+	{
+		detail::check_solver_sizes (a, b, x);
+
+		auto const n = b.size();
+		auto const inverse_diagonal = detail::inverse_diagonal (a, parameters.jacobi_preconditioner);
+		auto const apply = [&] (std::vector<S> const& input, std::vector<S>& output) {
+			if constexpr (F == SparseFormat::CompressedRows)
+				if (parameters.work_performer)
+					return multiply (a, std::span<S const> (input), std::span<S> (output), *parameters.work_performer);
+
+			multiply (a, std::span<S const> (input), std::span<S> (output));
+		};
+
+		std::vector<S> const b_vector (b.begin(), b.end());
+		std::vector<S> x_vector (x.begin(), x.end());
+		std::vector<S> r (n), z (n), p (n), ap (n);
+		auto const b_norm = std::max (detail::vector_norm (b_vector), std::numeric_limits<S>::min());
+		IterativeSolverResult result;
+
+		apply (x_vector, ap);
+
+		for (std::size_t i = 0; i < n; ++i)
+			r[i] = b_vector[i] - ap[i];
+
+		detail::precondition (inverse_diagonal, r, z);
+		p = z;
+		auto rz = detail::vector_dot (r, z);
+		result.relative_residual = detail::vector_norm (r) / b_norm;
+
+		while (result.relative_residual > parameters.tolerance && result.iterations < parameters.max_iterations)
+		{
+			apply (p, ap);
+			auto const alpha = rz / detail::vector_dot (p, ap);
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				x_vector[i] += alpha * p[i];
+				r[i] -= alpha * ap[i];
+			}
+
+			++result.iterations;
+			result.relative_residual = detail::vector_norm (r) / b_norm;
+
+			detail::precondition (inverse_diagonal, r, z);
+			auto const rz_next = detail::vector_dot (r, z);
+			auto const beta = rz_next / rz;
+			rz = rz_next;
+
+			for (std::size_t i = 0; i < n; ++i)
+				p[i] = z[i] + beta * p[i];
+		}
+
+		std::ranges::copy (x_vector, x.begin());
+		result.converged = result.relative_residual <= parameters.tolerance;
+		return result;
+	}
+
+
+/**
+ * Solve A × x = b with preconditioned BiCGSTAB method. Works for non-symmetric matrices.
+ * On input x is the initial guess.
+ */
+template<std::floating_point S, SparseFormat F>
+	inline IterativeSolverResult
+	bicgstab (SparseMatrix<S, F> const& a, std::span<S const> const b, std::span<S> const x, IterativeSolverParameters const& parameters = {})
+	{
+		detail::check_solver_sizes (a, b, x);
+
+		auto const n = b.size();
+		auto const inverse_diagonal = detail::inverse_diagonal (a, parameters.jacobi_preconditioner);
+		auto const apply = [&] (std::vector<S> const& input, std::vector<S>& output) {
+			if constexpr (F == SparseFormat::CompressedRows)
+				if (parameters.work_performer)
+					return multiply (a, std::span<S const> (input), std::span<S> (output), *parameters.work_performer);
+
+			multiply (a, std::span<S const> (input), std::span<S> (output));
+		};
+
+		std::vector<S> const b_vector (b.begin(), b.end());
+		std::vector<S> x_vector (x.begin(), x.end());
+		std::vector<S> r (n), r_hat (n), p (n, S (0)), v (n, S (0)), y (n), s (n), z (n), t (n);
+		auto const b_norm = std::max (detail::vector_norm (b_vector), std::numeric_limits<S>::min());
+		S rho = 1, alpha = 1, omega = 1;
+		IterativeSolverResult result;
+
+		apply (x_vector, t);
+
+		for (std::size_t i = 0; i < n; ++i)
+			r[i] = b_vector[i] - t[i];
+
+		r_hat = r;
+		result.relative_residual = detail::vector_norm (r) / b_norm;
+
+		while (result.relative_residual > parameters.tolerance && result.iterations < parameters.max_iterations)
+		{
+			auto const rho_next = detail::vector_dot (r_hat, r);
+
+			// Breakdown, method can't continue:
+			if (rho_next == S (0) || omega == S (0))
+				break;
+
+			auto const beta = (rho_next / rho) * (alpha / omega);
+			rho = rho_next;
+
+			for (std::size_t i = 0; i < n; ++i)
+				p[i] = r[i] + beta * (p[i] - omega * v[i]);
+
+			detail::precondition (inverse_diagonal, p, y);
+			apply (y, v);
+			alpha = rho / detail::vector_dot (r_hat, v);
+
+			for (std::size_t i = 0; i < n; ++i)
+				s[i] = r[i] - alpha * v[i];
+
+			++result.iterations;
+
+			if (auto const s_residual = detail::vector_norm (s) / b_norm; s_residual <= parameters.tolerance)
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					x_vector[i] += alpha * y[i];
+
+				result.relative_residual = s_residual;
+				break;
+			}
+
+			detail::precondition (inverse_diagonal, s, z);
+			apply (z, t);
+			omega = detail::vector_dot (t, s) / detail::vector_dot (t, t);
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				x_vector[i] += alpha * y[i] + omega * z[i];
+				r[i] = s[i] - omega * t[i];
+			}
+
+			result.relative_residual = detail::vector_norm (r) / b_norm;
+		}
+
+		std::ranges::copy (x_vector, x.begin());
+		result.converged = result.relative_residual <= parameters.tolerance;
+		return result;
+	}
+
+} // namespace neutrino::math
+
+#endif
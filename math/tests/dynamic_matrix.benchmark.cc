@@ -0,0 +1,119 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/dynamic_matrix.h>
+#include <neutrino/test/benchmark.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <cstddef>
+#include <format>
+#include <random>
+#include <thread>
+
+
+namespace neutrino::test {
+namespace {
+
+Logger g_null_logger;
+
+
+math::DynamicMatrix<double>
+random_matrix (std::size_t const size)
+{
+	std::mt19937 generator (42);
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+	math::DynamicMatrix<double> result (size, size);
+
+	for (auto& component: result.components())
+		component = distribution (generator);
+
+	return result;
+}
+
+
+/**
+ * Register benchmarks of Size×Size products: naive triple loop, blocked GEMM and blocked GEMM on all hardware
+ * threads.
+ */
+template<std::size_t Size>
+	void
+	register_gemm_benchmarks (std::vector<Benchmark>& benchmarks)
+	{
+		auto const name = std::format ("DynamicMatrix<double> {}×{} × {}×{}", Size, Size, Size, Size);
+
+		benchmarks.emplace_back (name + " naive", [](std::size_t const iterations) {
+			auto a = random_matrix (Size);
+			auto const b = random_matrix (Size);
+			math::DynamicMatrix<double> result (Size, Size);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+
+				for (std::size_t r = 0; r < Size; ++r)
+				{
+					for (std::size_t c = 0; c < Size; ++c)
+					{
+						double sum = 0.0;
+
+						for (std::size_t k = 0; k < Size; ++k)
+							sum += a[k, r] * b[c, k];
+
+						result[c, r] = sum;
+					}
+				}
+
+				do_not_optimize (result);
+			}
+		});
+
+		benchmarks.emplace_back (name + " gemm()", [](std::size_t const iterations) {
+			auto a = random_matrix (Size);
+			auto const b = random_matrix (Size);
+			math::DynamicMatrix<double> result (Size, Size);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				math::gemm (a.view(), b.view(), result.view());
+				do_not_optimize (result);
+			}
+		});
+
+		benchmarks.emplace_back (name + " gemm() on WorkPerformer", [](std::size_t const iterations) {
+			WorkPerformer work_performer (std::thread::hardware_concurrency(), g_null_logger);
+			auto a = random_matrix (Size);
+			auto const b = random_matrix (Size);
+			math::DynamicMatrix<double> result (Size, Size);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				math::gemm (a.view(), b.view(), result.view(), work_performer);
+				do_not_optimize (result);
+			}
+		});
+	}
+
+
+std::vector<Benchmark> const g_gemm_benchmarks = [] {
+	std::vector<Benchmark> benchmarks;
+	register_gemm_benchmarks<64> (benchmarks);
+	register_gemm_benchmarks<256> (benchmarks);
+	return benchmarks;
+}();
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,160 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/dynamic_matrix.h>
+#include <neutrino/math/math.h>
+#include <neutrino/si/si.h>
+#include <neutrino/test/auto_test.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <stdexcept>
+#include <typeinfo>
+
+
+namespace neutrino::test {
+namespace {
+
+Logger g_null_logger;
+
+
+template<class Scalar>
+	math::DynamicMatrix<Scalar>
+	random_matrix (std::mt19937& generator, std::size_t const columns, std::size_t const rows)
+	{
+		std::uniform_real_distribution<Scalar> distribution (-1.0, 1.0);
+		math::DynamicMatrix<Scalar> result (columns, rows);
+
+		for (auto& component: result.components())
+			component = distribution (generator);
+
+		return result;
+	}
+
+
+template<class Scalar>
+	math::DynamicMatrix<Scalar>
+	naive_product (math::DynamicMatrix<Scalar> const& a, math::DynamicMatrix<Scalar> const& b)
+	{
+		math::DynamicMatrix<Scalar> result (b.n_columns(), a.n_rows());
+
+		for (std::size_t r = 0; r < a.n_rows(); ++r)
+			for (std::size_t c = 0; c < b.n_columns(); ++c)
+				for (std::size_t i = 0; i < a.n_columns(); ++i)
+					result[c, r] += a[i, r] * b[c, i];
+
+		return result;
+	}
+
+
+template<class Scalar>
+	void
+	verify_equal (std::string const& name, math::DynamicMatrix<Scalar> const& a, math::DynamicMatrix<Scalar> const& b, Scalar const epsilon)
+	{
+		test_asserts::verify (name + " (sizes)", a.n_columns() == b.n_columns() && a.n_rows() == b.n_rows());
+
+		for (std::size_t i = 0; i < a.components().size(); ++i)
+			test_asserts::verify_equal_with_epsilon (name, a.components()[i], b.components()[i], epsilon);
+	}
+
+
+template<class Scalar>
+	void
+	verify_products (std::mt19937& generator, WorkPerformer& work_performer, Scalar const epsilon)
+	{
+		// Sizes chosen so that micro-kernel tails and multiple cache blocks are used:
+		for (auto const [rows, depth, columns]: { std::array<std::size_t, 3> { 1, 1, 1 },
+												  std::array<std::size_t, 3> { 7, 5, 3 },
+												  std::array<std::size_t, 3> { 37, 53, 29 },
+												  std::array<std::size_t, 3> { 70, 300, 270 } })
+		{
+			auto const name = std::format ("{} {}×{} × {}×{}", typeid (Scalar).name(), rows, depth, depth, columns);
+			auto const a = random_matrix<Scalar> (generator, depth, rows);
+			auto const b = random_matrix<Scalar> (generator, columns, depth);
+			auto const expected = naive_product (a, b);
+
+			verify_equal (name + " operator*", a * b, expected, epsilon);
+			verify_equal (name + " multiply() on WorkPerformer", math::multiply (a, b, work_performer), expected, epsilon);
+		}
+	}
+
+
+AutoTest t1 ("DynamicMatrix: blocked GEMM matches naive product", []{
+	std::mt19937 generator (1);
+	WorkPerformer work_performer (4, g_null_logger);
+
+	verify_products<double> (generator, work_performer, 1e-12);
+	verify_products<float> (generator, work_performer, 1e-3f);
+});
+
+
+AutoTest t2 ("DynamicMatrix: interoperability with Matrix", []{
+	math::Matrix<double, 3, 2> const fixed {
+		1.0, 2.0, 3.0,
+		4.0, 5.0, 6.0,
+	};
+	math::Matrix<double, 2, 3> const other {
+		1.0, 0.0,
+		0.0, 1.0,
+		1.0, 1.0,
+	};
+
+	auto const dynamic = math::DynamicMatrix<double> (fixed);
+	test_asserts::verify ("sizes are copied", dynamic.n_columns() == 3 && dynamic.n_rows() == 2);
+	test_asserts::verify ("elements are copied", dynamic[2, 0] == 3.0 && dynamic[0, 1] == 4.0);
+	test_asserts::verify ("to_matrix() works", dynamic.to_matrix<3, 2>() == fixed);
+	test_asserts::verify_throws<std::length_error> ("to_matrix() with wrong size throws", [&] { (void) dynamic.to_matrix<2, 3>(); });
+
+	// GEMM on views of fixed-size matrices:
+	math::Matrix<double, 2, 2> product;
+	math::gemm (math::view (fixed), math::view (other), math::view (product));
+	test_asserts::verify ("gemm() on views of Matrix works", product == fixed * other);
+
+	auto const from_view = math::DynamicMatrix<double> (math::view (fixed));
+	test_asserts::verify ("copy from view works", from_view == dynamic);
+	test_asserts::verify ("transposed() works", dynamic.transposed().to_matrix<2, 3>() == fixed.transposed());
+});
+
+
+AutoTest t3 ("DynamicMatrix: storage and error handling", []{
+	math::DynamicMatrix<double> a (5, 3, math::identity);
+
+	test_asserts::verify ("storage is aligned", reinterpret_cast<std::uintptr_t> (a.components().data()) % 64 == 0);
+	test_asserts::verify ("identity is initialized", a[0, 0] == 1.0 && a[2, 2] == 1.0 && a[3, 2] == 0.0);
+	test_asserts::verify_throws<std::out_of_range> ("at() checks bounds", [&] { (void) a.at (5, 0); });
+	test_asserts::verify_throws<std::length_error> ("product of incompatible matrices throws", [&] { (void) (a * a); });
+	test_asserts::verify_throws<std::length_error> ("sum of incompatible matrices throws", [&] { (void) (a + a.transposed()); });
+	test_asserts::verify_throws<std::length_error> ("wrong number of values throws", [] { math::DynamicMatrix<double> (2, 2, { 1.0, 2.0, 3.0 }); });
+
+	auto const b = math::DynamicMatrix<double> (2, 2, { 1.0, 2.0, 3.0, 4.0 });
+	test_asserts::verify ("arithmetic works", (b + b - b) * 2.0 == math::DynamicMatrix<double> (2, 2, { 2.0, 4.0, 6.0, 8.0 }));
+});
+
+
+AutoTest t4 ("DynamicMatrix: SI quantities", []{
+	using namespace si::literals;
+
+	auto const a = math::DynamicMatrix<si::Length> (2, 2, { 1_m, 2_m, 3_m, 4_m });
+	auto const b = math::DynamicMatrix<si::Time> (1, 2, { 1_s, 2_s });
+	auto const product = a * b;
+
+	test_asserts::verify ("product of quantities works", product[0, 0] == 5_m * 1_s && product[0, 1] == 11_m * 1_s);
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,135 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/fast_math.h>
+#include <neutrino/test/benchmark.h>
+
+// Standard:
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+using math::Accuracy;
+
+constexpr std::size_t kValues = 4096;
+
+
+std::vector<double>
+random_values (double const min, double const max)
+{
+	std::mt19937 generator (1);
+	std::uniform_real_distribution<double> distribution (min, max);
+	std::vector<double> values (kValues);
+
+	for (auto& value: values)
+		value = distribution (generator);
+
+	return values;
+}
+
+
+template<class Function>
+	void
+	benchmark_function (std::size_t const iterations, double const min, double const max, Function const function)
+	{
+		auto const values = random_values (min, max);
+		std::vector<double> results (values.size());
+
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			do_not_optimize (values);
+			function (values, results);
+			do_not_optimize (results);
+		}
+	}
+
+
+Benchmark b1 ("4096 × std::sin()", [](std::size_t const iterations) {
+	benchmark_function (iterations, -10.0, 10.0, [](auto const& values, auto& results) {
+		for (std::size_t i = 0; i < values.size(); ++i)
+			results[i] = std::sin (values[i]);
+	});
+});
+
+
+Benchmark b2 ("4096 × fast_sin<Accuracy::Medium>()", [](std::size_t const iterations) {
+	benchmark_function (iterations, -10.0, 10.0, [](auto const& values, auto& results) {
+		math::fast_sin<Accuracy::Medium> (values, results);
+	});
+});
+
+
+Benchmark b3 ("4096 × fast_sin<Accuracy::Low>()", [](std::size_t const iterations) {
+	benchmark_function (iterations, -10.0, 10.0, [](auto const& values, auto& results) {
+		math::fast_sin<Accuracy::Low> (values, results);
+	});
+});
+
+
+Benchmark b4 ("4096 × std::exp()", [](std::size_t const iterations) {
+	benchmark_function (iterations, -10.0, 10.0, [](auto const& values, auto& results) {
+		for (std::size_t i = 0; i < values.size(); ++i)
+			results[i] = std::exp (values[i]);
+	});
+});
+
+
+Benchmark b5 ("4096 × fast_exp<Accuracy::Medium>()", [](std::size_t const iterations) {
+	benchmark_function (iterations, -10.0, 10.0, [](auto const& values, auto& results) {
+		math::fast_exp<Accuracy::Medium> (values, results);
+	});
+});
+
+
+Benchmark b6 ("4096 × std::log()", [](std::size_t const iterations) {
+	benchmark_function (iterations, 1e-3, 1e3, [](auto const& values, auto& results) {
+		for (std::size_t i = 0; i < values.size(); ++i)
+			results[i] = std::log (values[i]);
+	});
+});
+
+
+Benchmark b7 ("4096 × fast_log<Accuracy::Medium>()", [](std::size_t const iterations) {
+	benchmark_function (iterations, 1e-3, 1e3, [](auto const& values, auto& results) {
+		math::fast_log<Accuracy::Medium> (values, results);
+	});
+});
+
+
+Benchmark b8 ("4096 × std::atan2()", [](std::size_t const iterations) {
+	auto const xs = random_values (-1.0, 1.0);
+
+	benchmark_function (iterations, -1.0, 1.0, [&xs](auto const& values, auto& results) {
+		for (std::size_t i = 0; i < values.size(); ++i)
+			results[i] = std::atan2 (values[i], xs[i]);
+	});
+});
+
+
+Benchmark b9 ("4096 × fast_atan2<Accuracy::Medium>()", [](std::size_t const iterations) {
+	auto const xs = random_values (-1.0, 1.0);
+
+	benchmark_function (iterations, -1.0, 1.0, [&xs](auto const& values, auto& results) {
+		math::fast_atan2<Accuracy::Medium> (values, xs, results);
+	});
+});
+
+} // namespace
+} // namespace neutrino::test
+
@@ -0,0 +1,199 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/fast_math.h>
+#include <neutrino/si/si.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace neutrino::si::literals;
+using math::Accuracy;
+
+
+template<class S>
+	std::vector<S>
+	random_values (std::size_t const count, S const min, S const max)
+	{
+		std::mt19937 generator (1);
+		std::uniform_real_distribution<S> distribution (min, max);
+		std::vector<S> values (count);
+
+		for (auto& value: values)
+			value = distribution (generator);
+
+		return values;
+	}
+
+
+/**
+ * Return maximum relative or absolute error of results against expected values.
+ */
+template<class S>
+	double
+	max_error (std::vector<S> const& results, std::vector<S> const& expected, bool const relative)
+	{
+		double error = 0.0;
+
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			auto const difference = std::abs (static_cast<double> (results[i]) - expected[i]);
+			error = std::max (error, relative ? difference / std::abs (static_cast<double> (expected[i])) : difference);
+		}
+
+		return error;
+	}
+
+
+/**
+ * Verify that error of fast function at each accuracy is within the tier.
+ */
+template<class S>
+	void
+	verify_accuracy (std::string_view const name, bool const relative, std::vector<S> const& arguments, std::function<S (S)> const& reference, auto const& fast_function)
+	{
+		std::vector<S> expected (arguments.size());
+		std::ranges::transform (arguments, expected.begin(), reference);
+		std::vector<S> results (arguments.size());
+
+		fast_function.template operator()<Accuracy::Low> (arguments, results);
+		auto const low_error = max_error (results, expected, relative);
+		fast_function.template operator()<Accuracy::Medium> (arguments, results);
+		auto const medium_error = max_error (results, expected, relative);
+		fast_function.template operator()<Accuracy::Full> (arguments, results);
+		auto const full_error = max_error (results, expected, relative);
+
+		// Floats can't have error much below 1e-7:
+		auto const medium_limit = std::is_same_v<S, float> ? 2e-6 : 1e-6;
+
+		test_asserts::verify (std::format ("{}: Accuracy::Low has error below 1e-3 (is {:.2g})", name, low_error), low_error < 1e-3);
+		test_asserts::verify (std::format ("{}: Accuracy::Medium has error below 1e-6 (is {:.2g})", name, medium_error), medium_error < medium_limit);
+		test_asserts::verify (std::format ("{}: Accuracy::Full gives std results", name), full_error == 0.0);
+	}
+
+
+template<class S>
+	void
+	verify_all_functions()
+	{
+		auto const type = std::is_same_v<S, float> ? "float" : "double";
+		auto const max_angle = std::is_same_v<S, float> ? S (1000) : S (1e5);
+
+		verify_accuracy<S> (std::format ("fast_exp<{}>", type), true, random_values<S> (10'000, -80, 80), [](S x) { return std::exp (x); },
+							[]<Accuracy kAccuracy> (auto const& x, auto& y) { math::fast_exp<kAccuracy> (x, y); });
+		verify_accuracy<S> (std::format ("fast_log<{}>", type), true, random_values<S> (10'000, 1e-30f, 1e30f), [](S x) { return std::log (x); },
+							[]<Accuracy kAccuracy> (auto const& x, auto& y) { math::fast_log<kAccuracy> (x, y); });
+		verify_accuracy<S> (std::format ("fast_sin<{}>", type), false, random_values<S> (10'000, -max_angle, max_angle), [](S x) { return std::sin (x); },
+							[]<Accuracy kAccuracy> (auto const& x, auto& y) { math::fast_sin<kAccuracy> (x, y); });
+		verify_accuracy<S> (std::format ("fast_cos<{}>", type), false, random_values<S> (10'000, -max_angle, max_angle), [](S x) { return std::cos (x); },
+							[]<Accuracy kAccuracy> (auto const& x, auto& y) { math::fast_cos<kAccuracy> (x, y); });
+		verify_accuracy<S> (std::format ("fast_rsqrt<{}>", type), true, random_values<S> (10'000, 1e-10f, 1e10f), [](S x) { return 1 / std::sqrt (x); },
+							[]<Accuracy kAccuracy> (auto const& x, auto& y) { math::fast_rsqrt<kAccuracy> (x, y); });
+
+		// fast_atan2() with y values from a second array:
+		auto const ys = random_values<S> (10'000, -10, 10);
+		std::vector<S> expected (ys.size());
+		auto xs = random_values<S> (10'000, -10, 10);
+		std::ranges::transform (ys, xs, expected.begin(), [](S y, S x) { return std::atan2 (y, x); });
+		std::vector<S> results (ys.size());
+
+		math::fast_atan2<Accuracy::Low> (ys, xs, results);
+		test_asserts::verify (std::format ("fast_atan2<{}>: Accuracy::Low has error below 1e-3", type), max_error (results, expected, false) < 1e-3);
+		math::fast_atan2<Accuracy::Medium> (ys, xs, results);
+		test_asserts::verify (std::format ("fast_atan2<{}>: Accuracy::Medium has error below 1e-6", type), max_error (results, expected, false) < 2e-6);
+	}
+
+
+AutoTest t1 ("math::fast_math: accuracy tiers", []{
+	verify_all_functions<double>();
+	verify_all_functions<float>();
+});
+
+
+AutoTest t2 ("math::fast_math: special values", []{
+	constexpr auto kInfinity = std::numeric_limits<double>::infinity();
+	std::vector<double> const arguments { 0.0, -1.0, kInfinity, 1e-310, -1000.0, 1000.0, 1.0 };
+	std::vector<double> logs (arguments.size());
+	std::vector<double> exps (arguments.size());
+	math::fast_log (arguments, logs);
+	math::fast_exp (arguments, exps);
+
+	test_asserts::verify ("log (0) is -inf", logs[0] == -kInfinity);
+	test_asserts::verify ("log (-1) is NaN", std::isnan (logs[1]));
+	test_asserts::verify ("log (inf) is inf", logs[2] == kInfinity);
+	test_asserts::verify_equal_with_epsilon ("log() of subnormal value is correct", logs[3], std::log (1e-310), 1e-6 * 713.8);
+	test_asserts::verify ("exp() of large negative value is 0", exps[4] == 0.0);
+	test_asserts::verify ("exp() of large value is inf", exps[5] == kInfinity);
+	test_asserts::verify ("exp (0) is 1", exps[0] == 1.0);
+
+	std::vector<double> const zeros { 0.0, -0.0 };
+	std::vector<double> const ones { 1.0, -1.0 };
+	std::vector<double> angles (2);
+	math::fast_atan2 (zeros, ones, angles);
+	test_asserts::verify ("atan2 (0, 1) is 0", angles[0] == 0.0);
+	test_asserts::verify_equal_with_epsilon ("atan2 (-0, -1) is -π", angles[1], -std::numbers::pi, 1e-12);
+
+	test_asserts::verify_throws<std::length_error> ("ranges must have the same size", [&] {
+		math::fast_exp (arguments, angles);
+	});
+});
+
+
+AutoTest t3 ("math::fast_math: SI quantities", []{
+	std::vector<si::Angle> const angles { 0_deg, 30_deg, 90_deg, 180_deg, -45_deg, 1000_deg };
+	std::vector<double> sines (angles.size());
+	std::vector<double> cosines (angles.size());
+	math::fast_sin_cos (angles, sines, cosines);
+
+	for (std::size_t i = 0; i < angles.size(); ++i)
+	{
+		test_asserts::verify_equal_with_epsilon (std::format ("sin ({}) is correct", angles[i]), sines[i], si::sin (angles[i]), 1e-6);
+		test_asserts::verify_equal_with_epsilon (std::format ("cos ({}) is correct", angles[i]), cosines[i], si::cos (angles[i]), 1e-6);
+	}
+
+	std::vector<si::Length> const ys { 1_m, 1_m, -2_m };
+	std::vector<si::Length> const xs { 1_m, -1_m, 0_m };
+	std::vector<si::Angle> directions (ys.size());
+	math::fast_atan2 (ys, xs, directions);
+	test_asserts::verify_equal_with_epsilon ("atan2() of quantities is correct", directions[1], 135_deg, 1e-4_deg);
+	test_asserts::verify_equal_with_epsilon ("atan2() of quantities is correct", directions[2], -90_deg, 1e-4_deg);
+
+	std::vector<si::Area> const areas { 4_m2, 9_m2 };
+	std::vector<si::Length> lengths (areas.size());
+	std::vector<decltype (1 / 1_m)> inverse_lengths (areas.size());
+	math::fast_sqrt (areas, lengths);
+	math::fast_rsqrt (areas, inverse_lengths);
+	test_asserts::verify ("sqrt() of quantities is correct", lengths[0] == 2_m && lengths[1] == 3_m);
+	test_asserts::verify_equal_with_epsilon ("rsqrt() of quantities is correct", inverse_lengths[1] * 1_m, 1.0 / 3, 1e-6);
+});
+
+} // namespace
+} // namespace neutrino::test
+
@@ -0,0 +1,409 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/field.h>
+#include <neutrino/test/benchmark.h>
+
+// Standard:
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+constexpr std::size_t kQueries = 1000;
+
+
+/**
+ * Return random arguments within [0, max).
+ */
+std::vector<double>
+random_arguments (double const max)
+{
+	std::mt19937 generator (42);
+	std::uniform_real_distribution<double> distribution (0.0, max);
+	std::vector<double> result (kQueries);
+
+	for (auto& value: result)
+		value = distribution (generator);
+
+	return result;
+}
+
+
+math::Field<double, double>
+field_1d (std::size_t const points)
+{
+	math::Field<double, double>::DataMap map;
+
+	for (std::size_t i = 0; i < points; ++i)
+		map[static_cast<double> (i)] = std::sin (0.01 * static_cast<double> (i));
+
+	return math::Field<double, double> (std::move (map));
+}
+
+
+math::Field<double, double, double>
+field_2d (std::size_t const side)
+{
+	math::Field<double, double, double>::DataMap map;
+
+	for (std::size_t x = 0; x < side; ++x)
+		for (std::size_t y = 0; y < side; ++y)
+			map[static_cast<double> (x)][static_cast<double> (y)] = static_cast<double> (x * y);
+
+	return math::Field<double, double, double> (std::move (map));
+}
+
+
+template<std::size_t>
+	using Double = double;
+
+
+template<std::size_t Dimensions, class = std::make_index_sequence<Dimensions>>
+	struct FieldOfDimensionsH;
+
+
+template<std::size_t Dimensions, std::size_t ...I>
+	struct FieldOfDimensionsH<Dimensions, std::index_sequence<I...>>
+	{
+		using type = math::Field<Double<I>..., double>;
+	};
+
+
+template<std::size_t Dimensions>
+	using FieldOfDimensions = typename FieldOfDimensionsH<Dimensions>::type;
+
+
+template<class Map>
+	void
+	fill_map (Map& map, std::vector<double> const& keys, double const sum)
+	{
+		for (auto const key: keys)
+		{
+			if constexpr (std::is_same_v<typename Map::mapped_type, double>)
+				map[key] = sum + key;
+			else
+				fill_map (map[key], keys, sum + key);
+		}
+	}
+
+
+std::size_t
+side_for (std::size_t const points, std::size_t const dimensions)
+{
+	return static_cast<std::size_t> (std::lround (std::pow (static_cast<double> (points), 1.0 / static_cast<double> (dimensions))));
+}
+
+
+/**
+ * Build a field with the same keys on each axis and about given number of points in total.
+ * If uniform is false, every other key is shifted by 30% of the spacing, so that the uniform-axis
+ * lookups can't be used.
+ */
+template<std::size_t Dimensions>
+	FieldOfDimensions<Dimensions>
+	field_nd (std::size_t const points, bool const uniform)
+	{
+		auto const side = side_for (points, Dimensions);
+		std::vector<double> keys;
+
+		for (std::size_t i = 0; i < side; ++i)
+			keys.push_back (static_cast<double> (i) + (uniform || i % 2 == 0 || i == side - 1 ? 0.0 : 0.3));
+
+		typename FieldOfDimensions<Dimensions>::DataMap map;
+		fill_map (map, keys, 0.0);
+		return FieldOfDimensions<Dimensions> (std::move (map));
+	}
+
+
+/**
+ * Large fields take a lot of memory, so keep only the one that is currently benchmarked.
+ * The field is built during the first (calibration) run of the benchmark.
+ */
+template<class Field>
+	Field const&
+	cached_field (std::string const& name, std::function<Field()> const& build)
+	{
+		static std::shared_ptr<void> cached;
+		static std::string cached_name;
+
+		if (name != cached_name)
+		{
+			cached.reset();
+			cached = std::make_shared<Field> (build());
+			cached_name = name;
+		}
+
+		return *std::static_pointer_cast<Field const> (cached);
+	}
+
+
+template<std::size_t Dimensions>
+	void
+	add_nd_benchmarks (std::vector<Benchmark>& benchmarks)
+	{
+		for (std::size_t const points: { 1'000u, 1'000'000u })
+		{
+			for (bool const uniform: { true, false })
+			{
+				auto const name = std::format ("1000 × Field<{}D>::value(), ~{} points, {}", Dimensions, points, uniform ? "uniform axes" : "non-uniform axes");
+
+				benchmarks.emplace_back (name, [name, points, uniform] (std::size_t const iterations) {
+					auto const& field = cached_field<FieldOfDimensions<Dimensions>> (name, [&] { return field_nd<Dimensions> (points, uniform); });
+					auto const max_argument = static_cast<double> (side_for (points, Dimensions) - 1);
+					std::array<std::vector<double>, Dimensions> arguments;
+
+					for (std::size_t d = 0; d < Dimensions; ++d)
+					{
+						arguments[d] = random_arguments (max_argument);
+						std::ranges::rotate (arguments[d], arguments[d].begin() + static_cast<std::ptrdiff_t> (d));
+					}
+
+					for (std::size_t i = 0; i < iterations; ++i)
+					{
+						do_not_optimize (arguments);
+
+						for (std::size_t j = 0; j < kQueries; ++j)
+						{
+							auto const value = [&]<std::size_t ...D> (std::index_sequence<D...>) {
+								return field.value (arguments[D][j]...);
+							} (std::make_index_sequence<Dimensions>());
+
+							do_not_optimize (value);
+						}
+					}
+				});
+			}
+		}
+	}
+
+
+template<std::size_t Dimensions>
+	void
+	add_evaluate_benchmarks (std::vector<Benchmark>& benchmarks)
+	{
+		using Field = FieldOfDimensions<Dimensions>;
+
+		for (std::size_t const points: { 1'000u, 1'000'000u })
+		{
+			for (bool const sorted: { false, true })
+			{
+				auto const name = std::format ("1000 × Field<{}D>::evaluate(), ~{} points, uniform axes, {}", Dimensions, points, sorted ? "sorted queries" : "random queries");
+				// Cached field is the same as in the value() benchmark:
+				auto const field_name = std::format ("1000 × Field<{}D>::value(), ~{} points, uniform axes", Dimensions, points);
+
+				benchmarks.emplace_back (name, [field_name, points, sorted] (std::size_t const iterations) {
+					auto const& field = cached_field<Field> (field_name, [&] { return field_nd<Dimensions> (points, true); });
+					auto const max_argument = static_cast<double> (side_for (points, Dimensions) - 1);
+					std::array<std::vector<double>, Dimensions> arguments;
+					std::vector<typename Field::Arguments> queries (kQueries);
+					std::vector<std::optional<double>> results (kQueries);
+
+					for (std::size_t d = 0; d < Dimensions; ++d)
+					{
+						arguments[d] = random_arguments (max_argument);
+						std::ranges::rotate (arguments[d], arguments[d].begin() + static_cast<std::ptrdiff_t> (d));
+					}
+
+					for (std::size_t j = 0; j < kQueries; ++j)
+					{
+						queries[j] = [&]<std::size_t ...D> (std::index_sequence<D...>) {
+							return typename Field::Arguments (arguments[D][j]...);
+						} (std::make_index_sequence<Dimensions>());
+					}
+
+					if (sorted)
+						std::ranges::sort (queries);
+
+					for (std::size_t i = 0; i < iterations; ++i)
+					{
+						do_not_optimize (queries);
+						field.evaluate (queries, results);
+						do_not_optimize (results);
+					}
+				});
+			}
+		}
+	}
+
+
+/**
+ * Compare Field::value() and Field::Cursor for queries moving smoothly through a 2D field.
+ */
+void
+add_cursor_benchmarks (std::vector<Benchmark>& benchmarks)
+{
+	using Field = FieldOfDimensions<2>;
+
+	for (bool const uniform: { true, false })
+	{
+		for (bool const use_cursor: { false, true })
+		{
+			auto const axes = uniform ? "uniform axes" : "non-uniform axes";
+			auto const name = std::format ("1000 × Field<2D>::{}, ~1000000 points, {}, smooth trajectory", use_cursor ? "Cursor::value()" : "value()", axes);
+			// Cached field is the same as in the value() benchmark:
+			auto const field_name = std::format ("1000 × Field<2D>::value(), ~1000000 points, {}", axes);
+
+			benchmarks.emplace_back (name, [field_name, uniform, use_cursor] (std::size_t const iterations) {
+				auto const& field = cached_field<Field> (field_name, [&] { return field_nd<2> (1'000'000, uniform); });
+				auto cursor = field.cursor();
+				std::vector<double> xs (kQueries);
+				std::vector<double> ys (kQueries);
+
+				for (std::size_t j = 0; j < kQueries; ++j)
+				{
+					auto const t = 0.001 * static_cast<double> (j);
+					xs[j] = 500.0 + 400.0 * std::sin (t);
+					ys[j] = 500.0 + 400.0 * std::cos (t);
+				}
+
+				for (std::size_t i = 0; i < iterations; ++i)
+				{
+					do_not_optimize (xs);
+					do_not_optimize (ys);
+
+					for (std::size_t j = 0; j < kQueries; ++j)
+					{
+						auto const value = use_cursor ? cursor.value (xs[j], ys[j]) : field.value (xs[j], ys[j]);
+						do_not_optimize (value);
+					}
+				}
+			});
+		}
+	}
+}
+
+
+/**
+ * Compare a dense linearly interpolated sine table with a sparse cubic spline table of similar accuracy (max error
+ * about 5e-8 and 1.3e-8).
+ */
+void
+add_cubic_benchmarks (std::vector<Benchmark>& benchmarks)
+{
+	for (auto const& [points, interpolation]: { std::pair { 10'000u, math::FieldInterpolation::Linear }, std::pair { 200u, math::FieldInterpolation::CubicSpline } })
+	{
+		math::Field<double, double>::DataMap map;
+
+		for (std::size_t i = 0; i < points; ++i)
+		{
+			auto const x = 2.0 * std::numbers::pi * static_cast<double> (i) / static_cast<double> (points - 1);
+			map[x] = std::sin (x);
+		}
+
+		auto const field = std::make_shared<math::Field<double, double>> (std::move (map));
+
+		if (interpolation != math::FieldInterpolation::Linear)
+			field->compile (interpolation);
+
+		auto const name = std::format ("1000 × Field<double, double>::value(), sine, {} points, {}", points,
+									   interpolation == math::FieldInterpolation::Linear ? "linear interpolation" : "cubic spline");
+
+		benchmarks.emplace_back (name, [field] (std::size_t const iterations) {
+			auto const arguments = random_arguments (2.0 * std::numbers::pi);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (arguments);
+
+				for (auto const x: arguments)
+				{
+					auto const value = field->value (x);
+					do_not_optimize (value);
+				}
+			}
+		});
+	}
+}
+
+
+std::vector<Benchmark> const g_benchmarks = [] {
+	std::vector<Benchmark> benchmarks;
+
+	for (std::size_t const points: { 10u, 100u, 1000u, 10000u })
+	{
+		// Build fields up front, so that the benchmark doesn't measure building maps:
+		auto const field = std::make_shared<math::Field<double, double>> (field_1d (points));
+
+		benchmarks.emplace_back (std::format ("1000 × Field<double, double>::value(), {} points", points), [field, points] (std::size_t const iterations) {
+			auto const arguments = random_arguments (static_cast<double> (points - 1));
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (arguments);
+
+				for (auto const x: arguments)
+				{
+					auto const value = field->value (x);
+					do_not_optimize (value);
+				}
+			}
+		});
+	}
+
+	for (std::size_t const side: { 10u, 100u, 1000u })
+	{
+		auto const field = std::make_shared<math::Field<double, double, double>> (field_2d (side));
+
+		benchmarks.emplace_back (std::format ("1000 × Field<double, double, double>::value(), {}×{} points", side, side), [field, side] (std::size_t const iterations) {
+			auto const xs = random_arguments (static_cast<double> (side - 1));
+			auto ys = xs;
+			std::ranges::reverse (ys);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (xs);
+				do_not_optimize (ys);
+
+				for (std::size_t j = 0; j < xs.size(); ++j)
+				{
+					auto const value = field->value (xs[j], ys[j]);
+					do_not_optimize (value);
+				}
+			}
+		});
+	}
+
+	add_nd_benchmarks<1> (benchmarks);
+	add_nd_benchmarks<2> (benchmarks);
+	add_nd_benchmarks<3> (benchmarks);
+	add_nd_benchmarks<4> (benchmarks);
+
+	add_evaluate_benchmarks<1> (benchmarks);
+	add_evaluate_benchmarks<2> (benchmarks);
+	add_evaluate_benchmarks<3> (benchmarks);
+	add_evaluate_benchmarks<4> (benchmarks);
+
+	add_cursor_benchmarks (benchmarks);
+	add_cubic_benchmarks (benchmarks);
+
+	return benchmarks;
+}();
+
+} // namespace
+} // namespace neutrino::test
@@ -15,17 +15,65 @@
 #include <neutrino/math/math.h>
 #include <neutrino/math/field.h>
 #include <neutrino/test/auto_test.h>
+#include <neutrino/work_performer.h>
 
 // Standard:
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <format>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
 
 
 namespace neutrino::test {
 namespace {
 
+Logger g_null_logger;
+
 using namespace neutrino::si::literals;
 
 
+/**
+ * Reference lookup in nested maps with linear search, as done by Field before it got flat tables.
+ */
+template<class Map, class X, class ...Xs>
+	std::optional<double>
+	reference_value (Map const& map, bool const extrapolate, X const x, Xs const ...xs)
+	{
+		auto const get_first = [](auto const& pair) { return pair.first; };
+		auto const [inside_domain, ia, ib] = adjacent_find_for_extrapolation (map.begin(), map.end(), x, get_first);
+		Range const xrange { ia->first, ib->first };
+
+		if constexpr (sizeof...(xs) > 0)
+		{
+			auto const min_y = reference_value (ia->second, extrapolate, xs...);
+
+			if (ia == ib || !min_y)
+				return min_y;
+
+			auto const max_y = reference_value (ib->second, extrapolate, xs...);
+
+			if (!max_y)
+				return std::nullopt;
+
+			return renormalize (clamp (x, xrange), xrange, Range { *min_y, *max_y });
+		}
+		else
+		{
+			if (ia == ib)
+				return ia->second;
+			else if (inside_domain || extrapolate)
+				return renormalize (clamp (x, xrange), xrange, Range { ia->second, ib->second });
+			else
+				return std::nullopt;
+		}
+	}
+
+
 AutoTest t1 ("Field<1 argument, 1 value>", []{
 	math::Field<double, double> field {
 		{ 0.0, 0.0 },
@@ -205,6 +253,25 @@ AutoTest t3 ("Field<3 arguments, 1 value>", []{
 	test_asserts::verify_equal_with_epsilon ("min_value (2.0, 0°) == -100_m", field.min_value (2.0, 0_deg).value_or (-1_m), -100_m, 0.000001_m);
 	test_asserts::verify_equal_with_epsilon ("min_value (2.0, 5°) == -70_m", field.min_value (2.0, 5_deg).value_or (-1_m), -70_m, 0.000001_m);
 	test_asserts::verify_equal_with_epsilon ("min_value (2.0, 10°) == -100_m", field.min_value (2.0, 10_deg).value_or (-1_m), -100_m, 0.000001_m);
+
+	// Arguments:
+	test_asserts::verify_equal_with_epsilon ("min_argument (0.5, 0°) == 1.5_s", field.min_argument (0.5, 0_deg).value_or (-1_s), 1.5_s, 0.000001_s);
+	test_asserts::verify_equal_with_epsilon ("max_argument (0.5, 0°) == 3.5_s", field.max_argument (0.5, 0_deg).value_or (-1_s), 3.5_s, 0.000001_s);
+	test_asserts::verify ("min_argument (3.0, 0°) == null", !field.min_argument (3.0, 0_deg));
+
+	{
+		auto const domain = field.domain (0.5, 0_deg);
+		test_asserts::verify ("domain (0.5, 0°) is defined", !!domain);
+		test_asserts::verify_equal_with_epsilon ("domain (0.5, 0°).min() == 1.5_s", domain->min(), 1.5_s, 0.000001_s);
+		test_asserts::verify_equal_with_epsilon ("domain (0.5, 0°).max() == 3.5_s", domain->max(), 3.5_s, 0.000001_s);
+	}
+
+	{
+		auto const codomain = field.codomain (0.0, 10_deg);
+		test_asserts::verify ("codomain (0.0, 10°) is defined", !!codomain);
+		test_asserts::verify_equal_with_epsilon ("codomain (0.0, 10°).min() == -30_m", codomain->min(), -30_m, 0.000001_m);
+		test_asserts::verify_equal_with_epsilon ("codomain (0.0, 10°).max() == -10_m", codomain->max(), -10_m, 0.000001_m);
+	}
 });
 
 
@@ -240,5 +307,342 @@ AutoTest t4 ("Field<..., math::Vector<...>>", []{
 	test_asserts::verify_equal_with_epsilon ("field.value (0.5) is vector { 0.5, 0.5, 0.0 }", abs (*field.value (0.5)), abs (Vector { 0.5, 0.5, 0.0 }), abs (epsilon));
 });
 
+
+AutoTest t5 ("Field: lookups in flat tables match lookups in maps", []{
+	using Field = math::Field<double, double, double, double>;
+
+	std::mt19937 generator (1);
+	std::uniform_int_distribution<std::size_t> size_distribution (1, 6);
+	std::uniform_real_distribution<double> value_distribution (-100.0, 100.0);
+	Field::DataMap map;
+
+	// Ragged field: each submap has different number of keys at different positions:
+	auto const random_keys = [&] {
+		std::vector<double> keys;
+		auto const size = size_distribution (generator);
+
+		for (std::size_t i = 0; i < size; ++i)
+			keys.push_back (std::round (value_distribution (generator) / 10.0));
+
+		return keys;
+	};
+
+	for (auto const x: random_keys())
+		for (auto const y: random_keys())
+			for (auto const z: random_keys())
+				map[x][y][z] = value_distribution (generator);
+
+	auto const field = Field (map);
+
+	for (double x = -12.0; x <= 12.0; x += 1.5)
+	{
+		for (double y = -12.0; y <= 12.0; y += 1.5)
+		{
+			for (double z = -12.0; z <= 12.0; z += 1.5)
+			{
+				auto const name = std::format ("value at ({}, {}, {}) is correct", x, y, z);
+				auto const expected = reference_value (map, false, x, y, z);
+				auto const value = field.value (x, y, z);
+
+				test_asserts::verify (name, value.has_value() == expected.has_value() && (!value || *value == *expected));
+				test_asserts::verify ("extrapolated " + name, field.extrapolated_value (x, y, z) == *reference_value (map, true, x, y, z));
+			}
+		}
+	}
+});
+
+
+AutoTest t6 ("Field: lookups on uniform axes match lookups in maps", []{
+	using Field = math::Field<double, double, double>;
+
+	std::mt19937 generator (2);
+	std::uniform_real_distribution<double> value_distribution (-100.0, 100.0);
+	std::uniform_real_distribution<double> jitter_distribution (-0.001, 0.001);
+	Field::DataMap map;
+
+	// X axis is uniform with spacing not exactly representable as double; half of Y submaps are uniform with
+	// small jitter and the other half are not uniform at all:
+	for (std::size_t i = 0; i <= 20; ++i)
+	{
+		auto const x = -1.0 + 0.1 * static_cast<double> (i);
+
+		for (std::size_t j = 0; j <= 10; ++j)
+		{
+			auto const y = i % 2 == 0
+				? 0.3 * static_cast<double> (j) + jitter_distribution (generator)
+				: 0.03 * static_cast<double> (j * j);
+
+			map[x][y] = value_distribution (generator);
+		}
+	}
+
+	auto const field = Field (map);
+	std::vector<double> queries { -1.5, 3.5, 4.0 };
+
+	// Exact keys and points between them:
+	for (auto const& [x, submap]: map)
+	{
+		queries.push_back (x);
+		queries.push_back (std::nextafter (x, 10.0));
+
+		for (auto const& [y, value]: submap)
+		{
+			queries.push_back (y);
+			queries.push_back (y + 0.01);
+		}
+	}
+
+	for (auto const x: queries)
+	{
+		for (auto const y: queries)
+		{
+			auto const name = std::format ("value at ({}, {}) is correct", x, y);
+			auto const expected = reference_value (map, false, x, y);
+			auto const value = field.value (x, y);
+
+			test_asserts::verify (name, value.has_value() == expected.has_value() && (!value || *value == *expected));
+			test_asserts::verify ("extrapolated " + name, field.extrapolated_value (x, y) == *reference_value (map, true, x, y));
+		}
+	}
+
+	// Uniform axes with SI quantities as keys:
+	math::Field<si::Time, si::Length> const si_field {
+		{ 0_s, 0_m },
+		{ 1_s, 10_m },
+		{ 2_s, 30_m },
+		{ 3_s, 60_m },
+	};
+
+	test_asserts::verify_equal_with_epsilon ("uniform SI axis works 1", *si_field.value (0.5_s), 5_m, 1e-9_m);
+	test_asserts::verify_equal_with_epsilon ("uniform SI axis works 2", *si_field.value (2.5_s), 45_m, 1e-9_m);
+	test_asserts::verify_equal_with_epsilon ("uniform SI axis works 3", *si_field.value (3_s), 60_m, 1e-9_m);
+	test_asserts::verify_equal_with_epsilon ("uniform SI axis works 4", si_field.extrapolated_value (4_s), 60_m, 1e-9_m);
+});
+
+
+AutoTest t7 ("Field: evaluate() gives the same results as value()", []{
+	using Field = math::Field<double, double, double, double>;
+
+	std::mt19937 generator (3);
+	std::uniform_int_distribution<std::size_t> size_distribution (1, 8);
+	std::uniform_real_distribution<double> value_distribution (-100.0, 100.0);
+	Field::DataMap map;
+
+	// Ragged field with some uniform submaps:
+	auto const random_keys = [&] {
+		std::vector<double> keys;
+		auto const size = size_distribution (generator);
+		auto const uniform = size % 2 == 0;
+
+		for (std::size_t i = 0; i < size; ++i)
+			keys.push_back (uniform ? -10.0 + 3.0 * static_cast<double> (i) : std::round (value_distribution (generator) / 10.0));
+
+		return keys;
+	};
+
+	for (auto const x: random_keys())
+		for (auto const y: random_keys())
+			for (auto const z: random_keys())
+				map[x][y][z] = value_distribution (generator);
+
+	auto const field = Field (map);
+	std::uniform_real_distribution<double> argument_distribution (-15.0, 15.0);
+	std::vector<Field::Arguments> points;
+
+	// Random points and runs of nearby points, which reuse bracket searches:
+	for (std::size_t i = 0; i < 1000; ++i)
+	{
+		auto const x = argument_distribution (generator);
+		auto const y = argument_distribution (generator);
+		auto const z = argument_distribution (generator);
+		points.emplace_back (x, y, z);
+
+		for (std::size_t j = 0; j < 5; ++j)
+			points.emplace_back (x, y, z + 0.1 * static_cast<double> (j));
+	}
+
+	std::vector<std::optional<double>> values (points.size());
+	std::vector<double> extrapolated_values (points.size());
+	field.evaluate (points, values);
+	field.evaluate_extrapolated (points, extrapolated_values);
+
+	WorkPerformer work_performer (3, g_null_logger);
+	std::vector<std::optional<double>> parallel_values (points.size());
+	std::vector<double> parallel_extrapolated_values (points.size());
+	field.evaluate (points, parallel_values, work_performer);
+	field.evaluate_extrapolated (points, parallel_extrapolated_values, work_performer);
+
+	for (std::size_t i = 0; i < points.size(); ++i)
+	{
+		auto const [x, y, z] = points[i];
+		auto const name = std::format ("value at ({}, {}, {}) is correct", x, y, z);
+		auto const expected = field.value (x, y, z);
+		auto const expected_extrapolated = field.extrapolated_value (x, y, z);
+
+		test_asserts::verify (name, values[i] == expected);
+		test_asserts::verify ("extrapolated " + name, extrapolated_values[i] == expected_extrapolated);
+		test_asserts::verify ("parallel " + name, parallel_values[i] == expected);
+		test_asserts::verify ("parallel extrapolated " + name, parallel_extrapolated_values[i] == expected_extrapolated);
+	}
+
+	// Fields with vector values:
+	math::Field<si::Time, math::Vector<si::Length, 2>> const vector_field {
+		{ 0_s, { 0_m, 0_m } },
+		{ 1_s, { 1_m, 2_m } },
+		{ 3_s, { 5_m, 2_m } },
+	};
+	std::vector<std::tuple<si::Time>> const times { { -1_s }, { 0.5_s }, { 2_s }, { 4_s } };
+	std::vector<std::optional<math::Vector<si::Length, 2>>> vectors (times.size());
+	vector_field.evaluate (times, vectors);
+
+	for (std::size_t i = 0; i < times.size(); ++i)
+	{
+		auto const expected = vector_field.value (std::get<0> (times[i]));
+		test_asserts::verify ("vector value is correct", vectors[i].has_value() == expected.has_value() && (!expected || vectors[i]->components() == expected->components()));
+	}
+
+	std::vector<std::optional<double>> too_short (points.size() - 1);
+	test_asserts::verify_throws<std::length_error> ("evaluate() with different sizes throws", [&] { field.evaluate (points, too_short); });
+});
+
+
+AutoTest t8 ("Field::Cursor gives the same results as value()", []{
+	using Field = math::Field<double, double, double>;
+
+	std::mt19937 generator (4);
+	std::uniform_real_distribution<double> value_distribution (-100.0, 100.0);
+	Field::DataMap map;
+
+	// Uniform X axis, ragged non-uniform Y submaps:
+	for (std::size_t i = 0; i <= 10; ++i)
+		for (std::size_t j = 0; j <= i; ++j)
+			map[static_cast<double> (i)][0.1 * static_cast<double> (j * j)] = value_distribution (generator);
+
+	auto const field = Field (map);
+	auto cursor = field.cursor();
+
+	auto const verify_at = [&] (double const x, double const y) {
+		auto const name = std::format ("value at ({}, {}) is correct", x, y);
+		test_asserts::verify (name, cursor.value (x, y) == field.value (x, y));
+		test_asserts::verify ("extrapolated " + name, cursor.extrapolated_value (x, y) == field.extrapolated_value (x, y));
+	};
+
+	// Smooth trajectory crossing cells forward and backward, going outside of the domain and jumping far:
+	for (double t = 0.0; t < 20.0; t += 0.01)
+		verify_at (5.0 + 6.0 * std::sin (t), 5.0 + 6.0 * std::cos (1.3 * t));
+
+	for (double t = 0.0; t < 20.0; t += 0.37)
+		verify_at (value_distribution (generator) / 8.0, value_distribution (generator) / 8.0);
+
+	// Exact keys:
+	for (auto const& [x, submap]: map)
+		for (auto const& [y, value]: submap)
+			verify_at (x, y);
+});
+
+
+AutoTest t9 ("Field: cubic interpolation", []{
+	using Field = math::Field<double, double>;
+	using math::FieldInterpolation;
+
+	// Sparse sine table with slightly uneven spacing:
+	Field::DataMap sine_map;
+
+	for (std::size_t i = 0; i <= 12; ++i)
+	{
+		auto const x = 2.0 * std::numbers::pi * static_cast<double> (i) / 12.0 + (i % 3 == 1 ? 0.1 : 0.0);
+		sine_map[x] = std::sin (x);
+	}
+
+	auto const max_error = [&] (FieldInterpolation const interpolation) {
+		auto field = Field (sine_map);
+		field.compile (interpolation);
+		double error = 0.0;
+
+		for (double x = 0.0; x <= 2.0 * std::numbers::pi; x += 0.001)
+			error = std::max (error, std::abs (*field.value (x) - std::sin (x)));
+
+		for (auto const& [x, y]: sine_map)
+			test_asserts::verify ("values at keys are exact", std::abs (*field.value (x) - y) < 1e-12);
+
+		return error;
+	};
+
+	test_asserts::verify ("linear interpolation is inaccurate", max_error (FieldInterpolation::Linear) > 0.04);
+	test_asserts::verify ("cubic spline is accurate", max_error (FieldInterpolation::CubicSpline) < 1e-3);
+	test_asserts::verify ("Akima spline is accurate", max_error (FieldInterpolation::Akima) < 0.02);
+	test_asserts::verify ("PCHIP is accurate", max_error (FieldInterpolation::Pchip) < 0.02);
+
+	// Linear data is reproduced exactly by all methods:
+	for (auto const interpolation: { FieldInterpolation::CubicSpline, FieldInterpolation::Akima, FieldInterpolation::Pchip })
+	{
+		auto field = Field { { 0.0, 1.0 }, { 1.0, 3.0 }, { 3.0, 7.0 }, { 3.5, 8.0 } };
+		field.compile (interpolation);
+		test_asserts::verify ("interpolation() is set", field.interpolation() == interpolation);
+
+		for (double x = -1.0; x <= 4.0; x += 0.1)
+			test_asserts::verify_equal_with_epsilon ("linear data is reproduced", field.extrapolated_value (x), 1.0 + 2.0 * std::clamp (x, 0.0, 3.5), 1e-12);
+	}
+
+	// PCHIP preserves monotonicity, cubic spline overshoots:
+	auto step = Field { { 0.0, 0.0 }, { 1.0, 0.0 }, { 2.0, 0.0 }, { 3.0, 1.0 }, { 4.0, 1.0 }, { 5.0, 1.0 } };
+	auto const is_monotonic_within_data = [&] {
+		double previous = 0.0;
+
+		for (double x = 0.0; x <= 5.0; x += 0.01)
+		{
+			auto const y = *step.value (x);
+
+			if (y < previous || y > 1.0)
+				return false;
+
+			previous = y;
+		}
+
+		return true;
+	};
+
+	step.compile (FieldInterpolation::Pchip);
+	test_asserts::verify ("PCHIP is monotonic", is_monotonic_within_data());
+	step.compile (FieldInterpolation::CubicSpline);
+	test_asserts::verify ("cubic spline overshoots", !is_monotonic_within_data());
+	step.compile (FieldInterpolation::Linear);
+	test_asserts::verify ("compile (Linear) restores linear interpolation", *step.value (2.5) == 0.5);
+
+	// Multi-dimensional fields: evaluate() and Cursor use the same polynomials:
+	std::mt19937 generator (5);
+	std::uniform_real_distribution<double> value_distribution (-10.0, 10.0);
+	math::Field<double, double, double>::DataMap map;
+
+	for (std::size_t i = 0; i < 5; ++i)
+		for (std::size_t j = 0; j < 2 + i; ++j)
+			map[static_cast<double> (i)][static_cast<double> (j * j)] = value_distribution (generator);
+
+	auto field = math::Field<double, double, double> (map);
+	field.compile (FieldInterpolation::Akima);
+	auto cursor = field.cursor();
+	std::vector<std::tuple<double, double>> points;
+
+	for (double x = -1.0; x <= 5.0; x += 0.25)
+		for (double y = -1.0; y <= 17.0; y += 0.25)
+			points.emplace_back (x, y);
+
+	std::vector<std::optional<double>> values (points.size());
+	field.evaluate (points, values);
+
+	for (std::size_t i = 0; i < points.size(); ++i)
+	{
+		auto const [x, y] = points[i];
+		auto const expected = field.value (x, y);
+		test_asserts::verify ("evaluate() uses polynomials", values[i] == expected);
+		test_asserts::verify ("Cursor uses polynomials", cursor.value (x, y) == expected);
+	}
+
+	// SI quantities:
+	auto distance = math::Field<si::Time, si::Length> { { 0_s, 0_m }, { 1_s, 1_m }, { 2_s, 4_m }, { 3_s, 9_m }, { 4_s, 16_m } };
+	distance.compile (FieldInterpolation::CubicSpline);
+	test_asserts::verify_equal_with_epsilon ("cubic spline works with SI quantities", *distance.value (2.5_s), 6.25_m, 0.05_m);
+});
+
 } // namespace
 } // namespace neutrino::test
@@ -0,0 +1,155 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/mapped_file.h>
+#include <neutrino/math/field.h>
+#include <neutrino/math/field_file.h>
+#include <neutrino/si/si.h>
+#include <neutrino/stdexcept.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace neutrino::si::literals;
+
+using AltitudeField = math::Field<si::Length, si::Velocity, double, si::Force>;
+
+
+/**
+ * Return a field with irregular axes and different number of keys in each submap.
+ */
+AltitudeField
+random_field()
+{
+	std::mt19937 generator (7);
+	std::uniform_int_distribution<std::size_t> sizes (1, 6);
+	std::uniform_real_distribution<double> values (-100.0, 100.0);
+	AltitudeField::DataMap map;
+	auto altitude = 0_m;
+
+	for (std::size_t i = 0, n = sizes (generator); i < n; ++i, altitude += 1_m * (1 + i * i))
+	{
+		auto speed = 10_mps;
+
+		for (std::size_t j = 0, m = sizes (generator); j < m; ++j, speed += 5_mps * (1 + j))
+			for (std::size_t k = 0, p = sizes (generator); k < p; ++k)
+				map[altitude][speed][0.1 * k * k] = 1_N * values (generator);
+	}
+
+	return AltitudeField (std::move (map));
+}
+
+
+void
+verify_same_lookups (AltitudeField const& field, math::FieldView<si::Length, si::Velocity, double, si::Force> const& view)
+{
+	std::mt19937 generator (11);
+	std::uniform_real_distribution<double> altitudes (-5.0, 60.0);
+	std::uniform_real_distribution<double> speeds (0.0, 100.0);
+	std::uniform_real_distribution<double> ratios (-0.5, 3.0);
+	bool all_equal = true;
+
+	for (std::size_t i = 0; i < 10'000; ++i)
+	{
+		auto const altitude = 1_m * altitudes (generator);
+		auto const speed = 1_mps * speeds (generator);
+		auto const ratio = ratios (generator);
+
+		all_equal = all_equal
+			&& view.value (altitude, speed, ratio) == field.value (altitude, speed, ratio)
+			&& view.extrapolated_value (altitude, speed, ratio) == field.extrapolated_value (altitude, speed, ratio);
+	}
+
+	test_asserts::verify ("FieldView lookups are equal to Field lookups", all_equal);
+}
+
+
+AutoTest t1 ("math::FieldView: lookups in serialized field", []{
+	auto const field = random_field();
+	auto const blob = math::to_field_file (field);
+	math::FieldView<si::Length, si::Velocity, double, si::Force> const view (blob);
+	verify_same_lookups (field, view);
+	test_asserts::verify ("to_data_map() restores the original map", view.to_data_map() == field.data_map());
+});
+
+
+AutoTest t2 ("math::FieldView: invalid files are rejected", []{
+	auto const blob = math::to_field_file (random_field());
+	using View = math::FieldView<si::Length, si::Velocity, double, si::Force>;
+
+	auto bad_magic = blob;
+	bad_magic[0] = 'X';
+	test_asserts::verify_throws<InvalidFormat> ("bad magic is rejected", [&] { View view (bad_magic); });
+
+	auto bad_version = blob;
+	bad_version[8] = 99;
+	test_asserts::verify_throws<InvalidFormat> ("unknown version is rejected", [&] { View view (bad_version); });
+
+	auto const truncated = Blob (blob.substr (0, blob.size() - 8));
+	test_asserts::verify_throws<InvalidFormat> ("truncated file is rejected", [&] { View view (truncated); });
+
+	using WrongUnits = math::FieldView<si::Length, si::Velocity, double, si::Power>;
+	test_asserts::verify_throws<InvalidFormat> ("different unit is rejected", [&] { WrongUnits view (blob); });
+
+	using WrongPrecision = math::FieldView<si::Length, si::Velocity, float, si::Force>;
+	test_asserts::verify_throws<InvalidFormat> ("different precision is rejected", [&] { WrongPrecision view (blob); });
+
+	using WrongDimensions = math::FieldView<si::Length, si::Velocity, si::Force>;
+	test_asserts::verify_throws<InvalidFormat> ("different number of arguments is rejected", [&] { WrongDimensions view (blob); });
+
+	// Make the first offsets array describe an empty submap:
+	auto bad_offsets = blob;
+	auto const offsets_descriptor = 24 + 72 * 4 + 16 * 3;
+	auto const offsets_position = math::detail::read_little_endian<uint64_t> (bad_offsets, offsets_descriptor);
+	bad_offsets[offsets_position + 8] = 0;
+	test_asserts::verify_throws<InvalidFormat> ("invalid offsets are rejected", [&] { View view (bad_offsets); });
+});
+
+
+AutoTest t3 ("math::FieldView: lookups in memory-mapped file", []{
+	auto const field = random_field();
+	auto const blob = math::to_field_file (field);
+	auto const path = std::filesystem::temp_directory_path() / std::format ("neutrino-field-file-test-{}.bin", std::random_device()());
+
+	{
+		std::ofstream file (path, std::ios::binary);
+		file.write (reinterpret_cast<char const*> (blob.data()), static_cast<std::streamsize> (blob.size()));
+	}
+
+	{
+		MappedFile const mapped (path);
+		test_asserts::verify ("mapped file has the same contents", mapped.data() == BlobView (blob));
+
+		math::FieldView<si::Length, si::Velocity, double, si::Force> const view (mapped.data());
+		verify_same_lookups (field, view);
+	}
+
+	std::filesystem::remove (path);
+
+	test_asserts::verify_throws<IOError> ("mapping non-existent file throws", [&] { MappedFile mapped (path); });
+});
+
+} // namespace
+} // namespace neutrino::test
+
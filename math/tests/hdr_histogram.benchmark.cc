@@ -0,0 +1,106 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/hdr_histogram.h>
+#include <neutrino/si/si.h>
+#include <neutrino/test/benchmark.h>
+
+// Standard:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace neutrino::si::literals;
+
+constexpr std::size_t kSamples = 100'000;
+
+math::HdrHistogram<si::Time>::Parameters const kParameters { .resolution = 1_ns, .max_value = 100_s, .significant_digits = 3 };
+
+
+std::vector<si::Time>
+random_latencies()
+{
+	std::mt19937 generator (1);
+	std::lognormal_distribution<double> distribution (std::log (1e5), 3.0);
+	std::vector<si::Time> latencies (kSamples);
+
+	for (auto& latency: latencies)
+		latency = 1_ns * std::min (distribution (generator), 1e11);
+
+	return latencies;
+}
+
+
+Benchmark b1 ("100k × HdrHistogram::record()", [](std::size_t const iterations) {
+	auto const latencies = random_latencies();
+	math::HdrHistogram<si::Time> histogram (kParameters);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (latencies);
+
+		for (auto const latency: latencies)
+			histogram.record (latency);
+
+		do_not_optimize (histogram);
+	}
+});
+
+
+Benchmark b2 ("p50, p99, p99.9 of 100k latencies, HdrHistogram::values_at_percentiles()", [](std::size_t const iterations) {
+	math::HdrHistogram<si::Time> histogram (kParameters);
+
+	for (auto const latency: random_latencies())
+		histogram.record (latency);
+
+	std::vector<double> const percentiles { 0.5, 0.99, 0.999 };
+	std::vector<si::Time> results (percentiles.size());
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		histogram.values_at_percentiles (percentiles, results);
+		do_not_optimize (results);
+	}
+});
+
+
+Benchmark b3 ("p50, p99, p99.9 of 100k latencies, nth_element() on a copy", [](std::size_t const iterations) {
+	auto const latencies = random_latencies();
+	std::vector<si::Time> results (3);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		auto copy = latencies;
+		std::size_t n = 0;
+
+		for (auto const percentile: { 0.5, 0.99, 0.999 })
+		{
+			auto const nth = copy.begin() + static_cast<std::ptrdiff_t> (percentile * (kSamples - 1));
+			std::nth_element (copy.begin(), nth, copy.end());
+			results[n++] = *nth;
+		}
+
+		do_not_optimize (results);
+	}
+});
+
+} // namespace
+} // namespace neutrino::test
+
@@ -0,0 +1,160 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/hdr_histogram.h>
+#include <neutrino/si/si.h>
+#include <neutrino/stdexcept.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace neutrino::si::literals;
+
+using TimeHistogram = math::HdrHistogram<si::Time>;
+
+TimeHistogram::Parameters const kParameters { .resolution = 1_ns, .max_value = 100_s, .significant_digits = 3 };
+
+
+/**
+ * Return latencies spread over many orders of magnitude.
+ */
+std::vector<si::Time>
+random_latencies (std::size_t const count, unsigned int const seed)
+{
+	std::mt19937 generator (seed);
+	std::lognormal_distribution<double> distribution (std::log (1e5), 3.0);
+	std::vector<si::Time> latencies;
+
+	for (std::size_t i = 0; i < count; ++i)
+		latencies.push_back (1_ns * std::min (distribution (generator), 1e11));
+
+	return latencies;
+}
+
+
+AutoTest t1 ("math::HdrHistogram: percentiles have requested precision", []{
+	auto latencies = random_latencies (100'000, 1);
+	TimeHistogram histogram (kParameters);
+
+	for (auto const latency: latencies)
+		histogram.record (latency);
+
+	std::ranges::sort (latencies);
+	test_asserts::verify ("count() is correct", histogram.count() == latencies.size());
+
+	for (auto const percentile: { 0.0, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0 })
+	{
+		auto const rank = std::max<std::size_t> (1, static_cast<std::size_t> (std::ceil (percentile * latencies.size())));
+		auto const exact = latencies[rank - 1];
+		auto const result = histogram.value_at_percentile (percentile);
+		auto const tolerance = std::max<si::Time> (1e-3 * exact, 1_ns);
+		test_asserts::verify_equal_with_epsilon (std::format ("value_at_percentile ({}) is correct", percentile), result, exact, tolerance);
+	}
+
+	test_asserts::verify_equal_with_epsilon ("min() is correct", histogram.min(), latencies.front(), std::max<si::Time> (1e-3 * latencies.front(), 1_ns));
+	test_asserts::verify_equal_with_epsilon ("max() is correct", histogram.max(), latencies.back(), 1e-3 * latencies.back());
+
+	std::vector<double> const percentiles { 0.99, 0.5, 0.9, 0.0, 1.0 };
+	std::vector<si::Time> results (percentiles.size());
+	histogram.values_at_percentiles (percentiles, results);
+	bool all_equal = true;
+
+	for (std::size_t i = 0; i < percentiles.size(); ++i)
+		all_equal = all_equal && results[i] == histogram.value_at_percentile (percentiles[i]);
+
+	test_asserts::verify ("values_at_percentiles() gives the same results as value_at_percentile()", all_equal);
+
+	histogram.record (-1_s);
+	histogram.record (1000_s);
+	test_asserts::verify ("negative values are recorded as 0", histogram.min() == 0_s);
+	test_asserts::verify_equal_with_epsilon ("values above max_value are recorded as max_value", histogram.max(), 100_s, 0.1_s);
+
+	histogram.reset();
+	test_asserts::verify ("reset() removes all values", histogram.count() == 0 && histogram.value_at_percentile (0.5) == 0_s);
+});
+
+
+AutoTest t2 ("math::HdrHistogram: concurrent recording and merge()", []{
+	constexpr std::size_t kThreads = 4;
+	constexpr std::size_t kPerThread = 25'000;
+
+	TimeHistogram shared (kParameters);
+	TimeHistogram merged (kParameters);
+	TimeHistogram serial (kParameters);
+	std::vector<TimeHistogram> partials;
+	std::vector<std::thread> threads;
+
+	for (std::size_t t = 0; t < kThreads; ++t)
+		partials.emplace_back (kParameters);
+
+	for (std::size_t t = 0; t < kThreads; ++t)
+	{
+		threads.emplace_back ([&, t] {
+			for (auto const latency: random_latencies (kPerThread, static_cast<unsigned int> (t)))
+			{
+				shared.record (latency);
+				partials[t].record (latency);
+			}
+		});
+	}
+
+	for (auto& thread: threads)
+		thread.join();
+
+	for (std::size_t t = 0; t < kThreads; ++t)
+	{
+		for (auto const latency: random_latencies (kPerThread, static_cast<unsigned int> (t)))
+			serial.record (latency);
+
+		merged.merge (partials[t]);
+	}
+
+	test_asserts::verify ("no records are lost when recording concurrently", shared.count() == kThreads * kPerThread);
+	test_asserts::verify ("merged histogram has all records", merged.count() == kThreads * kPerThread);
+
+	bool all_equal = true;
+
+	for (auto const percentile: { 0.0, 0.25, 0.5, 0.75, 0.99, 0.9999, 1.0 })
+	{
+		all_equal = all_equal
+			&& merged.value_at_percentile (percentile) == serial.value_at_percentile (percentile)
+			&& shared.value_at_percentile (percentile) == serial.value_at_percentile (percentile);
+	}
+
+	test_asserts::verify ("merge() is lossless", all_equal);
+	test_asserts::verify ("mean() of merged histogram is the same", merged.mean() == serial.mean());
+
+	test_asserts::verify_throws<InvalidArgument> ("histograms with different parameters can't be merged", [&] {
+		merged.merge (TimeHistogram ({ .resolution = 1_us, .max_value = 100_s, .significant_digits = 3 }));
+	});
+
+	test_asserts::verify_throws<InvalidArgument> ("invalid parameters are rejected", [&] {
+		TimeHistogram ({ .resolution = 1_ns, .max_value = 100_s, .significant_digits = 7 });
+	});
+});
+
+} // namespace
+} // namespace neutrino::test
+
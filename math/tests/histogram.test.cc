@@ -0,0 +1,196 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/histogram.h>
+#include <neutrino/numeric.h>
+#include <neutrino/si/si.h>
+#include <neutrino/stdexcept.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace neutrino::si::literals;
+
+
+std::vector<double>
+random_samples (std::size_t const count)
+{
+	std::mt19937 generator (1);
+	std::normal_distribution<double> distribution (50.0, 10.0);
+	std::vector<double> samples;
+
+	for (std::size_t i = 0; i < count; ++i)
+		samples.push_back (distribution (generator));
+
+	return samples;
+}
+
+
+AutoTest t1 ("math::Histogram: statistics computed in a single pass", []{
+	auto const samples = random_samples (10'000);
+	math::Histogram<double> const histogram (samples.begin(), samples.end(), { .bin_width = 0.5, .min_x = std::nullopt, .max_x = std::nullopt });
+
+	test_asserts::verify ("n_samples() is correct", histogram.n_samples() == samples.size());
+	test_asserts::verify_equal_with_epsilon ("mean() is correct", histogram.mean(), neutrino::mean (samples.begin(), samples.end()), 1e-9);
+	test_asserts::verify_equal_with_epsilon ("stddev() is correct", histogram.stddev(), neutrino::stddev (samples.begin(), samples.end()), 1e-9);
+	test_asserts::verify_equal_with_epsilon ("median() is within bin width", histogram.median(), neutrino::median (samples.begin(), samples.end()), 0.5);
+	test_asserts::verify ("min() is correct", histogram.min() == *std::min_element (samples.begin(), samples.end()));
+	test_asserts::verify ("max() is correct", histogram.max() == *std::max_element (samples.begin(), samples.end()));
+
+	math::Histogram<double> incremental ({ .bin_width = 0.5, .min_x = histogram.min_x(), .max_x = histogram.max_x() });
+
+	for (auto const sample: samples)
+		incremental.add (sample);
+
+	test_asserts::verify ("incrementally filled histogram has the same bins", incremental.bins() == histogram.bins());
+	test_asserts::verify ("incrementally filled histogram has the same max_y()", incremental.max_y() == histogram.max_y());
+	test_asserts::verify_equal_with_epsilon ("incrementally filled histogram has the same mean()", incremental.mean(), histogram.mean(), 1e-12);
+
+	test_asserts::verify_throws<InvalidArgument> ("histogram without range can't be filled incrementally", []{
+		math::Histogram<double> ({ .bin_width = 0.5, .min_x = std::nullopt, .max_x = std::nullopt });
+	});
+});
+
+
+AutoTest t2 ("math::Histogram: merge()", []{
+	auto const samples = random_samples (10'000);
+	math::Histogram<double>::Parameters const parameters { .bin_width = 1.0, .min_x = 20.0, .max_x = 80.0 };
+	math::Histogram<double> const whole (samples.begin(), samples.end(), parameters);
+	math::Histogram<double> merged (parameters);
+
+	// Like filling in parallel, each part in its own histogram:
+	for (std::size_t part = 0; part < 4; ++part)
+	{
+		math::Histogram<double> partial (parameters);
+		partial.add (samples.begin() + neutrino::to_signed (part * 2500), samples.begin() + neutrino::to_signed ((part + 1) * 2500));
+		merged.merge (partial);
+	}
+
+	merged.merge (math::Histogram<double> (parameters));
+
+	test_asserts::verify ("merged n_samples() is correct", merged.n_samples() == whole.n_samples());
+	test_asserts::verify ("merged bins are correct", merged.bins() == whole.bins());
+	test_asserts::verify ("merged max_y() is correct", merged.max_y() == whole.max_y());
+	test_asserts::verify ("merged min() is correct", merged.min() == whole.min());
+	test_asserts::verify ("merged max() is correct", merged.max() == whole.max());
+	test_asserts::verify ("merged median() is correct", merged.median() == whole.median());
+	test_asserts::verify_equal_with_epsilon ("merged mean() is correct", merged.mean(), whole.mean(), 1e-9);
+	test_asserts::verify_equal_with_epsilon ("merged stddev() is correct", merged.stddev(), whole.stddev(), 1e-9);
+
+	test_asserts::verify_throws<InvalidArgument> ("histograms with different bins can't be merged", [&] {
+		merged.merge (math::Histogram<double> ({ .bin_width = 2.0, .min_x = 20.0, .max_x = 80.0 }));
+	});
+});
+
+
+AutoTest t3 ("math::Histogram: SI quantities", []{
+	math::Histogram<si::Time> histogram ({ .bin_width = 1_ms, .min_x = 0_ms, .max_x = 10_ms });
+
+	for (auto const sample: { 1.5_ms, 2.5_ms, 3.5_ms, 4.5_ms, 20_ms })
+		histogram.add (sample);
+
+	test_asserts::verify ("sample above max_x is not put in bins", histogram.bins()[1] == 1 && histogram.bins()[9] == 0);
+	test_asserts::verify_equal_with_epsilon ("mean() is correct", histogram.mean(), 6.4_ms, 1e-9_ms);
+	test_asserts::verify_equal_with_epsilon ("median() is correct", histogram.median(), 3.5_ms, 1e-9_ms);
+	test_asserts::verify_equal_with_epsilon ("stddev() is correct", histogram.stddev(), 7.6843998_ms, 1e-6_ms);
+});
+
+
+AutoTest t4 ("math::Histogram: percentile queries", []{
+	auto const samples = random_samples (10'000);
+	math::Histogram<double> histogram (samples.begin(), samples.end(), { .bin_width = 0.5, .min_x = 20.0, .max_x = 80.0 });
+
+	// Reference implementation summing bins on each call:
+	auto const expected_percentile_for = [&] (double const value) {
+		std::size_t count = 0;
+
+		for (std::size_t b = histogram.bin_index (std::max (value, histogram.min_x())); b < histogram.bins().size(); ++b)
+			count += histogram.bins()[b];
+
+		return 1.0f * count / histogram.n_samples();
+	};
+
+	std::vector<double> thresholds;
+	std::vector<float> expected_percentiles;
+
+	for (double value = 10.0; value < 90.0; value += 0.37)
+	{
+		thresholds.push_back (value);
+		expected_percentiles.push_back (expected_percentile_for (value));
+	}
+
+	std::vector<float> percentiles (thresholds.size());
+	histogram.normalized_percentiles_for (thresholds, percentiles);
+	test_asserts::verify ("normalized_percentiles_for() gives correct results", percentiles == expected_percentiles);
+	test_asserts::verify ("normalized_percentile_for() gives correct result", histogram.normalized_percentile_for (50.0) == expected_percentile_for (50.0));
+
+	test_asserts::verify ("value_at_percentile (0.5) is median()", histogram.value_at_percentile (0.5) == histogram.median());
+	test_asserts::verify ("value_at_percentile (0) is min_x()", histogram.value_at_percentile (0.0) == histogram.min_x());
+
+	std::vector<double> const normalized_percentiles { 0.01, 0.1, 0.5, 0.9, 0.99 };
+	std::vector<double> values (normalized_percentiles.size());
+	histogram.values_at_percentiles (normalized_percentiles, values);
+	auto sorted = samples;
+	std::ranges::sort (sorted);
+
+	for (std::size_t i = 0; i < values.size(); ++i)
+	{
+		auto const exact = sorted[static_cast<std::size_t> (normalized_percentiles[i] * static_cast<double> (sorted.size()))];
+		test_asserts::verify_equal_with_epsilon ("values_at_percentiles() is within bin width", values[i], exact, 0.5);
+		// It's an inverse of normalized_percentile_for():
+		test_asserts::verify_equal_with_epsilon ("value_at_percentile() is inverse of normalized_percentile_for()", 1.0 - histogram.normalized_percentile_for (values[i]), normalized_percentiles[i], 0.02);
+	}
+
+	// Cumulative bins must be updated after adding samples:
+	auto const before = histogram.normalized_percentile_for (70.0);
+	histogram.add (75.0);
+	test_asserts::verify ("percentiles are updated after add()", histogram.normalized_percentile_for (70.0) > before);
+
+	test_asserts::verify_throws<std::length_error> ("spans must have the same size", [&] {
+		histogram.values_at_percentiles (normalized_percentiles, std::span (values).first (2));
+	});
+});
+
+
+AutoTest t5 ("math::Histogram: all samples are binned with default range", []{
+	auto const sum_of_bins = [] (math::Histogram<double> const& histogram) {
+		return std::accumulate (histogram.bins().begin(), histogram.bins().end(), std::size_t (0));
+	};
+
+	auto const samples = random_samples (10'000);
+	math::Histogram<double> const histogram (samples.begin(), samples.end(), { .bin_width = 0.5, .min_x = std::nullopt, .max_x = std::nullopt });
+	test_asserts::verify ("bins sum up to n_samples()", sum_of_bins (histogram) == histogram.n_samples());
+
+	// Range being a multiple of bin width puts max_x one past the last bin:
+	std::vector<double> const integers { 0.0, 1.0, 2.0, 3.0, 4.0, 4.0 };
+	math::Histogram<double> const exact (integers.begin(), integers.end(), { .bin_width = 1.0, .min_x = std::nullopt, .max_x = std::nullopt });
+	test_asserts::verify ("bins sum up to n_samples() when range is a multiple of bin width", sum_of_bins (exact) == exact.n_samples());
+	test_asserts::verify ("max_x is put in the last bin", exact.bins().size() == 4 && exact.bins()[3] == 3 && exact.max_y() == 3);
+});
+
+} // namespace
+} // namespace neutrino::test
+
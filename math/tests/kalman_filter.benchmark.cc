@@ -0,0 +1,85 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/kalman_filter.h>
+#include <neutrino/math/math.h>
+#include <neutrino/test/benchmark.h>
+
+// Standard:
+#include <cstddef>
+
+
+namespace neutrino::test {
+namespace {
+
+// Constant-velocity model in 3D with position measurements:
+using Filter = math::KalmanFilter<double, 6, 3>;
+
+constexpr double kDt = 0.01;
+
+Filter::Transition const g_transition {
+	1.0, 0.0, 0.0, kDt, 0.0, 0.0,
+	0.0, 1.0, 0.0, 0.0, kDt, 0.0,
+	0.0, 0.0, 1.0, 0.0, 0.0, kDt,
+	0.0, 0.0, 0.0, 1.0, 0.0, 0.0,
+	0.0, 0.0, 0.0, 0.0, 1.0, 0.0,
+	0.0, 0.0, 0.0, 0.0, 0.0, 1.0,
+};
+
+Filter::Observation const g_observation {
+	1.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+	0.0, 1.0, 0.0, 0.0, 0.0, 0.0,
+	0.0, 0.0, 1.0, 0.0, 0.0, 0.0,
+};
+
+auto const g_process_noise = Filter::Covariance::equal_diagonal (1e-4);
+auto const g_measurement_noise = Filter::MeasurementCovariance::equal_diagonal (0.01);
+auto const g_measurement = Filter::Measurement { 1.0, 2.0, 3.0 };
+
+
+Benchmark b1 ("KalmanFilter<double, 6, 3> step, hand-rolled with inverted()", [](std::size_t const iterations) {
+	auto x = Filter::State (math::zero);
+	auto p = Filter::Covariance::equal_diagonal (1.0);
+	auto const& f = g_transition;
+	auto const& h = g_observation;
+	auto const& r = g_measurement_noise;
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		x = f * x;
+		p = f * p * f.transposed() + g_process_noise;
+		auto const k = p * h.transposed() * (h * p * h.transposed() + r).inverted();
+		auto const i_kh = Filter::Transition (math::identity) - k * h;
+		x = x + k * (g_measurement - h * x);
+		p = i_kh * p * i_kh.transposed() + k * r * k.transposed();
+		do_not_optimize (x);
+		do_not_optimize (p);
+	}
+});
+
+
+Benchmark b2 ("KalmanFilter<double, 6, 3> step, KalmanFilter", [](std::size_t const iterations) {
+	Filter filter (Filter::State (math::zero), Filter::Covariance::equal_diagonal (1.0));
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		filter.predict (g_transition, g_process_noise);
+		auto const updated = filter.update (g_measurement, g_observation, g_measurement_noise);
+		do_not_optimize (updated);
+		do_not_optimize (filter);
+	}
+});
+
+} // namespace
+} // namespace neutrino::test
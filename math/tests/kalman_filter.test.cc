@@ -0,0 +1,144 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/kalman_filter.h>
+#include <neutrino/math/math.h>
+#include <neutrino/si/si.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <cstddef>
+#include <random>
+
+
+namespace neutrino::test {
+namespace {
+
+struct StateSpace: math::CoordinateSystemBase { };
+struct SensorSpace: math::CoordinateSystemBase { };
+
+
+AutoTest t1 ("KalmanFilter: matches textbook implementation", []{
+	// Constant-velocity model with position measurements:
+	using Filter = math::KalmanFilter<double, 4, 2, double, StateSpace, SensorSpace>;
+
+	constexpr double dt = 0.1;
+	Filter::Transition const f {
+		1.0, 0.0,  dt, 0.0,
+		0.0, 1.0, 0.0,  dt,
+		0.0, 0.0, 1.0, 0.0,
+		0.0, 0.0, 0.0, 1.0,
+	};
+	Filter::Observation const h {
+		1.0, 0.0, 0.0, 0.0,
+		0.0, 1.0, 0.0, 0.0,
+	};
+	auto const q = Filter::Covariance::equal_diagonal (0.01);
+	auto const r = Filter::MeasurementCovariance::equal_diagonal (0.25);
+
+	Filter filter (Filter::State { 0.0, 0.0, 0.0, 0.0 }, Filter::Covariance::equal_diagonal (10.0));
+	auto x = filter.state();
+	auto p = filter.covariance();
+
+	std::mt19937 generator (1);
+	std::normal_distribution<double> noise (0.0, 0.5);
+
+	for (std::size_t step = 1; step <= 100; ++step)
+	{
+		auto const t = dt * static_cast<double> (step);
+		auto const z = Filter::Measurement { 2.0 * t + noise (generator), -1.0 * t + noise (generator) };
+
+		filter.predict (f, q);
+		auto const updated = filter.update (z, h, r);
+
+		x = f * x;
+		p = f * p * f.transposed() + q;
+		auto const k = p * h.transposed() * (h * p * h.transposed() + r).inverted();
+		x = x + k * (z - h * x);
+		p = (Filter::Transition (math::identity) - k * h) * p;
+
+		test_asserts::verify ("update succeeds", updated);
+		test_asserts::verify_equal_with_epsilon ("state matches", filter.state(), x, 1e-9);
+		test_asserts::verify_equal_with_epsilon ("covariance matches", filter.covariance(), p, 1e-9);
+		test_asserts::verify_equal_with_epsilon ("covariance is symmetric", filter.covariance(), filter.covariance().transposed(), 0.0);
+	}
+
+	test_asserts::verify_equal_with_epsilon ("velocity estimate converged", filter.state(), Filter::State { 20.0, -10.0, 2.0, -1.0 }, 0.5);
+});
+
+
+AutoTest t2 ("KalmanFilter: rejects update with invalid innovation covariance", []{
+	using Filter = math::KalmanFilter<double, 2, 1>;
+
+	Filter filter (Filter::State { 1.0, 2.0 }, Filter::Covariance (math::zero));
+	auto const updated = filter.update (Filter::Measurement { 5.0 }, Filter::Observation { 1.0, 0.0 }, Filter::MeasurementCovariance { 0.0 });
+
+	test_asserts::verify ("update fails", !updated);
+	test_asserts::verify ("state is unchanged", filter.state() == Filter::State { 1.0, 2.0 });
+});
+
+
+AutoTest t3 ("KalmanFilter: SI quantities", []{
+	using namespace si::literals;
+
+	// Two independent distances measured by a single sensor that returns their sum and difference:
+	using Filter = math::KalmanFilter<si::Length, 2, 2, si::Length>;
+
+	Filter filter (Filter::State { 0_m, 0_m }, Filter::Covariance::equal_diagonal (100_m * 1_m));
+	Filter::Observation const h {
+		1.0, +1.0,
+		1.0, -1.0,
+	};
+	auto const r = Filter::MeasurementCovariance::equal_diagonal (0.01_m * 1_m);
+
+	for (int i = 0; i < 50; ++i)
+	{
+		filter.predict (Filter::Transition (math::identity), Filter::Covariance::equal_diagonal (1e-6_m * 1_m));
+		test_asserts::verify ("update succeeds", filter.update (Filter::Measurement { 5_m, 1_m }, h, r));
+	}
+
+	test_asserts::verify_equal_with_epsilon ("estimate converged", filter.state(), Filter::State { 3_m, 2_m }, 1e-3_m);
+	test_asserts::verify ("variance decreased", filter.covariance()[0, 0] < 0.01_m * 1_m);
+});
+
+
+AutoTest t4 ("KalmanFilter: covariance stays positive-definite when badly conditioned", []{
+	using Filter = math::KalmanFilter<double, 3, 1>;
+
+	constexpr double dt = 0.1;
+	Filter::Transition const f {
+		1.0,  dt, 0.0,
+		0.0, 1.0,  dt,
+		0.0, 0.0, 1.0,
+	};
+	// Variances spanning 12 orders of magnitude and measurements much more precise than the state:
+	Filter filter (Filter::State { 0.0, 0.0, 0.0 }, Filter::Covariance { 1e6, 0.0, 0.0,  0.0, 1.0, 0.0,  0.0, 0.0, 1e-6 });
+	auto const q = Filter::Covariance::equal_diagonal (1e-12);
+	auto const r = Filter::MeasurementCovariance { 1e-10 };
+
+	std::mt19937 generator (1);
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+
+	for (std::size_t step = 0; step < 1000; ++step)
+	{
+		Filter::Observation const h { distribution (generator), distribution (generator), distribution (generator) };
+
+		filter.predict (f, q);
+		test_asserts::verify ("update succeeds", filter.update (Filter::Measurement { distribution (generator) }, h, r));
+		test_asserts::verify ("covariance is positive-definite", filter.covariance().cholesky().positive_definite());
+	}
+});
+
+} // namespace
+} // namespace neutrino::test
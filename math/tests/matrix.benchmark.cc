@@ -0,0 +1,298 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/math/matrix_expression.h>
+#include <neutrino/test/benchmark.h>
+
+// Standard:
+#include <cstddef>
+#include <format>
+#include <random>
+#include <typeinfo>
+
+
+namespace neutrino::test {
+namespace {
+
+template<class Scalar, std::size_t Columns, std::size_t Rows>
+	math::Matrix<Scalar, Columns, Rows>
+	random_matrix()
+	{
+		std::mt19937 generator (42);
+		std::uniform_real_distribution<Scalar> distribution (-1.0, 1.0);
+		math::Matrix<Scalar, Columns, Rows> result;
+
+		for (auto& component: result.components())
+			component = distribution (generator);
+
+		return result;
+	}
+
+
+/**
+ * Register benchmarks of products of [Common × ARows] and [BColumns × Common] matrices: generic loop vs. the operator
+ * (which uses SIMD kernels if available).
+ */
+template<class Scalar, std::size_t ARows, std::size_t Common, std::size_t BColumns>
+	void
+	register_product_benchmarks (std::vector<Benchmark>& benchmarks)
+	{
+		auto const name = std::format ("Matrix<{}, {}, {}> × Matrix<{}, {}, {}>",
+									   typeid (Scalar).name(), Common, ARows, typeid (Scalar).name(), BColumns, Common);
+
+		benchmarks.emplace_back (name + " generic", [](std::size_t const iterations) {
+			auto a = random_matrix<Scalar, Common, ARows>();
+			auto const b = random_matrix<Scalar, BColumns, Common>();
+			math::Matrix<Scalar, BColumns, ARows> result (math::uninitialized);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				math::simd::product_generic<Scalar, ARows, Common, BColumns> (a.components().data(), b.components().data(), result.components().data());
+				do_not_optimize (result);
+			}
+		});
+
+		benchmarks.emplace_back (name + " operator*", [](std::size_t const iterations) {
+			auto a = random_matrix<Scalar, Common, ARows>();
+			auto const b = random_matrix<Scalar, BColumns, Common>();
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				auto const result = a * b;
+				do_not_optimize (result);
+			}
+		});
+	}
+
+
+std::vector<Benchmark> const g_product_benchmarks = [] {
+	std::vector<Benchmark> benchmarks;
+	register_product_benchmarks<double, 3, 3, 3> (benchmarks);
+	register_product_benchmarks<double, 4, 4, 4> (benchmarks);
+	register_product_benchmarks<float, 3, 3, 3> (benchmarks);
+	register_product_benchmarks<float, 4, 4, 4> (benchmarks);
+	register_product_benchmarks<double, 3, 4, 3> (benchmarks);
+	register_product_benchmarks<double, 4, 3, 4> (benchmarks);
+	register_product_benchmarks<float, 3, 4, 3> (benchmarks);
+	register_product_benchmarks<float, 4, 3, 4> (benchmarks);
+	register_product_benchmarks<double, 3, 3, 1> (benchmarks);
+	register_product_benchmarks<double, 4, 4, 1> (benchmarks);
+	register_product_benchmarks<double, 4, 3, 1> (benchmarks);
+	register_product_benchmarks<float, 4, 4, 1> (benchmarks);
+	return benchmarks;
+}();
+
+
+Benchmark b1 ("Matrix<double, 4, 4> + Matrix<double, 4, 4> generic", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 4, 4>();
+	auto const b = random_matrix<double, 4, 4>();
+	math::Matrix<double, 4, 4> result (math::uninitialized);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+
+		for (std::size_t j = 0; j < result.components().size(); ++j)
+			result.components()[j] = a.components()[j] + b.components()[j];
+
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b2 ("Matrix<double, 4, 4> + Matrix<double, 4, 4> operator+", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 4, 4>();
+	auto const b = random_matrix<double, 4, 4>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		auto const result = a + b;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b3 ("Matrix<double, 4, 4> × scalar generic", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 4, 4>();
+	math::Matrix<double, 4, 4> result (math::uninitialized);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+
+		for (std::size_t j = 0; j < result.components().size(); ++j)
+			result.components()[j] = a.components()[j] * 1.5;
+
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b4 ("Matrix<double, 4, 4> × scalar operator*", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 4, 4>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		auto const result = a * 1.5;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b5 ("Matrix<double, 4, 4>: a × b + b × a - e eager", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 4, 4>();
+	auto const b = random_matrix<double, 4, 4>();
+	auto const e = random_matrix<double, 4, 4>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		auto const result = a * b + b * a - e;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b6 ("Matrix<double, 4, 4>: a × b + b × a - e lazy", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 4, 4>();
+	auto const b = random_matrix<double, 4, 4>();
+	auto const e = random_matrix<double, 4, 4>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		math::Matrix<double, 4, 4> const result = math::lazy (a) * b + math::lazy (b) * a - e;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b7 ("Matrix<double, 8, 8>: a + b × 2 - c / 4 eager", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 8, 8>();
+	auto const b = random_matrix<double, 8, 8>();
+	auto const c = random_matrix<double, 8, 8>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		auto const result = a + b * 2.0 - c / 4.0;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b8 ("Matrix<double, 8, 8>: a + b × 2 - c / 4 lazy", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 8, 8>();
+	auto const b = random_matrix<double, 8, 8>();
+	auto const c = random_matrix<double, 8, 8>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		math::Matrix<double, 8, 8> const result = math::lazy (a) + math::lazy (b) * 2.0 - math::lazy (c) / 4.0;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b9 ("Matrix<double, 8, 8>: a × b + b × a - e eager", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 8, 8>();
+	auto const b = random_matrix<double, 8, 8>();
+	auto const e = random_matrix<double, 8, 8>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		auto const result = a * b + b * a - e;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b10 ("Matrix<double, 8, 8>: a × b + b × a - e lazy", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 8, 8>();
+	auto const b = random_matrix<double, 8, 8>();
+	auto const e = random_matrix<double, 8, 8>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		math::Matrix<double, 8, 8> const result = math::lazy (a) * b + math::lazy (b) * a - e;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b11 ("Matrix<double, 8, 8>: aᵀ × b with transposed()", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 8, 8>();
+	auto b = random_matrix<double, 8, 8>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		do_not_optimize (b);
+		auto const result = a.transposed() * b;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b12 ("Matrix<double, 8, 8>: aᵀ × b with transposed_view()", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 8, 8>();
+	auto b = random_matrix<double, 8, 8>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		do_not_optimize (b);
+		auto const result = a.transposed_view() * b;
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b13 ("Matrix<double, 8, 8>: a × bᵀ with transposed()", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 8, 8>();
+	auto b = random_matrix<double, 8, 8>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		do_not_optimize (b);
+		auto const result = a * b.transposed();
+		do_not_optimize (result);
+	}
+});
+
+
+Benchmark b14 ("Matrix<double, 8, 8>: a × bᵀ with transposed_view()", [](std::size_t const iterations) {
+	auto a = random_matrix<double, 8, 8>();
+	auto b = random_matrix<double, 8, 8>();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		do_not_optimize (b);
+		auto const result = a * b.transposed_view();
+		do_not_optimize (result);
+	}
+});
+
+} // namespace
+} // namespace neutrino::test
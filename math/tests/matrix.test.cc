@@ -0,0 +1,144 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <cstddef>
+#include <random>
+
+
+namespace neutrino::test {
+namespace {
+
+template<class Scalar, std::size_t Columns, std::size_t Rows>
+	math::Matrix<Scalar, Columns, Rows>
+	random_matrix (std::mt19937& generator)
+	{
+		std::uniform_real_distribution<Scalar> distribution (-10.0, 10.0);
+		math::Matrix<Scalar, Columns, Rows> result;
+
+		for (auto& component: result.components())
+			component = distribution (generator);
+
+		return result;
+	}
+
+
+template<class Scalar, std::size_t ARows, std::size_t Common, std::size_t BColumns>
+	void
+	verify_products (std::mt19937& generator, Scalar const epsilon)
+	{
+		auto const a = random_matrix<Scalar, Common, ARows> (generator);
+		auto const b = random_matrix<Scalar, BColumns, Common> (generator);
+		auto const v = random_matrix<Scalar, 1, Common> (generator);
+
+		math::Matrix<Scalar, BColumns, ARows> expected_ab (math::uninitialized);
+		math::simd::product_generic<Scalar, ARows, Common, BColumns> (a.components().data(), b.components().data(), expected_ab.components().data());
+
+		math::Matrix<Scalar, 1, ARows> expected_av (math::uninitialized);
+		math::simd::product_generic<Scalar, ARows, Common, 1> (a.components().data(), v.components().data(), expected_av.components().data());
+
+		auto const name = std::format ("{}×{} × {}×{} {}", Common, ARows, BColumns, Common, typeid (Scalar).name());
+		test_asserts::verify_equal_with_epsilon (name + " matrix × matrix is correct", a * b, expected_ab, epsilon);
+		test_asserts::verify_equal_with_epsilon (name + " matrix × vector is correct", a * v, expected_av, epsilon);
+		test_asserts::verify_equal_with_epsilon (name + " matrix + matrix is correct", a + a, a * Scalar (2), epsilon);
+		test_asserts::verify_equal_with_epsilon (name + " matrix - matrix is correct", (b - b) + b, b, epsilon);
+		test_asserts::verify_equal_with_epsilon (name + " matrix × scalar is correct", a * Scalar (2) - a, a, epsilon);
+	}
+
+
+template<class Scalar>
+	void
+	verify_products_of_all_shapes (std::mt19937& generator, Scalar const epsilon)
+	{
+		verify_products<Scalar, 3, 3, 3> (generator, epsilon);
+		verify_products<Scalar, 3, 3, 4> (generator, epsilon);
+		verify_products<Scalar, 3, 4, 3> (generator, epsilon);
+		verify_products<Scalar, 3, 4, 4> (generator, epsilon);
+		verify_products<Scalar, 4, 3, 3> (generator, epsilon);
+		verify_products<Scalar, 4, 3, 4> (generator, epsilon);
+		verify_products<Scalar, 4, 4, 3> (generator, epsilon);
+		verify_products<Scalar, 4, 4, 4> (generator, epsilon);
+	}
+
+
+AutoTest t1 ("Matrix: SIMD kernels match generic code", []{
+	std::mt19937 generator (1);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		verify_products_of_all_shapes<double> (generator, 1e-12);
+		verify_products_of_all_shapes<float> (generator, 1e-4f);
+	}
+});
+
+
+AutoTest t2 ("Matrix: operators work in constant expressions", []{
+	constexpr math::Matrix<double, 3, 3> a {
+		1.0, 2.0, 3.0,
+		4.0, 5.0, 6.0,
+		7.0, 8.0, 9.0,
+	};
+	constexpr math::Vector<double, 3> v { 1.0, 0.0, -1.0 };
+	constexpr auto av = a * v;
+	constexpr auto aa = a * a + a - 2.0 * a;
+
+	test_asserts::verify ("constexpr matrix × vector", av == math::Vector<double, 3> { -2.0, -2.0, -2.0 });
+	test_asserts::verify ("constexpr matrix arithmetic", aa[0, 0] == 29.0 && aa[2, 2] == 141.0);
+});
+
+
+AutoTest t3 ("Matrix: column-major storage and transposed views", []{
+	std::mt19937 generator (2);
+	auto const a = random_matrix<double, 3, 2> (generator);
+	auto const b = random_matrix<double, 4, 3> (generator);
+	auto const s = random_matrix<double, 4, 4> (generator);
+	auto const v = random_matrix<double, 1, 3> (generator);
+
+	auto const ca = math::storage_order_cast<math::StorageOrder::ColumnMajor> (a);
+	auto const cb = math::storage_order_cast<math::StorageOrder::ColumnMajor> (b);
+	auto const cs = math::storage_order_cast<math::StorageOrder::ColumnMajor> (s);
+
+	test_asserts::verify ("elements are preserved", ca[2, 1] == a[2, 1] && ca[1, 0] == a[1, 0]);
+	test_asserts::verify ("components are column-major", ca.components()[1] == a[0, 1] && ca.components()[2] == a[1, 0]);
+	test_asserts::verify ("conversion back works", math::storage_order_cast<math::StorageOrder::RowMajor> (ca) == a);
+
+	auto const row_major_from_column_major = [](auto const& m) { return math::storage_order_cast<math::StorageOrder::RowMajor> (m); };
+	auto const expected_ab = a * b;
+	auto const expected_ss = s * s;
+	test_asserts::verify_equal_with_epsilon ("column-major × column-major", row_major_from_column_major (ca * cb), expected_ab, 1e-12);
+	test_asserts::verify_equal_with_epsilon ("column-major × row-major", row_major_from_column_major (ca * b), expected_ab, 1e-12);
+	test_asserts::verify_equal_with_epsilon ("row-major × column-major", a * cb, expected_ab, 1e-12);
+	test_asserts::verify_equal_with_epsilon ("square column-major × column-major", row_major_from_column_major (cs * cs), expected_ss, 1e-12);
+	test_asserts::verify_equal_with_epsilon ("column-major × vector", ca * v, a * v, 1e-12);
+	test_asserts::verify_equal_with_epsilon ("element-wise operations", row_major_from_column_major (ca + ca * 2.0 - ca / 2.0), a + a * 2.0 - a / 2.0, 1e-12);
+	test_asserts::verify_equal_with_epsilon ("inverted()", row_major_from_column_major (cs.inverted()), s.inverted(), 1e-9);
+	test_asserts::verify_equal_with_epsilon ("determinant()", cs.determinant(), s.determinant(), 1e-9);
+	test_asserts::verify ("scalars list is read row by row", math::ColumnMajorMatrix<double, 2, 2> { 1.0, 2.0, 3.0, 4.0 }[1, 0] == 2.0);
+
+	// Transposed view shares components with the original matrix:
+	auto const& view = a.transposed_view();
+	test_asserts::verify ("transposed view has no copy", view.components().data() == a.components().data());
+	test_asserts::verify ("transposed view is transposition", row_major_from_column_major (view) == a.transposed());
+	test_asserts::verify_equal_with_epsilon ("product with transposed view", row_major_from_column_major (view * a), a.transposed() * a, 1e-12);
+
+	auto m = a;
+	m.transposed_view()[1, 2] = 42.0;
+	test_asserts::verify ("transposed view is writable", m[2, 1] == 42.0);
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,197 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/math/matrix_decomposition.h>
+#include <neutrino/test/benchmark.h>
+
+// Standard:
+#include <array>
+#include <cstddef>
+#include <format>
+#include <random>
+
+
+namespace neutrino::test {
+namespace {
+
+constexpr std::size_t kRightHandSides = 16;
+
+
+template<std::size_t Columns, std::size_t Rows>
+	math::Matrix<double, Columns, Rows>
+	random_matrix (std::mt19937& generator)
+	{
+		std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+		math::Matrix<double, Columns, Rows> result;
+
+		for (auto& component: result.components())
+			component = distribution (generator);
+
+		return result;
+	}
+
+
+/**
+ * Return symmetric positive-definite matrix, so that all methods can be compared on the same system.
+ */
+template<std::size_t Size>
+	math::Matrix<double, Size, Size>
+	random_system (std::mt19937& generator)
+	{
+		auto const a = random_matrix<Size, Size> (generator);
+		return a * a.transposed() + math::Matrix<double, Size, Size>::equal_diagonal (Size);
+	}
+
+
+/**
+ * Register benchmarks of solving Size-dimensional system A × x = b: with inverted() and with decompositions,
+ * first with one right-hand side and then with many right-hand sides sharing the same matrix.
+ */
+template<std::size_t Size>
+	void
+	register_solve_benchmarks (std::vector<Benchmark>& benchmarks)
+	{
+		auto const name = std::format ("{}×{} system", Size, Size);
+
+		benchmarks.emplace_back (name + ", inverted() × b", [](std::size_t const iterations) {
+			std::mt19937 generator (42);
+			auto a = random_system<Size> (generator);
+			auto const b = random_matrix<1, Size> (generator);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				auto const x = a.inverted() * b;
+				do_not_optimize (x);
+			}
+		});
+
+		benchmarks.emplace_back (name + ", lu().solve (b)", [](std::size_t const iterations) {
+			std::mt19937 generator (42);
+			auto a = random_system<Size> (generator);
+			auto const b = random_matrix<1, Size> (generator);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				auto const x = a.lu().solve (b);
+				do_not_optimize (x);
+			}
+		});
+
+		benchmarks.emplace_back (name + ", cholesky().solve (b)", [](std::size_t const iterations) {
+			std::mt19937 generator (42);
+			auto a = random_system<Size> (generator);
+			auto const b = random_matrix<1, Size> (generator);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				auto const x = a.cholesky().solve (b);
+				do_not_optimize (x);
+			}
+		});
+
+		auto const many_name = std::format ("{}, {} right-hand sides", name, kRightHandSides);
+
+		benchmarks.emplace_back (many_name + ", inverted() × b", [](std::size_t const iterations) {
+			std::mt19937 generator (42);
+			auto a = random_system<Size> (generator);
+			std::array<math::Matrix<double, 1, Size>, kRightHandSides> bs;
+
+			for (auto& b: bs)
+				b = random_matrix<1, Size> (generator);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				auto const inverted = a.inverted();
+
+				for (auto const& b: bs)
+				{
+					auto const x = inverted * b;
+					do_not_optimize (x);
+				}
+			}
+		});
+
+		benchmarks.emplace_back (many_name + ", cached lu().solve (b)", [](std::size_t const iterations) {
+			std::mt19937 generator (42);
+			auto a = random_system<Size> (generator);
+			std::array<math::Matrix<double, 1, Size>, kRightHandSides> bs;
+
+			for (auto& b: bs)
+				b = random_matrix<1, Size> (generator);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				auto const lu = a.lu();
+
+				for (auto const& b: bs)
+				{
+					auto const x = lu.solve (b);
+					do_not_optimize (x);
+				}
+			}
+		});
+
+		benchmarks.emplace_back (many_name + ", cached cholesky().solve (b)", [](std::size_t const iterations) {
+			std::mt19937 generator (42);
+			auto a = random_system<Size> (generator);
+			std::array<math::Matrix<double, 1, Size>, kRightHandSides> bs;
+
+			for (auto& b: bs)
+				b = random_matrix<1, Size> (generator);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				auto const cholesky = a.cholesky();
+
+				for (auto const& b: bs)
+				{
+					auto const x = cholesky.solve (b);
+					do_not_optimize (x);
+				}
+			}
+		});
+
+		benchmarks.emplace_back (many_name + ", lu().solve (B)", [](std::size_t const iterations) {
+			std::mt19937 generator (42);
+			auto a = random_system<Size> (generator);
+			auto const bs = random_matrix<kRightHandSides, Size> (generator);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (a);
+				auto const xs = a.lu().solve (bs);
+				do_not_optimize (xs);
+			}
+		});
+	}
+
+
+std::vector<Benchmark> const g_solve_benchmarks = [] {
+	std::vector<Benchmark> benchmarks;
+	register_solve_benchmarks<4> (benchmarks);
+	register_solve_benchmarks<6> (benchmarks);
+	register_solve_benchmarks<8> (benchmarks);
+	register_solve_benchmarks<12> (benchmarks);
+	return benchmarks;
+}();
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,166 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/math/matrix_decomposition.h>
+#include <neutrino/si/si.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <random>
+#include <type_traits>
+
+
+namespace neutrino::test {
+namespace {
+
+struct WorldSpace: math::CoordinateSystemBase { };
+struct BodySpace: math::CoordinateSystemBase { };
+
+
+template<std::size_t Columns, std::size_t Rows, class TargetSpace = void, class SourceSpace = TargetSpace>
+	math::Matrix<double, Columns, Rows, TargetSpace, SourceSpace>
+	random_matrix (std::mt19937& generator)
+	{
+		std::uniform_real_distribution<double> distribution (-10.0, 10.0);
+		math::Matrix<double, Columns, Rows, TargetSpace, SourceSpace> result;
+
+		for (auto& component: result.components())
+			component = distribution (generator);
+
+		return result;
+	}
+
+
+template<std::size_t Size>
+	void
+	verify_decompositions (std::mt19937& generator)
+	{
+		auto const name = std::format ("{}×{}", Size, Size);
+		auto const a = random_matrix<Size, Size, WorldSpace, BodySpace> (generator);
+		auto const b = random_matrix<1, Size, WorldSpace, void> (generator);
+		auto const bb = random_matrix<3, Size, WorldSpace, void> (generator);
+		// Symmetric positive-definite matrix:
+		auto const spd = a * a.transposed() + math::Matrix<double, Size, Size, WorldSpace, WorldSpace>::equal_diagonal (Size);
+
+		auto const lu = a.lu();
+		auto const x = lu.solve (b);
+		test_asserts::verify (name + " solution has correct coordinate systems",
+							  std::is_same_v<std::remove_cvref_t<decltype (x)>, math::Vector<double, Size, BodySpace, void>>);
+		test_asserts::verify (name + " LU of a random matrix is not singular", !lu.singular());
+		test_asserts::verify_equal_with_epsilon (name + " LU solve (b) satisfies A × x = b", a * x, b, 1e-9);
+		test_asserts::verify_equal_with_epsilon (name + " LU solve (B) satisfies A × X = B", a * lu.solve (bb), bb, 1e-9);
+		test_asserts::verify_equal_with_epsilon (name + " LU inverted() matches Matrix::inverted()", lu.inverted(), a.inverted(), 1e-9);
+
+		auto const cholesky = spd.cholesky();
+		test_asserts::verify (name + " SPD matrix is positive-definite", cholesky.positive_definite());
+		test_asserts::verify_equal_with_epsilon (name + " Cholesky solve (b) satisfies A × x = b", spd * cholesky.solve (b), b, 1e-9);
+		test_asserts::verify_equal_with_epsilon (name + " Cholesky solve (B) satisfies A × X = B", spd * cholesky.solve (bb), bb, 1e-9);
+		test_asserts::verify_equal_with_epsilon (name + " Cholesky determinant matches LU determinant",
+												 cholesky.determinant() / spd.lu().determinant(), 1.0, 1e-9);
+	}
+
+
+AutoTest t1 ("Matrix: LU and Cholesky decompositions solve linear systems", []{
+	std::mt19937 generator (1);
+
+	for (int i = 0; i < 20; ++i)
+	{
+		verify_decompositions<1> (generator);
+		verify_decompositions<2> (generator);
+		verify_decompositions<3> (generator);
+		verify_decompositions<4> (generator);
+		verify_decompositions<7> (generator);
+		verify_decompositions<12> (generator);
+	}
+});
+
+
+AutoTest t2 ("Matrix: LU decomposition uses partial pivoting", []{
+	// Gauss-Jordan without pivoting fails on zero leading element:
+	math::Matrix<double, 4, 4> const a {
+		0.0, 2.0, 1.0, 3.0,
+		1.0, 0.0, 4.0, 1.0,
+		2.0, 1.0, 0.0, 5.0,
+		3.0, 4.0, 1.0, 0.0,
+	};
+	math::Vector<double, 4> const b { 1.0, 2.0, 3.0, 4.0 };
+
+	auto const lu = a.lu();
+	test_asserts::verify_equal_with_epsilon ("solution is correct", a * lu.solve (b), b, 1e-12);
+	test_asserts::verify ("permutation was used", lu.permutation()[0] != 0);
+
+	math::Matrix<double, 4, 4> const singular {
+		1.0, 2.0, 3.0, 4.0,
+		2.0, 4.0, 6.0, 8.0,
+		1.0, 0.0, 1.0, 0.0,
+		0.0, 1.0, 0.0, 1.0,
+	};
+	test_asserts::verify ("singular matrix is detected", singular.lu().singular());
+	test_asserts::verify ("determinant of singular matrix is 0", singular.determinant() == 0.0);
+
+	math::Matrix<double, 4, 4> const indefinite (math::identity);
+	test_asserts::verify ("non-positive-definite matrix is detected", !(-indefinite).cholesky().positive_definite());
+});
+
+
+AutoTest t3 ("Matrix: determinant()", []{
+	std::mt19937 generator (1);
+	auto const a = random_matrix<3, 3> (generator);
+	auto const b = random_matrix<3, 3> (generator);
+
+	// Closed-form and LU paths must agree:
+	auto const closed_form = a.determinant();
+	test_asserts::verify_equal_with_epsilon ("3×3 determinant matches LU", closed_form, a.lu().determinant(), 1e-9);
+	test_asserts::verify_equal_with_epsilon ("det (A × B) = det (A) × det (B)", math::det (a * b), math::det (a) * math::det (b), 1e-6);
+
+	math::Matrix<double, 5, 5> const diagonal = math::Matrix<double, 5, 5>::equal_diagonal (2.0);
+	test_asserts::verify_equal_with_epsilon ("5×5 diagonal determinant", diagonal.determinant(), 32.0, 1e-12);
+
+	constexpr math::Matrix<double, 4, 4> c {
+		2.0, 0.0, 0.0, 1.0,
+		0.0, 3.0, 0.0, 0.0,
+		0.0, 0.0, 4.0, 0.0,
+		1.0, 0.0, 0.0, 1.0,
+	};
+	constexpr auto constexpr_det = c.determinant();
+	test_asserts::verify ("determinant works in constant expressions", constexpr_det == 12.0);
+});
+
+
+AutoTest t4 ("Matrix: decompositions of SI quantities", []{
+	using namespace si::literals;
+
+	math::Matrix<si::Length, 4, 4> const a {
+		4_m, 1_m, 0_m, 0_m,
+		1_m, 4_m, 1_m, 0_m,
+		0_m, 1_m, 4_m, 1_m,
+		0_m, 0_m, 1_m, 4_m,
+	};
+	math::Vector<si::Area, 4> const b { 1_m2, 2_m2, 3_m2, 4_m2 };
+
+	auto const x_lu = a.lu().solve (b);
+	auto const x_cholesky = a.cholesky().solve (b);
+
+	test_asserts::verify ("solution has correct unit", std::is_same_v<std::remove_cvref_t<decltype (x_lu[0])>, si::Length>);
+	test_asserts::verify_equal_with_epsilon ("LU solution is correct", a * x_lu, b, 1e-12_m2);
+	test_asserts::verify_equal_with_epsilon ("Cholesky solution is correct", a * x_cholesky, b, 1e-12_m2);
+	test_asserts::verify_equal_with_epsilon ("determinant has correct unit", a.determinant(), 209_m2 * 1_m2, 1e-9_m2 * 1_m2);
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,150 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/math/matrix_expression.h>
+#include <neutrino/si/si.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <cstddef>
+#include <random>
+#include <type_traits>
+
+
+namespace neutrino::test {
+namespace {
+
+struct WorldSpace: math::CoordinateSystemBase { };
+struct BodySpace: math::CoordinateSystemBase { };
+struct SensorSpace: math::CoordinateSystemBase { };
+
+
+template<class A, class B>
+	constexpr bool kCanAddLazily = requires (A const& a, B const& b) { math::lazy (a) + b; };
+
+template<class A, class B>
+	constexpr bool kCanMultiplyLazily = requires (A const& a, B const& b) { math::lazy (a) * b; };
+
+
+template<std::size_t Columns, std::size_t Rows, class TargetSpace = void, class SourceSpace = TargetSpace>
+	math::Matrix<double, Columns, Rows, TargetSpace, SourceSpace>
+	random_matrix (std::mt19937& generator)
+	{
+		std::uniform_real_distribution<double> distribution (-10.0, 10.0);
+		math::Matrix<double, Columns, Rows, TargetSpace, SourceSpace> result;
+
+		for (auto& component: result.components())
+			component = distribution (generator);
+
+		return result;
+	}
+
+
+AutoTest t1 ("MatrixExpression: lazy expressions match eager operators", []{
+	std::mt19937 generator (1);
+	auto const a = random_matrix<4, 4> (generator);
+	auto const b = random_matrix<4, 4> (generator);
+	auto const c = random_matrix<4, 4> (generator);
+	auto const d = random_matrix<4, 4> (generator);
+	auto const e = random_matrix<4, 4> (generator);
+	auto const v = random_matrix<1, 4> (generator);
+
+	math::Matrix<double, 4, 4> const fused = math::lazy (a) * b + math::lazy (c) * d - e;
+	test_asserts::verify_equal_with_epsilon ("a × b + c × d - e", fused, a * b + c * d - e, 1e-9);
+
+	math::Matrix<double, 4, 4> const scaled = -math::lazy (a) + b * 2.0 - math::lazy (c) / 4.0 + 3.0 * math::lazy (d);
+	test_asserts::verify_equal_with_epsilon ("element-wise operations", scaled, -a + b * 2.0 - c / 4.0 + 3.0 * d, 1e-9);
+
+	auto const nested = math::evaluate (math::lazy (a) * (math::lazy (b) * c + d) * v);
+	test_asserts::verify_equal_with_epsilon ("nested products", nested, a * (b * c + d) * v, 1e-9);
+
+	auto const from_temporary = math::evaluate (math::lazy (a + b) - c);
+	test_asserts::verify_equal_with_epsilon ("temporary operands are copied", from_temporary, a + b - c, 1e-9);
+
+	auto sum = a;
+	sum += math::lazy (b) * c;
+	test_asserts::verify_equal_with_epsilon ("compound assignment", sum, a + b * c, 1e-9);
+});
+
+
+AutoTest t2 ("MatrixExpression: coordinate systems are checked", []{
+	std::mt19937 generator (1);
+	auto const world_from_body = random_matrix<3, 3, WorldSpace, BodySpace> (generator);
+	auto const body_from_sensor = random_matrix<3, 3, BodySpace, SensorSpace> (generator);
+	auto const world_from_sensor = random_matrix<3, 3, WorldSpace, SensorSpace> (generator);
+
+	auto const result = math::evaluate (math::lazy (world_from_body) * body_from_sensor + world_from_sensor);
+
+	test_asserts::verify ("result has correct coordinate systems",
+						  std::is_same_v<std::remove_cvref_t<decltype (result)>, math::Matrix<double, 3, 3, WorldSpace, SensorSpace>>);
+	test_asserts::verify_equal_with_epsilon ("result is correct", result, world_from_body * body_from_sensor + world_from_sensor, 1e-9);
+
+	using WorldFromBody = std::remove_cvref_t<decltype (world_from_body)>;
+	using BodyFromSensor = std::remove_cvref_t<decltype (body_from_sensor)>;
+	using WorldFromSensor = std::remove_cvref_t<decltype (world_from_sensor)>;
+
+	test_asserts::verify ("adding matrices with same spaces compiles", kCanAddLazily<WorldFromSensor, WorldFromSensor>);
+	test_asserts::verify ("adding matrices with different spaces doesn't compile", !kCanAddLazily<WorldFromBody, WorldFromSensor>);
+	test_asserts::verify ("multiplying matrices with matching spaces compiles", kCanMultiplyLazily<WorldFromBody, BodyFromSensor>);
+	test_asserts::verify ("multiplying matrices with mismatched spaces doesn't compile", !kCanMultiplyLazily<BodyFromSensor, WorldFromBody>);
+});
+
+
+AutoTest t3 ("MatrixExpression: expressions work in constant expressions", []{
+	constexpr math::Matrix<double, 3, 3> a {
+		1.0, 2.0, 3.0,
+		4.0, 5.0, 6.0,
+		7.0, 8.0, 9.0,
+	};
+	constexpr math::Matrix<double, 3, 3> aa = math::lazy (a) * a + a - 2.0 * math::lazy (a);
+
+	test_asserts::verify ("constexpr lazy arithmetic", aa[0, 0] == 29.0 && aa[2, 2] == 141.0);
+});
+
+
+AutoTest t4 ("MatrixExpression: SI quantities", []{
+	using namespace si::literals;
+
+	math::Matrix<si::Length, 2, 2> const a { 1_m, 2_m, 3_m, 4_m };
+	math::Matrix<si::Time, 2, 2> const b { 1_s, 0_s, 0_s, 2_s };
+
+	auto const product = math::evaluate (math::lazy (a) * b + math::lazy (a) * b);
+	test_asserts::verify ("quantity product", product[1, 1] == 16_m * 1_s && product[0, 1] == 6_m * 1_s);
+
+	auto const speed = math::evaluate (math::lazy (a) / 2_s);
+	test_asserts::verify ("quantity division", speed[1, 0] == 1_mps);
+});
+
+
+AutoTest t5 ("MatrixExpression: operands with mixed storage orders", []{
+	std::mt19937 generator (2);
+	auto const a = random_matrix<4, 3> (generator);
+	auto const b = random_matrix<3, 4> (generator);
+	auto const c = random_matrix<3, 3> (generator);
+	auto const column_major_b = math::storage_order_cast<math::StorageOrder::ColumnMajor> (b);
+	auto const column_major_c = math::storage_order_cast<math::StorageOrder::ColumnMajor> (c);
+
+	math::Matrix<double, 3, 3> const mixed = math::lazy (a) * column_major_b + column_major_c;
+	test_asserts::verify_equal_with_epsilon ("row-major × column-major + column-major", mixed, a * b + c, 1e-9);
+
+	math::Matrix<double, 3, 3> const column_major_first = math::lazy (column_major_c) * c - math::lazy (column_major_c);
+	test_asserts::verify_equal_with_epsilon ("column-major operand starts an expression", column_major_first, c * c - c, 1e-9);
+
+	math::Matrix<double, 4, 4> const transposed = math::lazy (a.transposed_view()) * b.transposed_view();
+	test_asserts::verify_equal_with_epsilon ("transposed views are used without copying", transposed, (b * a).transposed(), 1e-9);
+});
+
+} // namespace
+} // namespace neutrino::test
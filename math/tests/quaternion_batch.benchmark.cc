@@ -0,0 +1,223 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/math/quaternion_batch.h>
+#include <neutrino/test/benchmark.h>
+
+// Standard:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+constexpr std::size_t kQuaternions = 100'000;
+constexpr double kDt = 1e-3;
+
+
+std::vector<math::Quaternion<double>>
+random_quaternions (unsigned int const seed)
+{
+	std::mt19937 generator (seed);
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+	std::vector<math::Quaternion<double>> result;
+	result.reserve (kQuaternions);
+
+	for (std::size_t i = 0; i < kQuaternions; ++i)
+		result.push_back (math::Quaternion<double> (distribution (generator), distribution (generator), distribution (generator), distribution (generator)).normalized());
+
+	return result;
+}
+
+
+std::vector<math::Vector<double, 3>>
+random_vectors()
+{
+	std::mt19937 generator (42);
+	std::uniform_real_distribution<double> distribution (-10.0, 10.0);
+	std::vector<math::Vector<double, 3>> result (kQuaternions);
+
+	for (auto& vector: result)
+		for (auto& component: vector.components())
+			component = distribution (generator);
+
+	return result;
+}
+
+
+Benchmark b1 ("100k × Quaternion<double> × Quaternion, array of quaternions", [](std::size_t const iterations) {
+	auto const a = random_quaternions (1);
+	auto const b = random_quaternions (2);
+	std::vector<math::Quaternion<double>> output (kQuaternions);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		do_not_optimize (b);
+
+		for (std::size_t j = 0; j < kQuaternions; ++j)
+			output[j] = a[j] * b[j];
+
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b2 ("100k × Quaternion<double> × Quaternion, QuaternionBatch", [](std::size_t const iterations) {
+	auto const a = math::QuaternionBatch<double> (std::span<math::Quaternion<double> const> (random_quaternions (1)));
+	auto const b = math::QuaternionBatch<double> (std::span<math::Quaternion<double> const> (random_quaternions (2)));
+	math::QuaternionBatch<double> output;
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		do_not_optimize (b);
+		math::multiply (a, b, output);
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b3 ("100k × Quaternion<double> × Vector, array of quaternions", [](std::size_t const iterations) {
+	auto const rotations = random_quaternions (1);
+	auto const vectors = random_vectors();
+	std::vector<math::Vector<double, 3>> output (kQuaternions);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (rotations);
+		do_not_optimize (vectors);
+
+		for (std::size_t j = 0; j < kQuaternions; ++j)
+			output[j] = rotations[j] * vectors[j];
+
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b4 ("100k × Quaternion<double> × Vector, QuaternionBatch", [](std::size_t const iterations) {
+	auto const rotations = math::QuaternionBatch<double> (std::span<math::Quaternion<double> const> (random_quaternions (1)));
+	auto const vectors = math::VectorBatch<double, 3> (std::span<math::Vector<double, 3> const> (random_vectors()));
+	math::VectorBatch<double, 3> output;
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (rotations);
+		do_not_optimize (vectors);
+		math::rotate (rotations, vectors, output);
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b5 ("100k × angular velocity integration step, array of quaternions, normalized()", [](std::size_t const iterations) {
+	auto orientations = random_quaternions (1);
+	auto const omegas = random_vectors();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (orientations);
+		do_not_optimize (omegas);
+
+		for (std::size_t j = 0; j < kQuaternions; ++j)
+		{
+			auto const omega = omegas[j];
+			auto const angle = abs (omega) * kDt;
+			auto const axis = omega / abs (omega);
+			auto const half_sin = std::sin (angle / 2);
+			auto const delta = math::Quaternion<double> (std::cos (angle / 2), half_sin * axis[0], half_sin * axis[1], half_sin * axis[2]);
+			orientations[j] = (orientations[j] * delta).normalized();
+		}
+
+		do_not_optimize (orientations);
+	}
+});
+
+
+Benchmark b6 ("100k × angular velocity integration step, QuaternionBatch, normalize()", [](std::size_t const iterations) {
+	auto orientations = math::QuaternionBatch<double> (std::span<math::Quaternion<double> const> (random_quaternions (1)));
+	auto const omegas = math::VectorBatch<double, 3> (std::span<math::Vector<double, 3> const> (random_vectors()));
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (orientations);
+		do_not_optimize (omegas);
+		math::integrate_angular_velocity (orientations, omegas, kDt);
+		math::normalize (orientations);
+		do_not_optimize (orientations);
+	}
+});
+
+
+Benchmark b7 ("100k × angular velocity integration step, QuaternionBatch, fast_renormalize()", [](std::size_t const iterations) {
+	auto orientations = math::QuaternionBatch<double> (std::span<math::Quaternion<double> const> (random_quaternions (1)));
+	auto const omegas = math::VectorBatch<double, 3> (std::span<math::Vector<double, 3> const> (random_vectors()));
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (orientations);
+		do_not_optimize (omegas);
+		math::integrate_angular_velocity (orientations, omegas, kDt);
+		math::fast_renormalize (orientations);
+		do_not_optimize (orientations);
+	}
+});
+
+
+Benchmark b8 ("100k × slerp, array of quaternions", [](std::size_t const iterations) {
+	auto const a = random_quaternions (1);
+	auto const b = random_quaternions (2);
+	std::vector<math::Quaternion<double>> output (kQuaternions);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		do_not_optimize (b);
+
+		for (std::size_t j = 0; j < kQuaternions; ++j)
+		{
+			auto const cos_angle = a[j].w() * b[j].w() + a[j].x() * b[j].x() + a[j].y() * b[j].y() + a[j].z() * b[j].z();
+			auto const sign = std::copysign (1.0, cos_angle);
+			auto const angle = std::acos (std::min (std::abs (cos_angle), 1.0));
+			auto const sin_angle = std::sin (angle);
+			output[j] = (std::sin (0.7 * angle) * a[j] + sign * std::sin (0.3 * angle) * b[j]) / sin_angle;
+		}
+
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b9 ("100k × slerp, QuaternionBatch", [](std::size_t const iterations) {
+	auto const a = math::QuaternionBatch<double> (std::span<math::Quaternion<double> const> (random_quaternions (1)));
+	auto const b = math::QuaternionBatch<double> (std::span<math::Quaternion<double> const> (random_quaternions (2)));
+	math::QuaternionBatch<double> output;
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (a);
+		do_not_optimize (b);
+		math::slerp (a, b, 0.3, output);
+		do_not_optimize (output);
+	}
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,233 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/math/quaternion_batch.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+struct WorldSpace: math::CoordinateSystemBase { };
+struct BodySpace: math::CoordinateSystemBase { };
+
+
+template<class Scalar, class TargetSpace, class SourceSpace>
+	math::QuaternionBatch<Scalar, TargetSpace, SourceSpace>
+	random_unit_batch (std::mt19937& generator, std::size_t const count)
+	{
+		std::uniform_real_distribution<Scalar> distribution (-1.0, 1.0);
+		math::QuaternionBatch<Scalar, TargetSpace, SourceSpace> result;
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto const q = math::Quaternion<Scalar, TargetSpace, SourceSpace> (distribution (generator), distribution (generator),
+																			   distribution (generator), distribution (generator));
+			result.push_back (q.normalized());
+		}
+
+		return result;
+	}
+
+
+template<class Scalar>
+	math::VectorBatch<Scalar, 3, BodySpace, void>
+	random_vectors (std::mt19937& generator, std::size_t const count, Scalar const max_component)
+	{
+		std::uniform_real_distribution<Scalar> distribution (-max_component, max_component);
+		math::VectorBatch<Scalar, 3, BodySpace, void> result (count);
+
+		for (std::size_t i = 0; i < count; ++i)
+			result.set (i, { distribution (generator), distribution (generator), distribution (generator) });
+
+		return result;
+	}
+
+
+template<class Quaternion>
+	typename Quaternion::Scalar
+	dot (Quaternion const& a, Quaternion const& b)
+	{
+		return a.w() * b.w() + a.x() * b.x() + a.y() * b.y() + a.z() * b.z();
+	}
+
+
+/**
+ * Reference slerp computed with trigonometric functions.
+ */
+template<class Quaternion>
+	Quaternion
+	reference_slerp (Quaternion const& a, Quaternion b, typename Quaternion::Scalar const t)
+	{
+		auto cos_angle = dot (a, b);
+
+		if (cos_angle < 0)
+		{
+			b = -b;
+			cos_angle = -cos_angle;
+		}
+
+		auto const angle = std::acos (std::min<decltype (cos_angle)> (cos_angle, 1));
+
+		if (angle < 1e-6)
+			return a;
+
+		return (std::sin ((1 - t) * angle) * a + std::sin (t * angle) * b) / std::sin (angle);
+	}
+
+
+// 256 quaternions go through SIMD packs of any width, the last one through the scalar tail:
+constexpr std::size_t kCount = 257;
+
+
+AutoTest t1 ("QuaternionBatch: multiply(), conjugated() and rotate() match Quaternion operations", []{
+	std::mt19937 generator (1);
+
+	auto const verify = [&]<class Scalar> (Scalar const epsilon) {
+		auto const a = random_unit_batch<Scalar, WorldSpace, BodySpace> (generator, kCount);
+		auto const b = random_unit_batch<Scalar, BodySpace, BodySpace> (generator, kCount);
+		auto const vectors = random_vectors<Scalar> (generator, kCount, 10);
+		auto const single = math::Quaternion<Scalar, WorldSpace, BodySpace> (0.5, -0.5, 0.5, 0.5);
+
+		math::QuaternionBatch<Scalar, WorldSpace, BodySpace> const products = math::multiply (a, b);
+		math::QuaternionBatch<Scalar, WorldSpace, BodySpace> const single_products = math::multiply (single, b);
+		math::QuaternionBatch<Scalar, BodySpace, WorldSpace> const conjugates = math::conjugated (a);
+		math::VectorBatch<Scalar, 3, WorldSpace, void> const rotated = math::rotate (a, vectors);
+
+		auto in_place = a;
+		math::multiply (in_place, b, in_place);
+
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			test_asserts::verify_equal_with_epsilon ("multiply() matches Hamilton product", products[i], a[i] * b[i], epsilon);
+			test_asserts::verify_equal_with_epsilon ("multiply() with single quaternion works", single_products[i], single * b[i], epsilon);
+			test_asserts::verify_equal_with_epsilon ("in-place multiply() works", in_place[i], products[i], epsilon);
+			test_asserts::verify_equal_with_epsilon ("conjugated() matches Quaternion::conjugated()", conjugates[i], a[i].conjugated(), epsilon);
+			test_asserts::verify_equal_with_epsilon ("rotate() matches quaternion × vector", rotated[i], a[i] * vectors[i], epsilon);
+		}
+	};
+
+	verify (1e-12);
+	verify (1e-5f);
+});
+
+
+AutoTest t2 ("QuaternionBatch: nlerp() and slerp()", []{
+	std::mt19937 generator (2);
+
+	// Slerp error bound is dominated by the truncated series (about 4.5e-8 for double), not by rounding:
+	auto const verify = [&]<class Scalar> (Scalar const epsilon, Scalar const slerp_epsilon) {
+		auto const a = random_unit_batch<Scalar, WorldSpace, BodySpace> (generator, kCount);
+		auto const b = random_unit_batch<Scalar, WorldSpace, BodySpace> (generator, kCount);
+		auto const nlerped = math::nlerp (a, b, Scalar (0.3));
+
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			auto const shorter_b = dot (a[i], b[i]) < 0 ? -b[i] : b[i];
+			auto const expected = (Scalar (0.7) * a[i] + Scalar (0.3) * shorter_b).normalized();
+			test_asserts::verify_equal_with_epsilon ("nlerp() interpolates along the shorter arc", nlerped[i], expected, epsilon);
+		}
+
+		for (Scalar const t: { Scalar (0), Scalar (0.25), Scalar (0.5), Scalar (0.9), Scalar (1) })
+		{
+			auto const slerped = math::slerp (a, b, t);
+
+			for (std::size_t i = 0; i < kCount; ++i)
+				test_asserts::verify_equal_with_epsilon ("slerp() matches exact slerp", slerped[i], reference_slerp (a[i], b[i], t), slerp_epsilon);
+		}
+	};
+
+	verify (1e-12, 1e-7);
+	verify (1e-5f, 1e-5f);
+});
+
+
+AutoTest t3 ("QuaternionBatch: in-place conjugate(), normalize() and resize()", []{
+	using Quaternion = math::Quaternion<double, BodySpace, BodySpace>;
+
+	std::vector<Quaternion> const quaternions { Quaternion (1.0, 2.0, 3.0, 4.0), Quaternion (5.0, 6.0, 7.0, 8.0) };
+	math::QuaternionBatch<double, BodySpace, BodySpace> batch (std::span<Quaternion const> { quaternions });
+
+	batch.resize (3);
+	test_asserts::verify ("resize() adds identity quaternions", batch[2].components() == Quaternion (math::identity).components());
+
+	math::conjugate (batch);
+	test_asserts::verify ("conjugate() works in place", batch[1].components() == Quaternion (5.0, -6.0, -7.0, -8.0).components());
+	test_asserts::verify ("conjugate() keeps identity", batch[2].components() == Quaternion (math::identity).components());
+
+	math::normalize (batch);
+	test_asserts::verify_equal_with_epsilon ("normalize() works", batch[1], Quaternion (5.0, -6.0, -7.0, -8.0).normalized(), 1e-12);
+
+	auto const other = math::QuaternionBatch<double, BodySpace, BodySpace> (2);
+	test_asserts::verify_throws<std::length_error> ("multiply() with different sizes throws", [&] { (void) math::multiply (batch, other); });
+});
+
+
+AutoTest t4 ("QuaternionBatch: angular velocity integration and renormalization", []{
+	using Quaternion = math::Quaternion<double, WorldSpace, BodySpace>;
+
+	std::mt19937 generator (3);
+	constexpr double kDt = 0.01;
+	auto batch = random_unit_batch<double, WorldSpace, BodySpace> (generator, kCount);
+	// Up to 100 rad/s, so up to 1 rad per step:
+	auto const omegas = random_vectors<double> (generator, kCount, 100.0 / std::sqrt (3.0) * 0.99);
+	auto const initial = batch;
+
+	math::integrate_angular_velocity (batch, omegas, kDt);
+
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		auto const omega = omegas[i];
+		auto const half_angle = abs (omega) * kDt / 2;
+		auto const axis = omega / abs (omega);
+		auto const delta = math::Quaternion<double, BodySpace, BodySpace> (std::cos (half_angle), std::sin (half_angle) * axis[0],
+																		   std::sin (half_angle) * axis[1], std::sin (half_angle) * axis[2]);
+		auto const expected = initial[i] * delta;
+
+		test_asserts::verify_equal_with_epsilon ("integrate_angular_velocity() matches exact rotation", batch[i], expected, 1e-9);
+	}
+
+	// Constant angular velocity around Z axis for 1000 steps should give rotation by 1000 × ω × dt:
+	math::QuaternionBatch<double, WorldSpace, BodySpace> spinning (1);
+	math::VectorBatch<double, 3, BodySpace, void> spin;
+	spin.push_back ({ 0.0, 0.0, 2.0 });
+
+	for (std::size_t step = 0; step < 1000; ++step)
+	{
+		math::integrate_angular_velocity (spinning, spin, 1e-3);
+		math::fast_renormalize (spinning);
+	}
+
+	test_asserts::verify_equal_with_epsilon ("repeated integration works", spinning[0], Quaternion (std::cos (1.0), 0.0, 0.0, std::sin (1.0)), 1e-9);
+
+	// Fast renormalization should square the norm error:
+	math::QuaternionBatch<double, WorldSpace, BodySpace> denormalized (1);
+	denormalized.set (0, Quaternion (1.001, 0.0, 0.0, 0.0));
+	math::fast_renormalize (denormalized);
+	test_asserts::verify_equal_with_epsilon ("fast_renormalize() reduces norm error quadratically", denormalized[0].norm(), 1.0, 2e-6);
+	test_asserts::verify ("fast_renormalize() is approximate", denormalized[0].norm() != 1.0);
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,157 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/sparse_matrix.h>
+#include <neutrino/test/benchmark.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <cstddef>
+#include <format>
+#include <thread>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+Logger g_null_logger;
+
+
+/**
+ * Return 2D Poisson matrix (5-point stencil) on a Side×Side grid.
+ */
+math::CsrMatrix<double>
+poisson_2d (std::size_t const side)
+{
+	auto const size = side * side;
+	std::vector<math::SparseElement<double>> elements;
+
+	for (std::size_t y = 0; y < side; ++y)
+	{
+		for (std::size_t x = 0; x < side; ++x)
+		{
+			auto const i = y * side + x;
+			elements.push_back ({ i, i, 4.0 });
+
+			if (x > 0)
+				elements.push_back ({ i - 1, i, -1.0 });
+
+			if (x + 1 < side)
+				elements.push_back ({ i + 1, i, -1.0 });
+
+			if (y > 0)
+				elements.push_back ({ i - side, i, -1.0 });
+
+			if (y + 1 < side)
+				elements.push_back ({ i + side, i, -1.0 });
+		}
+	}
+
+	return math::CsrMatrix<double> (size, size, elements);
+}
+
+
+/**
+ * Register benchmarks of matrix × vector products for the 2D Poisson problem: dense, CSR and CSR on all hardware
+ * threads.
+ */
+template<std::size_t Side>
+	void
+	register_spmv_benchmarks (std::vector<Benchmark>& benchmarks)
+	{
+		constexpr auto kSize = Side * Side;
+		auto const name = std::format ("Poisson {}×{} matrix × vector", kSize, kSize);
+
+		benchmarks.emplace_back (name + " dense", [](std::size_t const iterations) {
+			auto const a = poisson_2d (Side).to_dense();
+			auto x = math::DynamicMatrix<double> (1, kSize);
+			x.components()[0] = 1.0;
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (x);
+				auto const y = a * x;
+				do_not_optimize (y);
+			}
+		});
+
+		benchmarks.emplace_back (name + " CSR", [](std::size_t const iterations) {
+			auto const a = poisson_2d (Side);
+			std::vector<double> x (kSize, 1.0);
+			std::vector<double> y (kSize);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (x);
+				math::multiply (a, std::span<double const> (x), std::span<double> (y));
+				do_not_optimize (y);
+			}
+		});
+
+		benchmarks.emplace_back (name + " CSR on WorkPerformer", [](std::size_t const iterations) {
+			WorkPerformer work_performer (std::thread::hardware_concurrency(), g_null_logger);
+			auto const a = poisson_2d (Side);
+			std::vector<double> x (kSize, 1.0);
+			std::vector<double> y (kSize);
+
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				do_not_optimize (x);
+				math::multiply (a, std::span<double const> (x), std::span<double> (y), work_performer);
+				do_not_optimize (y);
+			}
+		});
+	}
+
+
+std::vector<Benchmark> const g_spmv_benchmarks = [] {
+	std::vector<Benchmark> benchmarks;
+	register_spmv_benchmarks<16> (benchmarks);
+	register_spmv_benchmarks<48> (benchmarks);
+	return benchmarks;
+}();
+
+
+Benchmark b1 ("Poisson 2304×2304 solve, CG with Jacobi preconditioner", [](std::size_t const iterations) {
+	auto const a = poisson_2d (48);
+	std::vector<double> const b (a.n_rows(), 1.0);
+	std::vector<double> x (a.n_rows());
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		std::ranges::fill (x, 0.0);
+		auto const result = math::conjugate_gradient (a, std::span<double const> (b), std::span<double> (x), { .tolerance = 1e-8 });
+		do_not_optimize (result);
+		do_not_optimize (x);
+	}
+});
+
+
+Benchmark b2 ("Poisson 2304×2304 solve, BiCGSTAB with Jacobi preconditioner", [](std::size_t const iterations) {
+	auto const a = poisson_2d (48);
+	std::vector<double> const b (a.n_rows(), 1.0);
+	std::vector<double> x (a.n_rows());
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		std::ranges::fill (x, 0.0);
+		auto const result = math::bicgstab (a, std::span<double const> (b), std::span<double> (x), { .tolerance = 1e-8 });
+		do_not_optimize (result);
+		do_not_optimize (x);
+	}
+});
+
+} // namespace
+} // namespace neutrino::test
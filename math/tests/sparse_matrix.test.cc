@@ -0,0 +1,235 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/sparse_matrix.h>
+#include <neutrino/test/auto_test.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+Logger g_null_logger;
+
+
+/**
+ * Return random sparse matrix with about `density` × N² non-zero elements.
+ * If diagonally_dominant is set, diagonal gets large enough values to make iterative methods converge.
+ */
+std::vector<math::SparseElement<double>>
+random_elements (std::mt19937& generator, std::size_t const size, double const density, bool const diagonally_dominant)
+{
+	std::uniform_real_distribution<double> value (-1.0, 1.0);
+	std::uniform_real_distribution<double> probability (0.0, 1.0);
+	std::vector<math::SparseElement<double>> result;
+
+	for (std::size_t r = 0; r < size; ++r)
+		for (std::size_t c = 0; c < size; ++c)
+			if (c != r && probability (generator) < density)
+				result.push_back ({ c, r, value (generator) });
+
+	if (diagonally_dominant)
+		for (std::size_t i = 0; i < size; ++i)
+			result.push_back ({ i, i, 2.0 + size * density * 2.0 });
+
+	return result;
+}
+
+
+/**
+ * Return 1D Poisson matrix (tridiagonal 2, -1), which is symmetric and positive-definite.
+ */
+math::CsrMatrix<double>
+poisson_matrix (std::size_t const size)
+{
+	std::vector<math::SparseElement<double>> elements;
+
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		elements.push_back ({ i, i, 2.0 });
+
+		if (i > 0)
+			elements.push_back ({ i - 1, i, -1.0 });
+
+		if (i + 1 < size)
+			elements.push_back ({ i + 1, i, -1.0 });
+	}
+
+	return math::CsrMatrix<double> (size, size, elements);
+}
+
+
+void
+verify_residual (std::string const& name, math::CsrMatrix<double> const& a, std::vector<double> const& x, std::vector<double> const& b, double const epsilon)
+{
+	auto const ax = a * x;
+
+	for (std::size_t i = 0; i < b.size(); ++i)
+		test_asserts::verify_equal_with_epsilon (name, ax[i], b[i], epsilon);
+}
+
+
+AutoTest t1 ("SparseMatrix: construction and conversions", []{
+	std::vector<math::SparseElement<double>> const elements {
+		{ 2, 0, 3.0 },
+		{ 0, 0, 1.0 },
+		{ 1, 2, 4.0 },
+		{ 1, 2, 0.5 }, // Duplicate, should be summed.
+		{ 3, 1, 2.0 },
+	};
+
+	auto const csr = math::CsrMatrix<double> (4, 3, elements);
+	auto const csc = math::CscMatrix<double> (4, 3, elements);
+	auto const dense = math::DynamicMatrix<double> (4, 3, {
+		1.0, 0.0, 3.0, 0.0,
+		0.0, 0.0, 0.0, 2.0,
+		0.0, 4.5, 0.0, 0.0,
+	});
+
+	test_asserts::verify ("duplicates are summed", csr.non_zeros() == 4 && csr.at (1, 2) == 4.5);
+	test_asserts::verify ("CSR offsets are correct", std::ranges::equal (csr.offsets(), std::vector<std::size_t> { 0, 2, 3, 4 }));
+	test_asserts::verify ("CSC offsets are correct", std::ranges::equal (csc.offsets(), std::vector<std::size_t> { 0, 1, 2, 3, 4 }));
+	test_asserts::verify ("CSR to_dense() works", csr.to_dense() == dense);
+	test_asserts::verify ("CSC to_dense() works", csc.to_dense() == dense);
+	test_asserts::verify ("construction from dense matrix works", math::CsrMatrix<double> (dense).to_dense() == dense);
+	test_asserts::verify ("CSR → CSC conversion works", math::CscMatrix<double> (csr).to_dense() == dense);
+	test_asserts::verify ("CSC → CSR conversion works", math::CsrMatrix<double> (csc).to_dense() == dense);
+	test_asserts::verify ("missing elements are zero", csr.at (1, 0) == 0.0 && csc.at (3, 2) == 0.0);
+	test_asserts::verify_throws<std::out_of_range> ("at() checks bounds", [&] { (void) csr.at (4, 0); });
+	test_asserts::verify_throws<std::out_of_range> ("elements outside matrix throw", [] {
+		math::CsrMatrix<double> (2, 2, std::vector<math::SparseElement<double>> { { 2, 0, 1.0 } });
+	});
+});
+
+
+AutoTest t2 ("SparseMatrix: products match dense products", []{
+	std::mt19937 generator (1);
+	WorkPerformer work_performer (4, g_null_logger);
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+
+	for (std::size_t const size: { 1u, 17u, 200u })
+	{
+		auto const elements = random_elements (generator, size, 0.05, false);
+		auto const csr = math::CsrMatrix<double> (size, size, elements);
+		auto const csc = math::CscMatrix<double> (size, size, elements);
+		auto const dense = csr.to_dense();
+		math::DynamicMatrix<double> x_matrix (1, size);
+		math::DynamicMatrix<double> b (5, size);
+
+		for (auto& component: x_matrix.components())
+			component = distribution (generator);
+
+		for (auto& component: b.components())
+			component = distribution (generator);
+
+		std::vector<double> const x (x_matrix.components().begin(), x_matrix.components().end());
+		auto const expected = dense * x_matrix;
+		std::vector<double> parallel_result (size);
+		math::multiply (csr, std::span<double const> (x), std::span<double> (parallel_result), work_performer);
+		auto const csr_result = csr * x;
+		auto const csc_result = csc * x;
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			test_asserts::verify_equal_with_epsilon ("CSR SpMV works", csr_result[i], expected[0, i], 1e-12);
+			test_asserts::verify_equal_with_epsilon ("CSC SpMV works", csc_result[i], expected[0, i], 1e-12);
+			test_asserts::verify_equal_with_epsilon ("parallel SpMV works", parallel_result[i], expected[0, i], 1e-12);
+		}
+
+		auto const expected_product = dense * b;
+		auto const csr_product = csr * b;
+		auto const csc_product = csc * b;
+
+		for (std::size_t i = 0; i < expected_product.components().size(); ++i)
+		{
+			test_asserts::verify_equal_with_epsilon ("CSR × dense works", csr_product.components()[i], expected_product.components()[i], 1e-12);
+			test_asserts::verify_equal_with_epsilon ("CSC × dense works", csc_product.components()[i], expected_product.components()[i], 1e-12);
+		}
+	}
+
+	auto const a = math::CsrMatrix<double> (3, 2, std::vector<math::SparseElement<double>>());
+	test_asserts::verify_throws<std::length_error> ("SpMV with wrong vector size throws", [&] { (void) (a * std::vector<double> (2)); });
+	test_asserts::verify_throws<std::length_error> ("product with wrong matrix size throws", [&] { (void) (a * math::DynamicMatrix<double> (2, 2)); });
+});
+
+
+AutoTest t3 ("SparseMatrix: conjugate gradient", []{
+	constexpr std::size_t kSize = 100;
+	auto const a = poisson_matrix (kSize);
+	std::vector<double> const b (kSize, 1.0);
+
+	for (bool const jacobi: { false, true })
+	{
+		std::vector<double> x (kSize, 0.0);
+		auto const result = math::conjugate_gradient (a, std::span<double const> (b), std::span<double> (x), { .tolerance = 1e-12, .jacobi_preconditioner = jacobi });
+
+		test_asserts::verify ("CG converges", result.converged);
+		// In exact arithmetic CG converges in at most N steps:
+		test_asserts::verify ("CG converges in at most N iterations", result.iterations <= kSize);
+		verify_residual ("CG solution is correct", a, x, b, 1e-9);
+	}
+
+	WorkPerformer work_performer (4, g_null_logger);
+	std::vector<double> x (kSize, 0.0);
+	auto const result = math::conjugate_gradient (a, std::span<double const> (b), std::span<double> (x), { .tolerance = 1e-12, .work_performer = &work_performer });
+	test_asserts::verify ("CG on WorkPerformer converges", result.converged);
+	verify_residual ("CG on WorkPerformer solution is correct", a, x, b, 1e-9);
+
+	std::vector<double> y (kSize, 0.0);
+	auto const limited = math::conjugate_gradient (a, std::span<double const> (b), std::span<double> (y), { .max_iterations = 3 });
+	test_asserts::verify ("CG reports no convergence when out of iterations", !limited.converged && limited.iterations == 3);
+});
+
+
+AutoTest t4 ("SparseMatrix: BiCGSTAB with Jacobi preconditioner", []{
+	std::mt19937 generator (2);
+	constexpr std::size_t kSize = 300;
+	auto const a = math::CsrMatrix<double> (kSize, kSize, random_elements (generator, kSize, 0.02, true));
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+	std::vector<double> b (kSize);
+
+	for (auto& value: b)
+		value = distribution (generator);
+
+	for (bool const jacobi: { false, true })
+	{
+		std::vector<double> x (kSize, 0.0);
+		auto const result = math::bicgstab (a, std::span<double const> (b), std::span<double> (x), { .tolerance = 1e-12, .jacobi_preconditioner = jacobi });
+
+		test_asserts::verify ("BiCGSTAB converges", result.converged);
+		verify_residual ("BiCGSTAB solution is correct", a, x, b, 1e-9);
+	}
+
+	auto const csc = math::CscMatrix<double> (a);
+	std::vector<double> x (kSize, 0.0);
+	auto const result = math::bicgstab (csc, std::span<double const> (b), std::span<double> (x));
+	test_asserts::verify ("BiCGSTAB on CSC matrix converges", result.converged);
+	verify_residual ("BiCGSTAB on CSC matrix solution is correct", a, x, b, 1e-8);
+
+	auto const zero_diagonal = math::CsrMatrix<double> (2, 2, std::vector<math::SparseElement<double>> { { 1, 0, 1.0 }, { 0, 1, 1.0 } });
+	std::vector<double> z (2, 0.0);
+	std::vector<double> const c (2, 1.0);
+	test_asserts::verify_throws<std::domain_error> ("Jacobi preconditioner with zero diagonal throws", [&] {
+		(void) math::bicgstab (zero_diagonal, std::span<double const> (c), std::span<double> (z));
+	});
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,145 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/math/vector_batch.h>
+#include <neutrino/test/benchmark.h>
+
+// Standard:
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+constexpr std::size_t kVectors = 100'000;
+
+
+std::vector<math::Vector<double, 3>>
+random_vectors()
+{
+	std::mt19937 generator (42);
+	std::uniform_real_distribution<double> distribution (-1.0, 1.0);
+	std::vector<math::Vector<double, 3>> result (kVectors);
+
+	for (auto& vector: result)
+		for (auto& component: vector.components())
+			component = distribution (generator);
+
+	return result;
+}
+
+
+auto const g_matrix = math::Matrix<double, 3, 3> {
+	0.5, -1.0, 2.0,
+	1.5, 0.25, -0.5,
+	-2.0, 1.0, 3.0,
+};
+
+auto const g_rotation = math::Quaternion<double> (0.5, -0.5, 0.5, 0.5);
+
+
+Benchmark b1 ("100k × Matrix<double, 3, 3> × Vector, array of vectors", [](std::size_t const iterations) {
+	auto const input = random_vectors();
+	std::vector<math::Vector<double, 3>> output (input.size());
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (input);
+
+		for (std::size_t j = 0; j < input.size(); ++j)
+			output[j] = g_matrix * input[j];
+
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b2 ("100k × Matrix<double, 3, 3> × Vector, VectorBatch", [](std::size_t const iterations) {
+	auto const vectors = random_vectors();
+	auto const input = math::VectorBatch<double, 3> (std::span (vectors));
+	math::VectorBatch<double, 3> output;
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (input);
+		math::transform (g_matrix, input, output);
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b3 ("100k × Quaternion<double> × Vector, array of vectors", [](std::size_t const iterations) {
+	auto const input = random_vectors();
+	std::vector<math::Vector<double, 3>> output (input.size());
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (input);
+
+		for (std::size_t j = 0; j < input.size(); ++j)
+			output[j] = g_rotation * input[j];
+
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b4 ("100k × Quaternion<double> × Vector, VectorBatch", [](std::size_t const iterations) {
+	auto const vectors = random_vectors();
+	auto const input = math::VectorBatch<double, 3> (std::span (vectors));
+	math::VectorBatch<double, 3> output;
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (input);
+		math::rotate (g_rotation, input, output);
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b5 ("100k × Vector<double, 3>::normalized(), array of vectors", [](std::size_t const iterations) {
+	auto const input = random_vectors();
+	std::vector<math::Vector<double, 3>> output (input.size());
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (input);
+
+		for (std::size_t j = 0; j < input.size(); ++j)
+			output[j] = input[j].normalized();
+
+		do_not_optimize (output);
+	}
+});
+
+
+Benchmark b6 ("100k × Vector<double, 3>::normalized(), VectorBatch", [](std::size_t const iterations) {
+	auto const vectors = random_vectors();
+	auto const input = math::VectorBatch<double, 3> (std::span (vectors));
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		auto batch = input;
+		do_not_optimize (batch);
+		math::normalize (batch);
+		do_not_optimize (batch);
+	}
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,154 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/math/math.h>
+#include <neutrino/math/vector_batch.h>
+#include <neutrino/si/si.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <cstddef>
+#include <format>
+#include <random>
+#include <typeinfo>
+
+
+namespace neutrino::test {
+namespace {
+
+struct WorldSpace: math::CoordinateSystemBase { };
+struct BodySpace: math::CoordinateSystemBase { };
+
+
+template<class Scalar, std::size_t Size, class TargetSpace>
+	math::VectorBatch<Scalar, Size, TargetSpace, void>
+	random_batch (std::mt19937& generator, std::size_t const count)
+	{
+		std::uniform_real_distribution<Scalar> distribution (-10.0, 10.0);
+		math::VectorBatch<Scalar, Size, TargetSpace, void> result;
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			math::Vector<Scalar, Size, TargetSpace, void> vector;
+
+			for (auto& component: vector.components())
+				component = distribution (generator);
+
+			result.push_back (vector);
+		}
+
+		return result;
+	}
+
+
+template<class Scalar>
+	void
+	verify_batch_operations (std::mt19937& generator, Scalar const epsilon)
+	{
+		// Odd size so that both SIMD and tail code paths are used:
+		constexpr std::size_t kCount = 1001;
+		auto const name = std::string (typeid (Scalar).name());
+
+		auto const batch = random_batch<Scalar, 3, BodySpace> (generator, kCount);
+		auto const other = random_batch<Scalar, 3, BodySpace> (generator, kCount);
+		auto const matrix = math::Matrix<Scalar, 3, 3, WorldSpace, BodySpace> {
+			0.5, -1.0, 2.0,
+			1.5, 0.25, -0.5,
+			-2.0, 1.0, 3.0,
+		};
+		auto const rotation = math::Quaternion<Scalar, WorldSpace, BodySpace> (2.0, -1.0, 0.5, 3.0);
+
+		math::VectorBatch<Scalar, 3, WorldSpace, void> const transformed = math::transform (matrix, batch);
+		math::VectorBatch<Scalar, 3, WorldSpace, void> const rotated = math::rotate (rotation, batch);
+		auto const dots = math::dot (batch, other);
+		auto const norms = math::norm (batch);
+		auto const normalized = math::normalized (batch);
+
+		test_asserts::verify (name + " result sizes are correct",
+							  transformed.size() == kCount && rotated.size() == kCount && dots.size() == kCount &&
+							  norms.size() == kCount && normalized.size() == kCount);
+
+		for (std::size_t i = 0; i < kCount; ++i)
+		{
+			auto const v = batch[i];
+
+			test_asserts::verify_equal_with_epsilon (name + " transform() matches matrix × vector", transformed[i], matrix * v, epsilon);
+			test_asserts::verify_equal_with_epsilon (name + " rotate() matches quaternion × vector", rotated[i], rotation * v, epsilon);
+			test_asserts::verify_equal_with_epsilon (name + " dot() matches dot_product()", dots[i], math::dot_product (v, other[i]), epsilon);
+			test_asserts::verify_equal_with_epsilon (name + " norm() matches abs()", norms[i], abs (v), epsilon);
+			test_asserts::verify_equal_with_epsilon (name + " normalize() matches Vector::normalized()", normalized[i], v.normalized(), epsilon);
+		}
+
+		// In-place transformation:
+		auto in_place = batch;
+		math::transform (math::Matrix<Scalar, 3, 3, BodySpace, BodySpace> (math::identity) * Scalar (2), in_place, in_place);
+
+		for (std::size_t i = 0; i < kCount; ++i)
+			test_asserts::verify_equal_with_epsilon (name + " in-place transform() works", in_place[i], batch[i] * Scalar (2), epsilon);
+	}
+
+
+AutoTest t1 ("VectorBatch: batch operations match single-vector operations", []{
+	std::mt19937 generator (1);
+	verify_batch_operations<double> (generator, 1e-9);
+	verify_batch_operations<float> (generator, 1e-3f);
+});
+
+
+AutoTest t2 ("VectorBatch: container operations", []{
+	using Vector = math::Vector<double, 3, WorldSpace, void>;
+
+	std::vector<Vector> const vectors { Vector { 1.0, 2.0, 3.0 }, Vector { 4.0, 5.0, 6.0 } };
+	math::VectorBatch<double, 3, WorldSpace, void> batch (std::span<Vector const> { vectors });
+
+	test_asserts::verify ("size is correct", batch.size() == 2);
+	test_asserts::verify ("components are stored as arrays", batch.component (1)[0] == 2.0 && batch.component (1)[1] == 5.0);
+	test_asserts::verify ("component arrays are aligned", reinterpret_cast<std::uintptr_t> (batch.component (2).data()) % 64 == 0);
+
+	batch.set (0, Vector { 7.0, 8.0, 9.0 });
+	test_asserts::verify ("set() works", batch[0] == Vector { 7.0, 8.0, 9.0 });
+
+	batch.resize (3);
+	test_asserts::verify ("resize() zero-initializes new vectors", batch[2] == Vector { 0.0, 0.0, 0.0 });
+	test_asserts::verify ("to_vectors() works", batch.to_vectors() == std::vector<Vector> { Vector { 7.0, 8.0, 9.0 }, vectors[1], Vector() });
+
+	batch.clear();
+	test_asserts::verify ("clear() works", batch.empty());
+});
+
+
+AutoTest t3 ("VectorBatch: SI quantities", []{
+	using namespace si::literals;
+
+	math::VectorBatch<si::Length, 3, BodySpace, void> batch;
+	batch.push_back ({ 3_m, 0_m, 4_m });
+	batch.push_back ({ 0_m, 2_m, 0_m });
+
+	auto const norms = math::norm (batch);
+	test_asserts::verify_equal_with_epsilon ("norm() of quantities works", norms[0], 5_m, 1e-9_m);
+	test_asserts::verify_equal_with_epsilon ("norm() of quantities works", norms[1], 2_m, 1e-9_m);
+
+	auto const dots = math::dot (batch, batch);
+	test_asserts::verify_equal_with_epsilon ("dot() of quantities works", dots[0], 25_m * 1_m, 1e-9_m * 1_m);
+
+	auto const rotation = math::Quaternion<double, WorldSpace, BodySpace> (math::identity);
+	auto const rotated = math::rotate (rotation, batch);
+	test_asserts::verify_equal_with_epsilon ("rotate() of quantities works", rotated[0], math::Vector<si::Length, 3, WorldSpace, void> { 3_m, 0_m, 4_m }, 1e-9_m);
+
+	math::normalize (batch);
+	test_asserts::verify_equal_with_epsilon ("normalize() of quantities works", batch[0], math::Vector<si::Length, 3, BodySpace, void> { 0.6_m, 0_m, 0.8_m }, 1e-9_m);
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,525 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__MATH__VECTOR_BATCH_H__INCLUDED
+#define NEUTRINO__MATH__VECTOR_BATCH_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/math/concepts.h>
+#include <neutrino/math/matrix.h>
+#include <neutrino/math/quaternion.h>
+#include <neutrino/math/simd_pack.h>
+
+// Boost:
+#include <boost/align/aligned_allocator.hpp>
+
+// Standard:
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace neutrino::math {
+
+/**
+ * Batch of vectors stored as structure-of-arrays: each component (x, y, z, …) of all vectors is kept in its own
+ * contiguous, cache-line aligned array. Use it with transform(), rotate(), dot(), norm() and normalize() to process
+ * large numbers of vectors with SIMD instructions.
+ *
+ * Coordinate-system tags have the same meaning as in Vector<Scalar, Size, TargetSpace, SourceSpace>.
+ */
+template<Scalar pScalar, std::size_t pSize, CoordinateSystem pTargetSpace = void, CoordinateSystem pSourceSpace = void>
+	class VectorBatch
+	{
+	  public:
+		static constexpr std::size_t kSize		= pSize;
+		static constexpr std::size_t kAlignment	= 64;
+
+		using Scalar			= pScalar;
+		using TargetSpace		= pTargetSpace;
+		using SourceSpace		= pSourceSpace;
+		using Vector			= math::Vector<Scalar, kSize, TargetSpace, SourceSpace>;
+		using ComponentArray	= std::vector<Scalar, boost::alignment::aligned_allocator<Scalar, kAlignment>>;
+
+	  public:
+		// Ctor. Creates empty batch.
+		VectorBatch() = default;
+
+		// Ctor. Creates batch of given number of zero vectors.
+		explicit
+		VectorBatch (std::size_t size);
+
+		// Ctor. Copies vectors into the batch.
+		explicit
+		VectorBatch (std::span<Vector const> vectors);
+
+		/**
+		 * Return number of vectors in the batch.
+		 */
+		[[nodiscard]]
+		std::size_t
+		size() const noexcept
+			{ return _components[0].size(); }
+
+		[[nodiscard]]
+		bool
+		empty() const noexcept
+			{ return _components[0].empty(); }
+
+		void
+		reserve (std::size_t capacity);
+
+		/**
+		 * Resize the batch; new vectors are zero-initialized.
+		 */
+		void
+		resize (std::size_t size);
+
+		void
+		clear() noexcept;
+
+		void
+		push_back (Vector const&);
+
+		/**
+		 * Return copy of the vector at given index.
+		 */
+		[[nodiscard]]
+		Vector
+		operator[] (std::size_t index) const noexcept;
+
+		/**
+		 * Replace vector at given index.
+		 */
+		void
+		set (std::size_t index, Vector const&) noexcept;
+
+		/**
+		 * Return array of given component of all vectors.
+		 */
+		[[nodiscard]]
+		std::span<Scalar>
+		component (std::size_t index) noexcept
+			{ return _components[index]; }
+
+		/**
+		 * Return array of given component of all vectors.
+		 */
+		[[nodiscard]]
+		std::span<Scalar const>
+		component (std::size_t index) const noexcept
+			{ return _components[index]; }
+
+		/**
+		 * Return vectors as an array of Vector objects.
+		 */
+		[[nodiscard]]
+		std::vector<Vector>
+		to_vectors() const;
+
+	  private:
+		std::array<ComponentArray, kSize> _components;
+	};
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline
+	VectorBatch<S, N, TS, SS>::VectorBatch (std::size_t const size)
+	{
+		resize (size);
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline
+	VectorBatch<S, N, TS, SS>::VectorBatch (std::span<Vector const> const vectors)
+	{
+		for (std::size_t c = 0; c < kSize; ++c)
+		{
+			auto& component = _components[c];
+			component.resize (vectors.size());
+
+			for (std::size_t i = 0; i < vectors.size(); ++i)
+				component[i] = vectors[i][c];
+		}
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline void
+	VectorBatch<S, N, TS, SS>::reserve (std::size_t const capacity)
+	{
+		for (auto& component: _components)
+			component.reserve (capacity);
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline void
+	VectorBatch<S, N, TS, SS>::resize (std::size_t const size)
+	{
+		for (auto& component: _components)
+			component.resize (size, Scalar (0));
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline void
+	VectorBatch<S, N, TS, SS>::clear() noexcept
+	{
+		for (auto& component: _components)
+			component.clear();
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline void
+	VectorBatch<S, N, TS, SS>::push_back (Vector const& vector)
+	{
+		for (std::size_t c = 0; c < kSize; ++c)
+			_components[c].push_back (vector[c]);
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline auto
+	VectorBatch<S, N, TS, SS>::operator[] (std::size_t const index) const noexcept -> Vector
+	{
+		Vector result (uninitialized);
+
+		for (std::size_t c = 0; c < kSize; ++c)
+			result[c] = _components[c][index];
+
+		return result;
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline void
+	VectorBatch<S, N, TS, SS>::set (std::size_t const index, Vector const& vector) noexcept
+	{
+		for (std::size_t c = 0; c < kSize; ++c)
+			_components[c][index] = vector[c];
+	}
+
+
+template<Scalar S, std::size_t N, CoordinateSystem TS, CoordinateSystem SS>
+	inline auto
+	VectorBatch<S, N, TS, SS>::to_vectors() const -> std::vector<Vector>
+	{
+		std::vector<Vector> result;
+		result.reserve (size());
+
+		for (std::size_t i = 0; i < size(); ++i)
+			result.push_back ((*this)[i]);
+
+		return result;
+	}
+
+
+namespace detail {
+
+/**
+ * Run kernel over [0, size) using SIMD packs of S if UseSimd is true, or one element at a time otherwise.
+ */
+template<bool UseSimd, class S, class Kernel>
+	inline void
+	for_each_batch_element (std::size_t const size, Kernel&& kernel)
+	{
+		if constexpr (UseSimd)
+			simd::for_each_pack<S> (size, kernel);
+		else
+			for (std::size_t i = 0; i < size; ++i)
+				kernel.template operator()<S> (i);
+	}
+
+
+inline void
+check_batch_sizes (std::size_t const a, std::size_t const b)
+{
+	if (a != b)
+		throw std::length_error ("vector batches have different sizes");
+}
+
+} // namespace detail
+
+
+/**
+ * Compute result[i] = matrix * batch[i] for all vectors in the batch.
+ * The result batch is resized as needed. It may be the same object as the input batch.
+ */
+template<
+	Scalar SM,
+	Scalar SV,
+	std::size_t Columns,
+	std::size_t Rows,
+	CoordinateSystem TargetSpace,
+	CoordinateSystem IntermediateSpace,
+	CoordinateSystem SourceSpace>
+	inline void
+	transform (Matrix<SM, Columns, Rows, TargetSpace, IntermediateSpace> const& matrix,
+			   VectorBatch<SV, Columns, IntermediateSpace, SourceSpace> const& batch,
+			   VectorBatch<decltype (std::declval<SM>() * std::declval<SV>()), Rows, TargetSpace, SourceSpace>& result)
+	{
+		using ResultScalar = decltype (std::declval<SM>() * std::declval<SV>());
+
+		auto const size = batch.size();
+		result.resize (size);
+
+		std::array<SV const*, Columns> inputs;
+		std::array<ResultScalar*, Rows> outputs;
+
+		for (std::size_t c = 0; c < Columns; ++c)
+			inputs[c] = batch.component (c).data();
+
+		for (std::size_t r = 0; r < Rows; ++r)
+			outputs[r] = result.component (r).data();
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			std::array<V, Columns> x;
+
+			// Load all inputs before storing anything, so that in-place operation works:
+			for (std::size_t c = 0; c < Columns; ++c)
+				x[c] = simd::load<V> (inputs[c] + i);
+
+			for (std::size_t r = 0; r < Rows; ++r)
+			{
+				auto sum = simd::broadcast<V> (matrix[0, r]) * x[0];
+
+				for (std::size_t c = 1; c < Columns; ++c)
+					sum = sum + simd::broadcast<V> (matrix[c, r]) * x[c];
+
+				simd::store (outputs[r] + i, sum);
+			}
+		};
+
+		detail::for_each_batch_element<std::is_same_v<SM, SV>, SV> (size, kernel);
+	}
+
+
+/**
+ * Return batch of matrix * batch[i].
+ */
+template<
+	Scalar SM,
+	Scalar SV,
+	std::size_t Columns,
+	std::size_t Rows,
+	CoordinateSystem TargetSpace,
+	CoordinateSystem IntermediateSpace,
+	CoordinateSystem SourceSpace>
+	[[nodiscard]]
+	inline auto
+	transform (Matrix<SM, Columns, Rows, TargetSpace, IntermediateSpace> const& matrix,
+			   VectorBatch<SV, Columns, IntermediateSpace, SourceSpace> const& batch)
+	{
+		VectorBatch<decltype (std::declval<SM>() * std::declval<SV>()), Rows, TargetSpace, SourceSpace> result;
+		transform (matrix, batch, result);
+		return result;
+	}
+
+
+/**
+ * Compute result[i] = rotation * batch[i] for all vectors in the batch. Equivalent to the rotation of a single vector
+ * with operator* (Quaternion, Vector), but the quaternion is converted to a rotation matrix once and the batch
+ * is transformed with SIMD. The quaternion doesn't need to be normalized.
+ */
+template<Scalar SQ, Scalar SV, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	inline void
+	rotate (Quaternion<SQ, TargetSpace, SourceSpace, IsRotationQuaternion> const& rotation,
+			VectorBatch<SV, 3, SourceSpace, void> const& batch,
+			VectorBatch<SV, 3, TargetSpace, void>& result)
+	{
+		auto const w = rotation.w();
+		auto const x = rotation.x();
+		auto const y = rotation.y();
+		auto const z = rotation.z();
+		auto const s = 2 / rotation.squared_norm();
+
+		using MatrixScalar = std::conditional_t<simd::kIsSimdScalar<SV>, SV, std::remove_cvref_t<decltype (w * w * s)>>;
+
+		auto const m = [&] (auto const value) { return static_cast<MatrixScalar> (value); };
+		auto const xx = x * x * s, yy = y * y * s, zz = z * z * s;
+		auto const xy = x * y * s, xz = x * z * s, yz = y * z * s;
+		auto const wx = w * x * s, wy = w * y * s, wz = w * z * s;
+
+		auto const matrix = Matrix<MatrixScalar, 3, 3, TargetSpace, SourceSpace> {
+			m (1 - yy - zz),	m (xy - wz),		m (xz + wy),
+			m (xy + wz),		m (1 - xx - zz),	m (yz - wx),
+			m (xz - wy),		m (yz + wx),		m (1 - xx - yy),
+		};
+
+		transform (matrix, batch, result);
+	}
+
+
+/**
+ * Return batch of rotation * batch[i].
+ */
+template<Scalar SQ, Scalar SV, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace, bool IsRotationQuaternion>
+	[[nodiscard]]
+	inline VectorBatch<SV, 3, TargetSpace, void>
+	rotate (Quaternion<SQ, TargetSpace, SourceSpace, IsRotationQuaternion> const& rotation,
+			VectorBatch<SV, 3, SourceSpace, void> const& batch)
+	{
+		VectorBatch<SV, 3, TargetSpace, void> result;
+		rotate (rotation, batch, result);
+		return result;
+	}
+
+
+/**
+ * Compute result[i] = dot (a[i], b[i]).
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<Scalar SA, Scalar SB, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	inline void
+	dot (VectorBatch<SA, Size, TargetSpace, SourceSpace> const& a,
+		 VectorBatch<SB, Size, TargetSpace, SourceSpace> const& b,
+		 std::vector<decltype (std::declval<SA>() * std::declval<SB>())>& result)
+	{
+		detail::check_batch_sizes (a.size(), b.size());
+		result.resize (a.size());
+
+		auto* const output = result.data();
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			using VB = std::conditional_t<std::is_same_v<V, SA>, SB, V>;
+
+			auto sum = simd::load<V> (a.component (0).data() + i) * simd::load<VB> (b.component (0).data() + i);
+
+			for (std::size_t c = 1; c < Size; ++c)
+				sum = sum + simd::load<V> (a.component (c).data() + i) * simd::load<VB> (b.component (c).data() + i);
+
+			simd::store (output + i, sum);
+		};
+
+		detail::for_each_batch_element<std::is_same_v<SA, SB>, SA> (a.size(), kernel);
+	}
+
+
+/**
+ * Return array of dot (a[i], b[i]).
+ * \throw	std::length_error if batch sizes differ.
+ */
+template<Scalar SA, Scalar SB, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	[[nodiscard]]
+	inline auto
+	dot (VectorBatch<SA, Size, TargetSpace, SourceSpace> const& a,
+		 VectorBatch<SB, Size, TargetSpace, SourceSpace> const& b)
+	{
+		std::vector<decltype (std::declval<SA>() * std::declval<SB>())> result;
+		dot (a, b, result);
+		return result;
+	}
+
+
+/**
+ * Compute result[i] = abs (batch[i]).
+ */
+template<Scalar S, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	inline void
+	norm (VectorBatch<S, Size, TargetSpace, SourceSpace> const& batch, std::vector<S>& result)
+	{
+		result.resize (batch.size());
+
+		auto* const output = result.data();
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			using std::sqrt;
+
+			auto const x0 = simd::load<V> (batch.component (0).data() + i);
+			auto sum = x0 * x0;
+
+			for (std::size_t c = 1; c < Size; ++c)
+			{
+				auto const xc = simd::load<V> (batch.component (c).data() + i);
+				sum = sum + xc * xc;
+			}
+
+			simd::store (output + i, V (sqrt (sum)));
+		};
+
+		detail::for_each_batch_element<true, S> (batch.size(), kernel);
+	}
+
+
+/**
+ * Return array of abs (batch[i]).
+ */
+template<Scalar S, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	[[nodiscard]]
+	inline std::vector<S>
+	norm (VectorBatch<S, Size, TargetSpace, SourceSpace> const& batch)
+	{
+		std::vector<S> result;
+		norm (batch, result);
+		return result;
+	}
+
+
+/**
+ * Normalize all vectors in the batch in place. Like Vector::normalize(), zero vectors become NaN vectors.
+ */
+template<Scalar S, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	inline void
+	normalize (VectorBatch<S, Size, TargetSpace, SourceSpace>& batch)
+	{
+		std::array<S*, Size> components;
+
+		for (std::size_t c = 0; c < Size; ++c)
+			components[c] = batch.component (c).data();
+
+		auto const kernel = [&]<class V> (std::size_t const i) {
+			using std::sqrt;
+
+			std::array<V, Size> x;
+
+			for (std::size_t c = 0; c < Size; ++c)
+				x[c] = simd::load<V> (components[c] + i);
+
+			auto sum = x[0] * x[0];
+
+			for (std::size_t c = 1; c < Size; ++c)
+				sum = sum + x[c] * x[c];
+
+			// Dimensionless factor, so that normalized vectors have length of 1 unit of S:
+			auto const factor = simd::broadcast<V> (S (1)) / sqrt (sum);
+
+			for (std::size_t c = 0; c < Size; ++c)
+				simd::store (components[c] + i, V (x[c] * factor));
+		};
+
+		detail::for_each_batch_element<true, S> (batch.size(), kernel);
+	}
+
+
+/**
+ * Return copy of the batch with all vectors normalized.
+ */
+template<Scalar S, std::size_t Size, CoordinateSystem TargetSpace, CoordinateSystem SourceSpace>
+	[[nodiscard]]
+	inline VectorBatch<S, Size, TargetSpace, SourceSpace>
+	normalized (VectorBatch<S, Size, TargetSpace, SourceSpace> batch)
+	{
+		normalize (batch);
+		return batch;
+	}
+
+} // namespace neutrino::math
+
+#endif
@@ -0,0 +1,347 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Local:
+#include "metrics.h"
+
+// Neutrino:
+#include <neutrino/stdexcept.h>
+
+// Standard:
+#include <cstddef>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+
+namespace neutrino {
+namespace {
+
+/**
+ * Return true if name is a valid Prometheus metric or label name.
+ */
+bool
+is_valid_metric_name (std::string_view const name)
+{
+	if (name.empty() || (name[0] >= '0' && name[0] <= '9'))
+		return false;
+
+	for (char const c: name)
+		if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':'))
+			return false;
+
+	return true;
+}
+
+
+/**
+ * Escape string for use in HELP line (with_quotes = false) or as a label value (with_quotes = true).
+ */
+std::string
+escape (std::string_view const string, bool const with_quotes)
+{
+	std::string result;
+	result.reserve (string.size());
+
+	for (char const c: string)
+	{
+		switch (c)
+		{
+			case '\\':	result += "\\\\"; break;
+			case '\n':	result += "\\n"; break;
+			case '"':	result += with_quotes ? "\\\"" : "\""; break;
+			default:	result += c;
+		}
+	}
+
+	return result;
+}
+
+
+/**
+ * Write labels in form {a="1",b="2"}, optionally with an additional label.
+ */
+void
+write_labels (std::ostream& out, MetricLabels const& labels, std::string_view const extra_name = {}, std::string_view const extra_value = {})
+{
+	if (labels.empty() && extra_name.empty())
+		return;
+
+	out << '{';
+	bool first = true;
+
+	for (auto const& [name, value]: labels)
+	{
+		out << (first ? "" : ",") << name << "=\"" << escape (value, true) << '"';
+		first = false;
+	}
+
+	if (!extra_name.empty())
+		out << (first ? "" : ",") << extra_name << "=\"" << extra_value << '"';
+
+	out << '}';
+}
+
+
+std::string_view
+to_string (MetricType const type)
+{
+	switch (type)
+	{
+		case MetricType::Counter:	return "counter";
+		case MetricType::Gauge:		return "gauge";
+		case MetricType::Histogram:	return "histogram";
+	}
+
+	return "untyped";
+}
+
+
+std::string
+format_seconds (si::Time const time)
+{
+	return std::format ("{}", time.in<si::Second>());
+}
+
+} // namespace
+
+
+std::uint64_t
+Counter::value() const noexcept
+{
+	std::uint64_t sum = 0;
+
+	for (auto const& shard: _shards)
+		sum += shard.value.load (std::memory_order_relaxed);
+
+	return sum;
+}
+
+
+void
+Gauge::set (double const value) noexcept
+{
+	for (std::size_t i = 1; i < _shards.size(); ++i)
+		_shards[i].value.store (0.0, std::memory_order_relaxed);
+
+	_shards[0].value.store (value, std::memory_order_relaxed);
+}
+
+
+double
+Gauge::value() const noexcept
+{
+	double sum = 0.0;
+
+	for (auto const& shard: _shards)
+		sum += shard.value.load (std::memory_order_relaxed);
+
+	return sum;
+}
+
+
+HistogramSnapshot
+LatencyHistogram::snapshot() const
+{
+	HistogramSnapshot result;
+	std::uint64_t count = 0;
+
+	for (std::size_t i = 0; i < _buckets.size(); ++i)
+	{
+		if (auto const n = _buckets[i].load (std::memory_order_relaxed);
+			n > 0)
+		{
+			result.buckets.push_back ({
+				.upper_bound = si::Time (1e-9 * static_cast<double> (bucket_upper_bound (i))),
+				.count = n,
+			});
+			count += n;
+		}
+	}
+
+	// Use sum of buckets as the count, so that it's consistent with the buckets even
+	// if some records were being made during the snapshot:
+	result.count = count;
+	result.sum = si::Time (1e-9 * static_cast<double> (_sum_ns.load (std::memory_order_relaxed)));
+	return result;
+}
+
+
+Counter&
+MetricsRegistry::counter (std::string const& name, std::string const& help, MetricLabels const& labels)
+{
+	return get_or_create<Counter> (name, help, MetricType::Counter, labels);
+}
+
+
+Gauge&
+MetricsRegistry::gauge (std::string const& name, std::string const& help, MetricLabels const& labels)
+{
+	return get_or_create<Gauge> (name, help, MetricType::Gauge, labels);
+}
+
+
+LatencyHistogram&
+MetricsRegistry::histogram (std::string const& name, std::string const& help, MetricLabels const& labels)
+{
+	return get_or_create<LatencyHistogram> (name, help, MetricType::Histogram, labels);
+}
+
+
+MetricsSnapshot
+MetricsRegistry::snapshot() const
+{
+	MetricsSnapshot result;
+	auto const families = _families.lock();
+
+	for (auto const& [name, family]: *families)
+	{
+		auto& snapshot_family = result.families.emplace_back();
+		snapshot_family.name = name;
+		snapshot_family.help = family.help;
+		snapshot_family.type = family.type;
+
+		for (auto const& [labels, metric]: family.metrics)
+		{
+			auto& sample = snapshot_family.samples.emplace_back();
+			sample.labels = labels;
+
+			if (auto const* counter = std::get_if<std::unique_ptr<Counter>> (&metric))
+				sample.value = (*counter)->value();
+			else if (auto const* gauge = std::get_if<std::unique_ptr<Gauge>> (&metric))
+				sample.value = (*gauge)->value();
+			else if (auto const* histogram = std::get_if<std::unique_ptr<LatencyHistogram>> (&metric))
+				sample.value = (*histogram)->snapshot();
+		}
+	}
+
+	return result;
+}
+
+
+template<class MetricClass>
+	MetricClass&
+	MetricsRegistry::get_or_create (std::string const& name, std::string const& help, MetricType const type, MetricLabels const& labels)
+	{
+		if (!is_valid_metric_name (name))
+			throw InvalidArgument (std::format ("invalid metric name '{}'", name));
+
+		for (auto const& [label_name, label_value]: labels)
+			if (!is_valid_metric_name (label_name) || label_name.starts_with ("__") || label_name == "le")
+				throw InvalidArgument (std::format ("invalid label name '{}' for metric '{}'", label_name, name));
+
+		auto families = _families.lock();
+		auto [family_it, inserted] = families->try_emplace (name, Family { .help = help, .type = type, .metrics = {} });
+		auto& family = family_it->second;
+
+		if (family.type != type)
+			throw InvalidArgument (std::format ("metric '{}' already registered as {}", name, to_string (family.type)));
+
+		auto& metric = family.metrics[labels];
+
+		if (!std::holds_alternative<std::unique_ptr<MetricClass>> (metric) || !std::get<std::unique_ptr<MetricClass>> (metric))
+			metric = std::make_unique<MetricClass>();
+
+		return *std::get<std::unique_ptr<MetricClass>> (metric);
+	}
+
+
+void
+write_prometheus_text (std::ostream& out, MetricsSnapshot const& snapshot)
+{
+	for (auto const& family: snapshot.families)
+	{
+		if (!family.help.empty())
+			out << "# HELP " << family.name << ' ' << escape (family.help, false) << '\n';
+
+		out << "# TYPE " << family.name << ' ' << to_string (family.type) << '\n';
+
+		for (auto const& sample: family.samples)
+		{
+			if (auto const* counter = std::get_if<std::uint64_t> (&sample.value))
+			{
+				out << family.name;
+				write_labels (out, sample.labels);
+				out << ' ' << *counter << '\n';
+			}
+			else if (auto const* gauge = std::get_if<double> (&sample.value))
+			{
+				out << family.name;
+				write_labels (out, sample.labels);
+				out << ' ' << std::format ("{}", *gauge) << '\n';
+			}
+			else if (auto const* histogram = std::get_if<HistogramSnapshot> (&sample.value))
+			{
+				std::uint64_t cumulative = 0;
+
+				for (auto const& bucket: histogram->buckets)
+				{
+					cumulative += bucket.count;
+					out << family.name << "_bucket";
+					write_labels (out, sample.labels, "le", format_seconds (bucket.upper_bound));
+					out << ' ' << cumulative << '\n';
+				}
+
+				out << family.name << "_bucket";
+				write_labels (out, sample.labels, "le", "+Inf");
+				out << ' ' << histogram->count << '\n';
+
+				out << family.name << "_sum";
+				write_labels (out, sample.labels);
+				out << ' ' << format_seconds (histogram->sum) << '\n';
+
+				out << family.name << "_count";
+				write_labels (out, sample.labels);
+				out << ' ' << histogram->count << '\n';
+			}
+		}
+	}
+}
+
+
+std::string
+to_prometheus_text (MetricsSnapshot const& snapshot)
+{
+	std::ostringstream out;
+	write_prometheus_text (out, snapshot);
+	return out.str();
+}
+
+
+void
+save_prometheus_text (std::filesystem::path const& path, MetricsSnapshot const& snapshot)
+{
+	auto temporary_path = path;
+	temporary_path += ".tmp";
+
+	{
+		std::ofstream file (temporary_path);
+
+		if (!file.good())
+			throw IOError ("could not open '" + std::string (temporary_path) + "' for writing");
+
+		write_prometheus_text (file, snapshot);
+		file.flush();
+
+		if (!file.good())
+			throw IOError ("failed to write all data to '" + std::string (temporary_path) + "'");
+	}
+
+	std::error_code error;
+	std::filesystem::rename (temporary_path, path, error);
+
+	if (error)
+		throw IOError (std::format ("could not rename '{}' to '{}': {}", std::string (temporary_path), std::string (path), error.message()));
+}
+
+} // namespace neutrino
@@ -0,0 +1,386 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__METRICS_H__INCLUDED
+#define NEUTRINO__METRICS_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/noncopyable.h>
+#include <neutrino/si/si.h>
+#include <neutrino/synchronized.h>
+
+// Standard:
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <variant>
+#include <vector>
+
+
+namespace neutrino {
+
+/**
+ * Set of label name → label value pairs that identify a metric instance within a family.
+ */
+using MetricLabels = std::map<std::string, std::string>;
+
+
+enum class MetricType
+{
+	Counter,
+	Gauge,
+	Histogram,
+};
+
+
+namespace detail {
+
+// Size of a cache line, used to avoid false sharing between shards:
+constexpr std::size_t kMetricsCacheLineSize = 64;
+
+// Number of shards used by sharded metrics:
+constexpr std::size_t kMetricsShards = 16;
+
+
+/**
+ * Return shard index assigned to the calling thread.
+ */
+inline std::size_t
+metrics_shard_index() noexcept
+{
+	static std::atomic<std::size_t> next_index { 0 };
+	thread_local std::size_t const index = next_index.fetch_add (1, std::memory_order_relaxed) % kMetricsShards;
+	return index;
+}
+
+} // namespace detail
+
+
+/**
+ * Monotonic counter. Each thread updates its own cache-line-sized shard with a relaxed atomic add,
+ * so concurrent updates from many threads don't contend. Reading sums all shards.
+ */
+class Counter: private Noncopyable
+{
+  public:
+	// Ctor
+	Counter() = default;
+
+	/**
+	 * Increment counter by given amount.
+	 */
+	void
+	add (std::uint64_t const amount = 1) noexcept
+		{ _shards[detail::metrics_shard_index()].value.fetch_add (amount, std::memory_order_relaxed); }
+
+	/**
+	 * Return current value.
+	 */
+	[[nodiscard]]
+	std::uint64_t
+	value() const noexcept;
+
+  private:
+	struct alignas (detail::kMetricsCacheLineSize) Shard
+	{
+		std::atomic<std::uint64_t> value { 0 };
+	};
+
+	std::array<Shard, detail::kMetricsShards> _shards;
+};
+
+
+/**
+ * Gauge: a value that can go up and down.
+ * Relative changes (add()/sub()) are sharded per thread like in Counter. set() replaces the value atomically
+ * with respect to readers, but concurrent add() calls made during set() may or may not be included in the result.
+ */
+class Gauge: private Noncopyable
+{
+  public:
+	// Ctor
+	Gauge() = default;
+
+	/**
+	 * Set new value.
+	 */
+	void
+	set (double value) noexcept;
+
+	/**
+	 * Add given amount to the gauge.
+	 */
+	void
+	add (double const amount) noexcept
+		{ _shards[detail::metrics_shard_index()].value.fetch_add (amount, std::memory_order_relaxed); }
+
+	/**
+	 * Subtract given amount from the gauge.
+	 */
+	void
+	sub (double const amount) noexcept
+		{ add (-amount); }
+
+	/**
+	 * Return current value.
+	 */
+	[[nodiscard]]
+	double
+	value() const noexcept;
+
+  private:
+	struct alignas (detail::kMetricsCacheLineSize) Shard
+	{
+		std::atomic<double> value { 0.0 };
+	};
+
+	std::array<Shard, detail::kMetricsShards> _shards;
+};
+
+
+/**
+ * Immutable copy of histogram state.
+ */
+struct HistogramSnapshot
+{
+	struct Bucket
+	{
+		// Inclusive upper bound of the bucket:
+		si::Time		upper_bound;
+		std::uint64_t	count;
+	};
+
+	// Non-empty buckets, sorted by upper bound; counts are not cumulative:
+	std::vector<Bucket>	buckets;
+	std::uint64_t		count	{ 0 };
+	si::Time			sum		{ 0.0 };
+};
+
+
+/**
+ * Latency histogram with log-linear buckets (similar to HDR histogram).
+ * Each power-of-two range of nanoseconds is split into kSubBuckets linear sub-buckets, so that relative
+ * bucket width is at most 1/kSubBuckets over the whole range 1 ns … 2⁶⁴ ns. Recording is a couple of
+ * relaxed atomic additions.
+ */
+class LatencyHistogram: private Noncopyable
+{
+  public:
+	static constexpr std::size_t	kSubBucketBits	= 3;
+	static constexpr std::size_t	kSubBuckets		= 1u << kSubBucketBits;
+	static constexpr std::size_t	kBuckets		= kSubBuckets + (64 - kSubBucketBits) * kSubBuckets;
+
+  public:
+	// Ctor
+	LatencyHistogram() = default;
+
+	/**
+	 * Record a single duration. Negative durations are recorded as 0.
+	 */
+	void
+	record (si::Time) noexcept;
+
+	/**
+	 * Return number of recorded samples.
+	 */
+	[[nodiscard]]
+	std::uint64_t
+	count() const noexcept
+		{ return _count.load (std::memory_order_relaxed); }
+
+	/**
+	 * Return copy of the current state.
+	 */
+	[[nodiscard]]
+	HistogramSnapshot
+	snapshot() const;
+
+	/**
+	 * Return bucket index for given number of nanoseconds.
+	 */
+	[[nodiscard]]
+	static constexpr std::size_t
+	bucket_index (std::uint64_t nanoseconds) noexcept;
+
+	/**
+	 * Return inclusive upper bound (in nanoseconds) of given bucket.
+	 */
+	[[nodiscard]]
+	static constexpr std::uint64_t
+	bucket_upper_bound (std::size_t index) noexcept;
+
+  private:
+	std::array<std::atomic<std::uint64_t>, kBuckets>	_buckets	{};
+	std::atomic<std::uint64_t>							_count		{ 0 };
+	std::atomic<std::uint64_t>							_sum_ns		{ 0 };
+};
+
+
+/**
+ * Point-in-time copy of all metrics in a registry.
+ */
+struct MetricsSnapshot
+{
+	struct Sample
+	{
+		MetricLabels											labels;
+		std::variant<std::uint64_t, double, HistogramSnapshot>	value;
+	};
+
+	struct Family
+	{
+		std::string			name;
+		std::string			help;
+		MetricType			type;
+		std::vector<Sample>	samples;
+	};
+
+	std::vector<Family> families;
+};
+
+
+/**
+ * Registry of named metric families. Each family has a type, a help string and any number of labeled instances.
+ *
+ * Registration (counter(), gauge(), histogram()) takes a lock and should be done once, up-front; returned references
+ * stay valid for the lifetime of the registry. Updating metrics through these references is lock-free.
+ */
+class MetricsRegistry: private Noncopyable
+{
+  public:
+	// Ctor
+	MetricsRegistry() = default;
+
+	/**
+	 * Return counter with given name and labels, creating it if necessary.
+	 * \throw	InvalidArgument if the name is invalid or already used by a metric of different type.
+	 */
+	Counter&
+	counter (std::string const& name, std::string const& help, MetricLabels const& = {});
+
+	/**
+	 * Return gauge with given name and labels, creating it if necessary.
+	 * \throw	InvalidArgument if the name is invalid or already used by a metric of different type.
+	 */
+	Gauge&
+	gauge (std::string const& name, std::string const& help, MetricLabels const& = {});
+
+	/**
+	 * Return latency histogram with given name and labels, creating it if necessary.
+	 * By Prometheus convention the name should end with "_seconds".
+	 * \throw	InvalidArgument if the name is invalid or already used by a metric of different type.
+	 */
+	LatencyHistogram&
+	histogram (std::string const& name, std::string const& help, MetricLabels const& = {});
+
+	/**
+	 * Return copy of all metric values. Families are sorted by name, samples by labels.
+	 */
+	[[nodiscard]]
+	MetricsSnapshot
+	snapshot() const;
+
+  private:
+	using Metric = std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>, std::unique_ptr<LatencyHistogram>>;
+
+	struct Family
+	{
+		std::string						help;
+		MetricType						type;
+		std::map<MetricLabels, Metric>	metrics;
+	};
+
+	using Families = std::map<std::string, Family>;
+
+  private:
+	template<class MetricClass>
+		MetricClass&
+		get_or_create (std::string const& name, std::string const& help, MetricType, MetricLabels const&);
+
+  private:
+	Synchronized<Families> mutable _families;
+};
+
+
+/**
+ * Write snapshot in the Prometheus text exposition format (version 0.0.4).
+ * Histogram buckets are written for non-empty buckets only, with values in seconds.
+ */
+void
+write_prometheus_text (std::ostream&, MetricsSnapshot const&);
+
+
+/**
+ * Return snapshot in the Prometheus text exposition format.
+ */
+[[nodiscard]]
+std::string
+to_prometheus_text (MetricsSnapshot const&);
+
+
+/**
+ * Save snapshot in the Prometheus text exposition format to a file (eg. for the node_exporter textfile collector).
+ * The file is written to a temporary file first and then atomically renamed.
+ * \throw	IOError on failure.
+ */
+void
+save_prometheus_text (std::filesystem::path const&, MetricsSnapshot const&);
+
+
+inline void
+LatencyHistogram::record (si::Time const duration) noexcept
+{
+	auto const ns = duration.in<si::Nanosecond>();
+	auto const value = ns > 0.0 ? static_cast<std::uint64_t> (std::round (ns)) : std::uint64_t (0);
+
+	_buckets[bucket_index (value)].fetch_add (1, std::memory_order_relaxed);
+	_sum_ns.fetch_add (value, std::memory_order_relaxed);
+	_count.fetch_add (1, std::memory_order_relaxed);
+}
+
+
+constexpr std::size_t
+LatencyHistogram::bucket_index (std::uint64_t const nanoseconds) noexcept
+{
+	if (nanoseconds < kSubBuckets)
+		return static_cast<std::size_t> (nanoseconds);
+
+	auto const exponent = static_cast<std::size_t> (std::bit_width (nanoseconds)) - 1;
+	auto const shift = exponent - kSubBucketBits;
+	auto const sub_bucket = static_cast<std::size_t> (nanoseconds >> shift) - kSubBuckets;
+	return kSubBuckets + shift * kSubBuckets + sub_bucket;
+}
+
+
+constexpr std::uint64_t
+LatencyHistogram::bucket_upper_bound (std::size_t const index) noexcept
+{
+	if (index < kSubBuckets)
+		return index;
+
+	auto const shift = (index - kSubBuckets) / kSubBuckets;
+	auto const sub_bucket = (index - kSubBuckets) % kSubBuckets;
+	return ((std::uint64_t (kSubBuckets + sub_bucket + 1)) << shift) - 1;
+}
+
+} // namespace neutrino
+
+#endif
@@ -0,0 +1,576 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__QUANTILE_H__INCLUDED
+#define NEUTRINO__QUANTILE_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/stdexcept.h>
+
+// Standard:
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace neutrino {
+
+/**
+ * Streaming estimator of a single quantile with the P² algorithm (Jain, Chlamtac, 1985).
+ * Uses constant memory (five markers) and O(1) time per sample; samples are not stored.
+ *
+ * P² has no guaranteed error bound. For smooth, continuous distributions the estimate is typically within
+ * a fraction of a percent of the exact quantile after a few thousand samples; it's worse for discrete or
+ * multimodal data and for extreme quantiles. Estimators can't be merged; use TDigest for that.
+ */
+template<class Value>
+	class P2Quantile
+	{
+	  public:
+		/**
+		 * Create an estimator of given quantile (0…1).
+		 * Throws InvalidArgument if quantile is outside of range 0…1.
+		 */
+		explicit
+		P2Quantile (double quantile);
+
+		/**
+		 * Add a sample.
+		 */
+		void
+		add (Value const&);
+
+		/**
+		 * Add samples from given sequence.
+		 */
+		template<class Iterator>
+			void
+			add (Iterator begin, Iterator end);
+
+		/**
+		 * Return number of added samples.
+		 */
+		[[nodiscard]]
+		std::size_t
+		count() const noexcept
+			{ return _count; }
+
+		/**
+		 * Return estimated quantile. Exact if at most five samples were added.
+		 * Throws std::length_error if there are no samples.
+		 */
+		[[nodiscard]]
+		Value
+		value() const;
+
+	  private:
+		double					_quantile;
+		std::size_t				_count		{ 0 };
+		// Marker heights and actual and desired positions:
+		std::array<Value, 5>	_heights;
+		std::array<double, 5>	_positions	{ 1, 2, 3, 4, 5 };
+		std::array<double, 5>	_desired	{ };
+		std::array<double, 5>	_increments	{ };
+	};
+
+
+/**
+ * Streaming quantile sketch (merging t-digest, Dunning, 2019).
+ *
+ * Samples are clustered into centroids whose size is limited by the k₁ scale function, so that centroids near
+ * the tails are small and near the median large. Memory is bounded: at most about compression centroids plus
+ * a buffer of recent samples. Digests filled separately (eg. by many threads) can be merged.
+ *
+ * Error is in terms of rank: with the default compression of 100 the returned value's rank is typically within
+ * 0.1% of the requested quantile, less near the tails where centroids hold only a few samples. Doubling
+ * compression roughly halves the error. Minimum and maximum are exact.
+ */
+template<class Value>
+	class TDigest
+	{
+	  public:
+		static constexpr double kDefaultCompression = 100.0;
+
+		struct Centroid
+		{
+			Value	mean;
+			double	weight;
+		};
+
+	  public:
+		/**
+		 * Create an empty digest.
+		 * Throws InvalidArgument if compression is less than 10.
+		 */
+		explicit
+		TDigest (double compression = kDefaultCompression);
+
+		/**
+		 * Add a sample with given weight.
+		 */
+		void
+		add (Value const&, double weight = 1.0);
+
+		/**
+		 * Add samples from given sequence.
+		 */
+		template<class Iterator>
+			void
+			add (Iterator begin, Iterator end);
+
+		/**
+		 * Add samples of the other digest to this one.
+		 */
+		void
+		merge (TDigest const&);
+
+		/**
+		 * Return total weight of samples (number of samples if all have weight 1).
+		 */
+		[[nodiscard]]
+		double
+		count() const noexcept
+			{ return _weight + _buffer_weight; }
+
+		/**
+		 * Minimum sample.
+		 * Throws std::length_error if there are no samples.
+		 */
+		[[nodiscard]]
+		Value
+		min() const;
+
+		/**
+		 * Maximum sample.
+		 * Throws std::length_error if there are no samples.
+		 */
+		[[nodiscard]]
+		Value
+		max() const;
+
+		/**
+		 * Return estimated quantile (0…1).
+		 * Throws std::length_error if there are no samples.
+		 */
+		[[nodiscard]]
+		Value
+		quantile (double) const;
+
+		/**
+		 * Return centroids, sorted by mean.
+		 */
+		[[nodiscard]]
+		std::vector<Centroid> const&
+		centroids() const;
+
+	  private:
+		/**
+		 * Merge buffered samples into centroids.
+		 */
+		void
+		compress() const;
+
+		/**
+		 * Return k₁ scale function for given quantile.
+		 */
+		[[nodiscard]]
+		double
+		scale (double quantile) const noexcept;
+
+		/**
+		 * Inverse of scale().
+		 */
+		[[nodiscard]]
+		double
+		inverse_scale (double k) const noexcept;
+
+	  private:
+		double							_compression;
+		std::size_t						_buffer_capacity;
+		// Buffered samples are merged into centroids lazily, also by const methods:
+		mutable std::vector<Centroid>	_centroids;
+		mutable std::vector<Centroid>	_buffer;
+		mutable double					_weight			{ 0.0 };
+		mutable double					_buffer_weight	{ 0.0 };
+		Value							_min			{ };
+		Value							_max			{ };
+	};
+
+
+template<class Value>
+	inline
+	P2Quantile<Value>::P2Quantile (double const quantile):
+		_quantile (quantile),
+		_desired ({ 1, 1 + 2 * quantile, 1 + 4 * quantile, 3 + 2 * quantile, 5 }),
+		_increments ({ 0, quantile / 2, quantile, (1 + quantile) / 2, 1 })
+	{
+		if (!(0.0 <= quantile && quantile <= 1.0))
+			throw InvalidArgument ("quantile must be in range 0…1");
+	}
+
+
+template<class Value>
+	inline void
+	P2Quantile<Value>::add (Value const& value)
+	{
+		if (_count < _heights.size())
+		{
+			_heights[_count++] = value;
+
+			if (_count == _heights.size())
+				std::sort (_heights.begin(), _heights.end());
+
+			return;
+		}
+
+		++_count;
+
+		// Find the cell containing value and update extreme markers:
+		std::size_t k;
+
+		if (value < _heights[0])
+		{
+			_heights[0] = value;
+			k = 0;
+		}
+		else if (value >= _heights[4])
+		{
+			_heights[4] = value;
+			k = 3;
+		}
+		else
+		{
+			k = 0;
+
+			while (value >= _heights[k + 1])
+				++k;
+		}
+
+		for (std::size_t i = k + 1; i < _positions.size(); ++i)
+			_positions[i] += 1;
+
+		for (std::size_t i = 0; i < _desired.size(); ++i)
+			_desired[i] += _increments[i];
+
+		// Adjust heights of the middle markers if they're off their desired positions:
+		for (std::size_t i = 1; i < 4; ++i)
+		{
+			auto const offset = _desired[i] - _positions[i];
+
+			if ((offset >= 1 && _positions[i + 1] - _positions[i] > 1) || (offset <= -1 && _positions[i - 1] - _positions[i] < -1))
+			{
+				auto const d = offset >= 0 ? 1.0 : -1.0;
+				auto const n_prev = _positions[i - 1];
+				auto const n = _positions[i];
+				auto const n_next = _positions[i + 1];
+				// Piecewise-parabolic prediction:
+				auto const parabolic = _heights[i] + (d / (n_next - n_prev)) * (
+					(_heights[i + 1] - _heights[i]) * ((n - n_prev + d) / (n_next - n)) +
+					(_heights[i] - _heights[i - 1]) * ((n_next - n - d) / (n - n_prev))
+				);
+
+				if (_heights[i - 1] < parabolic && parabolic < _heights[i + 1])
+					_heights[i] = parabolic;
+				else
+				{
+					// Linear prediction:
+					auto const j = d > 0 ? i + 1 : i - 1;
+					_heights[i] = _heights[i] + (_heights[j] - _heights[i]) * (d / (_positions[j] - n));
+				}
+
+				_positions[i] += d;
+			}
+		}
+	}
+
+
+template<class Value>
+	template<class Iterator>
+		inline void
+		P2Quantile<Value>::add (Iterator begin, Iterator end)
+		{
+			for (; begin != end; ++begin)
+				add (*begin);
+		}
+
+
+template<class Value>
+	inline Value
+	P2Quantile<Value>::value() const
+	{
+		if (_count == 0)
+			throw std::length_error ("can't compute quantile of zero samples");
+
+		// Up to five samples are stored as they are, so the quantile is exact:
+		if (_count <= _heights.size())
+		{
+			auto sorted = _heights;
+			std::sort (sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t> (_count));
+			auto const position = _quantile * static_cast<double> (_count - 1);
+			auto const a = static_cast<std::size_t> (position);
+			auto const b = std::min (a + 1, _count - 1);
+			return sorted[a] + (sorted[b] - sorted[a]) * (position - static_cast<double> (a));
+		}
+
+		return _heights[2];
+	}
+
+
+template<class Value>
+	inline
+	TDigest<Value>::TDigest (double const compression):
+		_compression (compression),
+		_buffer_capacity (static_cast<std::size_t> (5 * compression))
+	{
+		if (!(compression >= 10.0))
+			throw InvalidArgument ("t-digest compression must be at least 10");
+
+		_buffer.reserve (_buffer_capacity);
+	}
+
+
+template<class Value>
+	inline void
+	TDigest<Value>::add (Value const& value, double const weight)
+	{
+		if (count() == 0.0)
+			_min = _max = value;
+		else
+		{
+			_min = std::min (_min, value);
+			_max = std::max (_max, value);
+		}
+
+		_buffer.push_back ({ value, weight });
+		_buffer_weight += weight;
+
+		if (_buffer.size() >= _buffer_capacity)
+			compress();
+	}
+
+
+template<class Value>
+	template<class Iterator>
+		inline void
+		TDigest<Value>::add (Iterator begin, Iterator end)
+		{
+			for (; begin != end; ++begin)
+				add (*begin);
+		}
+
+
+template<class Value>
+	inline void
+	TDigest<Value>::merge (TDigest const& other)
+	{
+		if (other.count() == 0.0)
+			return;
+
+		auto const min = other.min();
+		auto const max = other.max();
+
+		// Copy, since adding may compress our centroids, and other may be this digest:
+		auto const centroids = other.centroids();
+
+		for (auto const& centroid: centroids)
+			add (centroid.mean, centroid.weight);
+
+		// Centroid means are within [min, max] of the other digest, but its exact extremes must be kept:
+		_min = std::min (_min, min);
+		_max = std::max (_max, max);
+	}
+
+
+template<class Value>
+	inline Value
+	TDigest<Value>::min() const
+	{
+		if (count() == 0.0)
+			throw std::length_error ("can't compute min() of empty t-digest");
+
+		return _min;
+	}
+
+
+template<class Value>
+	inline Value
+	TDigest<Value>::max() const
+	{
+		if (count() == 0.0)
+			throw std::length_error ("can't compute max() of empty t-digest");
+
+		return _max;
+	}
+
+
+template<class Value>
+	inline Value
+	TDigest<Value>::quantile (double const quantile) const
+	{
+		auto const& centroids = this->centroids();
+
+		if (centroids.empty())
+			throw std::length_error ("can't compute quantile() of empty t-digest");
+
+		// Each centroid's weight is spread evenly around its mean; values are interpolated between centroid
+		// centers and the exact minimum and maximum at both ends:
+		auto const index = std::clamp (quantile, 0.0, 1.0) * _weight;
+		auto const interpolate = [](Value const& a, Value const& b, double const position) {
+			return a + (b - a) * std::clamp (position, 0.0, 1.0);
+		};
+
+		auto const& first = centroids.front();
+
+		if (index < first.weight / 2)
+			return interpolate (_min, first.mean, index / (first.weight / 2));
+
+		auto weight_so_far = first.weight / 2;
+
+		for (std::size_t i = 0; i + 1 < centroids.size(); ++i)
+		{
+			auto const& left = centroids[i];
+			auto const& right = centroids[i + 1];
+			auto const step = (left.weight + right.weight) / 2;
+
+			if (index < weight_so_far + step)
+				return interpolate (left.mean, right.mean, (index - weight_so_far) / step);
+
+			weight_so_far += step;
+		}
+
+		auto const& last = centroids.back();
+		return interpolate (last.mean, _max, (index - weight_so_far) / (last.weight / 2));
+	}
+
+
+template<class Value>
+	inline auto
+	TDigest<Value>::centroids() const
+		-> std::vector<Centroid> const&
+	{
+		compress();
+		return _centroids;
+	}
+
+
+template<class Value>
+	inline void
+	TDigest<Value>::compress() const
+	{
+		if (_buffer.empty())
+			return;
+
+		_buffer.insert (_buffer.end(), _centroids.begin(), _centroids.end());
+		std::sort (_buffer.begin(), _buffer.end(), [](Centroid const& a, Centroid const& b) { return a.mean < b.mean; });
+
+		auto const total = _weight + _buffer_weight;
+		_centroids.clear();
+
+		auto current = _buffer.front();
+		double weight_before = 0.0;
+		double limit = total * inverse_scale (scale (0.0) + 1.0);
+
+		for (auto it = std::next (_buffer.begin()); it != _buffer.end(); ++it)
+		{
+			if (weight_before + current.weight + it->weight <= limit)
+			{
+				// Merge into the current centroid:
+				current.weight += it->weight;
+				current.mean = current.mean + (it->mean - current.mean) * (it->weight / current.weight);
+			}
+			else
+			{
+				weight_before += current.weight;
+				limit = total * inverse_scale (scale (weight_before / total) + 1.0);
+				_centroids.push_back (current);
+				current = *it;
+			}
+		}
+
+		_centroids.push_back (current);
+		_buffer.clear();
+		_weight = total;
+		_buffer_weight = 0.0;
+	}
+
+
+template<class Value>
+	inline double
+	TDigest<Value>::scale (double const quantile) const noexcept
+	{
+		return _compression / (2 * std::numbers::pi) * std::asin (2 * std::clamp (quantile, 0.0, 1.0) - 1);
+	}
+
+
+template<class Value>
+	inline double
+	TDigest<Value>::inverse_scale (double const k) const noexcept
+	{
+		auto const max_k = _compression / 4;
+
+		if (k >= max_k)
+			return 1.0;
+
+		return (std::sin (k * 2 * std::numbers::pi / _compression) + 1) / 2;
+	}
+
+
+/**
+ * Estimate median of a sequence in a single pass and constant memory with the P² algorithm.
+ * Unlike median() it doesn't copy the sequence, but the result is approximate (see P2Quantile).
+ */
+template<class Iterator>
+	[[nodiscard]]
+	inline auto
+	approximate_median (Iterator begin, Iterator end)
+	{
+		if (begin == end)
+			throw std::length_error ("can't compute approximate_median() of zero-length sequence");
+
+		using Value = std::remove_cvref_t<decltype (*std::declval<Iterator>())>;
+
+		P2Quantile<Value> estimator (0.5);
+		estimator.add (begin, end);
+		return estimator.value();
+	}
+
+
+/**
+ * Estimate given quantile (0…1) of a sequence in a single pass and bounded memory with a t-digest.
+ * The sequence isn't copied. See TDigest for error bounds.
+ */
+template<class Iterator>
+	[[nodiscard]]
+	inline auto
+	approximate_quantile (Iterator begin, Iterator end, double const quantile, double const compression = 100.0)
+	{
+		if (begin == end)
+			throw std::length_error ("can't compute approximate_quantile() of zero-length sequence");
+
+		using Value = std::remove_cvref_t<decltype (*std::declval<Iterator>())>;
+
+		TDigest<Value> digest (compression);
+		digest.add (begin, end);
+		return digest.quantile (quantile);
+	}
+
+} // namespace neutrino
+
+#endif
+
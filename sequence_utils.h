@@ -18,9 +18,12 @@
 #include <neutrino/range.h>
 
 // Standard:
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <stdexcept>
 #include <map>
+#include <tuple>
 
 
 namespace neutrino {
@@ -109,6 +112,54 @@ template<class ConstIterator, class Value, class Accessor>
 	}
 
 
+/**
+ * Same as adjacent_find_for_extrapolation(), but uses binary search, so it's O(log n) instead of O(n).
+ * Requires random-access iterators and a sequence sorted by get_value() with no duplicate values.
+ * Results are exactly the same as from adjacent_find_for_extrapolation() for such sequences.
+ */
+template<std::random_access_iterator ConstIterator, class Value, class Accessor>
+	inline std::tuple<bool, ConstIterator, ConstIterator>
+	sorted_adjacent_find_for_extrapolation (ConstIterator begin, ConstIterator end, Value const& value, Accessor&& get_value)
+	{
+		switch (std::distance (begin, end))
+		{
+			case 0:
+				return { false, end, end };
+
+			case 1:
+				return { get_value (*begin) == value, begin, begin };
+
+			case 2:
+				return { get_value (*begin) <= value && value <= get_value (*std::prev (end)), begin, std::prev (end) };
+
+			default:
+			{
+				// First element not less than value:
+				auto const b = std::partition_point (begin, end, [&] (auto const& element) { return get_value (element) < value; });
+
+				if (b == begin)
+				{
+					if (get_value (*begin) == value)
+						return { true, begin, std::next (begin) };
+					else if (value < get_value (*begin))
+						return { false, begin, std::next (begin) };
+					else
+					{
+						// Value is not comparable with elements (eg. NaN), adjacent_find_for_extrapolation() returns last
+						// element in such case:
+						auto const last = std::prev (end);
+						return { false, last, last };
+					}
+				}
+				else if (b == end)
+					return { false, std::prev (end, 2), std::prev (end) };
+				else
+					return { true, std::prev (b), b };
+			}
+		}
+	}
+
+
 /**
  * A simple trick to change const_iterator to iterator.
  */
@@ -0,0 +1,367 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__STATISTICS_H__INCLUDED
+#define NEUTRINO__STATISTICS_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/math/simd_pack.h>
+#include <neutrino/si/concepts.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace neutrino {
+
+/**
+ * Count, sum, extremes, mean and spread of a sequence of values.
+ */
+template<class Value>
+	struct DescriptiveStatistics
+	{
+		using Square = decltype (std::declval<Value>() * std::declval<Value>());
+
+		std::size_t	count	{ 0 };
+		Value		sum		{ };
+		Value		min		{ };
+		Value		max		{ };
+		Value		mean	{ };
+		// Sum of squared differences from the mean:
+		Square		m2		{ };
+
+		/**
+		 * Return sample variance.
+		 */
+		[[nodiscard]]
+		Square
+		variance() const noexcept
+			{ return m2 / static_cast<double> (count - 1); }
+
+		/**
+		 * Return sample standard deviation, same as stddev().
+		 */
+		[[nodiscard]]
+		Value
+		stddev() const noexcept
+		{
+			using std::sqrt;
+			return sqrt (variance());
+		}
+
+		/**
+		 * Combine with statistics of another sequence (Chan's formula), as if both sequences were concatenated.
+		 */
+		void
+		merge (DescriptiveStatistics const&);
+	};
+
+
+template<class Value>
+	inline void
+	DescriptiveStatistics<Value>::merge (DescriptiveStatistics const& other)
+	{
+		if (other.count == 0)
+			return;
+
+		if (count == 0)
+		{
+			*this = other;
+			return;
+		}
+
+		auto const n_a = static_cast<double> (count);
+		auto const n_b = static_cast<double> (other.count);
+		auto const n = n_a + n_b;
+		auto const delta = other.mean - mean;
+
+		count += other.count;
+		sum += other.sum;
+		min = std::min (min, other.min);
+		max = std::max (max, other.max);
+		mean = mean + delta * (n_b / n);
+		m2 += other.m2 + delta * delta * (n_a * n_b / n);
+	}
+
+
+namespace detail {
+
+/**
+ * Number of values processed by a single block of the statistics kernel. Blocks are small enough to stay in L1
+ * cache between the two passes over them.
+ */
+constexpr std::size_t kStatisticsBlockSize = 1024;
+
+/**
+ * Minimum number of values per task for the parallel version of descriptive_statistics().
+ */
+constexpr std::size_t kStatisticsMinValuesPerTask = 64 * kStatisticsBlockSize;
+
+
+/**
+ * Reduce all lanes of V (a SIMD pack or a scalar) to a single value.
+ */
+template<class Value, class V, class Reduce>
+	[[nodiscard]]
+	inline Value
+	reduce_lanes (V const& v, Reduce const reduce)
+	{
+		if constexpr (math::simd::kIsPack<V>)
+		{
+			std::array<Value, V::kLanes> lanes;
+			v.store (lanes.data());
+			return std::accumulate (lanes.begin() + 1, lanes.end(), lanes[0], reduce);
+		}
+		else
+			return v;
+	}
+
+
+/**
+ * Compute statistics of a single block of values: first pass computes the sum and extremes, the second one
+ * (over data that's now in cache) the sum of squared differences from the mean, with a correction term for rounding
+ * errors of the mean. Both passes use SIMD packs for float and double, with several independent accumulators
+ * to hide latency of additions.
+ */
+template<class Value>
+	[[nodiscard]]
+	inline DescriptiveStatistics<Value>
+	describe_block (Value const* const data, std::size_t const size)
+	{
+		using std::min;
+		using std::max;
+		using V = math::simd::NativePack<Value>;
+		using Square = typename DescriptiveStatistics<Value>::Square;
+
+		constexpr std::size_t kAccumulators = 4;
+		constexpr auto kLanes = math::simd::kNativeLanes<Value>;
+		constexpr auto kStride = kAccumulators * kLanes;
+		auto const unrolled_size = size - size % kStride;
+		auto const packed_size = size - size % kLanes;
+		auto const minimum_of = [](Value const& a, Value const& b) { return min (a, b); };
+		auto const maximum_of = [](Value const& a, Value const& b) { return max (a, b); };
+
+		std::array<V, kAccumulators> sums;
+		std::array<V, kAccumulators> minimums;
+		std::array<V, kAccumulators> maximums;
+		sums.fill (math::simd::broadcast<V> (Value()));
+		minimums.fill (math::simd::broadcast<V> (data[0]));
+		maximums.fill (math::simd::broadcast<V> (data[0]));
+
+		auto const accumulate_values = [&] (std::size_t const i, std::size_t const a) {
+			auto const x = math::simd::load<V> (data + i);
+			sums[a] = sums[a] + x;
+			minimums[a] = min (minimums[a], x);
+			maximums[a] = max (maximums[a], x);
+		};
+
+		for (std::size_t i = 0; i < unrolled_size; i += kStride)
+			for (std::size_t a = 0; a < kAccumulators; ++a)
+				accumulate_values (i + a * kLanes, a);
+
+		for (std::size_t i = unrolled_size; i < packed_size; i += kLanes)
+			accumulate_values (i, 0);
+
+		for (std::size_t a = 1; a < kAccumulators; ++a)
+		{
+			sums[0] = sums[0] + sums[a];
+			minimums[0] = min (minimums[0], minimums[a]);
+			maximums[0] = max (maximums[0], maximums[a]);
+		}
+
+		DescriptiveStatistics<Value> result;
+		result.count = size;
+		result.sum = reduce_lanes<Value> (sums[0], std::plus());
+		result.min = reduce_lanes<Value> (minimums[0], minimum_of);
+		result.max = reduce_lanes<Value> (maximums[0], maximum_of);
+
+		for (std::size_t i = packed_size; i < size; ++i)
+		{
+			result.sum += data[i];
+			result.min = min (result.min, data[i]);
+			result.max = max (result.max, data[i]);
+		}
+
+		result.mean = result.sum / static_cast<double> (size);
+
+		auto const mean = math::simd::broadcast<V> (result.mean);
+		std::array<V, kAccumulators> deviations;
+		std::array<decltype (mean * mean), kAccumulators> squares;
+		deviations.fill (math::simd::broadcast<V> (Value()));
+		squares.fill (math::simd::broadcast<V> (Square()));
+
+		auto const accumulate_deviations = [&] (std::size_t const i, std::size_t const a) {
+			auto const deviation = math::simd::load<V> (data + i) - mean;
+			deviations[a] = deviations[a] + deviation;
+			squares[a] = squares[a] + deviation * deviation;
+		};
+
+		for (std::size_t i = 0; i < unrolled_size; i += kStride)
+			for (std::size_t a = 0; a < kAccumulators; ++a)
+				accumulate_deviations (i + a * kLanes, a);
+
+		for (std::size_t i = unrolled_size; i < packed_size; i += kLanes)
+			accumulate_deviations (i, 0);
+
+		for (std::size_t a = 1; a < kAccumulators; ++a)
+		{
+			deviations[0] = deviations[0] + deviations[a];
+			squares[0] = squares[0] + squares[a];
+		}
+
+		auto deviations_sum = reduce_lanes<Value> (deviations[0], std::plus());
+		auto squares_sum = reduce_lanes<Square> (squares[0], std::plus());
+
+		for (std::size_t i = packed_size; i < size; ++i)
+		{
+			auto const deviation = data[i] - result.mean;
+			deviations_sum += deviation;
+			squares_sum += deviation * deviation;
+		}
+
+		result.m2 = squares_sum - deviations_sum * deviations_sum / static_cast<double> (size);
+		return result;
+	}
+
+
+/**
+ * Compute statistics of blocks and combine them pairwise, so that rounding errors grow only logarithmically
+ * with the number of values.
+ */
+template<class Value>
+	[[nodiscard]]
+	inline DescriptiveStatistics<Value>
+	describe_pairwise (Value const* const data, std::size_t const size)
+	{
+		if (size <= kStatisticsBlockSize)
+			return describe_block (data, size);
+
+		auto const half = (size / 2 + kStatisticsBlockSize - 1) / kStatisticsBlockSize * kStatisticsBlockSize;
+		auto result = describe_pairwise (data, half);
+		result.merge (describe_pairwise (data + half, size - half));
+		return result;
+	}
+
+} // namespace detail
+
+
+/**
+ * Values stored contiguously in memory (vector, array, span) that statistics can be computed for.
+ */
+template<class Values>
+	concept StatisticsRange =
+		std::ranges::contiguous_range<Values> &&
+		std::ranges::sized_range<Values> &&
+		si::FloatingPointOrQuantity<std::ranges::range_value_t<Values>>;
+
+
+/**
+ * Compute count, sum, min, max, mean and variance of values in a single pass over memory. Uses SIMD for float
+ * and double, and pairwise summation, which is much more accurate than plain accumulation.
+ * Throws std::length_error if there are no values.
+ */
+template<StatisticsRange Values>
+	[[nodiscard]]
+	inline auto
+	descriptive_statistics (Values const& values)
+	{
+		if (std::ranges::empty (values))
+			throw std::length_error ("can't compute descriptive_statistics() of zero-length sequence");
+
+		return detail::describe_pairwise (std::ranges::data (values), std::ranges::size (values));
+	}
+
+
+/**
+ * Like descriptive_statistics(), but split values between threads of given WorkPerformer.
+ * Blocks until all statistics are computed. Small sequences are computed in the calling thread.
+ */
+template<StatisticsRange Values>
+	[[nodiscard]]
+	inline auto
+	descriptive_statistics (Values const& values, WorkPerformer& work_performer)
+	{
+		if (std::ranges::empty (values))
+			throw std::length_error ("can't compute descriptive_statistics() of zero-length sequence");
+
+		using Value = std::ranges::range_value_t<Values>;
+
+		auto const data = std::ranges::data (values);
+		auto const size = std::ranges::size (values);
+		auto const tasks = std::max<std::size_t> (1, std::min (size / detail::kStatisticsMinValuesPerTask, work_performer.threads_number()));
+
+		if (tasks == 1)
+			return detail::describe_pairwise (data, size);
+
+		// Round chunks up to whole blocks:
+		auto const values_per_task = ((size + tasks - 1) / tasks + detail::kStatisticsBlockSize - 1) / detail::kStatisticsBlockSize * detail::kStatisticsBlockSize;
+		std::vector<std::future<DescriptiveStatistics<Value>>> futures;
+		futures.reserve (tasks);
+
+		for (std::size_t begin = 0; begin < size; begin += values_per_task)
+		{
+			auto const n = std::min (values_per_task, size - begin);
+			futures.push_back (work_performer.submit ([data, begin, n] {
+				return detail::describe_pairwise (data + begin, n);
+			}));
+		}
+
+		DescriptiveStatistics<Value> result;
+
+		for (auto& future: futures)
+			result.merge (future.get());
+
+		return result;
+	}
+
+
+/**
+ * Compute mean of contiguous values. Faster and more accurate than mean (begin, end).
+ * Throws std::length_error if there are no values.
+ */
+template<StatisticsRange Values>
+	[[nodiscard]]
+	inline auto
+	mean (Values const& values)
+	{
+		return descriptive_statistics (values).mean;
+	}
+
+
+/**
+ * Compute sample standard deviation of contiguous values in a single pass over memory.
+ * Throws std::length_error if there are no values.
+ */
+template<StatisticsRange Values>
+	[[nodiscard]]
+	inline auto
+	stddev (Values const& values)
+	{
+		return descriptive_statistics (values).stddev();
+	}
+
+} // namespace neutrino
+
+#endif
+
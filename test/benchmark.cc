@@ -0,0 +1,189 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Local:
+#include "benchmark.h"
+#include "benchmark_baseline.h"
+
+// Neutrino:
+#include <neutrino/exception.h>
+#include <neutrino/numeric.h>
+#include <neutrino/string.h>
+#include <neutrino/time.h>
+
+// Standard:
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+
+namespace neutrino {
+namespace {
+
+/**
+ * If arg has form "<option>=<value>", return the value.
+ */
+std::optional<std::string_view>
+option_value (std::string_view const arg, std::string_view const option)
+{
+	if (arg.starts_with (option) && arg.size() > option.size() && arg[option.size()] == '=')
+		return arg.substr (option.size() + 1);
+	else
+		return std::nullopt;
+}
+
+} // namespace
+
+
+Benchmark::Result
+Benchmark::execute (Entry const& entry, Parameters const& parameters)
+{
+	// Run once before calibration, so that one-time setup done by the benchmark function (eg. building lazily
+	// cached data) doesn't affect the number of iterations:
+	entry.function (1);
+
+	// Warm up caches and calibrate number of iterations so that a single repetition
+	// takes at least min_repetition_time:
+	std::size_t iterations = 1;
+
+	while (true)
+	{
+		auto const duration = measure_time ([&] { entry.function (iterations); });
+
+		if (duration >= parameters.min_repetition_time)
+			break;
+
+		// Grow geometrically, but aim directly at the target if we already have a reasonable measurement:
+		auto const needed = duration > si::Time (0.0)
+			? static_cast<std::size_t> (1.2 * iterations * (parameters.min_repetition_time / duration))
+			: 10 * iterations;
+
+		iterations = std::clamp<std::size_t> (needed, iterations + 1, 10 * iterations);
+	}
+
+	Result result;
+	result.name = entry.name;
+	result.iterations = iterations;
+	result.samples.reserve (parameters.repetitions);
+
+	for (std::size_t r = 0; r < parameters.repetitions; ++r)
+	{
+		auto const duration = measure_time ([&] { entry.function (iterations); });
+		result.samples.push_back (duration / static_cast<double> (iterations));
+	}
+
+	return result;
+}
+
+
+std::vector<Benchmark::Result>
+Benchmark::run_all (Parameters const& parameters)
+{
+	std::vector<Result> results;
+
+	for (auto const& entry: benchmarks())
+	{
+		if (!parameters.filter.empty() && entry.name.find (parameters.filter) == std::string::npos)
+			continue;
+
+		std::cout << "Benchmark: " << entry.name << "…" << std::flush;
+		auto result = execute (entry, parameters);
+		auto const& samples = result.samples;
+		auto const median_ns = median (samples.begin(), samples.end()).in<si::Nanosecond>();
+		auto const [min, max] = std::minmax_element (samples.begin(), samples.end());
+		std::cout << std::format (" median {:.2f} ns, min {:.2f} ns, max {:.2f} ns ({} iterations × {} repetitions)",
+								  median_ns, min->in<si::Nanosecond>(), max->in<si::Nanosecond>(), result.iterations, samples.size())
+				  << std::endl;
+		results.push_back (std::move (result));
+	}
+
+	return results;
+}
+
+
+int
+Benchmark::run_from_command_line (int argc, char const* const* argv)
+{
+	Parameters parameters;
+	BenchmarkComparison::Parameters comparison_parameters;
+	std::optional<std::string> save_baseline_file;
+	std::optional<std::string> compare_file;
+
+	try {
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string_view const arg = argv[i];
+
+			if (auto const value = option_value (arg, "--filter"))
+				parameters.filter = *value;
+			else if (auto const value = option_value (arg, "--repetitions"))
+				parameters.repetitions = parse<std::size_t> (*value);
+			else if (auto const value = option_value (arg, "--min-time-ms"))
+				parameters.min_repetition_time = si::Time (parse<double> (*value) / 1000.0);
+			else if (auto const value = option_value (arg, "--save-baseline"))
+				save_baseline_file = *value;
+			else if (auto const value = option_value (arg, "--compare"))
+				compare_file = *value;
+			else if (auto const value = option_value (arg, "--threshold"))
+				comparison_parameters.threshold = parse<double> (*value);
+			else if (auto const value = option_value (arg, "--alpha"))
+				comparison_parameters.alpha = parse<double> (*value);
+			else
+			{
+				std::cerr << "Unknown option: " << arg << std::endl;
+				return 2;
+			}
+		}
+
+		if (parameters.repetitions < 2)
+		{
+			std::cerr << "At least 2 repetitions are required." << std::endl;
+			return 2;
+		}
+
+		auto const current = BenchmarkBaseline (run_all (parameters));
+
+		if (save_baseline_file)
+		{
+			current.save (*save_baseline_file);
+			std::cout << "Baseline saved to " << *save_baseline_file << std::endl;
+		}
+
+		if (compare_file)
+		{
+			auto const baseline = BenchmarkBaseline::load (*compare_file);
+			auto const comparison = BenchmarkComparison (baseline, current, comparison_parameters);
+			comparison.write_report (std::cout);
+
+			if (comparison.has_regressions())
+				return 1;
+		}
+	}
+	catch (Exception const& e)
+	{
+		std::cerr << "Error: " << e.message() << std::endl;
+		return 2;
+	}
+	catch (std::exception const& e)
+	{
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 2;
+	}
+
+	return 0;
+}
+
+} // namespace neutrino
@@ -0,0 +1,134 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__TEST__BENCHMARK_H__INCLUDED
+#define NEUTRINO__TEST__BENCHMARK_H__INCLUDED
+
+// Neutrino:
+#include <neutrino/si/si.h>
+
+// Standard:
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace neutrino {
+
+/**
+ * Prevent the compiler from optimizing away computation of given value.
+ */
+template<class Value>
+	inline void
+	do_not_optimize (Value const& value)
+	{
+		asm volatile ("" : : "r,m" (value) : "memory");
+	}
+
+
+/**
+ * Self-registering benchmark, similar to AutoTest.
+ *
+ * Benchmarked function gets number of iterations and must execute the measured code exactly that many times.
+ * Iteration count is calibrated so that each repetition takes at least Parameters::min_repetition_time.
+ * Each repetition results in one sample (mean time of a single iteration), so that runs can later be compared
+ * statistically (see benchmark_baseline.h).
+ */
+class Benchmark
+{
+  public:
+	using BenchmarkFunction	= std::function<void (std::size_t iterations)>;
+
+	struct Parameters
+	{
+		// Number of samples to collect for each benchmark:
+		std::size_t	repetitions			{ 15 };
+		// Minimum duration of a single repetition (20 ms):
+		si::Time	min_repetition_time	{ 0.02 };
+		// Run only benchmarks which names contain this string:
+		std::string	filter;
+	};
+
+	struct Result
+	{
+		std::string				name;
+		std::size_t				iterations	{ 0 };
+		// Mean time of a single iteration, one for each repetition:
+		std::vector<si::Time>	samples;
+	};
+
+  private:
+	struct Entry
+	{
+		std::string			name;
+		BenchmarkFunction	function;
+	};
+
+  public:
+	// Ctor
+	Benchmark (std::string const& name, BenchmarkFunction);
+
+  public:
+	/**
+	 * Run given benchmark and collect samples.
+	 */
+	static Result
+	execute (Entry const&, Parameters const&);
+
+	/**
+	 * Run all registered benchmarks matching the filter and print progress to std::cout.
+	 */
+	static std::vector<Result>
+	run_all (Parameters const&);
+
+	/**
+	 * Entry point for benchmark executables.
+	 *
+	 * Recognized options:
+	 *   --filter=<substring>		run only matching benchmarks
+	 *   --repetitions=<n>			number of samples per benchmark
+	 *   --min-time-ms=<ms>		minimum duration of a single repetition
+	 *   --save-baseline=<file>		save results as a baseline file
+	 *   --compare=<file>			compare results with a baseline file
+	 *   --threshold=<fraction>		minimum relative change reported as regression/improvement (default 0.05)
+	 *   --alpha=<p>				significance level for the Mann-Whitney U test (default 0.01)
+	 *
+	 * Returns exit status for the program: 0 on success, 1 if regressions were found, 2 on usage or I/O errors.
+	 */
+	static int
+	run_from_command_line (int argc, char const* const* argv);
+
+	static std::vector<Entry>&
+	benchmarks();
+};
+
+
+inline
+Benchmark::Benchmark (std::string const& name, BenchmarkFunction function)
+{
+	benchmarks().push_back ({ name, std::move (function) });
+}
+
+
+inline auto
+Benchmark::benchmarks()
+	-> std::vector<Entry>&
+{
+	static std::vector<Entry> benchmarks;
+	return benchmarks;
+}
+
+} // namespace neutrino
+
+#endif
@@ -0,0 +1,296 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Local:
+#include "benchmark_baseline.h"
+
+// Neutrino:
+#include <neutrino/numeric.h>
+#include <neutrino/stdexcept.h>
+#include <neutrino/string.h>
+
+// Standard:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+
+namespace neutrino {
+namespace {
+
+constexpr char kBaselineHeader[] = "# neutrino benchmark baseline v1";
+
+} // namespace
+
+
+MannWhitneyResult
+mann_whitney_u_test (std::vector<double> const& a, std::vector<double> const& b)
+{
+	MannWhitneyResult result;
+
+	if (a.empty() || b.empty())
+		return result;
+
+	struct Ranked
+	{
+		double	value;
+		bool	from_a;
+	};
+
+	std::vector<Ranked> all;
+	all.reserve (a.size() + b.size());
+
+	for (auto const v: a)
+		all.push_back ({ v, true });
+
+	for (auto const v: b)
+		all.push_back ({ v, false });
+
+	std::sort (all.begin(), all.end(), [](auto const& x, auto const& y) { return x.value < y.value; });
+
+	// Assign average ranks to ties and collect the tie-correction term:
+	double rank_sum_a = 0.0;
+	double ties_term = 0.0;
+
+	for (std::size_t i = 0; i < all.size(); )
+	{
+		std::size_t j = i + 1;
+
+		while (j < all.size() && all[j].value == all[i].value)
+			++j;
+
+		auto const tied = static_cast<double> (j - i);
+		// Ranks are 1-based:
+		auto const average_rank = 0.5 * static_cast<double> (i + 1 + j);
+
+		for (std::size_t k = i; k < j; ++k)
+			if (all[k].from_a)
+				rank_sum_a += average_rank;
+
+		ties_term += tied * tied * tied - tied;
+		i = j;
+	}
+
+	auto const n1 = static_cast<double> (a.size());
+	auto const n2 = static_cast<double> (b.size());
+	auto const n = n1 + n2;
+
+	result.u = rank_sum_a - n1 * (n1 + 1.0) / 2.0;
+
+	auto const mean_u = n1 * n2 / 2.0;
+	auto const variance_u = n1 * n2 / 12.0 * ((n + 1.0) - ties_term / (n * (n - 1.0)));
+
+	if (variance_u <= 0.0)
+		return result;
+
+	auto const difference = result.u - mean_u;
+	// Continuity correction:
+	auto const corrected = std::max (0.0, std::abs (difference) - 0.5);
+
+	result.z = std::copysign (corrected / std::sqrt (variance_u), difference);
+	result.p_value = std::min (1.0, std::erfc (std::abs (result.z) / std::sqrt (2.0)));
+
+	return result;
+}
+
+
+BenchmarkBaseline::BenchmarkBaseline (std::vector<Benchmark::Result> const& results)
+{
+	for (auto const& result: results)
+	{
+		auto& samples = benchmarks[result.name];
+		samples.reserve (result.samples.size());
+
+		for (auto const sample: result.samples)
+			samples.push_back (sample.in<si::Nanosecond>());
+	}
+}
+
+
+BenchmarkBaseline
+BenchmarkBaseline::load (std::filesystem::path const& file_name)
+{
+	std::ifstream file (file_name);
+
+	if (!file.good())
+		throw IOError ("could not open '" + std::string (file_name) + "' for reading");
+
+	BenchmarkBaseline result;
+	std::string line;
+	std::size_t line_number = 0;
+
+	while (std::getline (file, line))
+	{
+		++line_number;
+
+		if (line_number == 1 && line != kBaselineHeader)
+			throw InvalidFormat (std::format ("'{}' is not a benchmark baseline file", std::string (file_name)));
+
+		if (line.empty() || line.front() == '#')
+			continue;
+
+		auto const tab = line.rfind ('\t');
+
+		if (tab == std::string::npos)
+			throw InvalidFormat (std::format ("missing tab separator in '{}' at line {}", std::string (file_name), line_number));
+
+		auto& samples = result.benchmarks[line.substr (0, tab)];
+		std::istringstream words (line.substr (tab + 1));
+		std::string word;
+
+		while (words >> word)
+			samples.push_back (parse<double> (word));
+	}
+
+	return result;
+}
+
+
+void
+BenchmarkBaseline::save (std::filesystem::path const& file_name) const
+{
+	if (file_name.has_parent_path())
+		std::filesystem::create_directories (file_name.parent_path());
+
+	std::ofstream file (file_name);
+
+	if (!file.good())
+		throw IOError ("could not open '" + std::string (file_name) + "' for writing");
+
+	file << kBaselineHeader << '\n';
+
+	for (auto const& [name, samples]: benchmarks)
+	{
+		file << name << '\t';
+
+		for (std::size_t i = 0; i < samples.size(); ++i)
+			file << (i > 0 ? " " : "") << std::format ("{:.3f}", samples[i]);
+
+		file << '\n';
+	}
+
+	if (!file.good())
+		throw IOError ("failed to write all data to '" + std::string (file_name) + "'");
+}
+
+
+BenchmarkComparison::BenchmarkComparison (BenchmarkBaseline const& baseline, BenchmarkBaseline const& current, Parameters const& parameters)
+{
+	auto const median_of = [](auto const& samples) -> std::optional<double> {
+		if (samples.empty())
+			return std::nullopt;
+		else
+			return neutrino::median (samples.begin(), samples.end());
+	};
+
+	for (auto const& [name, current_samples]: current.benchmarks)
+	{
+		Entry entry;
+		entry.name = name;
+		entry.current_median = median_of (current_samples);
+
+		if (auto const found = baseline.benchmarks.find (name);
+			found != baseline.benchmarks.end())
+		{
+			entry.baseline_median = median_of (found->second);
+
+			if (entry.baseline_median && entry.current_median && *entry.baseline_median > 0.0)
+			{
+				auto const change = (*entry.current_median - *entry.baseline_median) / *entry.baseline_median;
+				auto const test = mann_whitney_u_test (found->second, current_samples);
+				entry.relative_change = change;
+				entry.p_value = test.p_value;
+
+				if (test.p_value < parameters.alpha && std::abs (change) > parameters.threshold)
+					entry.verdict = change > 0.0 ? Verdict::Regression : Verdict::Improvement;
+			}
+		}
+		else
+			entry.verdict = Verdict::New;
+
+		entries.push_back (entry);
+	}
+
+	for (auto const& [name, baseline_samples]: baseline.benchmarks)
+	{
+		if (!current.benchmarks.contains (name))
+		{
+			Entry entry;
+			entry.name = name;
+			entry.verdict = Verdict::Missing;
+			entry.baseline_median = median_of (baseline_samples);
+			entries.push_back (entry);
+		}
+	}
+}
+
+
+std::size_t
+BenchmarkComparison::count (Verdict const verdict) const noexcept
+{
+	return to_unsigned (std::count_if (entries.begin(), entries.end(), [&](auto const& entry) { return entry.verdict == verdict; }));
+}
+
+
+void
+BenchmarkComparison::write_report (std::ostream& out) const
+{
+	auto const optional_ns = [](std::optional<double> const value) {
+		return value ? std::format ("{:.1f} ns", *value) : std::string ("-");
+	};
+
+	for (auto const verdict: { Verdict::Regression, Verdict::Improvement, Verdict::New, Verdict::Missing, Verdict::Unchanged })
+	{
+		for (auto const& entry: entries)
+		{
+			if (entry.verdict != verdict)
+				continue;
+
+			out << std::format ("{:<12} {}: {} → {}", to_string (entry.verdict), entry.name, optional_ns (entry.baseline_median), optional_ns (entry.current_median));
+
+			if (entry.relative_change)
+				out << std::format (" ({:+.1f}%", 100.0 * *entry.relative_change);
+
+			if (entry.p_value)
+				out << std::format (", p={:.4f})", *entry.p_value);
+
+			out << '\n';
+		}
+	}
+
+	out << std::format ("Summary: {} regressions, {} improvements, {} unchanged, {} new, {} missing\n",
+						count (Verdict::Regression), count (Verdict::Improvement), count (Verdict::Unchanged),
+						count (Verdict::New), count (Verdict::Missing));
+}
+
+
+std::string_view
+to_string (BenchmarkComparison::Verdict const verdict)
+{
+	switch (verdict)
+	{
+		case BenchmarkComparison::Verdict::Unchanged:	return "unchanged";
+		case BenchmarkComparison::Verdict::Regression:	return "REGRESSION";
+		case BenchmarkComparison::Verdict::Improvement:	return "improvement";
+		case BenchmarkComparison::Verdict::New:			return "new";
+		case BenchmarkComparison::Verdict::Missing:		return "missing";
+	}
+
+	return "unknown";
+}
+
+} // namespace neutrino
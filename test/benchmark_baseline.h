@@ -0,0 +1,173 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+#ifndef NEUTRINO__TEST__BENCHMARK_BASELINE_H__INCLUDED
+#define NEUTRINO__TEST__BENCHMARK_BASELINE_H__INCLUDED
+
+// Local:
+#include "benchmark.h"
+
+// Standard:
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace neutrino {
+
+/**
+ * Result of the two-sided Mann-Whitney U test.
+ */
+struct MannWhitneyResult
+{
+	// U statistic of the first sample:
+	double	u		{ 0.0 };
+	// Normal-approximated, tie-corrected z-score:
+	double	z		{ 0.0 };
+	// Two-sided p-value:
+	double	p_value	{ 1.0 };
+};
+
+
+/**
+ * Perform two-sided Mann-Whitney U test (aka Wilcoxon rank-sum test) on two independent samples.
+ * Uses normal approximation with tie and continuity corrections, which is reasonable for sample sizes above ~8.
+ * Returns p-value = 1 if any of the samples is empty.
+ */
+[[nodiscard]]
+MannWhitneyResult
+mann_whitney_u_test (std::vector<double> const& a, std::vector<double> const& b);
+
+
+/**
+ * Set of benchmark samples (nanoseconds per iteration) indexed by benchmark name.
+ * Can be saved to and loaded from a text file:
+ *
+ *   # neutrino benchmark baseline v1
+ *   <benchmark name><TAB><sample ns> <sample ns> …
+ */
+class BenchmarkBaseline
+{
+  public:
+	using Samples = std::vector<double>;
+
+  public:
+	std::map<std::string, Samples> benchmarks;
+
+  public:
+	// Ctor
+	BenchmarkBaseline() = default;
+
+	// Ctor
+	explicit
+	BenchmarkBaseline (std::vector<Benchmark::Result> const&);
+
+	/**
+	 * Load baseline from a file.
+	 * \throw	IOError if file can't be read.
+	 * \throw	InvalidFormat if file has wrong format.
+	 */
+	[[nodiscard]]
+	static BenchmarkBaseline
+	load (std::filesystem::path const&);
+
+	/**
+	 * Save baseline to a file.
+	 * \throw	IOError if file can't be written.
+	 */
+	void
+	save (std::filesystem::path const&) const;
+};
+
+
+/**
+ * Result of comparing current benchmark run to a baseline.
+ */
+class BenchmarkComparison
+{
+  public:
+	struct Parameters
+	{
+		// Relative change of median below which differences are ignored:
+		double	threshold	{ 0.05 };
+		// Significance level for the Mann-Whitney U test:
+		double	alpha		{ 0.01 };
+	};
+
+	enum class Verdict
+	{
+		Unchanged,
+		Regression,
+		Improvement,
+		// Benchmark missing in the baseline:
+		New,
+		// Benchmark missing in the current run:
+		Missing,
+	};
+
+	struct Entry
+	{
+		std::string				name;
+		Verdict					verdict			{ Verdict::Unchanged };
+		std::optional<double>	baseline_median;
+		std::optional<double>	current_median;
+		// (current_median - baseline_median) / baseline_median:
+		std::optional<double>	relative_change;
+		std::optional<double>	p_value;
+	};
+
+  public:
+	std::vector<Entry> entries;
+
+  public:
+	// Ctor
+	explicit
+	BenchmarkComparison (BenchmarkBaseline const& baseline, BenchmarkBaseline const& current, Parameters const&);
+
+	/**
+	 * Return number of entries with given verdict.
+	 */
+	[[nodiscard]]
+	std::size_t
+	count (Verdict) const noexcept;
+
+	/**
+	 * Return true if there were any significant regressions.
+	 */
+	[[nodiscard]]
+	bool
+	has_regressions() const noexcept
+		{ return count (Verdict::Regression) > 0; }
+
+	/**
+	 * Write human-readable report.
+	 */
+	void
+	write_report (std::ostream&) const;
+};
+
+
+/**
+ * Return printable name of the verdict.
+ */
+[[nodiscard]]
+std::string_view
+to_string (BenchmarkComparison::Verdict);
+
+} // namespace neutrino
+
+#endif
@@ -0,0 +1,100 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/test/auto_test.h>
+#include <neutrino/test/benchmark_baseline.h>
+
+// Standard:
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+std::vector<double>
+samples_around (double const center, double const spread, std::size_t const count = 15)
+{
+	std::vector<double> result;
+
+	for (std::size_t i = 0; i < count; ++i)
+		result.push_back (center + spread * (static_cast<double> (i % 5) - 2.0));
+
+	return result;
+}
+
+
+AutoTest t1 ("Mann-Whitney U test", []{
+	auto const a = samples_around (100.0, 1.0);
+	auto const b = samples_around (120.0, 1.0);
+
+	test_asserts::verify ("identical samples are not significantly different", mann_whitney_u_test (a, a).p_value > 0.5);
+	test_asserts::verify ("clearly separated samples are significantly different", mann_whitney_u_test (a, b).p_value < 1e-4);
+	test_asserts::verify ("U is 0 when all of a < b", mann_whitney_u_test (a, b).u == 0.0);
+	test_asserts::verify ("empty sample gives p-value = 1", mann_whitney_u_test (a, {}).p_value == 1.0);
+});
+
+
+AutoTest t2 ("BenchmarkComparison verdicts", []{
+	BenchmarkBaseline baseline;
+	baseline.benchmarks["same"] = samples_around (100.0, 1.0);
+	baseline.benchmarks["slower"] = samples_around (100.0, 1.0);
+	baseline.benchmarks["faster"] = samples_around (100.0, 1.0);
+	baseline.benchmarks["small change"] = samples_around (100.0, 1.0);
+	baseline.benchmarks["removed"] = samples_around (100.0, 1.0);
+
+	BenchmarkBaseline current;
+	current.benchmarks["same"] = samples_around (100.0, 1.0);
+	current.benchmarks["slower"] = samples_around (130.0, 1.0);
+	current.benchmarks["faster"] = samples_around (70.0, 1.0);
+	current.benchmarks["small change"] = samples_around (102.0, 1.0);
+	current.benchmarks["added"] = samples_around (100.0, 1.0);
+
+	BenchmarkComparison const comparison (baseline, current, { .threshold = 0.05, .alpha = 0.01 });
+	using Verdict = BenchmarkComparison::Verdict;
+
+	auto const verdict_of = [&](std::string const& name) {
+		for (auto const& entry: comparison.entries)
+			if (entry.name == name)
+				return entry.verdict;
+
+		throw TestAssertFailed ("entry exists", name);
+	};
+
+	test_asserts::verify ("unchanged benchmark", verdict_of ("same") == Verdict::Unchanged);
+	test_asserts::verify ("regression detected", verdict_of ("slower") == Verdict::Regression);
+	test_asserts::verify ("improvement detected", verdict_of ("faster") == Verdict::Improvement);
+	test_asserts::verify ("change below threshold ignored", verdict_of ("small change") == Verdict::Unchanged);
+	test_asserts::verify ("new benchmark", verdict_of ("added") == Verdict::New);
+	test_asserts::verify ("missing benchmark", verdict_of ("removed") == Verdict::Missing);
+	test_asserts::verify ("has_regressions()", comparison.has_regressions());
+});
+
+
+AutoTest t3 ("BenchmarkBaseline save/load", []{
+	BenchmarkBaseline baseline;
+	baseline.benchmarks["mean() of 4096 values"] = { 1.5, 2.25, 3.125 };
+	baseline.benchmarks["other"] = { 10.0 };
+
+	auto const file = std::filesystem::temp_directory_path() / "neutrino-benchmark-baseline.test";
+	baseline.save (file);
+	auto const loaded = BenchmarkBaseline::load (file);
+	std::filesystem::remove (file);
+
+	test_asserts::verify ("loaded baseline equals saved one", loaded.benchmarks == baseline.benchmarks);
+});
+
+} // namespace
+} // namespace neutrino::test
@@ -0,0 +1,88 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/integration.h>
+#include <neutrino/logger.h>
+#include <neutrino/numeric.h>
+#include <neutrino/test/benchmark.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <cmath>
+#include <cstddef>
+
+
+namespace neutrino::test {
+namespace {
+
+Logger g_null_logger;
+
+
+double
+peaked (double const x)
+{
+	return 1.0 / (1e-4 + (x - 0.3) * (x - 0.3));
+}
+
+
+// Same function, but expensive to evaluate, like a simulation step:
+double
+expensive_peaked (double const x)
+{
+	auto result = 0.0;
+
+	for (int i = 0; i < 1000; ++i)
+		result += std::sqrt (peaked (x) * peaked (x) + i * 1e-12);
+
+	return result / 1000.0;
+}
+
+
+IntegrationParameters<double> const kParameters { .absolute_tolerance = 0.0, .relative_tolerance = 1e-8, .max_intervals = 10'000 };
+
+
+Benchmark b1 ("trapezoid_integral() of peaked function, 1e-5 step", [](std::size_t const iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (trapezoid_integral (peaked, Range { 0.0, 1.0 }, 1e-5));
+});
+
+
+Benchmark b2 ("gauss_kronrod_integral() of peaked function, 1e-8 relative tolerance", [](std::size_t const iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (gauss_kronrod_integral (peaked, Range { 0.0, 1.0 }, kParameters));
+});
+
+
+Benchmark b3 ("simpson_integral() of peaked function, 1e-8 relative tolerance", [](std::size_t const iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (simpson_integral (peaked, Range { 0.0, 1.0 }, kParameters));
+});
+
+
+Benchmark b4 ("gauss_kronrod_integral() of expensive function", [](std::size_t const iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (gauss_kronrod_integral (expensive_peaked, Range { 0.0, 1.0 }, kParameters));
+});
+
+
+Benchmark b5 ("gauss_kronrod_integral() of expensive function, 4 threads", [](std::size_t const iterations) {
+	static WorkPerformer work_performer (4, g_null_logger);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (gauss_kronrod_integral (expensive_peaked, Range { 0.0, 1.0 }, kParameters, work_performer));
+});
+
+} // namespace
+} // namespace neutrino::test
+
@@ -0,0 +1,137 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/integration.h>
+#include <neutrino/logger.h>
+#include <neutrino/numeric.h>
+#include <neutrino/si/si.h>
+#include <neutrino/test/auto_test.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace neutrino::si::literals;
+
+Logger g_null_logger;
+
+
+double
+smooth (double const x)
+{
+	return std::exp (-x) * std::cos (3.0 * x);
+}
+
+
+// ∫₀⁴ smooth(x) dx:
+double const kSmoothIntegral = (1.0 - std::exp (-4.0) * (std::cos (12.0) - 3.0 * std::sin (12.0))) / 10.0;
+
+
+double
+peaked (double const x)
+{
+	return 1.0 / (1e-4 + (x - 0.3) * (x - 0.3));
+}
+
+
+// ∫₀¹ peaked(x) dx:
+double const kPeakedIntegral = 100.0 * (std::atan (70.0) + std::atan (30.0));
+
+
+AutoTest t1 ("gauss_kronrod_integral()", []{
+	auto const result = gauss_kronrod_integral (smooth, Range { 0.0, 4.0 });
+	test_asserts::verify ("converged on smooth function", result.converged);
+	test_asserts::verify_equal_with_epsilon ("smooth function integral is correct", result.value, kSmoothIntegral, 1e-12);
+	test_asserts::verify ("smooth function needs few evaluations", result.evaluations <= 150);
+	test_asserts::verify ("error estimate is sane", result.error >= 0.0 && result.error < 1e-9);
+
+	auto const peaked_result = gauss_kronrod_integral (peaked, Range { 0.0, 1.0 }, { .absolute_tolerance = 0.0, .relative_tolerance = 1e-10, .max_intervals = 1000 });
+	test_asserts::verify ("converged on peaked function", peaked_result.converged);
+	test_asserts::verify_equal_with_epsilon ("peaked function integral is correct", peaked_result.value, kPeakedIntegral, 1e-10 * kPeakedIntegral);
+
+	// Compare with fixed-step trapezoid method needing much more evaluations for worse accuracy:
+	auto const trapezoid = trapezoid_integral (peaked, Range { 0.0, 1.0 }, 1e-5);
+	test_asserts::verify ("better than trapezoid_integral()", std::abs (peaked_result.value - kPeakedIntegral) < std::abs (trapezoid - kPeakedIntegral));
+	test_asserts::verify ("uses fewer evaluations than trapezoid_integral()", peaked_result.evaluations < 10'000);
+
+	auto const limited = gauss_kronrod_integral (peaked, Range { 0.0, 1.0 }, { .absolute_tolerance = 0.0, .relative_tolerance = 1e-14, .max_intervals = 4 });
+	test_asserts::verify ("reports no convergence when max_intervals is reached", !limited.converged);
+	test_asserts::verify ("respects max_intervals", limited.evaluations <= 15 * 7);
+});
+
+
+AutoTest t2 ("simpson_integral()", []{
+	auto const result = simpson_integral (smooth, Range { 0.0, 4.0 }, { .absolute_tolerance = 0.0, .relative_tolerance = 1e-10, .max_intervals = 10'000 });
+	test_asserts::verify ("converged on smooth function", result.converged);
+	test_asserts::verify_equal_with_epsilon ("smooth function integral is correct", result.value, kSmoothIntegral, 1e-10);
+
+	auto const peaked_result = simpson_integral (peaked, Range { 0.0, 1.0 }, { .absolute_tolerance = 0.0, .relative_tolerance = 1e-8, .max_intervals = 10'000 });
+	test_asserts::verify ("converged on peaked function", peaked_result.converged);
+	test_asserts::verify_equal_with_epsilon ("peaked function integral is correct", peaked_result.value, kPeakedIntegral, 1e-8 * kPeakedIntegral);
+
+	// Function with a kink:
+	auto const kinked = simpson_integral ([](double const x) { return std::abs (x - 1.0 / 3.0); }, Range { 0.0, 1.0 });
+	test_asserts::verify_equal_with_epsilon ("kinked function integral is correct", kinked.value, 5.0 / 18.0, 1e-9);
+
+	auto const limited = simpson_integral (peaked, Range { 0.0, 1.0 }, { .absolute_tolerance = 0.0, .relative_tolerance = 1e-14, .max_intervals = 4 });
+	test_asserts::verify ("reports no convergence when max_intervals is reached", !limited.converged);
+});
+
+
+AutoTest t3 ("integration: parallel mode", []{
+	WorkPerformer wp (4, g_null_logger);
+	IntegrationParameters<double> const parameters { .absolute_tolerance = 0.0, .relative_tolerance = 1e-10, .max_intervals = 1000 };
+
+	auto const serial = gauss_kronrod_integral (peaked, Range { 0.0, 1.0 }, parameters);
+	auto const parallel = gauss_kronrod_integral (peaked, Range { 0.0, 1.0 }, parameters, wp);
+	test_asserts::verify ("parallel gauss_kronrod_integral() converged", parallel.converged);
+	test_asserts::verify_equal_with_epsilon ("parallel gauss_kronrod_integral() is correct", parallel.value, kPeakedIntegral, 1e-10 * kPeakedIntegral);
+	test_asserts::verify_equal_with_epsilon ("parallel gauss_kronrod_integral() matches serial", parallel.value, serial.value, 2e-10 * kPeakedIntegral);
+
+	auto const simpson = simpson_integral (peaked, Range { 0.0, 1.0 }, { .absolute_tolerance = 0.0, .relative_tolerance = 1e-8, .max_intervals = 10'000 }, wp);
+	test_asserts::verify ("parallel simpson_integral() converged", simpson.converged);
+	test_asserts::verify_equal_with_epsilon ("parallel simpson_integral() is correct", simpson.value, kPeakedIntegral, 1e-8 * kPeakedIntegral);
+});
+
+
+AutoTest t4 ("integration: SI quantities", []{
+	WorkPerformer wp (4, g_null_logger);
+	// Velocity of a harmonic oscillator; integral over whole period is 0, over half a period 2 × amplitude:
+	auto const amplitude = 2_m;
+	auto const period = 4_s;
+	auto const velocity = [&] (si::Time const t) -> si::Velocity {
+		return amplitude * (2.0 * std::numbers::pi / period) * std::cos (2.0 * std::numbers::pi * (t / period));
+	};
+	IntegrationParameters<si::Length> const parameters { .absolute_tolerance = 1_nm, .relative_tolerance = 1e-10, .max_intervals = 1000 };
+
+	auto const gk = gauss_kronrod_integral (velocity, Range<si::Time> { -1_s, 1_s }, parameters);
+	test_asserts::verify_equal_with_epsilon ("gauss_kronrod_integral() over si::Time is correct", gk.value, 2.0 * amplitude, 1_nm);
+	auto const gk_parallel = gauss_kronrod_integral (velocity, Range<si::Time> { -1_s, 1_s }, parameters, wp);
+	test_asserts::verify_equal_with_epsilon ("parallel gauss_kronrod_integral() over si::Time is correct", gk_parallel.value, 2.0 * amplitude, 1_nm);
+
+	auto const simpson = simpson_integral (velocity, Range<si::Time> { -1_s, 1_s }, parameters);
+	test_asserts::verify_equal_with_epsilon ("simpson_integral() over si::Time is correct", simpson.value, 2.0 * amplitude, 1_nm);
+	auto const simpson_parallel = simpson_integral (velocity, Range<si::Time> { -1_s, 1_s }, parameters, wp);
+	test_asserts::verify_equal_with_epsilon ("parallel simpson_integral() over si::Time is correct", simpson_parallel.value, 2.0 * amplitude, 1_nm);
+});
+
+} // namespace
+} // namespace neutrino::test
+
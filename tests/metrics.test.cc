@@ -0,0 +1,177 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/test/auto_test.h>
+#include <neutrino/metrics.h>
+#include <neutrino/stdexcept.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace si::literals;
+
+Logger g_null_logger;
+
+
+AutoTest t1 ("neutrino::Counter and Gauge: concurrent updates", []{
+	constexpr std::size_t kThreads = 8;
+	constexpr std::size_t kUpdates = 100'000;
+
+	MetricsRegistry registry;
+	auto& counter = registry.counter ("test_updates_total", "Updates");
+	auto& gauge = registry.gauge ("test_level", "Level");
+	std::vector<std::jthread> threads;
+
+	for (std::size_t t = 0; t < kThreads; ++t)
+	{
+		threads.emplace_back ([&] {
+			for (std::size_t i = 0; i < kUpdates; ++i)
+			{
+				counter.add();
+				gauge.add (2.0);
+				gauge.sub (1.0);
+			}
+		});
+	}
+
+	threads.clear();
+
+	test_asserts::verify ("counter sums all shards", counter.value() == kThreads * kUpdates);
+	test_asserts::verify ("gauge sums all shards", gauge.value() == static_cast<double> (kThreads * kUpdates));
+
+	gauge.set (-5.0);
+	test_asserts::verify ("gauge set() replaces value", gauge.value() == -5.0);
+});
+
+
+AutoTest t2 ("neutrino::LatencyHistogram: log-linear buckets", []{
+	bool all_correct = true;
+
+	for (std::uint64_t ns: { 0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 1000ull, 123'456'789ull, 1ull << 40, ~0ull })
+	{
+		auto const index = LatencyHistogram::bucket_index (ns);
+		auto const upper = LatencyHistogram::bucket_upper_bound (index);
+		auto const lower = index == 0 ? 0 : LatencyHistogram::bucket_upper_bound (index - 1) + 1;
+
+		// Value must lie within its bucket and the bucket width must not exceed 1/8 of the value:
+		if (ns < lower || ns > upper || (ns >= 8 && (upper - lower + 1) > ns / 8 + 1))
+			all_correct = false;
+	}
+
+	test_asserts::verify ("values fall into correct buckets", all_correct);
+	test_asserts::verify ("last bucket index", LatencyHistogram::bucket_index (~0ull) == LatencyHistogram::kBuckets - 1);
+
+	LatencyHistogram histogram;
+	histogram.record (1_us);
+	histogram.record (1_us);
+	histogram.record (1_ms);
+	auto const snapshot = histogram.snapshot();
+
+	test_asserts::verify ("count is correct", snapshot.count == 3);
+	test_asserts::verify ("two non-empty buckets", snapshot.buckets.size() == 2);
+	test_asserts::verify_equal_with_epsilon ("sum is correct", snapshot.sum, 1.002_ms, 1_ns);
+});
+
+
+AutoTest t3 ("neutrino::MetricsRegistry: labels and Prometheus export", []{
+	MetricsRegistry registry;
+	registry.counter ("requests_total", "Requests", { { "method", "get" } }).add (3);
+	registry.counter ("requests_total", "Requests", { { "method", "post" } }).add (2);
+	registry.counter ("requests_total", "Requests", { { "method", "get" } }).add (1);
+	registry.gauge ("temperature", "Temperature with \"quotes\"", { { "place", "a\"b" } }).set (21.5);
+	registry.histogram ("latency_seconds", "Latency").record (5_ns);
+
+	auto const text = to_prometheus_text (registry.snapshot());
+	auto const expected =
+		"# HELP latency_seconds Latency\n"
+		"# TYPE latency_seconds histogram\n"
+		"latency_seconds_bucket{le=\"5e-09\"} 1\n"
+		"latency_seconds_bucket{le=\"+Inf\"} 1\n"
+		"latency_seconds_sum 5e-09\n"
+		"latency_seconds_count 1\n"
+		"# HELP requests_total Requests\n"
+		"# TYPE requests_total counter\n"
+		"requests_total{method=\"get\"} 4\n"
+		"requests_total{method=\"post\"} 2\n"
+		"# HELP temperature Temperature with \"quotes\"\n"
+		"# TYPE temperature gauge\n"
+		"temperature{place=\"a\\\"b\"} 21.5\n";
+
+	test_asserts::verify ("Prometheus text is correct", text == expected);
+
+	test_asserts::verify_throws<InvalidArgument> ("re-registering with different type throws", [&] {
+		(void) registry.gauge ("requests_total", "Requests");
+	});
+
+	test_asserts::verify_throws<InvalidArgument> ("invalid name throws", [&] {
+		(void) registry.counter ("0-invalid", "Invalid");
+	});
+});
+
+
+AutoTest t4 ("neutrino::WorkPerformer: metrics", []{
+	MetricsRegistry registry;
+
+	{
+		WorkPerformer wp (2, g_null_logger, registry, { { "pool", "test" } });
+
+		for (int i = 0; i < 100; ++i)
+			(void) wp.submit ([]{ return 0; });
+
+		while (wp.queued_tasks() > 0)
+			std::this_thread::yield();
+	}
+
+	auto const snapshot = registry.snapshot();
+	std::uint64_t submitted = 0;
+	std::uint64_t executed = 0;
+
+	for (auto const& family: snapshot.families)
+	{
+		if (family.name == "neutrino_work_performer_submitted_tasks_total")
+			submitted = std::get<std::uint64_t> (family.samples.at (0).value);
+		else if (family.name == "neutrino_work_performer_executed_tasks_total")
+			executed = std::get<std::uint64_t> (family.samples.at (0).value);
+	}
+
+	test_asserts::verify ("submitted tasks are counted", submitted == 100);
+	test_asserts::verify ("executed tasks are counted", executed == 100);
+});
+
+
+AutoTest t5 ("neutrino::WorkPerformer: tasks abandoned on destruction leave the queue gauge", []{
+	MetricsRegistry registry;
+	MetricLabels const labels { { "pool", "test" } };
+
+	{
+		WorkPerformer wp (1, g_null_logger, registry, labels);
+
+		for (int i = 0; i < 10; ++i)
+			(void) wp.submit ([]{ std::this_thread::sleep_for (std::chrono::milliseconds (10)); return 0; });
+	}
+
+	auto const& queued = registry.gauge ("neutrino_work_performer_queued_tasks", "Number of tasks waiting for execution", labels);
+	test_asserts::verify ("queued tasks gauge drops to zero", queued.value() == 0.0);
+});
+
+} // namespace
+} // namespace neutrino::test
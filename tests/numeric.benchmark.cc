@@ -0,0 +1,72 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/test/benchmark.h>
+#include <neutrino/numeric.h>
+
+// Standard:
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+std::vector<double>
+random_values (std::size_t const count)
+{
+	std::mt19937 generator (42);
+	std::normal_distribution<double> distribution (10.0, 2.0);
+	std::vector<double> values (count);
+
+	for (auto& v: values)
+		v = distribution (generator);
+
+	return values;
+}
+
+
+Benchmark b1 ("mean() of 4096 values", [](std::size_t const iterations) {
+	auto const values = random_values (4096);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (mean (values.begin(), values.end()));
+});
+
+
+Benchmark b2 ("median() of 4096 values", [](std::size_t const iterations) {
+	auto const values = random_values (4096);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (median (values.begin(), values.end()));
+});
+
+
+Benchmark b3 ("stddev() of 4096 values", [](std::size_t const iterations) {
+	auto const values = random_values (4096);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (stddev (values.begin(), values.end()));
+});
+
+
+Benchmark b4 ("trapezoid_integral() of sin()", [](std::size_t const iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (trapezoid_integral (static_cast<double (*)(double)> (std::sin), { -5.3, +12.0 }, 1e-3));
+});
+
+} // namespace
+} // namespace neutrino::test
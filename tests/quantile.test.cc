@@ -0,0 +1,181 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/numeric.h>
+#include <neutrino/quantile.h>
+#include <neutrino/si/si.h>
+#include <neutrino/stdexcept.h>
+#include <neutrino/test/auto_test.h>
+
+// Standard:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace neutrino::si::literals;
+
+
+std::vector<double>
+random_samples (std::size_t const count, unsigned int const seed)
+{
+	std::mt19937 generator (seed);
+	std::lognormal_distribution<double> distribution (0.0, 1.0);
+	std::vector<double> samples;
+
+	for (std::size_t i = 0; i < count; ++i)
+		samples.push_back (distribution (generator));
+
+	return samples;
+}
+
+
+/**
+ * Return normalized rank of value in sorted sequence.
+ */
+double
+rank_of (std::vector<double> const& sorted, double const value)
+{
+	auto const position = std::lower_bound (sorted.begin(), sorted.end(), value) - sorted.begin();
+	return static_cast<double> (position) / static_cast<double> (sorted.size());
+}
+
+
+AutoTest t1 ("TDigest: rank error", []{
+	auto samples = random_samples (100'000, 1);
+	TDigest<double> digest;
+	digest.add (samples.begin(), samples.end());
+	std::ranges::sort (samples);
+
+	test_asserts::verify ("count() is correct", digest.count() == samples.size());
+	test_asserts::verify ("memory is bounded", digest.centroids().size() <= 100);
+	test_asserts::verify ("min() is exact", digest.min() == samples.front());
+	test_asserts::verify ("max() is exact", digest.max() == samples.back());
+	test_asserts::verify ("quantile (0) is min()", digest.quantile (0.0) == samples.front());
+	test_asserts::verify ("quantile (1) is max()", digest.quantile (1.0) == samples.back());
+
+	for (auto const q: { 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999 })
+	{
+		test_asserts::verify_equal_with_epsilon (std::format ("rank of quantile ({}) is correct", q), rank_of (samples, digest.quantile (q)), q, 1e-3);
+	}
+
+	auto const median = approximate_quantile (samples.begin(), samples.end(), 0.5);
+	test_asserts::verify_equal_with_epsilon ("approximate_quantile() is correct", rank_of (samples, median), 0.5, 1e-3);
+
+	test_asserts::verify_throws<std::length_error> ("quantile() of empty digest throws", []{
+		(void) TDigest<double>().quantile (0.5);
+	});
+
+	test_asserts::verify_throws<InvalidArgument> ("too small compression is rejected", []{
+		TDigest<double> (1.0);
+	});
+});
+
+
+AutoTest t2 ("TDigest: merge()", []{
+	constexpr std::size_t kParts = 8;
+	std::vector<double> all;
+	TDigest<double> merged;
+
+	// Like filling in parallel, each part in its own digest:
+	for (std::size_t part = 0; part < kParts; ++part)
+	{
+		auto const samples = random_samples (10'000, static_cast<unsigned int> (part + 10));
+		TDigest<double> partial;
+		partial.add (samples.begin(), samples.end());
+		merged.merge (partial);
+		all.insert (all.end(), samples.begin(), samples.end());
+	}
+
+	merged.merge (TDigest<double>());
+	std::ranges::sort (all);
+
+	TDigest<double> doubled;
+	doubled.add (all.begin(), all.end());
+	auto const median = doubled.quantile (0.5);
+	doubled.merge (doubled);
+	test_asserts::verify ("merging digest with itself doubles count()", doubled.count() == 2 * all.size());
+	test_asserts::verify_equal_with_epsilon ("merging digest with itself keeps quantiles", rank_of (all, doubled.quantile (0.5)), rank_of (all, median), 2e-3);
+
+	test_asserts::verify ("merged count() is correct", merged.count() == all.size());
+	test_asserts::verify ("merged min() is exact", merged.min() == all.front());
+	test_asserts::verify ("merged max() is exact", merged.max() == all.back());
+
+	for (auto const q: { 0.001, 0.01, 0.5, 0.99, 0.999 })
+	{
+		test_asserts::verify_equal_with_epsilon (std::format ("rank of merged quantile ({}) is correct", q), rank_of (all, merged.quantile (q)), q, 2e-3);
+	}
+});
+
+
+AutoTest t3 ("P2Quantile", []{
+	auto samples = random_samples (100'000, 2);
+	P2Quantile<double> p50 (0.5);
+	P2Quantile<double> p99 (0.99);
+	p50.add (samples.begin(), samples.end());
+	p99.add (samples.begin(), samples.end());
+	auto const approximate = approximate_median (samples.begin(), samples.end());
+	std::ranges::sort (samples);
+
+	test_asserts::verify ("count() is correct", p50.count() == samples.size());
+	test_asserts::verify_equal_with_epsilon ("median is correct", p50.value(), samples[samples.size() / 2], 0.01);
+	test_asserts::verify_equal_with_epsilon ("rank of 99th percentile is correct", rank_of (samples, p99.value()), 0.99, 0.001);
+	test_asserts::verify ("approximate_median() gives the same result", approximate == p50.value());
+
+	P2Quantile<double> few (0.5);
+
+	for (auto const sample: { 4.0, 1.0, 3.0 })
+		few.add (sample);
+
+	test_asserts::verify ("median of less than five samples is exact", few.value() == 3.0);
+
+	P2Quantile<double> five (0.25);
+
+	for (auto const sample: { 5.0, 1.0, 4.0, 2.0, 3.0 })
+		five.add (sample);
+
+	test_asserts::verify ("quantile of five samples is exact", five.value() == 2.0);
+
+	test_asserts::verify_throws<std::length_error> ("value() of empty estimator throws", []{
+		(void) P2Quantile<double> (0.5).value();
+	});
+
+	test_asserts::verify_throws<InvalidArgument> ("invalid quantile is rejected", []{
+		P2Quantile<double> (1.5);
+	});
+});
+
+
+AutoTest t4 ("quantile sketches: SI quantities", []{
+	std::vector<si::Time> samples;
+
+	for (auto const sample: random_samples (10'000, 3))
+		samples.push_back (1_ms * sample);
+
+	auto const raw = random_samples (10'000, 3);
+	auto const exact = 1_ms * neutrino::median (raw.begin(), raw.end());
+	test_asserts::verify_equal_with_epsilon ("approximate_median() is correct", approximate_median (samples.begin(), samples.end()), exact, 0.02_ms);
+	test_asserts::verify_equal_with_epsilon ("approximate_quantile() is correct", approximate_quantile (samples.begin(), samples.end(), 0.5), exact, 0.02_ms);
+});
+
+} // namespace
+} // namespace neutrino::test
+
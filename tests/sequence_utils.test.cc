@@ -0,0 +1,56 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/test/auto_test.h>
+#include <neutrino/sequence_utils.h>
+
+// Standard:
+#include <cstddef>
+#include <format>
+#include <limits>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+AutoTest t1 ("sorted_adjacent_find_for_extrapolation() matches adjacent_find_for_extrapolation()", []{
+	auto const identity = [](double const value) { return value; };
+
+	for (std::size_t size = 0; size < 8; ++size)
+	{
+		std::vector<double> keys;
+
+		for (std::size_t i = 0; i < size; ++i)
+			keys.push_back (1.0 + 2.0 * i);
+
+		// Query keys themselves, points between them, outside of the range and NaN:
+		std::vector<double> queries { std::numeric_limits<double>::quiet_NaN() };
+
+		for (double query = -1.0; query <= 2.0 * size + 2.0; query += 0.5)
+			queries.push_back (query);
+
+		for (auto const query: queries)
+		{
+			auto const [expected_inside, expected_a, expected_b] = adjacent_find_for_extrapolation (keys.begin(), keys.end(), query, identity);
+			auto const [inside, a, b] = sorted_adjacent_find_for_extrapolation (keys.begin(), keys.end(), query, identity);
+			auto const name = std::format ("results are equal for size {} and value {}", size, query);
+
+			test_asserts::verify (name, inside == expected_inside && a == expected_a && b == expected_b);
+		}
+	}
+});
+
+} // namespace
+} // namespace neutrino::test
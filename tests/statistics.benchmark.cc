@@ -0,0 +1,83 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/numeric.h>
+#include <neutrino/statistics.h>
+#include <neutrino/test/benchmark.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+Logger g_null_logger;
+
+
+std::vector<double>
+random_values (std::size_t const count)
+{
+	std::mt19937 generator (42);
+	std::normal_distribution<double> distribution (10.0, 2.0);
+	std::vector<double> values (count);
+
+	for (auto& v: values)
+		v = distribution (generator);
+
+	return values;
+}
+
+
+Benchmark b1 ("mean() + stddev() of 4096 values, iterator version", [](std::size_t const iterations) {
+	auto const values = random_values (4096);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		do_not_optimize (mean (values.begin(), values.end()));
+		do_not_optimize (stddev (values.begin(), values.end()));
+	}
+});
+
+
+Benchmark b2 ("descriptive_statistics() of 4096 values", [](std::size_t const iterations) {
+	auto const values = random_values (4096);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (descriptive_statistics (values));
+});
+
+
+Benchmark b3 ("descriptive_statistics() of 16M values", [](std::size_t const iterations) {
+	static auto const values = random_values (16'000'000);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (descriptive_statistics (values));
+});
+
+
+Benchmark b4 ("descriptive_statistics() of 16M values, 4 threads", [](std::size_t const iterations) {
+	static auto const values = random_values (16'000'000);
+	static WorkPerformer work_performer (4, g_null_logger);
+
+	for (std::size_t i = 0; i < iterations; ++i)
+		do_not_optimize (descriptive_statistics (values, work_performer));
+});
+
+} // namespace
+} // namespace neutrino::test
+
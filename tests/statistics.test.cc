@@ -0,0 +1,127 @@
+/* vim:ts=4
+ *
+ * Copyleft 2025  Michał Gawron
+ * Marduk Unix Labs, http://mulabs.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Visit http://www.gnu.org/licenses/gpl-3.0.html for more information on licensing.
+ */
+
+// Neutrino:
+#include <neutrino/numeric.h>
+#include <neutrino/si/si.h>
+#include <neutrino/statistics.h>
+#include <neutrino/test/auto_test.h>
+#include <neutrino/work_performer.h>
+
+// Standard:
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace neutrino::test {
+namespace {
+
+using namespace neutrino::si::literals;
+
+Logger g_null_logger;
+
+
+std::vector<double>
+random_values (std::size_t const count, double const offset)
+{
+	std::mt19937 generator (1);
+	std::normal_distribution<double> distribution (offset, 2.0);
+	std::vector<double> values (count);
+
+	for (auto& value: values)
+		value = distribution (generator);
+
+	return values;
+}
+
+
+AutoTest t1 ("descriptive_statistics(): results match numeric.h functions", []{
+	// Sizes not divisible by block or SIMD pack sizes:
+	for (auto const size: { 1uz, 3uz, 1000uz, 4097uz, 100'003uz })
+	{
+		auto const values = random_values (size, 10.0);
+		auto const statistics = descriptive_statistics (values);
+		auto const expected_sum = std::accumulate (values.begin(), values.end(), 0.0);
+
+		test_asserts::verify (std::format ("count is correct for {} values", size), statistics.count == size);
+		test_asserts::verify_equal_with_epsilon (std::format ("sum is correct for {} values", size), statistics.sum, expected_sum, 1e-9 * size);
+		test_asserts::verify (std::format ("min is correct for {} values", size), statistics.min == std::ranges::min (values));
+		test_asserts::verify (std::format ("max is correct for {} values", size), statistics.max == std::ranges::max (values));
+		test_asserts::verify_equal_with_epsilon (std::format ("mean is correct for {} values", size), statistics.mean, neutrino::mean (values.begin(), values.end()), 1e-12);
+
+		if (size > 1)
+			test_asserts::verify_equal_with_epsilon (std::format ("stddev() is correct for {} values", size), statistics.stddev(), neutrino::stddev (values.begin(), values.end()), 1e-12);
+	}
+
+	auto const values = random_values (1000, 10.0);
+	test_asserts::verify ("mean() of contiguous values is correct", neutrino::mean (std::span (values)) == descriptive_statistics (values).mean);
+	test_asserts::verify ("stddev() of contiguous values is correct", neutrino::stddev (values) == descriptive_statistics (values).stddev());
+
+	test_asserts::verify_throws<std::length_error> ("statistics of empty sequence can't be computed", []{
+		(void) descriptive_statistics (std::vector<double>());
+	});
+});
+
+
+AutoTest t2 ("descriptive_statistics(): accuracy", []{
+	// Large offset makes naive sum of squares lose all precision:
+	auto const values = random_values (1'000'000, 1e9);
+	auto const statistics = descriptive_statistics (values);
+	auto const float_values = [] {
+		auto const values = random_values (1'000'000, 1e4);
+		return std::vector<float> (values.begin(), values.end());
+	}();
+	auto const float_as_double = std::vector<double> (float_values.begin(), float_values.end());
+	std::vector<float> ones (10'000'000, 1.0f);
+
+	test_asserts::verify_equal_with_epsilon ("stddev() is accurate with large mean", statistics.stddev(), neutrino::stddev (values.begin(), values.end()), 1e-6);
+	test_asserts::verify_equal_with_epsilon ("stddev() of floats is accurate", descriptive_statistics (float_values).stddev(), static_cast<float> (descriptive_statistics (float_as_double).stddev()), 1e-4f);
+	test_asserts::verify ("sum of many floats is exact", descriptive_statistics (ones).sum == 1e7f);
+});
+
+
+AutoTest t3 ("descriptive_statistics(): parallel version", []{
+	WorkPerformer work_performer (4, g_null_logger);
+	auto const values = random_values (1'000'003, 10.0);
+	auto const serial = descriptive_statistics (values);
+	auto const parallel = descriptive_statistics (values, work_performer);
+	auto const small = random_values (100, 10.0);
+
+	test_asserts::verify ("count is correct", parallel.count == serial.count);
+	test_asserts::verify ("min and max are correct", parallel.min == serial.min && parallel.max == serial.max);
+	test_asserts::verify_equal_with_epsilon ("sum is correct", parallel.sum, serial.sum, 1e-6);
+	test_asserts::verify_equal_with_epsilon ("mean is correct", parallel.mean, serial.mean, 1e-12);
+	test_asserts::verify_equal_with_epsilon ("stddev() is correct", parallel.stddev(), serial.stddev(), 1e-12);
+	test_asserts::verify ("small sequence gives the same result", descriptive_statistics (small, work_performer).m2 == descriptive_statistics (small).m2);
+});
+
+
+AutoTest t4 ("descriptive_statistics(): SI quantities", []{
+	std::vector<si::Time> const values { 1.5_ms, 2.5_ms, 3.5_ms, 4.5_ms, 20_ms };
+	auto const statistics = descriptive_statistics (values);
+
+	test_asserts::verify ("min and max are correct", statistics.min == 1.5_ms && statistics.max == 20_ms);
+	test_asserts::verify_equal_with_epsilon ("sum is correct", statistics.sum, 32_ms, 1e-9_ms);
+	test_asserts::verify_equal_with_epsilon ("mean is correct", statistics.mean, 6.4_ms, 1e-9_ms);
+	test_asserts::verify_equal_with_epsilon ("stddev() is correct", statistics.stddev(), 7.6843998_ms, 1e-6_ms);
+});
+
+} // namespace
+} // namespace neutrino::test
+
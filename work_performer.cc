@@ -27,7 +27,24 @@
 namespace neutrino {
 
 WorkPerformer::WorkPerformer (std::size_t threads_number, Logger const& logger):
+	WorkPerformer (threads_number, logger, std::nullopt)
+{ }
+
+
+WorkPerformer::WorkPerformer (std::size_t threads_number, Logger const& logger, MetricsRegistry& metrics, MetricLabels const& labels):
+	WorkPerformer (threads_number, logger, Metrics {
+		.submitted_tasks = metrics.counter ("neutrino_work_performer_submitted_tasks_total", "Number of tasks submitted to WorkPerformer", labels),
+		.executed_tasks = metrics.counter ("neutrino_work_performer_executed_tasks_total", "Number of tasks executed by WorkPerformer", labels),
+		.queued_tasks = metrics.gauge ("neutrino_work_performer_queued_tasks", "Number of tasks waiting for execution", labels),
+		.wait_time = metrics.histogram ("neutrino_work_performer_task_wait_seconds", "Time tasks spent in the queue", labels),
+		.execution_time = metrics.histogram ("neutrino_work_performer_task_execution_seconds", "Time of task execution", labels),
+	})
+{ }
+
+
+WorkPerformer::WorkPerformer (std::size_t threads_number, Logger const& logger, std::optional<Metrics> metrics):
 	_logger (logger.with_context ("<work performer>")),
+	_metrics (std::move (metrics)),
 	_tasks_semaphore (0)
 {
 	if (threads_number == 0)
@@ -50,6 +67,10 @@ WorkPerformer::~WorkPerformer()
 		tasks->size() > 0)
 	{
 		_logger << std::format ("Destroyed WorkPerformer with {} tasks never started\n", tasks->size());
+
+		// The registry outlives this performer, so remove tasks that will never run from the gauge:
+		if (_metrics)
+			_metrics->queued_tasks.sub (static_cast<double> (tasks->size()));
 	}
 }
 
@@ -88,7 +109,19 @@ WorkPerformer::thread()
 		}
 
 		if (task)
-			(*task)();
+		{
+			if (_metrics)
+			{
+				auto const started = steady_now();
+				_metrics->queued_tasks.sub (1.0);
+				_metrics->wait_time.record (started - task->submit_timestamp);
+				(*task)();
+				_metrics->execution_time.record (steady_now() - started);
+				_metrics->executed_tasks.add();
+			}
+			else
+				(*task)();
+		}
 	}
 }
 
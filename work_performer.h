@@ -16,10 +16,12 @@
 
 // Neutrino:
 #include <neutrino/logger.h>
+#include <neutrino/metrics.h>
 #include <neutrino/noncopyable.h>
 #include <neutrino/polymorphic.h>
 #include <neutrino/synchronized.h>
 #include <neutrino/thread.h>
+#include <neutrino/time.h>
 
 // Standard:
 #include <cstddef>
@@ -50,6 +52,14 @@ class WorkPerformer: private Noncopyable
 	explicit
 	WorkPerformer (std::size_t threads_number, Logger const&);
 
+	/**
+	 * Ctor
+	 * Also registers and updates work performer metrics (submitted/executed tasks, queue length, task wait and
+	 * execution times) in given registry. Use labels to distinguish between multiple WorkPerformers.
+	 */
+	explicit
+	WorkPerformer (std::size_t threads_number, Logger const&, MetricsRegistry&, MetricLabels const& = {});
+
 	// Dtor
 	~WorkPerformer();
 
@@ -93,11 +103,27 @@ class WorkPerformer: private Noncopyable
 	{
 		virtual void
 		operator()() = 0;
+
+		// Time of submission, set only when metrics are enabled:
+		si::Time submit_timestamp { 0.0 };
+	};
+
+	struct Metrics
+	{
+		Counter&			submitted_tasks;
+		Counter&			executed_tasks;
+		Gauge&				queued_tasks;
+		LatencyHistogram&	wait_time;
+		LatencyHistogram&	execution_time;
 	};
 
 	using TaskQueue = std::queue<std::unique_ptr<AbstractTask>>;
 
   private:
+	// Ctor
+	explicit
+	WorkPerformer (std::size_t threads_number, Logger const&, std::optional<Metrics>);
+
 	/**
 	 * Function executed by all threads.
 	 * Waits for new tasks or exits when _terminating is true.
@@ -105,8 +131,15 @@ class WorkPerformer: private Noncopyable
 	void
 	thread();
 
+	/**
+	 * Queue task for execution.
+	 */
+	void
+	enqueue (std::unique_ptr<AbstractTask>);
+
   private:
 	Logger							_logger;
+	std::optional<Metrics>			_metrics;
 	std::atomic<bool>				_terminating { false };
 	Synchronized<TaskQueue> mutable	_tasks;
 	std::counting_semaphore<>		_tasks_semaphore;
@@ -121,6 +154,21 @@ WorkPerformer::threads_number() const noexcept
 }
 
 
+inline void
+WorkPerformer::enqueue (std::unique_ptr<AbstractTask> task)
+{
+	if (_metrics)
+	{
+		task->submit_timestamp = steady_now();
+		_metrics->submitted_tasks.add();
+		_metrics->queued_tasks.add (1.0);
+	}
+
+	_tasks->push (std::move (task));
+	_tasks_semaphore.release();
+}
+
+
 template<class Result, class ...Args>
 	inline std::future<Result>
 	WorkPerformer::submit (std::packaged_task<Result (Args...)>&& task, Args&&... args)
@@ -146,8 +194,7 @@ template<class Result, class ...Args>
 		};
 
 		std::future<Result> future = task.get_future();
-		_tasks->emplace (std::make_unique<ConcreteTask> (std::move (task), std::forward<Args> (args)...));
-		_tasks_semaphore.release();
+		enqueue (std::make_unique<ConcreteTask> (std::move (task), std::forward<Args> (args)...));
 		return future;
 	}
 